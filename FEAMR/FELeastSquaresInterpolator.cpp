@@ -24,97 +24,9 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 #include "FELeastSquaresInterpolator.h"
-#include <FECore/FENNQuery.h>
 #include <algorithm>
 using namespace std;
 
-class KDTree
-{
-public:
-	KDTree()
-	{
-		m_parent = nullptr;
-		m_left = nullptr;
-		m_right = nullptr;
-	}
-
-	void build(vector<vec3d> pts, int depth = 0)
-	{
-		size_t n = pts.size();
-		if (n == 1)
-		{
-			m_r = pts[0];
-			return;
-		}
-
-		int axis = depth % 3;
-		std::sort(pts.begin(), pts.end(), [=](const vec3d& a, const vec3d& b) {
-			if (axis == 0) return (a.x < b.x);
-			if (axis == 1) return (a.y < b.y);
-			if (axis == 2) return (a.z < b.z);
-			return false;
-		});
-
-		int med = n / 2;
-
-		m_r = pts[med];
-
-		// build left list
-		if (med > 0)
-		{
-			vector<vec3d> l(pts.begin(), pts.begin() + med);
-			m_left = new KDTree(this);
-			m_left->build(l, depth + 1);
-		}
-
-		// build right list
-		if (med < n - 1)
-		{
-			vector<vec3d> r(pts.begin() + med + 1, pts.end());
-			m_right = new KDTree(this);
-			m_right->build(r, depth + 1);
-		}
-	}
-
-public:
-	vec3d	m_r;
-	KDTree*	m_parent;
-	KDTree*	m_left;
-	KDTree*	m_right;
-
-public:
-	KDTree(KDTree* parent) : m_parent(parent)
-	{
-		m_left = nullptr;
-		m_right = nullptr;
-	}
-};
-
-class NearestNeighborSearch
-{
-public:
-	NearestNeighborSearch() {}
-
-	void Init(const std::vector<vec3d>& points, int k)
-	{
-		m_k = k;
-		m_points = points;
-
-//		m_kdtree.build(m_points);
-	}
-
-	int findNearestNeighbors(const vec3d& x, std::vector<int>& closestNodes)
-	{
-		return findNeirestNeighbors(m_points, x, m_k, closestNodes);
-	}
-
-protected:
-	int				m_k;
-	vector<vec3d>	m_points;
-
-	KDTree	m_kdtree;
-};
-
 FELeastSquaresInterpolator::Data::Data() {}
 FELeastSquaresInterpolator::Data::Data(const Data& d)
 {
@@ -154,6 +66,10 @@ void FELeastSquaresInterpolator::SetCheckForMatch(bool b) { m_checkForMatch = b;
 void FELeastSquaresInterpolator::SetSourcePoints(const vector<vec3d>& srcPoints)
 {
 	m_src = srcPoints;
+
+	// the search tree only depends on the source points, so we build it here
+	// instead of in Init, which gets called for every target point in SetTargetPoint.
+	m_tree.Build(m_src);
 }
 
 void FELeastSquaresInterpolator::SetTargetPoints(const vector<vec3d>& trgPoints)
@@ -179,19 +95,17 @@ bool FELeastSquaresInterpolator::Init()
 
 	m_data.resize(N1);
 
-	// initialize nearest neighbor search
-	NearestNeighborSearch NNS;
-	NNS.Init(m_src, m_nnc);
-
 	// do nearest-neighbor search
+#pragma omp parallel for
 	for (int i = 0; i < N1; ++i)
 	{
 		vec3d ri = m_trg[i];
-		int M = NNS.findNearestNeighbors(ri, m_data[i].cpl);
+		int M = m_tree.FindNearest(ri, m_nnc, m_data[i].cpl);
 		assert(M > 4);
 		m_data[i].cpl.resize(M);
 	}
 
+#pragma omp parallel for
 	for (int i = 0; i < N1; ++i)
 	{
 		Data& d = m_data[i];
@@ -168,6 +168,8 @@ int FEBioApp::RunModel()
 	fem.SetLogFilename(m_ops.szlog);
 	fem.SetPlotFilename(m_ops.szplt);
 	fem.SetDumpFilename(m_ops.szdmp);
+	fem.SetProfileFilename(m_ops.szprof);
+	fem.SetTraceFilename(m_ops.sztrace);
 
 	// read the input file if specified
 	int nret = 0;
@@ -253,6 +255,8 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 	ops.sztask[0] = 0;
 	ops.szctrl[0] = 0;
 	ops.szimp[0] = 0;
+	ops.szprof[0] = 0;
+	ops.sztrace[0] = 0;
 
 	// set initial configuration file name
 	if (ops.szcnf[0] == 0)
@@ -434,6 +438,26 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 				return false;
 			}
 		}
+		else if (strcmp(sz, "-profile") == 0)
+		{
+			if ((i < nargs - 1) && (argv[i+1][0] != '-'))
+				strcpy(ops.szprof, argv[++i]);
+			else
+			{
+				fprintf(stderr, "FATAL ERROR: insufficient number of arguments for -profile.\n");
+				return false;
+			}
+		}
+		else if (strcmp(sz, "-trace") == 0)
+		{
+			if ((i < nargs - 1) && (argv[i+1][0] != '-'))
+				strcpy(ops.sztrace, argv[++i]);
+			else
+			{
+				fprintf(stderr, "FATAL ERROR: insufficient number of arguments for -trace.\n");
+				return false;
+			}
+		}
 		else if (sz[0] == '-')
 		{
 			fprintf(stderr, "FATAL ERROR: Invalid command line option.\n");
@@ -35,6 +35,7 @@ SOFTWARE.*/
 #include <FECore/CompactMatrix.h>
 #include <FECore/FEAnalysis.h>
 #include <FECore/FEGlobalMatrix.h>
+#include <FECore/BinaryDataRecord.h>
 #include "FEBioCommand.h"
 #include "console.h"
 #include <FEBioLib/cmdoptions.h>
@@ -72,6 +73,7 @@ REGISTER_COMMAND(FEBioCmd_Fail         , "fail"   , "force iteratoin failer");
 REGISTER_COMMAND(FEBioCmd_Help         , "help"   , "print available commands");
 REGISTER_COMMAND(FEBioCmd_hist         , "hist"   , "lists history of commands");
 REGISTER_COMMAND(FEBioCmd_LoadPlugin   , "import" , "load a plugin");
+REGISTER_COMMAND(FEBioCmd_logdump      , "logdump", "convert a binary data file to text");
 REGISTER_COMMAND(FEBioCmd_Plot         , "plot"   , "store current state to plot file");
 REGISTER_COMMAND(FEBioCmd_out          , "out"    , "write matrix and rhs file");
 REGISTER_COMMAND(FEBioCmd_Plugins      , "plugins", "list the plugins that are loaded");
@@ -780,3 +782,57 @@ int FEBioCmd_set::run(int nargs, char** argv)
 
 	return 0;
 }
+
+//-----------------------------------------------------------------------------
+// usage: logdump binfile [txtfile]
+// Writes the contents of a binary data file in the same layout as the text data files.
+int FEBioCmd_logdump::run(int nargs, char** argv)
+{
+	if ((nargs < 2) || (nargs > 3)) return invalid_nr_args();
+
+	BinaryDataRecordReader in;
+	if (in.Open(argv[1]) == false)
+	{
+		printf("Failed reading binary data file %s\n", argv[1]);
+		return 0;
+	}
+
+	FILE* fp = stdout;
+	if (nargs == 3)
+	{
+		fp = fopen(argv[2], "wt");
+		if (fp == nullptr)
+		{
+			printf("Failed creating file %s\n", argv[2]);
+			return 0;
+		}
+	}
+
+	const std::vector<int>& items = in.Items();
+	int N = (int)items.size();
+	int nc = (int)in.Columns().size();
+
+	int nblocks = 0;
+	BinaryDataRecordReader::BLOCK block;
+	while (in.ReadBlock(block))
+	{
+		fprintf(fp, "*Step  = %d\n", block.step);
+		fprintf(fp, "*Time  = %.9lg\n", block.time);
+		fprintf(fp, "*Data  = %s\n", in.Name().c_str());
+		for (int i = 0; i < N; ++i)
+		{
+			fprintf(fp, "%d", items[i]);
+			for (int j = 0; j < nc; ++j) fprintf(fp, " %.12lg", in.Value(block, i, j));
+			fprintf(fp, "\n");
+		}
+		nblocks++;
+	}
+
+	if (fp != stdout)
+	{
+		fclose(fp);
+		printf("%d steps written to %s\n", nblocks, argv[2]);
+	}
+
+	return 0;
+}
@@ -270,3 +270,11 @@ public:
 	int run(int nargs, char** argv);
 	DECLARE_COMMAND(FEBioCmd_set);
 };
+
+//-----------------------------------------------------------------------------
+class FEBioCmd_logdump : public FEBioCommand
+{
+public:
+	int run(int nargs, char** argv);
+	DECLARE_COMMAND(FEBioCmd_logdump);
+};
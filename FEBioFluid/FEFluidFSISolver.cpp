@@ -54,6 +54,7 @@ SOFTWARE.*/
 #include <FECore/FEAnalysis.h>
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/DumpStream.h>
+#include <FECore/FEProfiler.h>
 #include <NumCore/NumCore.h>
 #include "FEFluidFSIAnalysis.h"
 
@@ -513,7 +514,11 @@ void FEFluidFSISolver::UpdateKinematics(vector<double>& ui)
     for (int i=0; i<nvel; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive()) bc.Update();
+        if (bc.IsActive())
+        {
+            TRACK_COMPONENT(&bc, "Update");
+            bc.Update();
+        }
     }
     
     // apply prescribed DOFs for specialized surface loads
@@ -806,7 +811,11 @@ void FEFluidFSISolver::PrepStep()
     for (int i=0; i<nbc; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive()) bc.PrepStep(ui);
+        if (bc.IsActive())
+        {
+            TRACK_COMPONENT(&bc, "PrepStep");
+            bc.PrepStep(ui);
+        }
     }
 
     // apply prescribed DOFs for specialized surface loads
@@ -1067,6 +1076,7 @@ bool FEFluidFSISolver::StiffnessMatrix()
     // calculate the stiffness matrix for each domain
     for (int i=0; i<mesh.Domains(); ++i)
     {
+        TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
         FEDomain& dom = mesh.Domain(i);
         if (dom.IsActive()) {
             FEFluidDomain* fdom = dynamic_cast<FEFluidDomain*>(&dom);
@@ -1170,7 +1180,11 @@ void FEFluidFSISolver::NonLinearConstraintStiffness(FELinearSystem& LS, const FE
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->StiffnessMatrix(LS, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "StiffnessMatrix");
+            plc->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -1185,7 +1199,11 @@ void FEFluidFSISolver::ContactStiffness(FELinearSystem& LS)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "StiffnessMatrix");
+            pci->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -1199,7 +1217,11 @@ void FEFluidFSISolver::ContactForces(FEGlobalVector& R)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->LoadVector(R, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "LoadVector");
+            pci->LoadVector(R, tp);
+        }
     }
 }
 
@@ -1234,6 +1256,7 @@ bool FEFluidFSISolver::Residual(vector<double>& R)
     // calculate the internal (stress) forces
     for (int i=0; i<mesh.Domains(); ++i)
     {
+        TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
         FEDomain& dom = mesh.Domain(i);
         if (dom.IsActive())
 		{
@@ -1314,7 +1337,11 @@ bool FEFluidFSISolver::Residual(vector<double>& R)
     for (int i = 0; i < NML; ++i)
     {
         FEModelLoad& mli = *fem.ModelLoad(i);
-        if (mli.IsActive()) mli.LoadVector(RHS);
+        if (mli.IsActive())
+        {
+            TRACK_COMPONENT(&mli, "LoadVector");
+            mli.LoadVector(RHS);
+        }
     }
 
     // calculate contact forces
@@ -1355,6 +1382,10 @@ void FEFluidFSISolver::NonLinearConstraintForces(FEGlobalVector& R, const FETime
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->LoadVector(R, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "LoadVector");
+            plc->LoadVector(R, tp);
+        }
     }
 }
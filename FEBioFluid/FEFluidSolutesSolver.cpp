@@ -54,6 +54,7 @@ SOFTWARE.*/
 #include <FECore/FENLConstraint.h>
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEProfiler.h>
 #include "FEFluidSolutesAnalysis.h"
 #include <limits>
 
@@ -426,7 +427,11 @@ void FEFluidSolutesSolver::UpdateKinematics(vector<double>& ui)
     for (int i=0; i<nvel; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive() && HasActiveDofs(bc.GetDofList())) bc.Update();
+        if (bc.IsActive() && HasActiveDofs(bc.GetDofList()))
+        {
+            TRACK_COMPONENT(&bc, "Update");
+            bc.Update();
+        }
     }
     
     // prescribe DOFs for specialized surface loads
@@ -669,7 +674,11 @@ void FEFluidSolutesSolver::PrepStep()
     for (int i=0; i<nbc; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive() && HasActiveDofs(bc.GetDofList())) bc.PrepStep(ui);
+        if (bc.IsActive() && HasActiveDofs(bc.GetDofList()))
+        {
+            TRACK_COMPONENT(&bc, "PrepStep");
+            bc.PrepStep(ui);
+        }
     }
     
     // apply prescribed DOFs for specialized surface loads
@@ -1001,6 +1010,7 @@ bool FEFluidSolutesSolver::StiffnessMatrix(FELinearSystem& LS)
     for (int i=0; i<mesh.Domains(); ++i)
     {
         FEFluidDomain& dom = dynamic_cast<FEFluidDomain&>(mesh.Domain(i));
+        TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
         dom.StiffnessMatrix(LS);
     }
     
@@ -1027,7 +1037,11 @@ bool FEFluidSolutesSolver::StiffnessMatrix(FELinearSystem& LS)
     for (int i=0; i<nsl; ++i)
     {
         FEModelLoad* pml = fem.ModelLoad(i);
-        if (pml->IsActive()) pml->StiffnessMatrix(LS);
+        if (pml->IsActive())
+        {
+            TRACK_COMPONENT(pml, "StiffnessMatrix");
+            pml->StiffnessMatrix(LS);
+        }
         //        if (pml->IsActive() && HasActiveDofs(pml->GetDofList())) pml->StiffnessMatrix(LS);
     }
 
@@ -1057,7 +1071,11 @@ void FEFluidSolutesSolver::NonLinearConstraintStiffness(FELinearSystem& LS, cons
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->StiffnessMatrix(LS, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "StiffnessMatrix");
+            plc->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -1072,7 +1090,11 @@ void FEFluidSolutesSolver::ContactStiffness(FELinearSystem& LS)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "StiffnessMatrix");
+            pci->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -1086,7 +1108,11 @@ void FEFluidSolutesSolver::ContactForces(FEGlobalVector& R)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->LoadVector(R, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "LoadVector");
+            pci->LoadVector(R, tp);
+        }
     }
 }
 
@@ -1119,6 +1145,7 @@ bool FEFluidSolutesSolver::Residual(vector<double>& R)
     for (int i=0; i<mesh.Domains(); ++i)
     {
         FEFluidDomain& dom = dynamic_cast<FEFluidDomain&>(mesh.Domain(i));
+        TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
         dom.InternalForces(RHS);
     }
     
@@ -1158,6 +1185,7 @@ bool FEFluidSolutesSolver::Residual(vector<double>& R)
         FEModelLoad& mli = *fem.ModelLoad(i);
         if (mli.IsActive())
         {
+            TRACK_COMPONENT(&mli, "LoadVector");
             mli.LoadVector(RHS);
         }
     }
@@ -1193,7 +1221,11 @@ void FEFluidSolutesSolver::NonLinearConstraintForces(FEGlobalVector& R, const FE
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->LoadVector(R, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "LoadVector");
+            plc->LoadVector(R, tp);
+        }
     }
 }
 
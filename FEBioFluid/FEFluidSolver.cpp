@@ -52,6 +52,7 @@ SOFTWARE.*/
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FENLConstraint.h>
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEProfiler.h>
 #include "FEBioFluid.h"
 #include "FEFluidAnalysis.h"
 
@@ -348,7 +349,11 @@ void FEFluidSolver::UpdateKinematics(vector<double>& ui)
     for (int i=0; i<nvel; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive() && HasActiveDofs(bc.GetDofList())) bc.Update();
+        if (bc.IsActive() && HasActiveDofs(bc.GetDofList()))
+        {
+            TRACK_COMPONENT(&bc, "Update");
+            bc.Update();
+        }
     }
 
 	// enforce the linear constraints
@@ -532,7 +537,11 @@ void FEFluidSolver::PrepStep()
     for (int i=0; i<nbc; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive() && HasActiveDofs(bc.GetDofList())) bc.PrepStep(ui);
+        if (bc.IsActive() && HasActiveDofs(bc.GetDofList()))
+        {
+            TRACK_COMPONENT(&bc, "PrepStep");
+            bc.PrepStep(ui);
+        }
     }
   
     // apply prescribed DOFs for specialized surface loads
@@ -751,6 +760,7 @@ bool FEFluidSolver::StiffnessMatrix(FELinearSystem& LS)
     for (int i=0; i<mesh.Domains(); ++i)
     {
         FEFluidDomain& dom = dynamic_cast<FEFluidDomain&>(mesh.Domain(i));
+        TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
         dom.StiffnessMatrix(LS);
     }
     
@@ -777,7 +787,11 @@ bool FEFluidSolver::StiffnessMatrix(FELinearSystem& LS)
     for (int i=0; i<nsl; ++i)
     {
         FEModelLoad* pml = fem.ModelLoad(i);
-        if (pml->IsActive()) pml->StiffnessMatrix(LS);
+        if (pml->IsActive())
+        {
+            TRACK_COMPONENT(pml, "StiffnessMatrix");
+            pml->StiffnessMatrix(LS);
+        }
 //        if (pml->IsActive() && HasActiveDofs(pml->GetDofList())) pml->StiffnessMatrix(LS);
     }
     
@@ -807,7 +821,11 @@ void FEFluidSolver::NonLinearConstraintStiffness(FELinearSystem& LS, const FETim
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->StiffnessMatrix(LS, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "StiffnessMatrix");
+            plc->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -822,7 +840,11 @@ void FEFluidSolver::ContactStiffness(FELinearSystem& LS)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "StiffnessMatrix");
+            pci->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -836,7 +858,11 @@ void FEFluidSolver::ContactForces(FEGlobalVector& R)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->LoadVector(R, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "LoadVector");
+            pci->LoadVector(R, tp);
+        }
     }
 }
 
@@ -869,6 +895,7 @@ bool FEFluidSolver::Residual(vector<double>& R)
     for (int i=0; i<mesh.Domains(); ++i)
     {
         FEFluidDomain& dom = dynamic_cast<FEFluidDomain&>(mesh.Domain(i));
+        TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
         dom.InternalForces(RHS);
     }
     
@@ -908,6 +935,7 @@ bool FEFluidSolver::Residual(vector<double>& R)
         FEModelLoad& mli = *fem.ModelLoad(i);
         if (mli.IsActive())
         {
+            TRACK_COMPONENT(&mli, "LoadVector");
             mli.LoadVector(RHS);
         }
     }
@@ -943,7 +971,11 @@ void FEFluidSolver::NonLinearConstraintForces(FEGlobalVector& R, const FETimeInf
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->LoadVector(R, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "LoadVector");
+            plc->LoadVector(R, tp);
+        }
     }
 }
 
@@ -58,6 +58,7 @@
 #include <FECore/FEAnalysis.h>
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/DumpStream.h>
+#include <FECore/FEProfiler.h>
 #include <FEBioMech/FESolidLinearSystem.h>
 #include "FEBioFSI.h"
 #include "FEBioMultiphasicFSI.h"
@@ -620,7 +621,11 @@ void FEMultiphasicFSISolver::UpdateKinematics(vector<double>& ui)
     for (int i=0; i<nvel; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive()) bc.Update();
+        if (bc.IsActive())
+        {
+            TRACK_COMPONENT(&bc, "Update");
+            bc.Update();
+        }
     }
     
     // apply prescribed DOFs for specialized surface loads
@@ -953,7 +958,11 @@ void FEMultiphasicFSISolver::PrepStep()
     for (int i=0; i<nbc; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive()) bc.PrepStep(ui);
+        if (bc.IsActive())
+        {
+            TRACK_COMPONENT(&bc, "PrepStep");
+            bc.PrepStep(ui);
+        }
     }
     
     // apply prescribed DOFs for specialized surface loads
@@ -1255,6 +1264,7 @@ bool FEMultiphasicFSISolver::StiffnessMatrix()
     // calculate the stiffness matrix for each domain
     for (int i=0; i<mesh.Domains(); ++i)
     {
+        TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
         FEDomain& dom = mesh.Domain(i);
         if (dom.IsActive()) {
             FEFluidDomain* fdom = dynamic_cast<FEFluidDomain*>(&dom);
@@ -1364,7 +1374,11 @@ void FEMultiphasicFSISolver::NonLinearConstraintStiffness(FELinearSystem& LS, co
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->StiffnessMatrix(LS, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "StiffnessMatrix");
+            plc->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -1379,7 +1393,11 @@ void FEMultiphasicFSISolver::ContactStiffness(FELinearSystem& LS)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "StiffnessMatrix");
+            pci->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -1393,7 +1411,11 @@ void FEMultiphasicFSISolver::ContactForces(FEGlobalVector& R)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->LoadVector(R, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "LoadVector");
+            pci->LoadVector(R, tp);
+        }
     }
 }
 
@@ -1428,6 +1450,7 @@ bool FEMultiphasicFSISolver::Residual(vector<double>& R)
     // calculate the internal (stress) forces
     for (int i=0; i<mesh.Domains(); ++i)
     {
+        TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
         FEDomain& dom = mesh.Domain(i);
         if (dom.IsActive())
         {
@@ -1522,7 +1545,11 @@ bool FEMultiphasicFSISolver::Residual(vector<double>& R)
     for (int i=0; i<NML; ++i)
     {
         FEModelLoad& mli = *fem.ModelLoad(i);
-        if (mli.IsActive()) mli.LoadVector(RHS);
+        if (mli.IsActive())
+        {
+            TRACK_COMPONENT(&mli, "LoadVector");
+            mli.LoadVector(RHS);
+        }
     }
     
     // set the nodal reaction forces
@@ -1555,6 +1582,10 @@ void FEMultiphasicFSISolver::NonLinearConstraintForces(FEGlobalVector& R, const
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->LoadVector(R, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "LoadVector");
+            plc->LoadVector(R, tp);
+        }
     }
 }
@@ -55,6 +55,7 @@
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FENLConstraint.h>
 #include <FECore/DumpStream.h>
+#include <FECore/FEProfiler.h>
 #include <NumCore/NumCore.h>
 
 //-----------------------------------------------------------------------------
@@ -474,7 +475,11 @@ void FEPolarFluidSolver::UpdateKinematics(vector<double>& ui)
     for (int i=0; i<nvel; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive()) bc.Update();
+        if (bc.IsActive())
+        {
+            TRACK_COMPONENT(&bc, "Update");
+            bc.Update();
+        }
     }
 
     // enforce the linear constraints
@@ -740,7 +745,11 @@ void FEPolarFluidSolver::PrepStep()
     for (int i=0; i<nbc; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive()) bc.PrepStep(ui);
+        if (bc.IsActive())
+        {
+            TRACK_COMPONENT(&bc, "PrepStep");
+            bc.PrepStep(ui);
+        }
     }
 
     // do the linear constraints
@@ -978,6 +987,7 @@ bool FEPolarFluidSolver::StiffnessMatrix(FELinearSystem& LS)
     // calculate the stiffness matrix for each domain
     for (int i=0; i<mesh.Domains(); ++i)
     {
+        TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
         FEDomain& dom = mesh.Domain(i);
         if (dom.IsActive()) {
             FEFluidDomain* fdom = dynamic_cast<FEFluidDomain*>(&dom);
@@ -1055,7 +1065,11 @@ void FEPolarFluidSolver::NonLinearConstraintStiffness(FELinearSystem& LS, const
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->StiffnessMatrix(LS, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "StiffnessMatrix");
+            plc->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -1070,7 +1084,11 @@ void FEPolarFluidSolver::ContactStiffness(FELinearSystem& LS)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "StiffnessMatrix");
+            pci->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -1084,7 +1102,11 @@ void FEPolarFluidSolver::ContactForces(FEGlobalVector& R)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->LoadVector(R, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "LoadVector");
+            pci->LoadVector(R, tp);
+        }
     }
 }
 
@@ -1116,6 +1138,7 @@ bool FEPolarFluidSolver::Residual(vector<double>& R)
     // calculate the internal (stress) forces
     for (int i=0; i<mesh.Domains(); ++i)
     {
+        TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
         FEDomain& dom = mesh.Domain(i);
         if (dom.IsActive())
         {
@@ -1155,7 +1178,11 @@ bool FEPolarFluidSolver::Residual(vector<double>& R)
     for (int j = 0; j<fem.ModelLoads(); ++j)
     {
         FEModelLoad* pml = fem.ModelLoad(j);
-        if (pml->IsActive()) pml->LoadVector(RHS);
+        if (pml->IsActive())
+        {
+            TRACK_COMPONENT(pml, "LoadVector");
+            pml->LoadVector(RHS);
+        }
     }
     
     // calculate inertial forces
@@ -1209,6 +1236,10 @@ void FEPolarFluidSolver::NonLinearConstraintForces(FEGlobalVector& R, const FETi
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->LoadVector(R, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "LoadVector");
+            plc->LoadVector(R, tp);
+        }
     }
 }
@@ -40,6 +40,7 @@ SOFTWARE.*/
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FELinearSystem.h>
 #include <FECore/FEModel.h>
+#include <FECore/FEProfiler.h>
 #include "FEBioFluidSolutes.h"
 #include <assert.h>
 #include "FEFluidSolutesAnalysis.h"
@@ -297,7 +298,11 @@ void FESolutesSolver::UpdateKinematics(vector<double>& ui)
     for (int i=0; i<nbc; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive() && HasActiveDofs(bc.GetDofList())) bc.Update();
+        if (bc.IsActive() && HasActiveDofs(bc.GetDofList()))
+        {
+            TRACK_COMPONENT(&bc, "Update");
+            bc.Update();
+        }
     }
     
     // prescribe DOFs for specialized surface loads
@@ -492,7 +497,11 @@ void FESolutesSolver::PrepStep()
     for (int i=0; i<nbc; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive() && HasActiveDofs(bc.GetDofList())) bc.PrepStep(ui);
+        if (bc.IsActive() && HasActiveDofs(bc.GetDofList()))
+        {
+            TRACK_COMPONENT(&bc, "PrepStep");
+            bc.PrepStep(ui);
+        }
     }
     
     // apply prescribed DOFs for specialized surface loads
@@ -715,6 +724,7 @@ bool FESolutesSolver::StiffnessMatrix(FELinearSystem& LS)
     for (int i=0; i<mesh.Domains(); ++i)
     {
 		FESolutesDomain& dom = dynamic_cast<FESolutesDomain&>(mesh.Domain(i));
+        TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
         dom.StiffnessMatrix(LS);
     }
     
@@ -724,7 +734,11 @@ bool FESolutesSolver::StiffnessMatrix(FELinearSystem& LS)
     {
         FEModelLoad* pml = fem.ModelLoad(i);
 //        if (pml->IsActive() && HasActiveDofs(pml->GetDofList())) pml->StiffnessMatrix(LS);
-        if (pml->IsActive()) pml->StiffnessMatrix(LS);
+        if (pml->IsActive())
+        {
+            TRACK_COMPONENT(pml, "StiffnessMatrix");
+            pml->StiffnessMatrix(LS);
+        }
     }
     
     return true;
@@ -759,6 +773,7 @@ bool FESolutesSolver::Residual(vector<double>& R)
     for (int i=0; i<mesh.Domains(); ++i)
     {
         FESolutesDomain& dom = dynamic_cast<FESolutesDomain&>(mesh.Domain(i));
+        TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
         dom.InternalForces(RHS);
     }
     
@@ -767,7 +782,11 @@ bool FESolutesSolver::Residual(vector<double>& R)
     for (int i=0; i<NML; ++i)
     {
         FEModelLoad& mli = *fem.ModelLoad(i);
-        if (mli.IsActive()) mli.LoadVector(RHS);
+        if (mli.IsActive())
+        {
+            TRACK_COMPONENT(&mli, "LoadVector");
+            mli.LoadVector(RHS);
+        }
     }
     
     // increase RHS counter
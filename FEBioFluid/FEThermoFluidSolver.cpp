@@ -55,6 +55,7 @@ SOFTWARE.*/
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FELinearSystem.h>
 #include <FECore/FENLConstraint.h>
+#include <FECore/FEProfiler.h>
 #include <NumCore/NumCore.h>
 #include "FEThermoFluidAnalysis.h"
 
@@ -457,7 +458,11 @@ void FEThermoFluidSolver::UpdateKinematics(vector<double>& ui)
     for (int i=0; i<nvel; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive() && HasActiveDofs(bc.GetDofList())) bc.Update();
+        if (bc.IsActive() && HasActiveDofs(bc.GetDofList()))
+        {
+            TRACK_COMPONENT(&bc, "Update");
+            bc.Update();
+        }
     }
 
     // enforce the linear constraints
@@ -655,7 +660,11 @@ void FEThermoFluidSolver::PrepStep()
     for (int i=0; i<nbc; ++i)
     {
         FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-        if (bc.IsActive() && HasActiveDofs(bc.GetDofList())) bc.PrepStep(ui);
+        if (bc.IsActive() && HasActiveDofs(bc.GetDofList()))
+        {
+            TRACK_COMPONENT(&bc, "PrepStep");
+            bc.PrepStep(ui);
+        }
     }
     
     // apply prescribed DOFs for specialized surface loads
@@ -948,6 +957,7 @@ bool FEThermoFluidSolver::StiffnessMatrix(FELinearSystem& LS)
     for (int i=0; i<mesh.Domains(); ++i)
     {
         FEFluidDomain& dom = dynamic_cast<FEFluidDomain&>(mesh.Domain(i));
+        TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
         dom.StiffnessMatrix(LS);
     }
     
@@ -984,7 +994,11 @@ bool FEThermoFluidSolver::StiffnessMatrix(FELinearSystem& LS)
     for (int i=0; i<nsl; ++i)
     {
         FEModelLoad* pml = fem.ModelLoad(i);
-        if (pml->IsActive()) pml->StiffnessMatrix(LS);
+        if (pml->IsActive())
+        {
+            TRACK_COMPONENT(pml, "StiffnessMatrix");
+            pml->StiffnessMatrix(LS);
+        }
     }
     // Add mass matrix
     // loop over all domains
@@ -1012,7 +1026,11 @@ void FEThermoFluidSolver::NonLinearConstraintStiffness(FELinearSystem& LS, const
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->StiffnessMatrix(LS, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "StiffnessMatrix");
+            plc->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -1027,7 +1045,11 @@ void FEThermoFluidSolver::ContactStiffness(FELinearSystem& LS)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "StiffnessMatrix");
+            pci->StiffnessMatrix(LS, tp);
+        }
     }
 }
 
@@ -1041,7 +1063,11 @@ void FEThermoFluidSolver::ContactForces(FEGlobalVector& R)
     for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
     {
         FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-        if (pci->IsActive()) pci->LoadVector(R, tp);
+        if (pci->IsActive())
+        {
+            TRACK_COMPONENT(pci, "LoadVector");
+            pci->LoadVector(R, tp);
+        }
     }
 }
 
@@ -1075,6 +1101,7 @@ bool FEThermoFluidSolver::Residual(vector<double>& R)
     for (int i=0; i<mesh.Domains(); ++i)
     {
         FEFluidDomain& dom = dynamic_cast<FEFluidDomain&>(mesh.Domain(i));
+        TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
         dom.InternalForces(RHS);
     }
     
@@ -1125,6 +1152,7 @@ bool FEThermoFluidSolver::Residual(vector<double>& R)
         FEModelLoad& mli = *fem.ModelLoad(i);
         if (mli.IsActive())
         {
+            TRACK_COMPONENT(&mli, "LoadVector");
             mli.LoadVector(RHS);
         }
     }
@@ -1160,7 +1188,11 @@ void FEThermoFluidSolver::NonLinearConstraintForces(FEGlobalVector& R, const FET
     for (int i=0; i<N; ++i)
     {
         FENLConstraint* plc = fem.NonlinearConstraint(i);
-        if (plc->IsActive()) plc->LoadVector(R, tp);
+        if (plc->IsActive())
+        {
+            TRACK_COMPONENT(plc, "LoadVector");
+            plc->LoadVector(R, tp);
+        }
     }
 }
 
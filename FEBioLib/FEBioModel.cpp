@@ -59,15 +59,15 @@ SOFTWARE.*/
 #include <FECore/FEMaterial.h>
 #include <FECore/FEPlotDataStore.h>
 #include <FECore/FETimeStepController.h>
+#include <FECore/FEProfiler.h>
 #include "febio.h"
 #include "version.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
 
-#ifdef WIN32
 size_t FEBIOLIB_API GetPeakMemory();	// in memory.cpp
-#endif
+size_t FEBIOLIB_API GetCurrentMemory();	// in memory.cpp
 
 //-----------------------------------------------------------------------------
 BEGIN_FECORE_CLASS(FEBioModel, FEMechModel)
@@ -121,6 +121,7 @@ FEBioModel::FEBioModel()
 	m_stats.ntotalIters = 0;
 	m_stats.ntotalRHS = 0;
 	m_stats.ntotalReforms = 0;
+	m_stats.peakMemory = 0;
 
 	m_pltAppendOnRestart = true;
 
@@ -195,6 +196,47 @@ ModelStats FEBioModel::GetModelStats() const
 	return m_stats;
 }
 
+//-----------------------------------------------------------------------------
+void FEBioModel::GetMemoryStats(FEMODEL_MEMORY_STATS& stats)
+{
+	FEMechModel::GetMemoryStats(stats);
+	if (m_plot) stats.Output += m_plot->BufferSize();
+}
+
+//-----------------------------------------------------------------------------
+const FEMODEL_MEMORY_STATS& FEBioModel::GetPeakMemoryStats() const
+{
+	return m_memPeak;
+}
+
+//-----------------------------------------------------------------------------
+// Record the largest memory usage of each subsystem. The solver data is only 
+// available until the end of a step, so this is called after each step.
+void FEBioModel::UpdateMemoryStats()
+{
+	FEMODEL_MEMORY_STATS mem;
+	GetMemoryStats(mem);
+
+	if (mem.StiffnessMatrix > m_memPeak.StiffnessMatrix) m_memPeak.StiffnessMatrix = mem.StiffnessMatrix;
+	if (mem.Mesh            > m_memPeak.Mesh           ) m_memPeak.Mesh            = mem.Mesh;
+	if (mem.LinearSolver    > m_memPeak.LinearSolver   ) m_memPeak.LinearSolver    = mem.LinearSolver;
+	if (mem.NonLinSolver    > m_memPeak.NonLinSolver   ) m_memPeak.NonLinSolver    = mem.NonLinSolver;
+	if (mem.MaterialPoints  > m_memPeak.MaterialPoints ) m_memPeak.MaterialPoints  = mem.MaterialPoints;
+	if (mem.Contact         > m_memPeak.Contact        ) m_memPeak.Contact         = mem.Contact;
+	if (mem.Output          > m_memPeak.Output         ) m_memPeak.Output          = mem.Output;
+
+	if (m_memPeak.DomainData.size() != mem.DomainData.size()) m_memPeak.DomainData = mem.DomainData;
+	else
+	{
+		for (size_t i = 0; i < mem.DomainData.size(); ++i)
+		{
+			if (mem.DomainData[i].second > m_memPeak.DomainData[i].second) m_memPeak.DomainData[i] = mem.DomainData[i];
+		}
+	}
+
+	m_stats.peakMemory = GetPeakMemory();
+}
+
 //-----------------------------------------------------------------------------
 //! Set the title of the model
 void FEBioModel::SetTitle(const char* sz)
@@ -272,6 +314,23 @@ void FEBioModel::SetDumpFilename(const std::string& sfile)
 	m_sdump = sfile;
 }
 
+//-----------------------------------------------------------------------------
+//! Set the name of the file the profile report is written to
+void FEBioModel::SetProfileFilename(const std::string& sfile)
+{
+	m_sprof = sfile;
+	GetProfiler().Enable(!m_sprof.empty() || !m_strace.empty());
+}
+
+//-----------------------------------------------------------------------------
+//! Set the name of the file the profiler timeline is written to
+void FEBioModel::SetTraceFilename(const std::string& sfile)
+{
+	m_strace = sfile;
+	GetProfiler().RecordTrace(m_strace.empty() == false);
+	GetProfiler().Enable(!m_sprof.empty() || !m_strace.empty());
+}
+
 //-----------------------------------------------------------------------------
 //! Return the name of the input file
 const std::string& FEBioModel::GetInputFileName()
@@ -405,6 +464,7 @@ void FEBioModel::DomainListFromMaterial(vector<int>& lmat, vector<int>& ldom)
 void FEBioModel::Write(unsigned int nevent)
 {
 	TimerTracker t(&m_IOTimer);
+	FEProfileScope prof(this, "Output");
 
 	// get the current step
 	FEAnalysis* pstep = GetCurrentStep();
@@ -1578,6 +1638,8 @@ bool FEBioModel::Reset()
 	m_stats.ntotalIters = 0;
 	m_stats.ntotalRHS = 0;
 	m_stats.ntotalReforms = 0;
+	m_stats.peakMemory = 0;
+	m_memPeak = FEMODEL_MEMORY_STATS();
 
 	// do the callback
 	DoCallback(CB_INIT);
@@ -1616,14 +1678,13 @@ void FEBioModel::on_cb_solved()
 	m_log.flush();
 
 	// get peak memory usage
-#ifdef WIN32
 	size_t memsize = GetPeakMemory();
 	if (memsize != 0)
 	{
+		m_stats.peakMemory = memsize;
 		double mb = (double)memsize / 1048576.0;
 		feLog(" Peak memory  : %.1lf MB\n", mb);
 	}
-#endif
 
 	// print the elapsed time
 	GetSolveTimer().time_str(sztime);
@@ -1644,9 +1705,11 @@ void FEBioModel::on_cb_solved()
 		double total_linsol = GetTimer(TimerID::Timer_LinSolve )->GetTime();
 		double total_reform = GetTimer(TimerID::Timer_Reform   )->GetTime();
 		double total_stiff  = GetTimer(TimerID::Timer_Stiffness)->GetTime();
+		double total_assem  = GetTimer(TimerID::Timer_Assemble )->GetTime();
 		double total_rhs    = GetTimer(TimerID::Timer_Residual )->GetTime();
 		double total_update = GetTimer(TimerID::Timer_Update   )->GetTime();
 		double total_qn     = GetTimer(TimerID::Timer_QNUpdate )->GetTime();
+		double total_snap   = GetTimer(TimerID::Timer_Snapshot )->GetTime();
 
 		feLog(" T I M I N G   I N F O R M A T I O N\n\n");
 		Timer::time_str(input_time  , sztime); feLog("\tInput time ...................... : %s (%lg sec)\n\n", sztime, input_time);
@@ -1655,12 +1718,51 @@ void FEBioModel::on_cb_solved()
 		Timer::time_str(io_time     , sztime); feLog("\t   IO-time (plot, dmp, data) .... : %s (%lg sec)\n\n", sztime, io_time);
 		Timer::time_str(total_reform, sztime); feLog("\t   reforming stiffness .......... : %s (%lg sec)\n\n", sztime, total_reform);
 		Timer::time_str(total_stiff , sztime); feLog("\t   evaluating stiffness ......... : %s (%lg sec)\n\n", sztime, total_stiff);
+		Timer::time_str(total_assem , sztime); feLog("\t      assembling stiffness ...... : %s (%lg sec)\n\n", sztime, total_assem);
 		Timer::time_str(total_rhs   , sztime); feLog("\t   evaluating residual .......... : %s (%lg sec)\n\n", sztime, total_rhs);
 		Timer::time_str(total_update, sztime); feLog("\t   model update ................. : %s (%lg sec)\n\n", sztime, total_update);
 		Timer::time_str(total_qn    , sztime); feLog("\t   QN updates ................... : %s (%lg sec)\n\n", sztime, total_qn);
+		Timer::time_str(total_snap  , sztime); feLog("\t   state snapshots .............. : %s (%lg sec)\n\n", sztime, total_snap);
 		Timer::time_str(total_linsol, sztime); feLog("\t   time in linear solver ........ : %s (%lg sec)\n\n", sztime, total_linsol);
 		Timer::time_str(total_time  , sztime); feLog("\tTotal elapsed time .............. : %s (%lg sec)\n\n", sztime, total_time);
 
+		// print the memory usage (the largest value of each item during the run)
+		const double MB = 1048576.0;
+		const FEMODEL_MEMORY_STATS& mem = m_memPeak;
+		feLog(" M E M O R Y   U S A G E\n\n");
+		feLog("\tPeak resident memory ............ : %.1lf MB\n\n", (double)m_stats.peakMemory / MB);
+		feLog("\tCurrent resident memory ......... : %.1lf MB\n\n", (double)GetCurrentMemory() / MB);
+		feLog("\t   mesh ......................... : %.1lf MB\n\n", (double)mem.Mesh / MB);
+		feLog("\t   material point data .......... : %.1lf MB\n\n", (double)mem.MaterialPoints / MB);
+		for (size_t i = 0; i < mem.DomainData.size(); ++i)
+		{
+			const char* szname = (mem.DomainData[i].first.empty() ? "(unnamed)" : mem.DomainData[i].first.c_str());
+			feLog("\t      %-27s : %.1lf MB\n\n", szname, (double)mem.DomainData[i].second / MB);
+		}
+		feLog("\t   stiffness matrix ............. : %.1lf MB\n\n", (double)mem.StiffnessMatrix / MB);
+		feLog("\t   linear solver ................ : %.1lf MB\n\n", (double)mem.LinearSolver / MB);
+		feLog("\t   nonlinear solver ............. : %.1lf MB\n\n", (double)mem.NonLinSolver / MB);
+		feLog("\t   contact ...................... : %.1lf MB\n\n", (double)mem.Contact / MB);
+		feLog("\t   plot and snapshot buffers .... : %.1lf MB\n\n", (double)mem.Output / MB);
+
+		// print the profiler's call tree
+		FEProfiler& prof = GetProfiler();
+		if (prof.IsEnabled())
+		{
+			std::vector<FEProfiler::Entry> report = prof.Report();
+			if (report.empty() == false)
+			{
+				feLog(" P R O F I L E\n\n");
+				feLog("\t%-52s %10s %14s %14s\n", "region", "calls", "time (sec)", "self (sec)");
+				for (const FEProfiler::Entry& e : report)
+				{
+					std::string name = std::string(2 * e.depth, ' ') + e.name;
+					feLog("\t%-52s %10lld %14lg %14lg\n", name.c_str(), e.calls, e.time, e.self);
+				}
+				feLog("\n");
+			}
+		}
+
 		m_log.SetMode(old_mode);
 
 		bool bconv = IsSolved();
@@ -1677,6 +1779,18 @@ void FEBioModel::on_cb_solved()
 		m_log.flush();
 	}
 
+	// write the profiler output files
+	if (m_sprof.empty() == false)
+	{
+		if (GetProfiler().WriteJSON(m_sprof.c_str()) == false)
+			feLogWarning("Failed writing profile to %s", m_sprof.c_str());
+	}
+	if (m_strace.empty() == false)
+	{
+		if (GetProfiler().WriteTrace(m_strace.c_str()) == false)
+			feLogWarning("Failed writing profiler trace to %s", m_strace.c_str());
+	}
+
 	// close the plot file
 	int hint = GetStep(Steps() - 1)->GetPlotHint();
 	if (hint != FE_PLOT_APPEND)
@@ -1719,4 +1833,7 @@ void FEBioModel::on_cb_stepSolved()
 	m_stats.ntotalIters   += step->m_ntotiter;
 	m_stats.ntotalRHS     += step->m_ntotrhs;
 	m_stats.ntotalReforms += step->m_ntotref;
+
+	// record the memory usage while the solver data is still allocated
+	UpdateMemoryStats();
 }
@@ -50,6 +50,7 @@ struct ModelStats {
 	int		ntotalIters;	//!< total nr of equilibrium iterations
 	int		ntotalRHS;		//!< total nr of right hand side evaluations
 	int		ntotalReforms;	//!< total nr of stiffness reformations
+	size_t	peakMemory;		//!< peak resident memory of the process (in bytes)
 };
 
 //-----------------------------------------------------------------------------
@@ -115,6 +116,8 @@ private:
 	void on_cb_solved();
 	void on_cb_stepSolved();
 
+	void UpdateMemoryStats();
+
 protected:
 	// helper functions for serialization
 	void SerializeIOData   (DumpStream& ar);
@@ -140,6 +143,10 @@ public: // --- I/O functions ---
 	void SetPlotFilename (const std::string& sfile);
 	void SetDumpFilename (const std::string& sfile);
 
+	// set the profiler output files
+	void SetProfileFilename(const std::string& sfile);
+	void SetTraceFilename  (const std::string& sfile);
+
 	//! Get the I/O file names
 	const std::string& GetInputFileName();
 	const std::string& GetLogfileName  ();
@@ -189,6 +196,12 @@ public:
 	//! Get the stats 
 	ModelStats GetModelStats() const;
 
+	//! get the memory breakdown (this adds the plot file buffers)
+	void GetMemoryStats(FEMODEL_MEMORY_STATS& stats) override;
+
+	//! Get the largest memory usage of each subsystem that was recorded during the run
+	const FEMODEL_MEMORY_STATS& GetPeakMemoryStats() const;
+
 	// flag to show warnings and errors
 	void ShowWarningsAndErrors(bool b);
 	bool ShowWarningsAndErrors() const;
@@ -207,6 +220,8 @@ private:
 	Timer		m_InitTime;		//!< timer to track model initialization
 	Timer		m_IOTimer;		//!< timer to track output (include plot, dump, and data)
 
+	FEMODEL_MEMORY_STATS	m_memPeak;	//!< largest memory usage of each subsystem
+
 	PlotFile*	m_plot;			//!< the plot file
 	bool		m_becho;		//!< echo input to logfile
 	int			m_ndebug;		//!< debug level flag
@@ -229,6 +244,8 @@ protected: // file names
 	std::string		m_splot;			//!< plot output file name
 	std::string		m_slog ;			//!< log output file name
 	std::string		m_sdump;			//!< dump file name
+	std::string		m_sprof;			//!< profile report file name
+	std::string		m_strace;			//!< profile trace file name
 
 	std::string	m_title;	//!< model title
 
@@ -31,6 +31,8 @@ SOFTWARE.*/
 #include <FEBioLib/FEBioModel.h>
 #include <FECore/log.h>
 #include <FEBioXML/FERestartImport.h>
+#include <FEBioXML/FEBioImport.h>
+#include "FEBioModelBuilder.h"
 #include <FECore/DumpFile.h>
 #include <FECore/FEAnalysis.h>
 #include <FECore/FEModelDataRecord.h>
@@ -121,3 +123,53 @@ bool FEBioTestSuiteTask::Run()
 {
 	return (GetFEModel() ? GetFEModel()->Solve() : false);
 }
+
+//=============================================================================
+FEBioConvertMeshTask::FEBioConvertMeshTask(FEModel* fem) : FECoreTask(fem) {}
+
+//! initialization
+bool FEBioConvertMeshTask::Init(const char* szfile)
+{
+	FEBioModel* fem = dynamic_cast<FEBioModel*>(GetFEModel());
+	if ((fem == nullptr) || fem->GetInputFileName().empty()) return false;
+
+	if (szfile && szfile[0]) m_outFile = szfile;
+	else
+	{
+		m_outFile = fem->GetInputFileName();
+		size_t n = m_outFile.rfind('.');
+		size_t m = m_outFile.find_last_of("/\\");
+		if ((n != std::string::npos) && ((m == std::string::npos) || (n > m))) m_outFile.erase(n);
+		m_outFile += ".febm";
+	}
+
+	return true;
+}
+
+//! write the binary mesh file
+bool FEBioConvertMeshTask::Run()
+{
+	FEBioModel* fem = dynamic_cast<FEBioModel*>(GetFEModel());
+	if (fem == nullptr) return false;
+
+	// The mesh part of the input file is discarded once the model is built,
+	// so we read the file again into a scratch model.
+	FEBioModel tmp;
+	tmp.SetLogLevel(0);
+	tmp.GetLogFile().SetMode(Logfile::LOG_NEVER);
+
+	FEBioImport fim;
+	fim.SetModelBuilder(new FEBioModelBuilder(tmp));
+	fim.SetMeshExportFile(m_outFile.c_str());
+	if (fim.Load(tmp, fem->GetInputFileName().c_str()) == false)
+	{
+		char szerr[256];
+		fim.GetErrorMessage(szerr);
+		fprintf(stderr, "%s\n", szerr);
+		return false;
+	}
+
+	fprintf(stdout, "Binary mesh written to %s\n", m_outFile.c_str());
+
+	return true;
+}
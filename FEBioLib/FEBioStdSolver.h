@@ -72,3 +72,22 @@ public:
 	//! Run the FE model
 	bool Run() override;
 };
+
+//-----------------------------------------------------------------------------
+// Converts the Mesh section of the model's input file to a binary mesh file.
+// The control file name is used as the output file name. If it is not given,
+// the input file name with the extension .febm is used.
+class FEBioConvertMeshTask : public FECoreTask
+{
+public:
+	FEBioConvertMeshTask(FEModel* fem);
+
+	//! initialization
+	bool Init(const char* szfile) override;
+
+	//! write the binary mesh file
+	bool Run() override;
+
+private:
+	std::string	m_outFile;
+};
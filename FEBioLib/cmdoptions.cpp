@@ -84,6 +84,8 @@ bool febio::ProcessOptionsString(const std::string& s, CMDOPTIONS& ops)
 	ops.sztask[0] = 0;
 	ops.szctrl[0] = 0;
 	ops.szimp[0] = 0;
+	ops.szprof[0] = 0;
+	ops.sztrace[0] = 0;
 
 	// set initial configuration file name
 	if (ops.szcnf[0] == 0)
@@ -211,6 +213,14 @@ bool febio::ProcessOptionsString(const std::string& s, CMDOPTIONS& ops)
 		{
 			strcpy(ops.szimp, args[++i].c_str());
 		}
+		else if (strcmp(sz, "-profile") == 0)
+		{
+			strcpy(ops.szprof, args[++i].c_str());
+		}
+		else if (strcmp(sz, "-trace") == 0)
+		{
+			strcpy(ops.sztrace, args[++i].c_str());
+		}
 		else if (sz[0] == '-')
 		{
 			fprintf(stderr, "FATAL ERROR: Invalid command line option.\n");
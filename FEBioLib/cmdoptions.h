@@ -50,6 +50,8 @@ struct FEBIOLIB_API CMDOPTIONS
 	char	sztask[MAXFILE];	//!< task name
 	char	szctrl[MAXFILE];	//!< control file for tasks
 	char	szimp[MAXFILE];		//!< import file
+	char	szprof[MAXFILE];	//!< profile report file (json)
+	char	sztrace[MAXFILE];	//!< profile trace file (chrome trace format)
 
 	CMDOPTIONS()
 	{
@@ -73,6 +75,8 @@ struct FEBIOLIB_API CMDOPTIONS
 		sztask[0] = 0;
 		szctrl[0] = 0;
 		szimp[0] = 0;
+		szprof[0] = 0;
+		sztrace[0] = 0;
 	}
 };
 
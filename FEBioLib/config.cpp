@@ -458,6 +458,8 @@ FEBIOLIB_API int RunModel(FEBioModel& fem, CMDOPTIONS* ops)
 		fem.SetLogFilename(ops->szlog);
 		fem.SetPlotFilename(ops->szplt);
 		fem.SetDumpFilename(ops->szdmp);
+		fem.SetProfileFilename(ops->szprof);
+		fem.SetTraceFilename(ops->sztrace);
 	}
 
 	// read the input file if specified
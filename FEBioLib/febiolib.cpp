@@ -48,6 +48,7 @@ SOFTWARE.*/
 #include "plugin.h"
 #include "FEBioStdSolver.h"
 #include "FEBioRestart.h"
+#include "FEBioModel.h"
 
 namespace febio {
 
@@ -57,6 +58,32 @@ FECoreKernel* GetFECoreKernel()
 	return &FECoreKernel::GetInstance();
 }
 
+#ifndef MECH_ONLY
+//-----------------------------------------------------------------------------
+// Creates a new model by reading the input file of the given model again.
+// The optimization module uses this to create models that can be solved concurrently,
+// so the new model doesn't write any output.
+static FEModel* CreateWorkerModel(FEModel* fem)
+{
+	FEBioModel* src = dynamic_cast<FEBioModel*>(fem);
+	if ((src == nullptr) || src->GetInputFileName().empty()) return nullptr;
+
+	FEBioModel* pfem = new FEBioModel;
+	pfem->SetLogLevel(0);
+	pfem->GetLogFile().SetMode(Logfile::LOG_NEVER);
+	if (pfem->Input(src->GetInputFileName().c_str()) == false)
+	{
+		delete pfem;
+		return nullptr;
+	}
+
+	// don't write any data records
+	pfem->GetDataStore().Clear();
+
+	return pfem;
+}
+#endif
+
 //-----------------------------------------------------------------------------
 // import all modules
 void InitLibrary()
@@ -65,6 +92,7 @@ void InitLibrary()
 	REGISTER_FECORE_CLASS(FEBioRestart  , "restart");
 	REGISTER_FECORE_CLASS(FEBioRCISolver, "rci_solve");
 	REGISTER_FECORE_CLASS(FEBioTestSuiteTask, "test");
+	REGISTER_FECORE_CLASS(FEBioConvertMeshTask, "convert_mesh");
 
 	FECore::InitModule();
 	FEAMR::InitModule();
@@ -74,6 +102,7 @@ void InitLibrary()
 #ifndef MECH_ONLY
 	FEBioMix::InitModule();
 	FEBioOpt::InitModule();
+	FEBioOpt::SetModelFactory(CreateWorkerModel);
 	FEBioFluid::InitModule();
 	FEBioFSI::InitModule();
     FEBioMultiphasicFSI::InitModule();
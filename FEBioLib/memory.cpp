@@ -29,8 +29,17 @@ SOFTWARE.*/
 #ifdef WIN32
 #include <windows.h>
 #include <psapi.h>
+#else
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
+#ifdef __APPLE__
+#include <mach/mach.h>
 #endif
 
+//-----------------------------------------------------------------------------
+// returns the peak resident memory (in bytes) of the process
 size_t FEBIOLIB_API GetPeakMemory()
 {
 #ifdef WIN32
@@ -38,6 +47,37 @@ size_t FEBIOLIB_API GetPeakMemory()
 	GetProcessMemoryInfo(GetCurrentProcess(), &memCounters, sizeof(memCounters));
 	return (size_t)memCounters.PeakWorkingSetSize;
 #else
-	return 0;
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+	return (size_t)usage.ru_maxrss;			// in bytes on macOS
+#else
+	return (size_t)usage.ru_maxrss * 1024;	// in kilobytes on Linux
+#endif
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// returns the current resident memory (in bytes) of the process
+size_t FEBIOLIB_API GetCurrentMemory()
+{
+#ifdef WIN32
+	PROCESS_MEMORY_COUNTERS memCounters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &memCounters, sizeof(memCounters));
+	return (size_t)memCounters.WorkingSetSize;
+#elif defined(__APPLE__)
+	mach_task_basic_info_data_t info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) return 0;
+	return (size_t)info.resident_size;
+#else
+	// the second value in statm is the resident set size (in pages)
+	FILE* fp = fopen("/proc/self/statm", "r");
+	if (fp == nullptr) return 0;
+	long pages = 0, resident = 0;
+	int n = fscanf(fp, "%ld %ld", &pages, &resident);
+	fclose(fp);
+	if (n != 2) return 0;
+	return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
 #endif
 }
@@ -46,6 +46,7 @@ SOFTWARE.*/
 #include <FECore/FESurfaceLoad.h>
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FENLConstraint.h>
+#include <FECore/FEProfiler.h>
 #include "FEBodyForce.h"
 #include "FECore/sys.h"
 #include "FEMechModel.h"
@@ -317,7 +318,11 @@ void FECGSolidSolver::PrepStep()
 	for (int i = 0; i<nbc; ++i)
 	{
 		FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-		if (bc.IsActive()) bc.PrepStep(ui);
+		if (bc.IsActive())
+		{
+			TRACK_COMPONENT(&bc, "PrepStep");
+			bc.PrepStep(ui);
+		}
 	}
 
 	// initialize rigid bodies
@@ -759,7 +764,11 @@ void FECGSolidSolver::UpdateKinematics(vector<double>& ui)
 	for (int i=0; i<ndis; ++i)
 	{
 		FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-		if (bc.IsActive()) bc.Update();
+		if (bc.IsActive())
+		{
+			TRACK_COMPONENT(&bc, "Update");
+			bc.Update();
+		}
 	}
 
 	// enforce the linear constraints
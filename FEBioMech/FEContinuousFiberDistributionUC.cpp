@@ -60,44 +60,53 @@ FEMaterialPointData* FEContinuousFiberDistributionUC::CreateMaterialPointData()
 }
 
 //-----------------------------------------------------------------------------
-//! calculate stress at material point
-mat3ds FEContinuousFiberDistributionUC::DevStress(FEMaterialPoint& mp)
-{ 
+// Collects the fibers of the current batch, converted to global coordinates and 
+// pre-stretched, together with their weights R*w.
+static int GatherFibers(FEFiberBatchIterator& it, FEMaterialPoint& mp, FEFiberDensityDistribution* pFDD, const mat3d& Q, double* nx, double* ny, double* nz, double* w)
+{
 	FEFiberMaterialPoint& fp = *mp.ExtractData<FEFiberMaterialPoint>();
 
-	// calculate stress
-	mat3ds s; s.zero();
+	int n = it.Points();
+	for (int i = 0; i < n; ++i)
+	{
+		// get the fiber direction for that fiber distribution
+		vec3d N(it.m_nx[i], it.m_ny[i], it.m_nz[i]);
+
+		// evaluate ellipsoidally distributed material coefficients
+		double R = pFDD->FiberDensity(mp, N);
+
+		// convert fiber to global coordinates
+		vec3d n0 = fp.FiberPreStretch(Q*N);
+
+		nx[i] = n0.x;
+		ny[i] = n0.y;
+		nz[i] = n0.z;
+		w[i] = R*it.m_w[i];
+	}
+	return n;
+}
 
+//-----------------------------------------------------------------------------
+//! calculate stress at material point
+mat3ds FEContinuousFiberDistributionUC::DevStress(FEMaterialPoint& mp)
+{ 
 	// get the local coordinate system
 	mat3d Q = GetLocalCS(mp);
 
 	double IFD = IntegratedFiberDensity(mp);
 
-	// obtain an integration point iterator
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(&mp);
-	if (it->IsValid())
+	// calculate stress
+	mat3ds s; s.zero();
+
+	// loop over the integration points in batches
+	double nx[FEFiberBatchIterator::MAX_POINTS], ny[FEFiberBatchIterator::MAX_POINTS], nz[FEFiberBatchIterator::MAX_POINTS], w[FEFiberBatchIterator::MAX_POINTS];
+	FEFiberBatchIterator it(m_pFint, &mp);
+	while (it.Next())
 	{
-		do
-		{
-            // get the fiber direction for that fiber distribution
-            vec3d& N = it->m_fiber;
-            
-            // evaluate ellipsoidally distributed material coefficients
-            double R = m_pFDD->FiberDensity(mp, N);
-            
-            // convert fiber to global coordinates
-            vec3d n0 = Q*N;
-
-			// calculate the stress
-			double wn = it->m_weight;
-			s += m_pFmat->DevFiberStress(mp, fp.FiberPreStretch(n0))*(R*wn);
-		}
-		while (it->Next());
+		int n = GatherFibers(it, mp, m_pFDD, Q, nx, ny, nz, w);
+		s += m_pFmat->DevFiberStressSum(mp, n, nx, ny, nz, w);
 	}
 
-	// don't forget to delete the iterator
-	delete it;
-
 	// divide by IFD
 	return s / IFD;
 }
@@ -105,79 +114,48 @@ mat3ds FEContinuousFiberDistributionUC::DevStress(FEMaterialPoint& mp)
 //-----------------------------------------------------------------------------
 //! calculate tangent stiffness at material point
 tens4ds FEContinuousFiberDistributionUC::DevTangent(FEMaterialPoint& mp)
-{ 
-	FEFiberMaterialPoint& fp = *mp.ExtractData<FEFiberMaterialPoint>();
-
+{
 	// get the local coordinate system
 	mat3d Q = GetLocalCS(mp);
 
-	// initialize stress tensor
-	tens4ds c;
-	c.zero();
-
 	double IFD = IntegratedFiberDensity(mp);
 
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(&mp);
-	if (it->IsValid())
+	// initialize tangent
+	tens4ds c; c.zero();
+
+	// loop over the integration points in batches
+	double nx[FEFiberBatchIterator::MAX_POINTS], ny[FEFiberBatchIterator::MAX_POINTS], nz[FEFiberBatchIterator::MAX_POINTS], w[FEFiberBatchIterator::MAX_POINTS];
+	FEFiberBatchIterator it(m_pFint, &mp);
+	while (it.Next())
 	{
-		do
-		{
-            // get the fiber direction for that fiber distribution
-            vec3d& N = it->m_fiber;
-            
-            // evaluate ellipsoidally distributed material coefficients
-            double R = m_pFDD->FiberDensity(mp, N);
-            
-            // convert fiber to global coordinates
-            vec3d n0 = Q*N;
-
-			// calculate the tangent
-			c += m_pFmat->DevFiberTangent(mp, fp.FiberPreStretch(n0))*(R*it->m_weight);
-		}
-		while (it->Next());
+		int n = GatherFibers(it, mp, m_pFDD, Q, nx, ny, nz, w);
+		c += m_pFmat->DevFiberTangentSum(mp, n, nx, ny, nz, w);
 	}
-	
-	// don't forget to delete the iterator
-	delete it;
 
 	// divide by IFD
 	return c / IFD;
 }
 
 //-----------------------------------------------------------------------------
-//! calculate deviatoric strain energy density
+//! calculate deviatoric strain energy density at material point
 double FEContinuousFiberDistributionUC::DevStrainEnergyDensity(FEMaterialPoint& mp)
 { 
-	FEFiberMaterialPoint& fp = *mp.ExtractData<FEFiberMaterialPoint>();
-
 	// get the local coordinate system
 	mat3d Q = GetLocalCS(mp);
 
 	double IFD = IntegratedFiberDensity(mp);
+
 	double sed = 0.0;
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(&mp);
-	if (it->IsValid())
+
+	// loop over the integration points in batches
+	double nx[FEFiberBatchIterator::MAX_POINTS], ny[FEFiberBatchIterator::MAX_POINTS], nz[FEFiberBatchIterator::MAX_POINTS], w[FEFiberBatchIterator::MAX_POINTS];
+	FEFiberBatchIterator it(m_pFint, &mp);
+	while (it.Next())
 	{
-		do
-		{
-            // get the fiber direction for that fiber distribution
-            vec3d& N = it->m_fiber;
-            
-            // evaluate ellipsoidally distributed material coefficients
-            double R = m_pFDD->FiberDensity(mp, N);
-            
-            // convert fiber to global coordinates
-            vec3d n0 = Q*N;
-
-			// calculate the stress
-			sed += m_pFmat->DevFiberStrainEnergyDensity(mp, fp.FiberPreStretch(n0))*(R*it->m_weight);
-		}
-		while (it->Next());
+		int n = GatherFibers(it, mp, m_pFDD, Q, nx, ny, nz, w);
+		sed += m_pFmat->DevFiberStrainEnergyDensitySum(mp, n, nx, ny, nz, w);
 	}
 
-	// don't forget to delete the iterator
-	delete it;
-
 	// divide by IFD
 	return sed / IFD;
 }
@@ -186,26 +164,23 @@ double FEContinuousFiberDistributionUC::DevStrainEnergyDensity(FEMaterialPoint&
 double FEContinuousFiberDistributionUC::IntegratedFiberDensity(FEMaterialPoint& mp)
 {
 	double IFD = 0;
-	// NOTE: Pass nullptr to GetIterator to avoid issues with GK rule!
-	FEFiberIntegrationSchemeIterator* it = m_pFint->GetIterator(nullptr);
-	if (it->IsValid())
+	// NOTE: Pass nullptr to avoid issues with GK rule!
+	FEFiberBatchIterator it(m_pFint, nullptr);
+	while (it.Next())
 	{
-		do
+		int n = it.Points();
+		for (int i = 0; i < n; ++i)
 		{
-			// set fiber direction in global coordinate system
-			vec3d& N = it->m_fiber;
+			// get the fiber direction for that fiber distribution
+			vec3d N(it.m_nx[i], it.m_ny[i], it.m_nz[i]);
 
 			double R = m_pFDD->FiberDensity(mp, N);
 
 			// integrate the fiber distribution
-			IFD += R * it->m_weight;
-
-		} while (it->Next());
+			IFD += R * it.m_w[i];
+		}
 	}
 
-	// don't forget to delete the iterator
-	delete it;
-
 	// just in case
 	if (IFD == 0.0) IFD = 1.0;
 
@@ -444,10 +444,7 @@ void FEElasticShellDomain::ElementBodyForceStiffness(FEBodyForce& BF, FEShellEle
 void FEElasticShellDomain::StiffnessMatrix(FELinearSystem& LS)
 {
     // repeat over all shell elements
-    int NS = (int)m_Elem.size();
-#pragma omp parallel for shared (NS)
-    for (int iel=0; iel<NS; ++iel)
-    {
+    AssembleElements(LS, [&](int iel) {
 		FEShellElement& el = m_Elem[iel];
         
         // create the element's stiffness matrix
@@ -465,7 +462,7 @@ void FEElasticShellDomain::StiffnessMatrix(FELinearSystem& LS)
         
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
-    }
+    });
 }
 
 //-----------------------------------------------------------------------------
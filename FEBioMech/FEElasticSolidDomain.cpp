@@ -319,6 +319,158 @@ void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement &el, matri
 //! Calculates element material stiffness element matrix
 
 void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &ke)
+{
+	// use the specialized kernels for the most common element types
+	switch (el.Shape())
+	{
+	case ET_TET4 : ElementMaterialStiffness< 4>(el, ke); break;
+	case ET_TET10: ElementMaterialStiffness<10>(el, ke); break;
+	case ET_HEX8 : ElementMaterialStiffness< 8>(el, ke); break;
+	case ET_HEX20: ElementMaterialStiffness<20>(el, ke); break;
+	case ET_HEX27: ElementMaterialStiffness<27>(el, ke); break;
+	default:
+		ElementMaterialStiffnessGeneric(el, ke);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Material stiffness kernel for elements with a fixed number of nodes. 
+//! This evaluates the same expression as ElementMaterialStiffnessGeneric, but:
+//! - the shape function gradients and tangents are evaluated for all integration points first,
+//! - the D*B products are calculated once per node instead of once per pair of nodes,
+//! - only the upper triangular blocks are calculated when all tangents are symmetric,
+//! - the data is stored in fixed-size arrays, indexed by node last, so that the 
+//!   inner loops can be vectorized by the compiler.
+template <int NELN> void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement& el, matrix& ke)
+{
+	const int nint = el.GaussPoints();
+	assert(el.Nodes() == NELN);
+	assert(nint <= FEElement::MAX_INTPOINTS);
+
+	// weights at gauss points
+	const double *gw = el.GaussWeights();
+
+	// shape function gradients and tangents (multiplied by the jacobian) at all integration points
+	double Gx[FEElement::MAX_INTPOINTS][NELN];
+	double Gy[FEElement::MAX_INTPOINTS][NELN];
+	double Gz[FEElement::MAX_INTPOINTS][NELN];
+	double D[FEElement::MAX_INTPOINTS][6][6];
+	bool bsymm = true;
+	vec3d G[FEElement::MAX_NODES];
+
+	// evaluate the material tangents of all integration points in one batch
+	// NOTE: deformation gradient and determinant have already been evaluated in the stress routine
+	FEMaterialPoint* mp[FEElement::MAX_INTPOINTS];
+	tens4dmm C[FEElement::MAX_INTPOINTS];
+	for (int n = 0; n < nint; ++n) mp[n] = el.GetMaterialPoint(n);
+	if (m_secant_tangent)
+	{
+		for (int n = 0; n < nint; ++n) C[n] = m_pMat->SecantTangent(*mp[n]);
+	}
+	else m_pMat->BatchSolidTangent(mp, nint, C);
+
+	for (int n = 0; n < nint; ++n)
+	{
+		// calculate jacobian and shape function gradients
+		double detJt = ShapeGradient(el, n, G, m_alphaf)*gw[n] * m_alphaf;
+		for (int i = 0; i < NELN; ++i)
+		{
+			Gx[n][i] = G[i].x;
+			Gy[n][i] = G[i].y;
+			Gz[n][i] = G[i].z;
+		}
+
+		// get the 'D' matrix
+		double (*Dn)[6] = D[n];
+		C[n].extract(Dn);
+		for (int a = 0; a < 6; ++a)
+			for (int b = 0; b < 6; ++b) Dn[a][b] *= detJt;
+
+		for (int a = 0; a < 6; ++a)
+			for (int b = a + 1; b < 6; ++b)
+				if (Dn[a][b] != Dn[b][a]) bsymm = false;
+	}
+
+	// The stiffness blocks Kij. K[a*3+b][i][j] stores ke[3*i+a][3*j+b].
+	double K[9][NELN][NELN] = { 0 };
+
+	// the D*B products for all nodes. DB[r*3+c][j] stores row r, column c of D*B_j.
+	double DB[18][NELN];
+
+	for (int n = 0; n < nint; ++n)
+	{
+		const double (*d)[6] = D[n];
+		const double* gx = Gx[n];
+		const double* gy = Gy[n];
+		const double* gz = Gz[n];
+
+		for (int r = 0; r < 6; ++r)
+		{
+			const double* dr = d[r];
+			double* db0 = DB[r * 3];
+			double* db1 = DB[r * 3 + 1];
+			double* db2 = DB[r * 3 + 2];
+			for (int j = 0; j < NELN; ++j)
+			{
+				db0[j] = dr[0] * gx[j] + dr[3] * gy[j] + dr[5] * gz[j];
+				db1[j] = dr[1] * gy[j] + dr[3] * gx[j] + dr[4] * gz[j];
+				db2[j] = dr[2] * gz[j] + dr[4] * gy[j] + dr[5] * gx[j];
+			}
+		}
+
+		for (int i = 0; i < NELN; ++i)
+		{
+			const double gxi = gx[i], gyi = gy[i], gzi = gz[i];
+
+			// when the tangent is symmetric, Kji = Kij^T so we only need j >= i
+			const int j0 = (bsymm ? i : 0);
+			for (int j = j0; j < NELN; ++j)
+			{
+				K[0][i][j] += gxi*DB[ 0][j] + gyi*DB[ 9][j] + gzi*DB[15][j];
+				K[1][i][j] += gxi*DB[ 1][j] + gyi*DB[10][j] + gzi*DB[16][j];
+				K[2][i][j] += gxi*DB[ 2][j] + gyi*DB[11][j] + gzi*DB[17][j];
+
+				K[3][i][j] += gyi*DB[ 3][j] + gxi*DB[ 9][j] + gzi*DB[12][j];
+				K[4][i][j] += gyi*DB[ 4][j] + gxi*DB[10][j] + gzi*DB[13][j];
+				K[5][i][j] += gyi*DB[ 5][j] + gxi*DB[11][j] + gzi*DB[14][j];
+
+				K[6][i][j] += gzi*DB[ 6][j] + gyi*DB[12][j] + gxi*DB[15][j];
+				K[7][i][j] += gzi*DB[ 7][j] + gyi*DB[13][j] + gxi*DB[16][j];
+				K[8][i][j] += gzi*DB[ 8][j] + gyi*DB[14][j] + gxi*DB[17][j];
+			}
+		}
+	}
+
+	// add it all to the element matrix
+	for (int i = 0; i < NELN; ++i)
+	{
+		const int j0 = (bsymm ? i : 0);
+		for (int j = j0; j < NELN; ++j)
+		{
+			for (int a = 0; a < 3; ++a)
+			{
+				double* ka = ke[3 * i + a] + 3 * j;
+				ka[0] += K[a * 3    ][i][j];
+				ka[1] += K[a * 3 + 1][i][j];
+				ka[2] += K[a * 3 + 2][i][j];
+			}
+
+			if (bsymm && (j > i))
+			{
+				for (int b = 0; b < 3; ++b)
+				{
+					double* kb = ke[3 * j + b] + 3 * i;
+					kb[0] += K[    b][i][j];
+					kb[1] += K[3 + b][i][j];
+					kb[2] += K[6 + b][i][j];
+				}
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticSolidDomain::ElementMaterialStiffnessGeneric(FESolidElement &el, matrix &ke)
 {
 	// Get the current element's data
 	const int nint = el.GaussPoints();
@@ -417,11 +569,7 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 {
 	// repeat over all solid elements
-	int NE = Elements();
-	
-	#pragma omp parallel for shared (NE)
-	for (int iel=0; iel<NE; ++iel)
-	{
+	AssembleElements(LS, [&](int iel) {
 		FESolidElement& el = m_Elem[iel];
 
 		if (el.isActive()) {
@@ -454,7 +602,7 @@ void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 			// assemble element matrix in global stiffness matrix
 			LS.Assemble(ke);
 		}
-	}
+	});
 }
 
 //-----------------------------------------------------------------------------
@@ -603,12 +751,20 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 		}
 	}
 
-	// loop over the integration points and calculate
-	// the stress at the integration point
+	// deformation gradients at the current time (needed for the energy adjustment)
+	const int NINT = FEElement::MAX_INTPOINTS;
+	assert(nint <= NINT);
+	mat3d FtList[NINT];
+	double JtList[NINT];
+
+	// loop over the integration points and update the kinematics
+	// at the integration point
+	FEMaterialPoint* mpList[NINT];
 	for (int n=0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
 		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+		mpList[n] = &mp;
 
 		// material point coordinates
 		mp.m_rt = el.Evaluate(r, n);
@@ -640,31 +796,55 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 
         // update specialized material points
         m_pMat->UpdateSpecializedMaterialPoints(mp, tp);
-        
-		// calculate the stress at this material point
-//		pt.m_s = m_pMat->Stress(mp);
-		pt.m_s = (m_secant_stress ? m_pMat->SecantStress(mp) : m_pMat->Stress(mp));
-        
-        // adjust stress for strain energy conservation
-        if (m_alphaf == 0.5) 
+
+		FtList[n] = Ft;
+		JtList[n] = Jt;
+	}
+
+	// calculate the stress at all the material points
+	if (m_secant_stress)
+	{
+		for (int n = 0; n < nint; ++n)
+		{
+			FEElasticMaterialPoint& pt = *(mpList[n]->ExtractData<FEElasticMaterialPoint>());
+			pt.m_s = m_pMat->SecantStress(*mpList[n]);
+		}
+	}
+	else
+	{
+		mat3ds s[NINT];
+		m_pMat->BatchStress(mpList, nint, s);
+		for (int n = 0; n < nint; ++n)
 		{
-			FEElasticMaterial* pme = dynamic_cast<FEElasticMaterial*>(m_pMat);
+			FEElasticMaterialPoint& pt = *(mpList[n]->ExtractData<FEElasticMaterialPoint>());
+			pt.m_s = s[n];
+		}
+	}
+
+	// adjust stress for strain energy conservation
+	if (m_alphaf == 0.5)
+	{
+		FEElasticMaterial* pme = dynamic_cast<FEElasticMaterial*>(m_pMat);
+		for (int n = 0; n < nint; ++n)
+		{
+			FEMaterialPoint& mp = *mpList[n];
+			FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
 
 			// evaluate strain energy at current time
 			mat3d Ftmp = pt.m_F;
 			double Jtmp = pt.m_J;
-			pt.m_F = Ft;
-			pt.m_J = Jt;
+			pt.m_F = FtList[n];
+			pt.m_J = JtList[n];
 			pt.m_Wt = pme->StrainEnergyDensity(mp);
 			pt.m_F = Ftmp;
 			pt.m_J = Jtmp;
 
-            mat3ds D = pt.RateOfDeformation();
-            double D2 = D.dotdot(D);
-            if (D2 > 0)
-                pt.m_s += D*(((pt.m_Wt-pt.m_Wp)/(dt*pt.m_J) - pt.m_s.dotdot(D))/D2);
-        }
-    }
+			mat3ds D = pt.RateOfDeformation();
+			double D2 = D.dotdot(D);
+			if (D2 > 0)
+				pt.m_s += D*(((pt.m_Wt-pt.m_Wp)/(dt*pt.m_J) - pt.m_s.dotdot(D))/D2);
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
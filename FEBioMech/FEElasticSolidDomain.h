@@ -108,6 +108,9 @@ public:
 	//! material stiffness component
 	virtual void ElementMaterialStiffness(FESolidElement& el, matrix& ke);
 
+	//! material stiffness component for any element type (i.e. without the specialized kernels)
+	void ElementMaterialStiffnessGeneric(FESolidElement& el, matrix& ke);
+
 	// --- R E S I D U A L ---
 
 	//! Calculates the internal stress vector for solid elements
@@ -116,6 +119,10 @@ public:
     //! Calculates the inertial force vector for solid elements
     void ElementInertialForce(FESolidElement& el, vector<double>& fe);
     
+protected:
+	//! material stiffness kernel for elements with NELN nodes
+	template <int NELN> void ElementMaterialStiffness(FESolidElement& el, matrix& ke);
+
 protected:
     double              m_alphaf;
     double              m_alpham;
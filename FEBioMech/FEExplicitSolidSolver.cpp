@@ -45,6 +45,7 @@ SOFTWARE.*/
 #include <FECore/FEAnalysis.h>
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FENLConstraint.h>
+#include <FECore/FEProfiler.h>
 #include "FEResidualVector.h"
 #include "FEBioMech.h"
 #include "FESolidAnalysis.h"
@@ -560,7 +561,11 @@ void FEExplicitSolidSolver::UpdateKinematics(vector<double>& ui)
 	for (int i=0; i<ndis; ++i)
 	{
 		FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-		if (bc.IsActive()) bc.Update();
+		if (bc.IsActive())
+		{
+			TRACK_COMPONENT(&bc, "Update");
+			bc.Update();
+		}
 	}
 
 	// enforce the linear constraints
@@ -781,7 +786,11 @@ void FEExplicitSolidSolver::PrepStep()
 	for (i=0; i<nbc; ++i)
 	{
 		FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-		if (bc.IsActive()) bc.PrepStep(ui);
+		if (bc.IsActive())
+		{
+			TRACK_COMPONENT(&bc, "PrepStep");
+			bc.PrepStep(ui);
+		}
 	}
 
 	// initialize rigid bodies
@@ -1036,6 +1045,7 @@ bool FEExplicitSolidSolver::Residual(vector<double>& R)
 	// calculate the internal (stress) forces
 	for (int i=0; i<mesh.Domains(); ++i)
 	{
+		TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
 		FEElasticDomain& dom = dynamic_cast<FEElasticDomain&>(mesh.Domain(i));
 		dom.InternalForces(RHS);
 	}
@@ -94,6 +94,14 @@ FEFacetSlidingSurface::FEFacetSlidingSurface(FEModel* pfem) : FEContactSurface(p
 {
 	// define class exports
 	EXPORT_DATA(PLT_VEC3F, FMT_NODE, &m_Fn, "contact nodal forces");
+
+	m_cpp = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FEFacetSlidingSurface::~FEFacetSlidingSurface()
+{
+	delete m_cpp;
 }
 
 //-----------------------------------------------------------------------------
@@ -111,6 +119,11 @@ bool FEFacetSlidingSurface::Init()
 	int nn = Nodes();
 	m_Fn.assign(nn, vec3d(0,0,0));
 
+	// The surface is initialized again when it is recreated (e.g. after mesh refinement),
+	// so the search structure, which stores the surface topology, must be rebuilt.
+	delete m_cpp;
+	m_cpp = nullptr;
+
 	return true;
 }
 
@@ -431,11 +444,18 @@ void FEFacet2FacetSliding::CalcAutoPenalty(FEFacetSlidingSurface& s)
 //
 void FEFacet2FacetSliding::ProjectSurface(FEFacetSlidingSurface &ss, FEFacetSlidingSurface &ms, bool bsegup, bool bmove)
 {
-	FEClosestPointProjection cpp(ms);
-	cpp.HandleSpecialCases(true);
+	// The search structure of the secondary surface is kept between updates.
+	// Its topology does not change, so after the first update we only need to
+	// refit its search tree to the new nodal positions.
+	if (ms.m_cpp == nullptr)
+	{
+		ms.m_cpp = new FEClosestPointProjection(ms);
+		ms.m_cpp->HandleSpecialCases(true);
+	}
+	FEClosestPointProjection& cpp = *ms.m_cpp;
 	cpp.SetSearchRadius(m_srad);
 	cpp.SetTolerance(m_stol);
-	cpp.Init();
+	cpp.Update();
 
 	// if we need to project the nodes onto the secondary surface,
 	// let's do this first
@@ -514,12 +534,8 @@ void FEFacet2FacetSliding::ProjectSurface(FEFacetSlidingSurface &ss, FEFacetSlid
 			{
 				if (pt.m_pme)
 				{
-					// see if it still projects to the same facet
-					q = ms.ProjectToSurface(*pt.m_pme, x, pt.m_rs[0], pt.m_rs[1]);
-					if (ms.IsInsideElement(*pt.m_pme, pt.m_rs[0], pt.m_rs[1], m_stol) == false)
-					{
-						pt.m_pme = nullptr;
-					}
+					// see if it still projects to the same facet or one of its neighbors
+					pt.m_pme = cpp.ProjectNeighbors(*pt.m_pme, x, q, pt.m_rs);
 				}
 
 				if (pt.m_pme == nullptr)
@@ -612,6 +628,7 @@ void FEFacet2FacetSliding::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		FEFacetSlidingSurface& ms = (np == 0? m_ms : m_ss);
 
 		// loop over all primary surface elements
+#pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hs, Hm, r0) shared(R) schedule(dynamic)
 		for (int i=0; i<ss.Elements(); ++i)
 		{
 			FESurfaceElement& se = ss.Element(i);
@@ -733,8 +750,27 @@ void FEFacet2FacetSliding::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 
 					for (int k=0; k<ndof; ++k) fe[k] *= tn*detJ[j]*w[j];
 
-					for (int k=0; k<nseln; ++k) ss.m_Fn[se.m_lnode[k]] += vec3d(fe[3*k], fe[3*k+1], fe[3*k+2]);
-					for (int k=0; k<nmeln; ++k) ms.m_Fn[me.m_lnode[k]] += vec3d(fe[3*nseln+3*k], fe[3*nseln+3*k+1], fe[3*nseln+3*k+2]);
+					// nodes are shared between elements, so the nodal forces are added atomically
+					for (int k=0; k<nseln; ++k)
+					{
+						vec3d& f = ss.m_Fn[se.m_lnode[k]];
+#pragma omp atomic
+						f.x += fe[3*k  ];
+#pragma omp atomic
+						f.y += fe[3*k+1];
+#pragma omp atomic
+						f.z += fe[3*k+2];
+					}
+					for (int k=0; k<nmeln; ++k)
+					{
+						vec3d& f = ms.m_Fn[me.m_lnode[k]];
+#pragma omp atomic
+						f.x += fe[3*nseln+3*k  ];
+#pragma omp atomic
+						f.y += fe[3*nseln+3*k+1];
+#pragma omp atomic
+						f.z += fe[3*nseln+3*k+2];
+					}
 
 					// assemble the global residual
 					R.Assemble(en, LM, fe);
@@ -788,6 +824,7 @@ void FEFacet2FacetSliding::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 		FEFacetSlidingSurface& ms = (np == 0? m_ms : m_ss);
 
 		// loop over all primary surface elements
+#pragma omp parallel for private(sLM, mLM, LM, en, ke, N, T1, T2, D1, D2, Nb1, Nb2, detJ, w, Hs, Hm, Hmr, Hms, r0) firstprivate(N1, N2) shared(LS) schedule(dynamic)
 		for (int i=0; i<ss.Elements(); ++i)
 		{
 			FESurfaceElement& se = ss.Element(i);
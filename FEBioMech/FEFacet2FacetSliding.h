@@ -31,6 +31,8 @@ SOFTWARE.*/
 #include "FEContactInterface.h"
 #include "FEContactSurface.h"
 
+class FEClosestPointProjection;
+
 //-----------------------------------------------------------------------------
 //! Contact surface for facet-to-facet sliding interfaces
 class FEFacetSlidingSurface : public FEContactSurface
@@ -55,6 +57,9 @@ public:
 	//! constructor
 	FEFacetSlidingSurface(FEModel* pfem);
 
+	//! destructor
+	~FEFacetSlidingSurface();
+
 	//! initialization
 	bool Init() override;
 
@@ -77,6 +82,8 @@ public:
 
 public:
 	vector<vec3d>	m_Fn;	//!< equivalent nodal forces
+
+	FEClosestPointProjection*	m_cpp;	//!< search structure, used when this is the secondary surface
 };
 
 //-----------------------------------------------------------------------------
@@ -206,6 +206,160 @@ double FEFiberExpPow::FiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d&
     return sed;
 }
 
+//-----------------------------------------------------------------------------
+// The sums below evaluate the same expressions as the single fiber functions, but
+// the material parameters and kinematics are only evaluated once. Fibers that are 
+// not in tension are masked out instead of skipped so that the loops vectorize.
+mat3ds FEFiberExpPow::FiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+
+	const mat3d& F = pt.m_F;
+	double J = pt.m_J;
+	mat3ds C = pt.RightCauchyGreen();
+
+	double lam0 = m_lam0(mp);
+	double I0 = lam0*lam0;
+	double ksi = m_ksi(mp);
+	double mu = m_mu(mp);
+	double alpha = m_alpha(mp);
+	double beta = m_beta(mp);
+	const double eps = m_epsf*std::numeric_limits<double>::epsilon();
+
+	// sums of w*Wl*N and w*N over all fibers in tension
+	double s[6] = { 0 }, m[6] = { 0 };
+	for (int i = 0; i < n; ++i)
+	{
+		double x = nx[i], y = ny[i], z = nz[i];
+		double In_I0 = x*(C.xx()*x + C.xy()*y + C.xz()*z) + y*(C.xy()*x + C.yy()*y + C.yz()*z) + z*(C.xz()*x + C.yz()*y + C.zz()*z) - I0;
+		double t = (In_I0 >= eps ? 1.0 : 0.0);
+		double I = (In_I0 >= eps ? In_I0 : 1.0);
+		double Wl = ksi*pow(I, beta - 1.0)*exp(alpha*pow(I, beta));
+
+		// spatial fiber direction
+		double ax = F[0][0]*x + F[0][1]*y + F[0][2]*z;
+		double ay = F[1][0]*x + F[1][1]*y + F[1][2]*z;
+		double az = F[2][0]*x + F[2][1]*y + F[2][2]*z;
+
+		double v[6] = { ax*ax, ay*ay, az*az, ax*ay, ay*az, ax*az };
+		double wt = w[i] * t;
+		for (int k = 0; k < 6; ++k)
+		{
+			s[k] += wt*Wl*v[k];
+			m[k] += wt*v[k];
+		}
+	}
+
+	mat3ds S = mat3ds(s[0], s[1], s[2], s[3], s[4], s[5])*(2.0 / J);
+
+	// add the contribution from shear
+	if (mu != 0.0)
+	{
+		mat3ds N(m[0], m[1], m[2], m[3], m[4], m[5]);
+		mat3ds BmI = pt.LeftCauchyGreen() - mat3dd(1);
+		S += (N*BmI).sym()*(mu / J);
+	}
+
+	return S;
+}
+
+//-----------------------------------------------------------------------------
+tens4ds FEFiberExpPow::FiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+
+	const mat3d& F = pt.m_F;
+	double J = pt.m_J;
+	mat3ds C = pt.RightCauchyGreen();
+
+	double lam0 = m_lam0(mp);
+	double I0 = lam0*lam0;
+	double ksi = m_ksi(mp);
+	double mu = m_mu(mp);
+	double alpha = m_alpha(mp);
+	double beta = m_beta(mp);
+	const double eps = m_epsf*std::numeric_limits<double>::epsilon();
+
+	// sums of w*Wll*(N dyad1s N) and w*N over all fibers in tension
+	double d[tens4ds::NNZ] = { 0 }, m[6] = { 0 };
+	for (int i = 0; i < n; ++i)
+	{
+		double x = nx[i], y = ny[i], z = nz[i];
+		double In_I0 = x*(C.xx()*x + C.xy()*y + C.xz()*z) + y*(C.xy()*x + C.yy()*y + C.yz()*z) + z*(C.xz()*x + C.yz()*y + C.zz()*z) - I0;
+		double t = (In_I0 >= eps ? 1.0 : 0.0);
+		double I = (In_I0 >= eps ? In_I0 : 1.0);
+		double tmp = alpha*pow(I, beta);
+		double Wll = ksi*pow(I, beta - 2.0)*((tmp + 1)*beta - 1.0)*exp(tmp);
+
+		// spatial fiber direction
+		double ax = F[0][0]*x + F[0][1]*y + F[0][2]*z;
+		double ay = F[1][0]*x + F[1][1]*y + F[1][2]*z;
+		double az = F[2][0]*x + F[2][1]*y + F[2][2]*z;
+
+		double v[6] = { ax*ax, ay*ay, az*az, ax*ay, ay*az, ax*az };
+		double wt = w[i] * t;
+		double a = wt*Wll;
+
+		// same (lower triangular) layout as dyad1s
+		for (int k = 0, l = 0; k < 6; ++k)
+			for (int j = 0; j <= k; ++j, ++l) d[l] += a*v[k]*v[j];
+
+		for (int k = 0; k < 6; ++k) m[k] += wt*v[k];
+	}
+
+	tens4ds c;
+	for (int l = 0; l < tens4ds::NNZ; ++l) c.d[l] = d[l]*(4.0 / J);
+
+	// add the contribution from shear
+	if (mu != 0.0)
+	{
+		mat3ds N(m[0], m[1], m[2], m[3], m[4], m[5]);
+		mat3ds B = pt.LeftCauchyGreen();
+		c += dyad4s(N, B)*(mu / J);
+	}
+
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+double FEFiberExpPow::FiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+
+	mat3ds C = pt.RightCauchyGreen();
+	mat3ds C2 = C.sqr();
+
+	double lam0 = m_lam0(mp);
+	double I0 = lam0*lam0;
+	double ksi = m_ksi(mp);
+	double mu = m_mu(mp);
+	double alpha = m_alpha(mp);
+	double beta = m_beta(mp);
+
+	double sed = 0.0;
+	for (int i = 0; i < n; ++i)
+	{
+		double x = nx[i], y = ny[i], z = nz[i];
+		double In = x*(C.xx()*x + C.xy()*y + C.xz()*z) + y*(C.xy()*x + C.yy()*y + C.yz()*z) + z*(C.xz()*x + C.yz()*y + C.zz()*z);
+		double In_I0 = In - I0;
+		double t = (In_I0 >= 0.0 ? 1.0 : 0.0);
+		double I = (In_I0 >= 0.0 ? In_I0 : 1.0);
+
+		double W = (alpha > 0 ? ksi / (alpha*beta)*(exp(alpha*pow(I, beta)) - 1) : ksi / beta*pow(I, beta));
+
+		// add the contribution from shear
+		if (mu != 0.0)
+		{
+			double I2 = x*(C2.xx()*x + C2.xy()*y + C2.xz()*z) + y*(C2.xy()*x + C2.yy()*y + C2.yz()*z) + z*(C2.xz()*x + C2.yz()*y + C2.zz()*z);
+			W += mu*(I2 - 2 * (In - 1) - 1) / 4.0;
+		}
+
+		sed += w[i]*t*W;
+	}
+
+	return sed;
+}
+
 // define the material parameters
 BEGIN_FECORE_CLASS(FEElasticFiberExpPow, FEElasticFiberMaterial)
 	ADD_PARAMETER(m_fib.m_alpha, FE_RANGE_GREATER_OR_EQUAL(0.0), "alpha");
@@ -49,6 +49,11 @@ public:
 	
 	//! Strain energy density
 	double FiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d& a0) override;
+
+	// weighted sums over fibers
+	mat3ds FiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w) override;
+	tens4ds FiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w) override;
+	double FiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w) override;
     
 protected:
 	FEParamDouble       m_alpha;	// coefficient of (In-I0) in exponential
@@ -144,6 +144,9 @@ void FEFiberIntegrationGeodesic::InitIntegrationRule()
 		m_sph[n] = sin(phi[n]);
 		m_w[n] = w[n];
 	}
+
+	// the integration points don't depend on the material point, so we can tabulate them
+	BuildTable();
 }
 
 //-----------------------------------------------------------------------------
@@ -29,6 +29,95 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEFiberIntegrationScheme.h"
 
+//-----------------------------------------------------------------------------
+void FEFiberIntegrationTable::Clear()
+{
+	m_nx.clear();
+	m_ny.clear();
+	m_nz.clear();
+	m_w.clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEFiberIntegrationTable::Add(const vec3d& fiber, double weight)
+{
+	m_nx.push_back(fiber.x);
+	m_ny.push_back(fiber.y);
+	m_nz.push_back(fiber.z);
+	m_w.push_back(weight);
+}
+
+//=============================================================================
 FEFiberIntegrationScheme::FEFiberIntegrationScheme(FEModel* pfem) : FEMaterialProperty(pfem)
 {
+	m_btable = false;
+}
+
+//-----------------------------------------------------------------------------
+void FEFiberIntegrationScheme::BuildTable()
+{
+	m_table.Clear();
+	FEFiberIntegrationSchemeIterator* it = GetIterator(nullptr);
+	if (it->IsValid())
+	{
+		do
+		{
+			m_table.Add(it->m_fiber, it->m_weight);
+		}
+		while (it->Next());
+	}
+	delete it;
+	m_btable = true;
+}
+
+//=============================================================================
+FEFiberBatchIterator::FEFiberBatchIterator(FEFiberIntegrationScheme* pint, FEMaterialPoint* mp)
+{
+	m_table = pint->GetTable();
+	m_it = (m_table ? nullptr : pint->GetIterator(mp));
+	m_pos = 0;
+	m_n = 0;
+	m_nx = m_ny = m_nz = m_w = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FEFiberBatchIterator::~FEFiberBatchIterator()
+{
+	delete m_it;
+}
+
+//-----------------------------------------------------------------------------
+bool FEFiberBatchIterator::Next()
+{
+	if (m_table)
+	{
+		// the batch points directly into the table
+		int N = m_table->Points();
+		if (m_pos >= N) { m_n = 0; return false; }
+		m_n = (N - m_pos < MAX_POINTS ? N - m_pos : MAX_POINTS);
+		m_nx = &m_table->m_nx[m_pos];
+		m_ny = &m_table->m_ny[m_pos];
+		m_nz = &m_table->m_nz[m_pos];
+		m_w  = &m_table->m_w [m_pos];
+		m_pos += m_n;
+	}
+	else
+	{
+		// collect the next batch from the iterator
+		m_n = 0;
+		while ((m_n < MAX_POINTS) && m_it->IsValid())
+		{
+			m_buf[0][m_n] = m_it->m_fiber.x;
+			m_buf[1][m_n] = m_it->m_fiber.y;
+			m_buf[2][m_n] = m_it->m_fiber.z;
+			m_buf[3][m_n] = m_it->m_weight;
+			m_n++;
+			m_it->Next();
+		}
+		m_nx = m_buf[0];
+		m_ny = m_buf[1];
+		m_nz = m_buf[2];
+		m_w  = m_buf[3];
+	}
+	return (m_n > 0);
 }
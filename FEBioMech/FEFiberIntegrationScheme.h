@@ -55,6 +55,23 @@ public:
 	double	m_weight;		// current integration weight
 };
 
+//----------------------------------------------------------------------------------
+// Table of fiber integration points. The fiber vectors and weights are stored in 
+// separate arrays so that they can be processed in batches.
+class FEBIOMECH_API FEFiberIntegrationTable
+{
+public:
+	void Clear();
+
+	void Add(const vec3d& fiber, double weight);
+
+	int Points() const { return (int)m_w.size(); }
+
+public:
+	std::vector<double>	m_nx, m_ny, m_nz;	// fiber vectors
+	std::vector<double>	m_w;				// integration weights
+};
+
 //----------------------------------------------------------------------------------
 // Base clase for integration schemes for continuous fiber distributions.
 // The purpose of this class is mainly to provide an interface to the integration schemes
@@ -71,5 +88,56 @@ public:
 	// The passed material point pointer will be zero when evaluating the integrated fiber density
 	virtual FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp = 0) = 0;
 
+	// Returns the table of integration points, or null if the integration points 
+	// depend on the material point, in which case the iterator has to be used.
+	const FEFiberIntegrationTable* GetTable() const { return (m_btable ? &m_table : nullptr); }
+
+protected:
+	// Fills the table of integration points using the iterator.
+	// Schemes whose integration points do not depend on the material point
+	// should call this after they have been initialized.
+	void BuildTable();
+
+private:
+	FEFiberIntegrationTable	m_table;
+	bool					m_btable;
+
 	FECORE_BASE_CLASS(FEFiberIntegrationScheme)
 };
+
+//----------------------------------------------------------------------------------
+// Loops over the integration points of a fiber integration scheme in batches of 
+// (at most) MAX_POINTS points. The points are taken from the scheme's table when 
+// it has one, and collected from the scheme's iterator otherwise.
+class FEBIOMECH_API FEFiberBatchIterator
+{
+public:
+	enum { MAX_POINTS = 64 };
+
+public:
+	FEFiberBatchIterator(FEFiberIntegrationScheme* pint, FEMaterialPoint* mp);
+	~FEFiberBatchIterator();
+
+	// Move to the next batch. Returns false if there are no more points.
+	bool Next();
+
+	// nr of points in the current batch
+	int Points() const { return m_n; }
+
+public:
+	const double*	m_nx;	// fiber vectors of current batch
+	const double*	m_ny;
+	const double*	m_nz;
+	const double*	m_w;	// integration weights of current batch
+
+private:
+	const FEFiberIntegrationTable*		m_table;
+	FEFiberIntegrationSchemeIterator*	m_it;
+	int		m_pos;	// start of next batch in table
+	int		m_n;	// size of current batch
+
+	double	m_buf[4][MAX_POINTS];	// storage for the batch when using the iterator
+
+	FEFiberBatchIterator(const FEFiberBatchIterator&) = delete;
+	void operator = (const FEFiberBatchIterator&) = delete;
+};
@@ -100,6 +100,22 @@ FEFiberIntegrationTrapezoidal::~FEFiberIntegrationTrapezoidal()
 {
 }
 
+//-----------------------------------------------------------------------------
+bool FEFiberIntegrationTrapezoidal::Init()
+{
+	// the integration points don't depend on the material point, so we can tabulate them
+	BuildTable();
+
+	return FEFiberIntegrationScheme::Init();
+}
+
+//-----------------------------------------------------------------------------
+void FEFiberIntegrationTrapezoidal::Serialize(DumpStream& ar)
+{
+	FEFiberIntegrationScheme::Serialize(ar);
+	if ((ar.IsShallow() == false) && ar.IsLoading()) BuildTable();
+}
+
 //-----------------------------------------------------------------------------
 FEFiberIntegrationSchemeIterator* FEFiberIntegrationTrapezoidal::GetIterator(FEMaterialPoint* mp)
 {
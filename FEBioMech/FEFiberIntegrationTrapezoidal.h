@@ -40,6 +40,12 @@ public:
     FEFiberIntegrationTrapezoidal(FEModel* pfem);
     ~FEFiberIntegrationTrapezoidal();
 
+	//! Initialization
+	bool Init() override;
+
+	// serialization
+	void Serialize(DumpStream& ar) override;
+
 	// get iterator	
 	FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp) override;
     
@@ -358,6 +358,9 @@ void FEFiberIntegrationTriangle::InitIntegrationRule()
             }
             break;
     }
+
+	// the integration points don't depend on the material point, so we can tabulate them
+	BuildTable();
 }
 
 //-----------------------------------------------------------------------------
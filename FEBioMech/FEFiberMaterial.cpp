@@ -36,6 +36,39 @@ FEMaterialPointData* FEFiberMaterial::CreateMaterialPointData()
 	return new FEFiberMaterialPoint(nullptr);
 }
 
+//-----------------------------------------------------------------------------
+mat3ds FEFiberMaterial::FiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	mat3ds s; s.zero();
+	for (int i = 0; i < n; ++i)
+	{
+		s += FiberStress(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return s;
+}
+
+//-----------------------------------------------------------------------------
+tens4ds FEFiberMaterial::FiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	tens4ds c; c.zero();
+	for (int i = 0; i < n; ++i)
+	{
+		c += FiberTangent(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+double FEFiberMaterial::FiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	double sed = 0.0;
+	for (int i = 0; i < n; ++i)
+	{
+		sed += FiberStrainEnergyDensity(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return sed;
+}
+
 //===========================================================================================
 FEFiberMaterialUncoupled::FEFiberMaterialUncoupled(FEModel* fem) : FEMaterialProperty(fem)
 {
@@ -45,3 +78,36 @@ FEMaterialPointData* FEFiberMaterialUncoupled::CreateMaterialPointData()
 {
 	return new FEFiberMaterialPoint(nullptr);
 }
+
+//-----------------------------------------------------------------------------
+mat3ds FEFiberMaterialUncoupled::DevFiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	mat3ds s; s.zero();
+	for (int i = 0; i < n; ++i)
+	{
+		s += DevFiberStress(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return s;
+}
+
+//-----------------------------------------------------------------------------
+tens4ds FEFiberMaterialUncoupled::DevFiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	tens4ds c; c.zero();
+	for (int i = 0; i < n; ++i)
+	{
+		c += DevFiberTangent(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+double FEFiberMaterialUncoupled::DevFiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w)
+{
+	double sed = 0.0;
+	for (int i = 0; i < n; ++i)
+	{
+		sed += DevFiberStrainEnergyDensity(mp, vec3d(nx[i], ny[i], nz[i]))*w[i];
+	}
+	return sed;
+}
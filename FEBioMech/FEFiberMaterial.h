@@ -42,6 +42,17 @@ public:
 	virtual tens4ds FiberTangent(FEMaterialPoint& mp, const vec3d& fiber) = 0;
 
 	virtual double FiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d& fiber) = 0;
+
+public:
+	// Weighted sums over n fibers, i.e. sum_i w_i*FiberStress(mp, n_i), etc. 
+	// The fiber vectors are passed as separate component arrays. The default
+	// implementations call the single fiber functions, but materials can override
+	// these to evaluate the fibers in a single (vectorizable) loop.
+	virtual mat3ds FiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w);
+
+	virtual tens4ds FiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w);
+
+	virtual double FiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w);
 };
 
 // fiber materials for use in uncoupled materials
@@ -59,4 +70,12 @@ public:
 	virtual tens4ds DevFiberTangent(FEMaterialPoint& mp, const vec3d& fiber) = 0;
 
 	virtual double DevFiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d& fiber) = 0;
+
+public:
+	// Weighted sums over n fibers (see FEFiberMaterial)
+	virtual mat3ds DevFiberStressSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w);
+
+	virtual tens4ds DevFiberTangentSum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w);
+
+	virtual double DevFiberStrainEnergyDensitySum(FEMaterialPoint& mp, int n, const double* nx, const double* ny, const double* nz, const double* w);
 };
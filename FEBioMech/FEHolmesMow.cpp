@@ -53,8 +53,13 @@ bool FEHolmesMow::Validate()
 //-----------------------------------------------------------------------------
 mat3ds FEHolmesMow::Stress(FEMaterialPoint& mp)
 {
-	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+	return Stress(*mp.ExtractData<FEElasticMaterialPoint>());
+}
 
+//-----------------------------------------------------------------------------
+//! Calculates the Cauchy stress for the given elastic point data
+mat3ds FEHolmesMow::Stress(const FEElasticMaterialPoint& pt)
+{
 	double detF = pt.m_J;
 	double detFi = 1.0/detF;
 	
@@ -80,8 +85,13 @@ mat3ds FEHolmesMow::Stress(FEMaterialPoint& mp)
 //-----------------------------------------------------------------------------
 tens4ds FEHolmesMow::Tangent(FEMaterialPoint& mp)
 {
-	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+	return Tangent(*mp.ExtractData<FEElasticMaterialPoint>());
+}
 
+//-----------------------------------------------------------------------------
+//! Calculates the spatial tangent for the given elastic point data
+tens4ds FEHolmesMow::Tangent(const FEElasticMaterialPoint& pt)
+{
 	double detF = pt.m_J;
 	double detFi = 1.0/detF;
 	
@@ -108,6 +118,109 @@ tens4ds FEHolmesMow::Tangent(FEMaterialPoint& mp)
 	return c;
 }
 
+//-----------------------------------------------------------------------------
+//! The material parameters are not spatially varying, so the constants are
+//! evaluated once and the points are processed component by component, which 
+//! lets the compiler vectorize the loops over the points.
+void FEHolmesMow::EvaluateBatch(FEMaterialPoint** mp, int npts, double* J, double* eQ, double (*b)[BATCH_SIZE], double (*s)[BATCH_SIZE])
+{
+	assert(npts <= BATCH_SIZE);
+
+	// constants of the exponential term
+	const double c1 = m_b*(2*mu - lam)/Ha;
+	const double c2 = m_b*lam/Ha;
+	const double mu2 = 2*mu;
+
+	// gather the kinematics
+	for (int i = 0; i < npts; ++i)
+	{
+		FEElasticMaterialPoint& pt = *mp[i]->ExtractData<FEElasticMaterialPoint>();
+		J[i] = pt.m_J;
+
+		const mat3d& F = pt.m_F;
+		b[0][i] = F[0][0]*F[0][0]+F[0][1]*F[0][1]+F[0][2]*F[0][2];
+		b[1][i] = F[1][0]*F[1][0]+F[1][1]*F[1][1]+F[1][2]*F[1][2];
+		b[2][i] = F[2][0]*F[2][0]+F[2][1]*F[2][1]+F[2][2]*F[2][2];
+		b[3][i] = F[0][0]*F[1][0]+F[0][1]*F[1][1]+F[0][2]*F[1][2];
+		b[4][i] = F[1][0]*F[2][0]+F[1][1]*F[2][1]+F[1][2]*F[2][2];
+		b[5][i] = F[0][0]*F[2][0]+F[0][1]*F[2][1]+F[0][2]*F[2][2];
+	}
+
+	// s = 0.5*eQ/J*((2*mu + lam*(I1 - 1))*b - lam*b^2 - Ha*I)
+	for (int i = 0; i < npts; ++i)
+	{
+		const double bxx = b[0][i], byy = b[1][i], bzz = b[2][i];
+		const double bxy = b[3][i], byz = b[4][i], bxz = b[5][i];
+
+		// b^2
+		const double qxx = bxx*bxx + bxy*bxy + bxz*bxz;
+		const double qyy = bxy*bxy + byy*byy + byz*byz;
+		const double qzz = bxz*bxz + byz*byz + bzz*bzz;
+		const double qxy = bxx*bxy + bxy*byy + bxz*byz;
+		const double qyz = bxy*bxz + byy*byz + byz*bzz;
+		const double qxz = bxx*bxz + bxy*byz + bxz*bzz;
+
+		// invariants of b
+		const double I1 = bxx + byy + bzz;
+		const double I2 = 0.5*(I1*I1 - (qxx + qyy + qzz));
+		const double I3 = bxx*(byy*bzz - byz*byz) - bxy*(bxy*bzz - byz*bxz) + bxz*(bxy*byz - byy*bxz);
+
+		// exponential term (pow(I3, m_b) is folded into the exponent)
+		eQ[i] = exp(c1*(I1 - 3) + c2*(I2 - 3) - m_b*log(I3));
+
+		const double k = 0.5*eQ[i]/J[i];
+		const double kb = k*(mu2 + lam*(I1 - 1));
+		const double kq = k*lam;
+		const double kh = k*Ha;
+		s[0][i] = kb*bxx - kq*qxx - kh;
+		s[1][i] = kb*byy - kq*qyy - kh;
+		s[2][i] = kb*bzz - kq*qzz - kh;
+		s[3][i] = kb*bxy - kq*qxy;
+		s[4][i] = kb*byz - kq*qyz;
+		s[5][i] = kb*bxz - kq*qxz;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEHolmesMow::BatchStress(FEMaterialPoint** mp, int npts, mat3ds* s)
+{
+	double J[BATCH_SIZE], eQ[BATCH_SIZE];
+	double b[6][BATCH_SIZE], sb[6][BATCH_SIZE];
+	for (int i0 = 0; i0 < npts; i0 += BATCH_SIZE)
+	{
+		const int n = (npts - i0 < BATCH_SIZE ? npts - i0 : BATCH_SIZE);
+		EvaluateBatch(mp + i0, n, J, eQ, b, sb);
+
+		mat3ds* si = s + i0;
+		for (int i = 0; i < n; ++i) si[i] = mat3ds(sb[0][i], sb[1][i], sb[2][i], sb[3][i], sb[4][i], sb[5][i]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEHolmesMow::BatchTangent(FEMaterialPoint** mp, int npts, tens4ds* c)
+{
+	mat3dd I(1);
+	tens4ds HaI4 = dyad4s(I)*Ha;
+	const double a = 4.*m_b/Ha;
+
+	double J[BATCH_SIZE], eQ[BATCH_SIZE];
+	double b[6][BATCH_SIZE], sb[6][BATCH_SIZE];
+	for (int i0 = 0; i0 < npts; i0 += BATCH_SIZE)
+	{
+		const int n = (npts - i0 < BATCH_SIZE ? npts - i0 : BATCH_SIZE);
+		EvaluateBatch(mp + i0, n, J, eQ, b, sb);
+
+		// c = 4*beta/Ha*J/eQ*(s x s) + eQ/J*(lam*(b x b - b(x)b) + Ha*I(x)I)
+		for (int i = 0; i < n; ++i)
+		{
+			mat3ds si(sb[0][i], sb[1][i], sb[2][i], sb[3][i], sb[4][i], sb[5][i]);
+			mat3ds bi(b[0][i], b[1][i], b[2][i], b[3][i], b[4][i], b[5][i]);
+			const double g = eQ[i]/J[i];
+			c[i0 + i] = dyad1s(si)*(a/g) + ((dyad1s(bi) - dyad4s(bi))*lam + HaI4)*g;
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 double FEHolmesMow::StrainEnergyDensity(FEMaterialPoint& mp)
 {
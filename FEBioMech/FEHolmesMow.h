@@ -52,9 +52,24 @@ public:
 		
 	//! calculate strain energy density at material point
 	virtual double StrainEnergyDensity(FEMaterialPoint& pt) override;
+
+	//! calculate stress at a batch of material points
+	void BatchStress(FEMaterialPoint** mp, int npts, mat3ds* s) override;
+
+	//! calculate tangent stiffness at a batch of material points
+	void BatchTangent(FEMaterialPoint** mp, int npts, tens4ds* c) override;
     
 	//! data initialization and checking
 	bool Validate() override;
+
+protected:
+	mat3ds Stress(const FEElasticMaterialPoint& pt);
+	tens4ds Tangent(const FEElasticMaterialPoint& pt);
+
+private:
+	// evaluate the left Cauchy-Green tensor b, the exponential term eQ and the 
+	// stress s of a batch of points (stored per component)
+	void EvaluateBatch(FEMaterialPoint** mp, int npts, double* J, double* eQ, double (*b)[BATCH_SIZE], double (*s)[BATCH_SIZE]);
 		
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
@@ -46,6 +46,13 @@ mat3ds FEMooneyRivlin::DevStress(FEMaterialPoint& mp)
 	double c1 = m_c1(mp);
 	double c2 = m_c2(mp);
 
+	return DevStress(pt, c1, c2);
+}
+
+//-----------------------------------------------------------------------------
+//! Calculate the deviatoric stress for given material parameters
+mat3ds FEMooneyRivlin::DevStress(const FEElasticMaterialPoint& pt, double c1, double c2)
+{
 	// determinant of deformation gradient
 	double J = pt.m_J;
 
@@ -86,6 +93,13 @@ tens4ds FEMooneyRivlin::DevTangent(FEMaterialPoint& mp)
 	double c1 = m_c1(mp);
 	double c2 = m_c2(mp);
 
+	return DevTangent(pt, c1, c2);
+}
+
+//-----------------------------------------------------------------------------
+//! Calculate the deviatoric tangent for given material parameters
+tens4ds FEMooneyRivlin::DevTangent(const FEElasticMaterialPoint& pt, double c1, double c2)
+{
 	// determinant of deformation gradient
 	double J = pt.m_J;
 	double Ji = 1.0/J;
@@ -135,6 +149,55 @@ tens4ds FEMooneyRivlin::DevTangent(FEMaterialPoint& mp)
 	return c;
 }
 
+//-----------------------------------------------------------------------------
+//! Gather the material points and the material parameters of a batch.
+//! The parameters are only evaluated once when they are constant.
+void FEMooneyRivlin::GatherBatch(FEMaterialPoint** mp, int npts, FEElasticMaterialPoint** pt, double* c1, double* c2)
+{
+	assert(npts <= BATCH_SIZE);
+	const bool bconst = (m_c1.isConst() && m_c2.isConst());
+	for (int i = 0; i < npts; ++i)
+	{
+		pt[i] = mp[i]->ExtractData<FEElasticMaterialPoint>();
+		if ((i == 0) || (bconst == false))
+		{
+			c1[i] = m_c1(*mp[i]);
+			c2[i] = m_c2(*mp[i]);
+		}
+		else
+		{
+			c1[i] = c1[0];
+			c2[i] = c2[0];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEMooneyRivlin::BatchDevStress(FEMaterialPoint** mp, int npts, mat3ds* s)
+{
+	FEElasticMaterialPoint* pt[BATCH_SIZE];
+	double c1[BATCH_SIZE], c2[BATCH_SIZE];
+	for (int i0 = 0; i0 < npts; i0 += BATCH_SIZE)
+	{
+		const int n = (npts - i0 < BATCH_SIZE ? npts - i0 : BATCH_SIZE);
+		GatherBatch(mp + i0, n, pt, c1, c2);
+		for (int i = 0; i < n; ++i) s[i0 + i] = DevStress(*pt[i], c1[i], c2[i]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEMooneyRivlin::BatchDevTangent(FEMaterialPoint** mp, int npts, tens4ds* c)
+{
+	FEElasticMaterialPoint* pt[BATCH_SIZE];
+	double c1[BATCH_SIZE], c2[BATCH_SIZE];
+	for (int i0 = 0; i0 < npts; i0 += BATCH_SIZE)
+	{
+		const int n = (npts - i0 < BATCH_SIZE ? npts - i0 : BATCH_SIZE);
+		GatherBatch(mp + i0, n, pt, c1, c2);
+		for (int i = 0; i < n; ++i) c[i0 + i] = DevTangent(*pt[i], c1[i], c2[i]);
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! calculate deviatoric strain energy density
 double FEMooneyRivlin::DevStrainEnergyDensity(FEMaterialPoint& mp)
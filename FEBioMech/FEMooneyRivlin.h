@@ -51,7 +51,18 @@ public:
 
 	//! calculate deviatoric strain energy density
 	double DevStrainEnergyDensity(FEMaterialPoint& mp) override;
-    
+
+	//! calculate deviatoric stress at a batch of material points
+	void BatchDevStress(FEMaterialPoint** mp, int npts, mat3ds* s) override;
+
+	//! calculate deviatoric tangent at a batch of material points
+	void BatchDevTangent(FEMaterialPoint** mp, int npts, tens4ds* c) override;
+
+private:
+	mat3ds DevStress(const FEElasticMaterialPoint& pt, double c1, double c2);
+	tens4ds DevTangent(const FEElasticMaterialPoint& pt, double c1, double c2);
+	void GatherBatch(FEMaterialPoint** mp, int npts, FEElasticMaterialPoint** pt, double* c1, double* c2);
+
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
 };
@@ -92,6 +92,113 @@ tens4ds FENeoHookean::Tangent(FEMaterialPoint& mp)
 	return dyad1s(I)*lam1 + dyad4s(I)*(2*mu1);
 }
 
+//-----------------------------------------------------------------------------
+//! Copy the data needed by the batched functions into structure-of-arrays buffers.
+//! The Lame parameters are only evaluated once when E and v are constant.
+//! If b is not null, the left Cauchy-Green tensor is stored as well.
+void FENeoHookean::GatherBatch(FEMaterialPoint** mp, int npts, double* J, double* lam, double* mu, double (*b)[BATCH_SIZE])
+{
+	assert(npts <= BATCH_SIZE);
+
+	// evaluate the material parameters
+	double E[BATCH_SIZE], v[BATCH_SIZE];
+	const bool bconst = (m_E.isConst() && m_v.isConst());
+	if (bconst)
+	{
+		E[0] = m_E(*mp[0]);
+		v[0] = m_v(*mp[0]);
+	}
+	else
+	{
+		m_E.BatchValue(mp, npts, E);
+		m_v.BatchValue(mp, npts, v);
+	}
+
+	for (int i = 0; i < npts; ++i)
+	{
+		FEMaterialPoint& mpi = *mp[i];
+		FEElasticMaterialPoint& pt = *mpi.ExtractData<FEElasticMaterialPoint>();
+		J[i] = pt.m_J;
+
+		if (b)
+		{
+			const mat3d& F = pt.m_F;
+			b[0][i] = F[0][0]*F[0][0]+F[0][1]*F[0][1]+F[0][2]*F[0][2];
+			b[1][i] = F[1][0]*F[1][0]+F[1][1]*F[1][1]+F[1][2]*F[1][2];
+			b[2][i] = F[2][0]*F[2][0]+F[2][1]*F[2][1]+F[2][2]*F[2][2];
+			b[3][i] = F[0][0]*F[1][0]+F[0][1]*F[1][1]+F[0][2]*F[1][2];
+			b[4][i] = F[1][0]*F[2][0]+F[1][1]*F[2][1]+F[1][2]*F[2][2];
+			b[5][i] = F[0][0]*F[2][0]+F[0][1]*F[2][1]+F[0][2]*F[2][2];
+		}
+
+		if ((i == 0) || (bconst == false))
+		{
+			lam[i] = v[i]*E[i]/((1+v[i])*(1-2*v[i]));
+			mu [i] = 0.5*E[i]/(1+v[i]);
+		}
+		else
+		{
+			lam[i] = lam[0];
+			mu [i] = mu[0];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FENeoHookean::BatchStress(FEMaterialPoint** mp, int npts, mat3ds* s)
+{
+	double J[BATCH_SIZE], lam[BATCH_SIZE], mu[BATCH_SIZE];
+	double b[6][BATCH_SIZE];
+	for (int i0 = 0; i0 < npts; i0 += BATCH_SIZE)
+	{
+		const int n = (npts - i0 < BATCH_SIZE ? npts - i0 : BATCH_SIZE);
+		GatherBatch(mp + i0, n, J, lam, mu, b);
+
+		// s = (b - I)*mu/J + I*lam*ln(J)/J
+		double a[BATCH_SIZE], p[BATCH_SIZE];
+		for (int i = 0; i < n; ++i)
+		{
+			double Ji = 1.0 / J[i];
+			a[i] = mu[i] * Ji;
+			p[i] = lam[i] * log(J[i])*Ji;
+		}
+
+		mat3ds* si = s + i0;
+		for (int i = 0; i < n; ++i)
+		{
+			si[i] = mat3ds(
+				(b[0][i] - 1.0)*a[i] + p[i],
+				(b[1][i] - 1.0)*a[i] + p[i],
+				(b[2][i] - 1.0)*a[i] + p[i],
+				b[3][i]*a[i],
+				b[4][i]*a[i],
+				b[5][i]*a[i]);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FENeoHookean::BatchTangent(FEMaterialPoint** mp, int npts, tens4ds* c)
+{
+	mat3dd I(1);
+	tens4ds IxI = dyad1s(I);
+	tens4ds I4  = dyad4s(I);
+
+	double J[BATCH_SIZE], lam[BATCH_SIZE], mu[BATCH_SIZE];
+	for (int i0 = 0; i0 < npts; i0 += BATCH_SIZE)
+	{
+		const int n = (npts - i0 < BATCH_SIZE ? npts - i0 : BATCH_SIZE);
+		GatherBatch(mp + i0, n, J, lam, mu, nullptr);
+
+		for (int i = 0; i < n; ++i)
+		{
+			double lam1 = lam[i] / J[i];
+			double mu1  = (mu[i] - lam[i]*log(J[i])) / J[i];
+			c[i0 + i] = IxI*lam1 + I4*(2*mu1);
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 double FENeoHookean::StrainEnergyDensity(FEMaterialPoint& mp)
 {
@@ -52,6 +52,12 @@ public:
 
 	//! calculate strain energy density at material point
 	virtual double StrainEnergyDensity(FEMaterialPoint& pt) override;
+
+	//! calculate stress at a batch of material points
+	void BatchStress(FEMaterialPoint** mp, int npts, mat3ds* s) override;
+
+	//! calculate tangent stiffness at a batch of material points
+	void BatchTangent(FEMaterialPoint** mp, int npts, tens4ds* c) override;
     
     //! calculate the 2nd Piola-Kirchhoff stress at material point
     mat3ds PK2Stress(FEMaterialPoint& pt, const mat3ds E) override;
@@ -59,6 +65,10 @@ public:
     //! calculate material tangent stiffness at material point
     tens4dmm MaterialTangent(FEMaterialPoint& pt, const mat3ds E) override;
     
+private:
+	// gather the kinematics and Lame parameters of a batch of points
+	void GatherBatch(FEMaterialPoint** mp, int npts, double* J, double* lam, double* mu, double (*b)[BATCH_SIZE]);
+
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
 };
@@ -80,7 +80,18 @@ mat3ds FEOgdenMaterial::DevStress(FEMaterialPoint &mp)
 {
     // extract elastic material data
     FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
-    
+
+    // evaluate coefficients at material point
+    double c[MAX_TERMS] = { 0 };
+    for (int i = 0; i < MAX_TERMS; ++i) c[i] = m_c[i](mp);
+
+    return DevStress(pt, c);
+}
+
+//-----------------------------------------------------------------------------
+//! Calculates the Cauchy stress for given coefficients
+mat3ds FEOgdenMaterial::DevStress(const FEElasticMaterialPoint& pt, const double* c)
+{
     // jacobian
     double J = pt.m_J;
     
@@ -98,9 +109,6 @@ mat3ds FEOgdenMaterial::DevStress(FEMaterialPoint &mp)
     lam[1] = sqrt(lam2[1]);
     lam[2] = sqrt(lam2[2]);
 
-    double c[MAX_TERMS] = { 0 };
-    for (int i = 0; i < MAX_TERMS; ++i) c[i] = m_c[i](mp);
-    
     // stress
     mat3ds s;
     s.zero();
@@ -119,10 +127,21 @@ mat3ds FEOgdenMaterial::DevStress(FEMaterialPoint &mp)
 //! Calculates the spatial tangent
 tens4ds FEOgdenMaterial::DevTangent(FEMaterialPoint& mp)
 {
-    int i,j,k;
-    
     // extract elastic material data
     FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+
+    // evaluate coefficients at material point
+    double ci[MAX_TERMS] = { 0 };
+    for (int i = 0; i < MAX_TERMS; ++i) ci[i] = m_c[i](mp);
+
+    return DevTangent(pt, ci);
+}
+
+//-----------------------------------------------------------------------------
+//! Calculates the spatial tangent for given coefficients
+tens4ds FEOgdenMaterial::DevTangent(const FEElasticMaterialPoint& pt, const double* ci)
+{
+    int i,j,k;
     
     // jacobian
     double J = pt.m_J;
@@ -152,10 +171,6 @@ tens4ds FEOgdenMaterial::DevTangent(FEMaterialPoint& mp)
         lamp[2][j] = pow(lam[2], m_m[j]);
     }
 
-    // evaluate coefficients at material points
-    double ci[MAX_TERMS] = { 0 };
-    for (int i = 0; i < MAX_TERMS; ++i) ci[i] = m_c[i](mp);
-    
     // principal stresses
     mat3ds s;
     s.zero();
@@ -206,6 +221,46 @@ tens4ds FEOgdenMaterial::DevTangent(FEMaterialPoint& mp)
     return c;
 }
 
+//-----------------------------------------------------------------------------
+//! Evaluate the coefficients of a batch of material points. When all coefficients
+//! are constant they are evaluated once and the same array is used for all points.
+bool FEOgdenMaterial::BatchCoefficients(FEMaterialPoint& mp, double* c)
+{
+    bool bconst = true;
+    for (int j = 0; j < MAX_TERMS; ++j)
+    {
+        c[j] = m_c[j](mp);
+        if (m_c[j].isConst() == false) bconst = false;
+    }
+    return bconst;
+}
+
+//-----------------------------------------------------------------------------
+void FEOgdenMaterial::BatchDevStress(FEMaterialPoint** mp, int npts, mat3ds* s)
+{
+    if (npts <= 0) return;
+    double c[MAX_TERMS];
+    bool bconst = BatchCoefficients(*mp[0], c);
+    for (int i = 0; i < npts; ++i)
+    {
+        if ((i > 0) && (bconst == false)) BatchCoefficients(*mp[i], c);
+        s[i] = DevStress(*mp[i]->ExtractData<FEElasticMaterialPoint>(), c);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void FEOgdenMaterial::BatchDevTangent(FEMaterialPoint** mp, int npts, tens4ds* c)
+{
+    if (npts <= 0) return;
+    double ci[MAX_TERMS];
+    bool bconst = BatchCoefficients(*mp[0], ci);
+    for (int i = 0; i < npts; ++i)
+    {
+        if ((i > 0) && (bconst == false)) BatchCoefficients(*mp[i], ci);
+        c[i] = DevTangent(*mp[i]->ExtractData<FEElasticMaterialPoint>(), ci);
+    }
+}
+
 //-----------------------------------------------------------------------------
 double FEOgdenMaterial::DevStrainEnergyDensity(FEMaterialPoint& mp)
 {
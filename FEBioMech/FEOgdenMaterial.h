@@ -45,9 +45,18 @@ public:
 
 	//! calculate the deviatoric strain energy density
 	double DevStrainEnergyDensity(FEMaterialPoint& pt) override;
+
+	//! calculate the deviatoric stress at a batch of material points
+	void BatchDevStress(FEMaterialPoint** mp, int npts, mat3ds* s) override;
+
+	//! calculate the deviatoric tangent at a batch of material points
+	void BatchDevTangent(FEMaterialPoint** mp, int npts, tens4ds* c) override;
     
 protected:
 	void EigenValues(mat3ds& A, double l[3], vec3d r[3], const double eps = 0);
+	mat3ds DevStress(const FEElasticMaterialPoint& pt, const double* c);
+	tens4ds DevTangent(const FEElasticMaterialPoint& pt, const double* ci);
+	bool BatchCoefficients(FEMaterialPoint& mp, double* c);
 	double	m_eps;
 
 public:
@@ -305,6 +305,20 @@ void FERigidSolver::PrepStep(const FETimeInfo& timeInfo, vector<double>& ui)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// see if any of the nodes is attached to a rigid body
+bool FERigidSolver::HasRigidNodes(const vector<int>& en)
+{
+	if ((m_fem == nullptr) || (m_fem->RigidBodies() == 0)) return false;
+
+	FEMesh& mesh = m_fem->GetMesh();
+	for (int n : en)
+	{
+		if ((n >= 0) && (mesh.Node(n).m_rid >= 0)) return true;
+	}
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 //! This function calculates the rigid stiffness matrices
 void FERigidSolver::RigidStiffness(SparseMatrix& K, vector<double>& ui, vector<double>& F, const FEElementMatrix& ke, double alpha)
@@ -62,6 +62,9 @@ public:
 	// This is called at the start of each time step
 	void PrepStep(const FETimeInfo& timeInfo, vector<double>& ui);
 
+	// see if any of the nodes is attached to a rigid body
+	bool HasRigidNodes(const std::vector<int>& en);
+
 	// correct stiffness matrix for rigid bodies
 	void RigidStiffness(SparseMatrix& K, std::vector<double>& ui, std::vector<double>& F, const FEElementMatrix& ke, double alpha);
 
@@ -109,7 +109,13 @@ void FESlidingElasticSurface::Data::Serialize(DumpStream& ar)
 
 FESlidingElasticSurface::FESlidingElasticSurface(FEModel* pfem) : FEContactSurface(pfem)
 {
-    
+    m_np = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FESlidingElasticSurface::~FESlidingElasticSurface()
+{
+    delete m_np;
 }
 
 //-----------------------------------------------------------------------------
@@ -118,6 +124,11 @@ bool FESlidingElasticSurface::Init()
     // initialize surface data first
     if (FEContactSurface::Init() == false) return false;
 
+    // the search structure depends on the surface topology, which changes
+    // when the surface is recreated after mesh refinement
+    delete m_np;
+    m_np = nullptr;
+
 	return true;
 }
 
@@ -485,11 +496,18 @@ void FESlidingElasticInterface::ProjectSurface(FESlidingElasticSurface& ss, FESl
 {
     FEMesh& mesh = GetFEModel()->GetMesh();
     
-    // initialize projection data
-    FENormalProjection np(ms);
+    // The search structure of the secondary surface is kept between updates.
+    // Its topology does not change, so after the first update we only need to
+    // refit its search tree to the new nodal positions.
+    if (ms.m_np == nullptr)
+    {
+        ms.m_np = new FENormalProjection(ms);
+        ms.m_np->SetNeighborSearch(true);
+    }
+    FENormalProjection& np = *ms.m_np;
     np.SetTolerance(m_stol);
     np.SetSearchRadius(m_srad);
-    np.Init();
+    np.Update();
     
     double psf = GetPenaltyScaleFactor();
     
@@ -586,17 +604,16 @@ void FESlidingElasticInterface::ProjectSurface(FESlidingElasticSurface& ss, FESl
             double rs[2] = {0,0};
             if (pme)
             {
-                double g;
-                
-                // see if the ray intersects this element
-                if (ms.Intersect(*pme, r, nu, rs, g, m_stol))
+                if (bupseg)
                 {
-                    data.m_rs[0] = rs[0];
-                    data.m_rs[1] = rs[1];
+                    // see if the ray intersects this element or one of its neighbors
+                    pme = np.ProjectNeighbors(*pme, r, nu, rs);
                 }
                 else
                 {
-                    pme = 0;
+                    // see if the ray intersects this element
+                    double g;
+                    if (ms.Intersect(*pme, r, nu, rs, g, m_stol) == false) pme = 0;
                 }
             }
             
@@ -957,9 +974,13 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
         FESlidingElasticSurface& ss = (np == 0? m_ss : m_ms);
         FESlidingElasticSurface& ms = (np == 0? m_ms : m_ss);
         
+        // contact forces of each primary element (summed after the loop)
+        int NE = ss.Elements();
+        vector<vec3d> Fs(NE, vec3d(0,0,0)), Fm(NE, vec3d(0,0,0));
+        
         // loop over all primary elements
-        //#pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hm, N)
-        for (int i=0; i<ss.Elements(); ++i)
+#pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hm, N) schedule(dynamic)
+        for (int i=0; i<NE; ++i)
         {
             // get the surface element
             FESurfaceElement& se = ss.Element(i);
@@ -1068,12 +1089,12 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
                         // calculate contact forces
                         for (int k=0; k<nseln; ++k)
                         {
-                            ss.m_Ft += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
+                            Fs[i] += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
                         }
                         
                         for (int k = 0; k<nmeln; ++k)
                         {
-                            ms.m_Ft += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
+                            Fm[i] += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
                         }
                         
                         // assemble the global residual
@@ -1082,6 +1103,12 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
                 }
             }
         }
+        
+        for (int i=0; i<NE; ++i)
+        {
+            ss.m_Ft += Fs[i];
+            ms.m_Ft += Fm[i];
+        }
     }
 }
 
@@ -1109,7 +1136,7 @@ void FESlidingElasticInterface::StiffnessMatrix(FELinearSystem& LS, const FETime
         FESlidingElasticSurface& ms = (np == 0? m_ms : m_ss);
         
         // loop over all primary elements
-        //#pragma omp parallel for private(detJ, w, Hm, N, sLM, mLM, LM, en, ke)
+#pragma omp parallel for private(detJ, w, Hm, N, sLM, mLM, LM, en, ke) shared(LS) schedule(dynamic)
         for (int i=0; i<ss.Elements(); ++i)
         {
             // get ths primary element
@@ -30,6 +30,8 @@ SOFTWARE.*/
 #include "FEContactInterface.h"
 #include "FEContactSurface.h"
 
+class FENormalProjection;
+
 // Elastic sliding contact, reducing the algorithm of biphasic sliding contact
 // (FESlidingInterface2) to elastic case.  The algorithm derives from Bonet
 // & Wood's treatment of surface pressures
@@ -64,6 +66,9 @@ public:
 public:
     //! constructor
     FESlidingElasticSurface(FEModel* pfem);
+
+    //! destructor
+    ~FESlidingElasticSurface();
     
     //! initialization
     bool Init() override;
@@ -93,6 +98,8 @@ public:
      
 public:
     vec3d    m_Ft;     //!< total contact force (from equivalent nodal forces)
+
+    FENormalProjection*  m_np;  //!< search structure, used when this is the secondary surface
 };
 
 //-----------------------------------------------------------------------------
@@ -30,6 +30,8 @@ SOFTWARE.*/
 #include "FESolidSolver.h"
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FEModel.h>
+#include <chrono>
+using namespace std::chrono;
 
 FESolidLinearSystem::FESolidLinearSystem(FESolver* solver, FERigidSolver* rigidSolver, FEGlobalMatrix& K, std::vector<double>& F, std::vector<double>& u, bool bsymm, double alpha, int nreq) : FELinearSystem(solver, K, F, u, bsymm)
 {
@@ -57,6 +59,8 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 	}
 	else
 	{
+		time_point<steady_clock> t0 = steady_clock::now();
+
 		// assemble into global stiffness matrix
 		if (m_stiffnessScale == 1.0)
 		{
@@ -109,8 +113,12 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 						if (I >= 0)
 						{
 							// dof i is not a prescribed degree of freedom
-							#pragma omp atomic
-							m_F[I] -= ke[i][j] * ui[J];
+							if (m_blockFree) m_F[I] -= ke[i][j] * ui[J];
+							else
+							{
+								#pragma omp atomic
+								m_F[I] -= ke[i][j] * ui[J];
+							}
 						}
 					}
 
@@ -121,7 +129,12 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 		}
 
 		// see if there are any rigid body dofs here
-		#pragma omp critical 
-		m_rigidSolver->RigidStiffness(m_K, m_u, m_F, ke, m_alpha);
+		if (m_rigidSolver->HasRigidNodes(ke.Nodes()))
+		{
+			#pragma omp critical 
+			m_rigidSolver->RigidStiffness(m_K, m_u, m_F, ke, m_alpha);
+		}
+
+		AddAssemblyTime(duration_cast<dseconds>(steady_clock::now() - t0).count());
 	}
 }
@@ -57,6 +57,36 @@ tens4dmm FESolidMaterial::SolidTangent(FEMaterialPoint& mp)
 	return (UseSecantTangent() ? SecantTangent(mp) : Tangent(mp));
 }
 
+//-----------------------------------------------------------------------------
+void FESolidMaterial::BatchStress(FEMaterialPoint** mp, int npts, mat3ds* s)
+{
+	for (int i = 0; i < npts; ++i) s[i] = Stress(*mp[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FESolidMaterial::BatchTangent(FEMaterialPoint** mp, int npts, tens4ds* c)
+{
+	for (int i = 0; i < npts; ++i) c[i] = Tangent(*mp[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FESolidMaterial::BatchSolidTangent(FEMaterialPoint** mp, int npts, tens4dmm* c)
+{
+	if (UseSecantTangent())
+	{
+		for (int i = 0; i < npts; ++i) c[i] = SecantTangent(*mp[i]);
+		return;
+	}
+
+	tens4ds cs[BATCH_SIZE];
+	for (int i0 = 0; i0 < npts; i0 += BATCH_SIZE)
+	{
+		int n = (npts - i0 < BATCH_SIZE ? npts - i0 : BATCH_SIZE);
+		BatchTangent(mp + i0, n, cs);
+		for (int i = 0; i < n; ++i) c[i0 + i] = cs[i];
+	}
+}
+
 //-----------------------------------------------------------------------------
 mat3ds FESolidMaterial::SecantStress(FEMaterialPoint& pt, bool PK2)
 {
@@ -70,6 +70,25 @@ public:
 	virtual mat3ds SecantStress(FEMaterialPoint& pt, bool PK2 = false);
 	virtual bool UseSecantTangent() { return false; }
 
+public:
+	// Batched evaluation of the stress and tangent at npts material points.
+	// The default implementations evaluate the points one at a time. Materials
+	// can override these to hoist parameter evaluation out of the loop and to
+	// evaluate the constitutive relation on structure-of-arrays buffers.
+
+	//! calculate the stress at a batch of material points
+	virtual void BatchStress(FEMaterialPoint** mp, int npts, mat3ds* s);
+
+	//! calculate the tangent at a batch of material points
+	virtual void BatchTangent(FEMaterialPoint** mp, int npts, tens4ds* c);
+
+	//! batched version of SolidTangent
+	void BatchSolidTangent(FEMaterialPoint** mp, int npts, tens4dmm* c);
+
+protected:
+	//! number of points that batched implementations process at once
+	enum { BATCH_SIZE = 32 };
+
 protected:
 	FEParamDouble	m_density;	//!< material density
 
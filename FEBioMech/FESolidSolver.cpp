@@ -46,6 +46,7 @@ SOFTWARE.*/
 #include <FECore/FENLConstraint.h>
 #include <FECore/FESurfaceLoad.h>
 #include <FECore/FEBodyLoad.h>
+#include <FECore/FEProfiler.h>
 #include <assert.h>
 #include "FEBioMech.h"
 #include "FESolidAnalysis.h"
@@ -225,7 +226,11 @@ void FESolidSolver::UpdateKinematics(vector<double>& ui)
 	for (int i = 0; i<nbcs; ++i)
 	{
 		FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-		if (bc.IsActive()) bc.Update();
+		if (bc.IsActive())
+		{
+			TRACK_COMPONENT(&bc, "Update");
+			bc.Update();
+		}
 	}
 
 	// enforce the linear constraints
@@ -319,7 +324,11 @@ void FESolidSolver::PrepStep()
 	for (int i = 0; i<nbc; ++i)
 	{
 		FEBoundaryCondition& dc = *fem.BoundaryCondition(i);
-		if (dc.IsActive()) dc.PrepStep(ui);
+		if (dc.IsActive())
+		{
+			TRACK_COMPONENT(&dc, "PrepStep");
+			dc.PrepStep(ui);
+		}
 	}
 
 	// initialize rigid bodies
@@ -530,6 +539,7 @@ bool FESolidSolver::StiffnessMatrix()
 	for (int i=0; i<mesh.Domains(); ++i) 
 	{
 		FEElasticDomain& dom = dynamic_cast<FEElasticDomain&>(mesh.Domain(i));
+		TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
 		dom.StiffnessMatrix(LS);
 	}
 
@@ -538,7 +548,11 @@ bool FESolidSolver::StiffnessMatrix()
 	for (int j = 0; j<NML; ++j)
 	{
 		FEModelLoad* pml = fem.ModelLoad(j);
-		if (pml->IsActive()) pml->StiffnessMatrix(LS);
+		if (pml->IsActive())
+		{
+			TRACK_COMPONENT(pml, "StiffnessMatrix");
+			pml->StiffnessMatrix(LS);
+		}
 	}
 
 	// Add mass matrix for dynamic problems
@@ -598,7 +612,11 @@ void FESolidSolver::NonLinearConstraintStiffness(FELinearSystem& LS, const FETim
 	for (int i=0; i<N; ++i) 
 	{
 		FENLConstraint* plc = fem.NonlinearConstraint(i);
-		if (plc->IsActive()) plc->StiffnessMatrix(LS, tp);
+		if (plc->IsActive())
+		{
+			TRACK_COMPONENT(plc, "StiffnessMatrix");
+			plc->StiffnessMatrix(LS, tp);
+		}
 	}
 }
 
@@ -612,7 +630,11 @@ void FESolidSolver::ContactStiffness(FELinearSystem& LS)
 	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+		if (pci->IsActive())
+		{
+			TRACK_COMPONENT(pci, "StiffnessMatrix");
+			pci->StiffnessMatrix(LS, tp);
+		}
 	}
 }
 
@@ -625,7 +647,11 @@ void FESolidSolver::ContactForces(FEGlobalVector& R)
 	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->LoadVector(R, tp);
+		if (pci->IsActive())
+		{
+			TRACK_COMPONENT(pci, "LoadVector");
+			pci->LoadVector(R, tp);
+		}
 	}
 }
 
@@ -660,6 +686,7 @@ bool FESolidSolver::Residual(vector<double>& R)
 	for (int i=0; i<mesh.Domains(); ++i)
 	{
 		FEElasticDomain& dom = dynamic_cast<FEElasticDomain&>(mesh.Domain(i));
+		TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
 		dom.InternalForces(RHS);
 	}
 
@@ -667,7 +694,11 @@ bool FESolidSolver::Residual(vector<double>& R)
 	for (int j = 0; j<fem.ModelLoads(); ++j)
 	{
 		FEModelLoad* pml = fem.ModelLoad(j);
-		if (pml->IsActive()) pml->LoadVector(RHS);
+		if (pml->IsActive())
+		{
+			TRACK_COMPONENT(pml, "LoadVector");
+			pml->LoadVector(RHS);
+		}
 	}
 
 	// calculate inertial forces for dynamic problems
@@ -733,7 +764,11 @@ void FESolidSolver::NonLinearConstraintForces(FEGlobalVector& R, const FETimeInf
 	for (int i=0; i<N; ++i) 
 	{
 		FENLConstraint* plc = fem.NonlinearConstraint(i);
-		if (plc->IsActive()) plc->LoadVector(R, tp);
+		if (plc->IsActive())
+		{
+			TRACK_COMPONENT(plc, "LoadVector");
+			plc->LoadVector(R, tp);
+		}
 	}
 }
 
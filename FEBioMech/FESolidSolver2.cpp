@@ -50,6 +50,7 @@ SOFTWARE.*/
 #include <FECore/FEModelLoad.h>
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/vector.h>
+#include <FECore/FEProfiler.h>
 #include "FESolidLinearSystem.h"
 #include "FEBioMech.h"
 #include "FESolidAnalysis.h"
@@ -386,7 +387,11 @@ void FESolidSolver2::UpdateKinematics(vector<double>& ui)
 	for (int i = 0; i<nbcs; ++i)
 	{
 		FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-		if (bc.IsActive()) bc.Update();
+		if (bc.IsActive())
+		{
+			TRACK_COMPONENT(&bc, "Update");
+			bc.Update();
+		}
 	}
 
 	// enforce the linear constraints
@@ -664,7 +669,11 @@ void FESolidSolver2::PrepStep()
 	for (int i=0; i<nbc; ++i)
 	{
 		FEBoundaryCondition& dc = *fem.BoundaryCondition(i);
-		if (dc.IsActive()) dc.PrepStep(ui);
+		if (dc.IsActive())
+		{
+			TRACK_COMPONENT(&dc, "PrepStep");
+			dc.PrepStep(ui);
+		}
 	}
 
 	// do the linear constraints
@@ -1069,6 +1078,7 @@ bool FESolidSolver2::StiffnessMatrix()
 		if (mesh.Domain(i).IsActive()) 
 		{
 			FEElasticDomain& dom = dynamic_cast<FEElasticDomain&>(mesh.Domain(i));
+			TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
 			dom.StiffnessMatrix(LS);
 		}
 	}
@@ -1077,7 +1087,11 @@ bool FESolidSolver2::StiffnessMatrix()
 	for (int j = 0; j<fem.ModelLoads(); ++j)
 	{
 		FEModelLoad* pml = fem.ModelLoad(j);
-		if (pml->IsActive()) pml->StiffnessMatrix(LS);
+		if (pml->IsActive())
+		{
+			TRACK_COMPONENT(pml, "StiffnessMatrix");
+			pml->StiffnessMatrix(LS);
+		}
 	}
     
     // TODO: add body force stiffness for rigid bodies
@@ -1138,7 +1152,11 @@ void FESolidSolver2::NonLinearConstraintStiffness(FELinearSystem& LS, const FETi
 	for (int i=0; i<N; ++i) 
 	{
 		FENLConstraint* plc = fem.NonlinearConstraint(i);
-		if (plc->IsActive()) plc->StiffnessMatrix(LS, tp);
+		if (plc->IsActive())
+		{
+			TRACK_COMPONENT(plc, "StiffnessMatrix");
+			plc->StiffnessMatrix(LS, tp);
+		}
 	}
 }
 
@@ -1152,7 +1170,11 @@ void FESolidSolver2::ContactStiffness(FELinearSystem& LS)
 	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+		if (pci->IsActive())
+		{
+			TRACK_COMPONENT(pci, "StiffnessMatrix");
+			pci->StiffnessMatrix(LS, tp);
+		}
 	}
 }
 
@@ -1165,7 +1187,11 @@ void FESolidSolver2::ContactForces(FEGlobalVector& R)
 	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->LoadVector(R, tp);
+		if (pci->IsActive())
+		{
+			TRACK_COMPONENT(pci, "LoadVector");
+			pci->LoadVector(R, tp);
+		}
 	}
 }
 
@@ -1264,7 +1290,11 @@ void FESolidSolver2::InternalForces(FEGlobalVector& R)
 	for (int i = 0; i<mesh.Domains(); ++i)
 	{
 		FEElasticDomain* edom = dynamic_cast<FEElasticDomain*>(&mesh.Domain(i));
-		if (edom) edom->InternalForces(R);
+		if (edom)
+		{
+			TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
+			edom->InternalForces(R);
+		}
 	}
 }
 
@@ -1280,7 +1310,11 @@ void FESolidSolver2::ExternalForces(FEGlobalVector& RHS)
 	for (int j = 0; j<fem.ModelLoads(); ++j)
 	{
 		FEModelLoad* pml = fem.ModelLoad(j);
-		if (pml->IsActive()) pml->LoadVector(RHS);
+		if (pml->IsActive())
+		{
+			TRACK_COMPONENT(pml, "LoadVector");
+			pml->LoadVector(RHS);
+		}
 	}
 
 	// calculate inertial forces for dynamic problems
@@ -1355,6 +1389,10 @@ void FESolidSolver2::NonLinearConstraintForces(FEGlobalVector& R, const FETimeIn
 	for (int i=0; i<N; ++i) 
 	{
 		FENLConstraint* plc = fem.NonlinearConstraint(i);
-		if (plc->IsActive()) plc->LoadVector(R, tp);
+		if (plc->IsActive())
+		{
+			TRACK_COMPONENT(plc, "LoadVector");
+			plc->LoadVector(R, tp);
+		}
 	}
 }
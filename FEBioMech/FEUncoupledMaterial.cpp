@@ -120,6 +120,63 @@ tens4ds FEUncoupledMaterial::Tangent(FEMaterialPoint &mp)
 	return DevTangent(mp) + (IxI - I4*2)*pt.m_p + IxI*(UJJ(pt.m_J)*pt.m_J);
 }
 
+//-----------------------------------------------------------------------------
+//! Batched version of Stress. The pressure is evaluated here and the deviatoric
+//! stress is delegated to BatchDevStress, which materials can override.
+void FEUncoupledMaterial::BatchStress(FEMaterialPoint** mp, int npts, mat3ds* s)
+{
+	for (int i = 0; i < npts; ++i)
+	{
+		FEElasticMaterialPoint& pt = *mp[i]->ExtractData<FEElasticMaterialPoint>();
+		pt.m_p = UJ(pt.m_J);
+	}
+
+	BatchDevStress(mp, npts, s);
+
+	for (int i = 0; i < npts; ++i)
+	{
+		FEElasticMaterialPoint& pt = *mp[i]->ExtractData<FEElasticMaterialPoint>();
+		s[i] = mat3dd(pt.m_p) + s[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Batched version of Tangent.
+void FEUncoupledMaterial::BatchTangent(FEMaterialPoint** mp, int npts, tens4ds* c)
+{
+	for (int i = 0; i < npts; ++i)
+	{
+		FEElasticMaterialPoint& pt = *mp[i]->ExtractData<FEElasticMaterialPoint>();
+		pt.m_p = UJ(pt.m_J);
+	}
+
+	BatchDevTangent(mp, npts, c);
+
+	// 4th-order identity tensors
+	mat3dd I(1);
+	tens4ds IxI = dyad1s(I);
+	tens4ds I4  = dyad4s(I);
+	tens4ds IxI_I4 = IxI - I4*2;
+
+	for (int i = 0; i < npts; ++i)
+	{
+		FEElasticMaterialPoint& pt = *mp[i]->ExtractData<FEElasticMaterialPoint>();
+		c[i] = c[i] + IxI_I4*pt.m_p + IxI*(UJJ(pt.m_J)*pt.m_J);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEUncoupledMaterial::BatchDevStress(FEMaterialPoint** mp, int npts, mat3ds* s)
+{
+	for (int i = 0; i < npts; ++i) s[i] = DevStress(*mp[i]);
+}
+
+//-----------------------------------------------------------------------------
+void FEUncoupledMaterial::BatchDevTangent(FEMaterialPoint** mp, int npts, tens4ds* c)
+{
+	for (int i = 0; i < npts; ++i) c[i] = DevTangent(*mp[i]);
+}
+
 //-----------------------------------------------------------------------------
 //! The strain energy density function calculates the total sed as a sum of
 //! two terms, namely the deviatoric sed and U(J).
@@ -50,6 +50,7 @@ class FEBIOMECH_API ObjectDataRecord : public DataRecord
 public:
 	ObjectDataRecord(FEModel* pfem);
 	double Evaluate(int item, int ndata) override;
+	bool ParallelEvaluation() const override { return true; }
 	void SetData(const char* sz) override;
 	void SelectAllItems() override;
 	int Size() const override;
@@ -506,11 +506,7 @@ void FEBiphasicSolidDomain::ElementInternalForceSS(FESolidElement& el, vector<do
 void FEBiphasicSolidDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 {
 	// repeat over all solid elements
-	int NE = (int)m_Elem.size();
-    
-    #pragma omp parallel for shared(NE)
-	for (int iel=0; iel<NE; ++iel)
-	{
+	AssembleElements(LS, [&](int iel) {
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
@@ -532,18 +528,14 @@ void FEBiphasicSolidDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
-	}
+	});
 }
 
 //-----------------------------------------------------------------------------
 void FEBiphasicSolidDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 {
 	// repeat over all solid elements
-	int NE = (int)m_Elem.size();
-
-	#pragma omp parallel for shared(NE)
-	for (int iel=0; iel<NE; ++iel)
-	{
+	AssembleElements(LS, [&](int iel) {
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
@@ -565,7 +557,7 @@ void FEBiphasicSolidDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 
 		// assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
-	}
+	});
 }
 
 //-----------------------------------------------------------------------------
@@ -41,6 +41,7 @@ SOFTWARE.*/
 #include <FECore/FENodalLoad.h>
 #include <FECore/FESurfaceLoad.h>
 #include "FECore/sys.h"
+#include "FECore/FEProfiler.h"
 #include "FEBiphasicSoluteAnalysis.h"
 
 //-----------------------------------------------------------------------------
@@ -411,6 +412,7 @@ bool FEBiphasicSoluteSolver::Residual(vector<double>& R)
 	// internal stress work
 	for (i=0; i<mesh.Domains(); ++i)
 	{
+        TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
         FEDomain& dom = mesh.Domain(i);
         FEElasticDomain* ped = dynamic_cast<FEElasticDomain*>(&dom);
         FEBiphasicDomain*  pbd = dynamic_cast<FEBiphasicDomain* >(&dom);
@@ -456,6 +458,7 @@ bool FEBiphasicSoluteSolver::Residual(vector<double>& R)
 		FEModelLoad& mli = *fem.ModelLoad(i);
 		if (mli.IsActive())
 		{
+			TRACK_COMPONENT(&mli, "LoadVector");
 			mli.LoadVector(RHS);
 		}
 	}
@@ -502,6 +505,7 @@ bool FEBiphasicSoluteSolver::StiffnessMatrix()
 	{
 		for (int i=0; i<mesh.Domains(); ++i) 
 		{
+            TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
             // Biphasic-solute analyses may also include biphasic and elastic domains
 			FETriphasicDomain*      ptdom = dynamic_cast<FETriphasicDomain*>(&mesh.Domain(i));
 			FEBiphasicSoluteDomain* psdom = dynamic_cast<FEBiphasicSoluteDomain*>(&mesh.Domain(i));
@@ -517,6 +521,7 @@ bool FEBiphasicSoluteSolver::StiffnessMatrix()
 	{
 		for (int i = 0; i<mesh.Domains(); ++i)
 		{
+            TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
             // Biphasic-solute analyses may also include biphasic and elastic domains
 			FETriphasicDomain*      ptdom = dynamic_cast<FETriphasicDomain*>(&mesh.Domain(i));
 			FEBiphasicSoluteDomain* psdom = dynamic_cast<FEBiphasicSoluteDomain*>(&mesh.Domain(i));
@@ -540,7 +545,11 @@ bool FEBiphasicSoluteSolver::StiffnessMatrix()
 	for (int i = 0; i<nml; ++i)
 	{
 		FEModelLoad* pml = fem.ModelLoad(i);
-		if (pml->IsActive()) pml->StiffnessMatrix(LS);
+		if (pml->IsActive())
+		{
+			TRACK_COMPONENT(pml, "StiffnessMatrix");
+			pml->StiffnessMatrix(LS);
+		}
 	}
 
 	// calculate nonlinear constraint stiffness
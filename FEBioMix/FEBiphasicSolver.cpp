@@ -45,6 +45,7 @@ SOFTWARE.*/
 #include <FECore/FENodalLoad.h>
 #include <FECore/FEAnalysis.h>
 #include <FECore/FEBoundaryCondition.h>
+#include <FECore/FEProfiler.h>
 #include "FEBiphasicAnalysis.h"
 
 //-----------------------------------------------------------------------------
@@ -378,6 +379,7 @@ bool FEBiphasicSolver::Residual(vector<double>& R)
 	{
 		for (int i=0; i<mesh.Domains(); ++i)
 		{
+			TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
 			FEBiphasicDomain* pdom = dynamic_cast<FEBiphasicDomain*>(&mesh.Domain(i));
 			if (pdom) pdom->InternalForcesSS(RHS);
             else
@@ -391,6 +393,7 @@ bool FEBiphasicSolver::Residual(vector<double>& R)
 	{
 		for (int i=0; i<mesh.Domains(); ++i)
 		{
+			TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
 			FEBiphasicDomain* pdom = dynamic_cast<FEBiphasicDomain*>(&mesh.Domain(i));
 			if (pdom) pdom->InternalForces(RHS);
             else
@@ -414,7 +417,11 @@ bool FEBiphasicSolver::Residual(vector<double>& R)
 	for (int i=0; i<NML; ++i)
 	{
 		FEModelLoad& mli = *fem.ModelLoad(i);
-		if (mli.IsActive()) mli.LoadVector(RHS);
+		if (mli.IsActive())
+		{
+			TRACK_COMPONENT(&mli, "LoadVector");
+			mli.LoadVector(RHS);
+		}
 	}
 
 	// set the nodal reaction forces
@@ -459,6 +466,7 @@ bool FEBiphasicSolver::StiffnessMatrix()
 	{
 		for (int i=0; i<mesh.Domains(); ++i) 
 		{
+			TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
             // Biphasic analyses may include biphasic and elastic domains
 			FEBiphasicDomain* pbdom = dynamic_cast<FEBiphasicDomain*>(&mesh.Domain(i));
 			if (pbdom) pbdom->StiffnessMatrixSS(LS, bsymm);
@@ -473,6 +481,7 @@ bool FEBiphasicSolver::StiffnessMatrix()
 	{
 		for (int i=0; i<mesh.Domains(); ++i) 
 		{
+			TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
             // Biphasic analyses may include biphasic and elastic domains
 			FEBiphasicDomain* pbdom = dynamic_cast<FEBiphasicDomain*>(&mesh.Domain(i));
 			if (pbdom) pbdom->StiffnessMatrix(LS, bsymm);
@@ -492,7 +501,11 @@ bool FEBiphasicSolver::StiffnessMatrix()
 	for (int i=0; i<nml; ++i)
 	{
 		FEModelLoad* pml = fem.ModelLoad(i);
-		if (pml->IsActive()) pml->StiffnessMatrix(LS);
+		if (pml->IsActive())
+		{
+			TRACK_COMPONENT(pml, "StiffnessMatrix");
+			pml->StiffnessMatrix(LS);
+		}
 	}
 
 	// calculate nonlinear constraint stiffness
@@ -49,6 +49,7 @@ SOFTWARE.*/
 #include <FECore/FEAnalysis.h>
 #include <FECore/FENodalLoad.h>
 #include <FECore/FEBoundaryCondition.h>
+#include <FECore/FEProfiler.h>
 #include "FEMultiphasicAnalysis.h"
 
 //-----------------------------------------------------------------------------
@@ -460,6 +461,7 @@ bool FEMultiphasicSolver::Residual(vector<double>& R)
 	// internal stress work
 	for (i=0; i<mesh.Domains(); ++i)
 	{
+        TRACK_COMPONENT(&mesh.Domain(i), "InternalForces");
         FEDomain& dom = mesh.Domain(i);
         FEElasticDomain* ped = dynamic_cast<FEElasticDomain*>(&dom);
         FEBiphasicDomain*  pbd = dynamic_cast<FEBiphasicDomain* >(&dom);
@@ -499,7 +501,11 @@ bool FEMultiphasicSolver::Residual(vector<double>& R)
 	for (i = 0; i < NML; ++i)
 	{
 		FEModelLoad& mli = *fem.ModelLoad(i);
-		if (mli.IsActive()) mli.LoadVector(RHS);
+		if (mli.IsActive())
+		{
+			TRACK_COMPONENT(&mli, "LoadVector");
+			mli.LoadVector(RHS);
+		}
 	}
 
 	// calculate contact forces
@@ -551,6 +557,7 @@ bool FEMultiphasicSolver::StiffnessMatrix()
 	{
 		for (int i=0; i<mesh.Domains(); ++i) 
 		{
+			TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
 			FEDomain& dom = mesh.Domain(i);
 			FEElasticDomain*        pde = dynamic_cast<FEElasticDomain*  >(&dom);
 			FEBiphasicDomain*       pbd = dynamic_cast<FEBiphasicDomain* >(&dom);
@@ -569,6 +576,7 @@ bool FEMultiphasicSolver::StiffnessMatrix()
 	{
 		for (int i = 0; i<mesh.Domains(); ++i)
 		{
+			TRACK_COMPONENT(&mesh.Domain(i), "StiffnessMatrix");
 			FEDomain& dom = mesh.Domain(i);
 			FEElasticDomain*        pde = dynamic_cast<FEElasticDomain*  >(&dom);
 			FEBiphasicDomain*       pbd = dynamic_cast<FEBiphasicDomain* >(&dom);
@@ -592,7 +600,11 @@ bool FEMultiphasicSolver::StiffnessMatrix()
 	for (int i = 0; i<nsl; ++i)
 	{
 		FEModelLoad* pml = fem.ModelLoad(i);
-		if (pml->IsActive()) pml->StiffnessMatrix(LS);
+		if (pml->IsActive())
+		{
+			TRACK_COMPONENT(pml, "StiffnessMatrix");
+			pml->StiffnessMatrix(LS);
+		}
 	}
 
 	// calculate nonlinear constraint stiffness
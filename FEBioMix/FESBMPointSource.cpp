@@ -34,6 +34,7 @@ SOFTWARE.*/
 #include <FEBioMech/FEElasticMaterialPoint.h>
 #include <iostream>
 #include <unordered_set>
+#include <set>
 #include <unordered_map>
 #include <limits>
 #include <FECore/FEAnalysis.h>
@@ -36,6 +36,7 @@ SOFTWARE.*/
 #include "FEConstrainedLMOptimizeMethod.h"
 #include "FEPowellOptimizeMethod.h"
 #include "FEScanOptimizeMethod.h"
+#include "FEOptimizeData.h"
 
 //-----------------------------------------------------------------------------
 //! Initialization of the FEBioOpt module. This function registers all the classes
@@ -55,3 +56,9 @@ void FEBioOpt::InitModule()
 	REGISTER_FECORE_CLASS(FEPowellOptimizeMethod, "powell");
 	REGISTER_FECORE_CLASS(FEScanOptimizeMethod, "scan");
 }
+
+//-----------------------------------------------------------------------------
+void FEBioOpt::SetModelFactory(FEModel* (*f)(FEModel* fem))
+{
+	FEOptimizeData::SetModelFactory(f);
+}
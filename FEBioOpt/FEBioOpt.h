@@ -26,6 +26,8 @@ SOFTWARE.*/
 #pragma once
 #include "febioopt_api.h"
 
+class FEModel;
+
 //-----------------------------------------------------------------------------
 //! The FEBioOpt module 
 
@@ -35,4 +37,8 @@ namespace FEBioOpt {
 
 	FEBIOOPT_API void InitModule();
 
+	// Set the function that creates a new model from the same input as a given model.
+	// This is needed for running FE solves concurrently during an optimization.
+	FEBIOOPT_API void SetModelFactory(FEModel* (*f)(FEModel* fem));
+
 }
@@ -39,6 +39,7 @@ BEGIN_FECORE_CLASS(FELMOptimizeMethod, FEOptimizeMethod)
 	ADD_PARAMETER(m_fdiff , "f_diff_scale");
 	ADD_PARAMETER(m_nmax  , "max_iter"    );
 	ADD_PARAMETER(m_bcov  , "print_cov"   );
+	ADD_PARAMETER(m_nthreads, FE_RANGE_GREATER_OR_EQUAL(1), "nthreads");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -75,6 +76,7 @@ FELMOptimizeMethod::FELMOptimizeMethod(FEModel* fem) : FEOptimizeMethod(fem)
 	m_fdiff  = 0.001;
 	m_nmax   = 100;
 	m_bcov   = 0;
+	m_nthreads = 1;
 	m_loglevel = LogLevel::LOG_NEVER;
 }
 
@@ -125,6 +127,14 @@ bool FELMOptimizeMethod::Solve(FEOptimizeData *pOpt, vector<double>& amin, vecto
 
 	FEModel* fem = pOpt->GetFEModel();
 
+	// The Jacobian requires a solve for each parameter, which can run concurrently
+	// if we have worker models. (There's no point in using more threads than that.)
+	if (m_nthreads > 1)
+	{
+		int nthreads = (m_nthreads > ma + 1 ? ma + 1 : m_nthreads);
+		opt.CreateWorkers(nthreads);
+	}
+
 	try
 	{
 		// do the first call with lamda to intialize the minimization
@@ -196,30 +206,33 @@ void FELMOptimizeMethod::ObjFun(vector<double>& x, vector<double>& a, vector<dou
 		}
 	}
 	
-	// evaluate at a
-	if (opt.FESolve(a) == false) throw FEErrorTermination();
-	
-	opt.GetObjective().Evaluate(y);
-	m_yopt = y;
-
-	// now calculate the derivatives using forward differences
-	int ndata = (int)x.size();
-	vector<double> a1(a);
-	vector<double> y1(ndata);
+	// setup the parameter sets: a itself, followed by the forward differences
 	int ma = (int)a.size();
+	vector< vector<double> > A(ma + 1, a);
 	for (int i=0; i<ma; ++i)
 	{
 		FEInputParameter& var = *opt.GetInputParameter(i);
 
 		double b = var.ScaleFactor();
 
-		a1[i] = a1[i] + dir*m_fdiff*(fabs(b) + fabs(a[i]));
-		assert(a1[i] != a[i]);
+		A[i + 1][i] = a[i] + dir*m_fdiff*(fabs(b) + fabs(a[i]));
+		assert(A[i + 1][i] != a[i]);
+	}
+
+	// solve them all
+	vector< vector<double> > Y;
+	if (opt.FESolve(A, Y) == false) throw FEErrorTermination();
+
+	// evaluate at a
+	y = Y[0];
+	m_yopt = y;
 
-		if (opt.FESolve(a1) == false) throw FEErrorTermination();
-		opt.GetObjective().Evaluate(y1);
-		for (int j=0; j<ndata; ++j) dyda[j][i] = (y1[j] - y[j])/(a1[i] - a[i]);
-		a1[i] = a[i];
+	// now calculate the derivatives using forward differences
+	int ndata = (int)x.size();
+	for (int i=0; i<ma; ++i)
+	{
+		vector<double>& y1 = Y[i + 1];
+		for (int j=0; j<ndata; ++j) dyda[j][i] = (y1[j] - y[j])/(A[i + 1][i] - a[i]);
 	}
 }
 
@@ -52,6 +52,7 @@ public:
 	double			m_fdiff;	// forward difference step size
 	int				m_nmax;		// maximum number of iterations
 	bool			m_bcov;		// flag to print covariant matrix
+	int				m_nthreads;	// max nr of FE solves that run concurrently
 
 protected:
 	std::vector<double>	m_yopt;	// optimal y-values
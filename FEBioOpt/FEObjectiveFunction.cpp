@@ -70,6 +70,16 @@ double FEObjectiveFunction::Evaluate(vector<double>& y)
 	// evaluate the functions
 	EvaluateFunctions(y);
 
+	// evaluate the objective
+	const vector<double>& yc = y;
+	return Evaluate(yc);
+}
+
+double FEObjectiveFunction::Evaluate(const vector<double>& y)
+{
+	// get the number of measurements
+	int ndata = (int)y.size();
+
 	// get the measurement vector
 	vector<double> y0(ndata);
 	GetMeasurements(y0);
@@ -69,6 +69,9 @@ public:
 	// evaluate objective function
 	double Evaluate();
 
+	// evaluate objective function for function values that were already calculated
+	double Evaluate(const std::vector<double>& y);
+
 	// print output to screen or not
 	void SetVerbose(bool b) { m_verbose = b; }
 
@@ -34,6 +34,7 @@ SOFTWARE.*/
 #include <FECore/FEModel.h>
 #include <FECore/FEAnalysis.h>
 #include <FECore/log.h>
+#include <FECore/sys.h>
 //=============================================================================
 
 //-----------------------------------------------------------------------------
@@ -127,9 +128,18 @@ FEOptimizeData::FEOptimizeData(FEModel* fem) : m_fem(fem)
 //-----------------------------------------------------------------------------
 FEOptimizeData::~FEOptimizeData(void)
 {
+	ClearWorkers();
 	delete m_pSolver;
 }
 
+//-----------------------------------------------------------------------------
+FEOPT_MODEL_FACTORY FEOptimizeData::m_modelFactory = nullptr;
+
+void FEOptimizeData::SetModelFactory(FEOPT_MODEL_FACTORY f)
+{
+	m_modelFactory = f;
+}
+
 //-----------------------------------------------------------------------------
 bool FEOptimizeData::Init()
 {
@@ -215,6 +225,9 @@ bool FEOptimizeData::Input(const char *szfile)
 {
 	FEOptimizeInput in;
 	if (in.Input(szfile, this) == false) return false;
+
+	// store the file name, since we need it to create workers
+	m_szfile = szfile;
 	return true;
 }
 
@@ -267,3 +280,168 @@ bool FEOptimizeData::FESolve(const vector<double>& a)
 
 	return bret;
 }
+
+//-----------------------------------------------------------------------------
+bool FEOptimizeData::SolveModel(const vector<double>& a)
+{
+	GetObjective().Reset();
+
+	int nvar = InputParameters();
+	if (nvar != (int)a.size()) return false;
+	for (int i = 0; i < nvar; ++i) GetInputParameter(i)->SetValue(a[i]);
+
+	FEModel& fem = *GetFEModel();
+	fem.BlockLog();
+	fem.Reset();
+	bool bret = false;
+	try {
+		bret = RunTask();
+	}
+	catch (...)
+	{
+		bret = false;
+	}
+	fem.UnBlockLog();
+
+	return bret;
+}
+
+//-----------------------------------------------------------------------------
+bool FEOptimizeData::FESolve(const vector< vector<double> >& a, vector< vector<double> >& y, vector<double>* fobj)
+{
+	int N = (int)a.size();
+	y.resize(N);
+
+	// figure out which parameter sets still need to be solved
+	vector<int> todo;
+	for (int i = 0; i < N; ++i)
+	{
+		std::map<vector<double>, vector<double> >::iterator it = m_cache.find(a[i]);
+		if (it != m_cache.end()) y[i] = it->second;
+		else
+		{
+			bool bdup = false;
+			for (int j : todo) if (a[j] == a[i]) { bdup = true; break; }
+			if (bdup == false) todo.push_back(i);
+		}
+	}
+	if ((int)todo.size() < N) feLog("\nreusing %d previous solution(s)\n", N - (int)todo.size());
+
+	int nsolve = (int)todo.size();
+	int nthreads = SolverThreads();
+	if (nthreads > nsolve) nthreads = nsolve;
+	if (nthreads <= 1)
+	{
+		// solve them one after another on this model
+		for (int i : todo)
+		{
+			if (FESolve(a[i]) == false) return false;
+			m_fcache[a[i]] = GetObjective().Evaluate(y[i]);
+			m_cache[a[i]] = y[i];
+		}
+	}
+	else
+	{
+		// report the parameter sets that will be solved
+		int nvar = InputParameters();
+		for (int i : todo)
+		{
+			m_niter++;
+			feLog("\n----- Iteration: %d -----\n", m_niter);
+			for (int j = 0; j < nvar; ++j)
+			{
+				string name = GetInputParameter(j)->GetName();
+				feLog("%-15s = %lg\n", name.c_str(), a[i][j]);
+			}
+		}
+
+		// solve them concurrently, one per worker
+		vector<int> status(nsolve, 0);
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+		for (int n = 0; n < nsolve; ++n)
+		{
+			int nt = omp_get_thread_num();
+			FEOptimizeData& opt = (nt == 0 ? *this : *m_workers[nt - 1]);
+
+			int i = todo[n];
+			if (opt.SolveModel(a[i]))
+			{
+				FEObjectiveFunction& obj = opt.GetObjective();
+				y[i].resize(obj.Measurements());
+				obj.EvaluateFunctions(y[i]);
+				status[n] = 1;
+			}
+		}
+
+		// report the results
+		FEObjectiveFunction& obj = GetObjective();
+		for (int n = 0; n < nsolve; ++n)
+		{
+			int i = todo[n];
+			if (status[n] == 0) return false;
+			m_cache[a[i]] = y[i];
+
+			feLog("\nresult of iteration %d:\n", m_niter - nsolve + n + 1);
+			const vector<double>& yi = y[i];
+			m_fcache[a[i]] = obj.Evaluate(yi);
+		}
+	}
+
+	// copy the cached values to the duplicates
+	for (int i = 0; i < N; ++i)
+	{
+		if (y[i].empty()) y[i] = m_cache[a[i]];
+	}
+
+	// return the objective values
+	if (fobj)
+	{
+		fobj->resize(N);
+		for (int i = 0; i < N; ++i) (*fobj)[i] = m_fcache[a[i]];
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEOptimizeData::CreateWorkers(int nthreads)
+{
+	ClearWorkers();
+	if (nthreads <= 1) return true;
+
+	if ((m_modelFactory == nullptr) || m_szfile.empty())
+	{
+		feLogWarning("Concurrent FE solves are not supported in this configuration.");
+		return false;
+	}
+
+	// the first thread uses this model, the others get a copy
+	for (int i = 1; i < nthreads; ++i)
+	{
+		FEModel* fem = m_modelFactory(GetFEModel());
+		if (fem == nullptr) { ClearWorkers(); return false; }
+		m_wfem.push_back(fem);
+
+		FEOptimizeData* opt = new FEOptimizeData(fem);
+		m_workers.push_back(opt);
+		if ((opt->Input(m_szfile.c_str()) == false) || (opt->Init() == false))
+		{
+			feLogError("Failed to create worker model %d.", i);
+			ClearWorkers();
+			return false;
+		}
+	}
+
+	feLog("FE solves will use up to %d threads.\n", nthreads);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEOptimizeData::ClearWorkers()
+{
+	for (FEOptimizeData* opt : m_workers) delete opt;
+	m_workers.clear();
+	for (FEModel* fem : m_wfem) delete fem;
+	m_wfem.clear();
+}
@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FEObjectiveFunction.h"
 #include <vector>
 #include <string>
+#include <map>
 
 //-----------------------------------------------------------------------------
 class FEOptimizeMethod;
@@ -116,6 +117,11 @@ struct OPT_LIN_CONSTRAINT
 	double	b;
 };
 
+//-----------------------------------------------------------------------------
+//! Function that creates a new (uninitialized) model from the same input as the
+//! given model. This is used to create the worker models for concurrent FE solves.
+typedef FEModel* (*FEOPT_MODEL_FACTORY)(FEModel* fem);
+
 //=============================================================================
 //! optimization analyses
 //! 
@@ -141,6 +147,24 @@ public:
 	//! solve the FE problem with a new set of parameters
 	bool FESolve(const std::vector<double>& a);
 
+	//! Solve the FE problem for several parameter sets and evaluate the objective
+	//! functions. The solves are distributed over the worker models (if any) and
+	//! parameter sets that were solved before are taken from the cache. If fobj is
+	//! not null, it returns the objective values (as calculated by FEObjectiveFunction::Evaluate).
+	bool FESolve(const std::vector< std::vector<double> >& a, std::vector< std::vector<double> >& y, std::vector<double>* fobj = nullptr);
+
+public:
+	//! Create worker models so that FE solves can run on (at most) nthreads threads.
+	//! Returns false if the workers could not be created, in which case all solves 
+	//! remain serial.
+	bool CreateWorkers(int nthreads);
+
+	//! number of threads that can run FE solves concurrently
+	int SolverThreads() const { return (int)m_workers.size() + 1; }
+
+	//! set the function that creates worker models
+	static void SetModelFactory(FEOPT_MODEL_FACTORY f);
+
 public:
 	// return the number of input parameters
 	int InputParameters() { return (int)m_Var.size(); }
@@ -185,4 +209,22 @@ protected:
 
 	std::vector<FEInputParameter*>	    m_Var;
 	std::vector<OPT_LIN_CONSTRAINT>		m_LinCon;
+
+private:
+	// solve the FE problem without reporting anything
+	bool SolveModel(const std::vector<double>& a);
+
+	// clear the worker models
+	void ClearWorkers();
+
+private:
+	std::string		m_szfile;	//!< optimization input file
+
+	std::vector<FEOptimizeData*>	m_workers;	//!< worker copies of this optimization
+	std::vector<FEModel*>			m_wfem;		//!< models of the worker copies
+
+	std::map<std::vector<double>, std::vector<double> >	m_cache;	//!< function values of parameter sets solved so far
+	std::map<std::vector<double>, double>				m_fcache;	//!< objective values of parameter sets solved so far
+
+	static FEOPT_MODEL_FACTORY	m_modelFactory;
 };
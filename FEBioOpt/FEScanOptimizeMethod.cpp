@@ -32,19 +32,18 @@ SOFTWARE.*/
 #include "FECore/log.h"
 
 BEGIN_FECORE_CLASS(FEScanOptimizeMethod, FEOptimizeMethod)
-
+	ADD_PARAMETER(m_nthreads, FE_RANGE_GREATER_OR_EQUAL(1), "nthreads");
 END_FECORE_CLASS();
 
 FEScanOptimizeMethod::FEScanOptimizeMethod(FEModel* fem) : FEOptimizeMethod(fem)
 {
-
+	m_nthreads = 1;
 }
 
 bool FEScanOptimizeMethod::Solve(FEOptimizeData* pOpt, vector<double>& amin, vector<double>& ymin, double* minObj)
 {
 	if (pOpt == 0) return false;
 	FEOptimizeData& opt = *pOpt;
-	FEObjectiveFunction& obj = opt.GetObjective();
 
 	// set the intial values for the variables
 	int ma = opt.InputParameters();
@@ -55,25 +54,19 @@ bool FEScanOptimizeMethod::Solve(FEOptimizeData* pOpt, vector<double>& amin, vec
 		a[i] = var->MinValue();
 	}
 
+	if (m_nthreads > 1) opt.CreateWorkers(m_nthreads);
+
+	// the parameter sets are solved in batches, one per thread
+	int nbatch = opt.SolverThreads();
+	vector< vector<double> > A, Y;
+	vector<double> F;
+
 	// loop until done
-	vector<double> y(ma, 0.0);
 	bool bdone = false;
 	double fmin = 0.0;
 	do
 	{
-		// solve the problem with the new input parameters
-		if (opt.FESolve(a) == false) return false;
-
-		// calculate objective function
-		double fobj = obj.Evaluate(y);
-
-		// update minimum
-		if ((fmin == 0.0) || (fobj < fmin))
-		{
-			fmin = fobj;
-			amin = a;
-			ymin = y;
-		}
+		A.push_back(a);
 
 		// update indices
 		for (int i=0; i<ma; ++i)
@@ -84,6 +77,28 @@ bool FEScanOptimizeMethod::Solve(FEOptimizeData* pOpt, vector<double>& amin, vec
 			else if (i<ma-1) a[i] = vi.MinValue();
 			else { bdone = true; }
 		}
+
+		if (((int)A.size() == nbatch) || bdone)
+		{
+			// solve the problem with the new input parameters
+			// (this also evaluates the objective function)
+			if (opt.FESolve(A, Y, &F) == false) return false;
+
+			for (int n = 0; n < (int)A.size(); ++n)
+			{
+				vector<double>& y = Y[n];
+				double fobj = F[n];
+
+				// update minimum
+				if ((fmin == 0.0) || (fobj < fmin))
+				{
+					fmin = fobj;
+					amin = A[n];
+					ymin = y;
+				}
+			}
+			A.clear();
+		}
 	}
 	while (!bdone);
 
@@ -42,5 +42,8 @@ public:
 	// returns the optimal objective function value in minObj
 	bool Solve(FEOptimizeData* pOpt, vector<double>& amin, vector<double>& ymin, double* minObj) override;
 
+public:
+	int		m_nthreads;	// max nr of FE solves that run concurrently
+
 	DECLARE_FECORE_CLASS();
 };
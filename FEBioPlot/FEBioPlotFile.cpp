@@ -35,6 +35,7 @@ SOFTWARE.*/
 #include <FECore/FESurface.h>
 #include <FECore/FEPlotDataStore.h>
 #include <FECore/log.h>
+#include <FECore/FEProfiler.h>
 
 FEBioPlotFile::DICTIONARY_ITEM::DICTIONARY_ITEM()
 {
@@ -722,6 +723,12 @@ bool FEBioPlotFile::IsValid() const
 	return m_ar.IsValid();
 }
 
+//-----------------------------------------------------------------------------
+size_t FEBioPlotFile::BufferSize()
+{
+	return m_ar.BufferSize();
+}
+
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::Close()
 {
@@ -740,6 +747,9 @@ bool FEBioPlotFile::Open(const char *szfile)
 	FEPlotDataStore& pltData = fem->GetPlotDataStore();
 	SetCompression(pltData.GetPlotCompression());
 
+	// write the states on a background thread if requested
+	m_ar.SetAsyncWriting(pltData.GetPlotAsyncWriting());
+
 	// add plot variables
 	for (int n = 0; n < pltData.PlotVariables(); ++n)
 	{
@@ -1682,6 +1692,8 @@ void FEBioPlotFile::WriteSurfaceData(FEModel& fem)
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::WriteNodeDataField(FEModel &fem, FEPlotData* pd)
 {
+	TRACK_COMPONENT(pd, "Save");
+
 	// loop over all node sets
 	// right now there is only one, namely the node set of all mesh nodes
 	// so we just pass the mesh
@@ -1701,6 +1713,8 @@ void FEBioPlotFile::WriteNodeDataField(FEModel &fem, FEPlotData* pd)
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::WriteSurfaceDataField(FEModel& fem, FEPlotData* pd)
 {
+	TRACK_COMPONENT(pd, "Save");
+
 	// get the domain name (if any)
 	string domName;
 	const char* szdom = pd->GetDomainName();
@@ -1780,6 +1794,8 @@ void FEBioPlotFile::WriteSurfaceDataField(FEModel& fem, FEPlotData* pd)
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::WriteDomainDataField(FEModel &fem, FEPlotData* pd)
 {
+	TRACK_COMPONENT(pd, "Save");
+
 	FEMesh& m = fem.GetMesh();
 	int ND = m.Domains();
 
@@ -1900,7 +1916,12 @@ bool FEBioPlotFile::Append(const char *szfile)
 	BuildSurfaceTable();
 
 	// ... and open for appending
-	if (bok) return m_ar.Append(szfile);
+	if (bok)
+	{
+		if (m_ar.Append(szfile) == false) return false;
+		m_ar.SetAsyncWriting(pltData.GetPlotAsyncWriting());
+		return true;
+	}
 
 	return false;
 }
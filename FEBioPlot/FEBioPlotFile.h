@@ -308,6 +308,9 @@ public:
 	//! see if the plot file is valid
 	bool IsValid() const override;
 
+	//! memory used by the archive's buffers
+	size_t BufferSize() override;
+
 public:
 	//! Add a variable to the dictionary
 	bool AddVariable(FEPlotData* ps, const char* szname);
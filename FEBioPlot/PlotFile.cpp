@@ -46,3 +46,9 @@ void PlotFile::Close()
 {
 	
 }
+
+//-----------------------------------------------------------------------------
+size_t PlotFile::BufferSize()
+{
+	return 0;
+}
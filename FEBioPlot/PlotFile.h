@@ -60,6 +60,9 @@ public:
 	//! see if the plot file is valid
 	virtual bool IsValid() const = 0;
 
+	//! memory (in bytes) used for buffering output
+	virtual size_t BufferSize();
+
 protected:
 	FEModel* GetFEModel() { return m_pfem; }
 
@@ -32,7 +32,6 @@ SOFTWARE.*/
 
 #ifdef HAVE_ZLIB
 #include "zlib.h"
-static z_stream strm;
 #endif
 
 //=============================================================================
@@ -47,6 +46,11 @@ FileStream::FileStream(FILE* fp, bool owner)
 	m_ncompress = 0;
 	m_fp = fp;
 	m_fileOwner = owner;
+#ifdef HAVE_ZLIB
+	m_strm = new z_stream;
+#else
+	m_strm = nullptr;
+#endif
 }
 
 FileStream::~FileStream()
@@ -56,6 +60,10 @@ FileStream::~FileStream()
 	delete [] m_pout;
 	m_buf = 0;
 	m_pout = 0;
+#ifdef HAVE_ZLIB
+	delete m_strm;
+#endif
+	m_strm = nullptr;
 }
 
 bool FileStream::Open(const char* szfile)
@@ -92,10 +100,10 @@ void FileStream::BeginStreaming()
 #ifdef HAVE_ZLIB
 	if (m_ncompress)
 	{
-		strm.zalloc = Z_NULL;
-		strm.zfree = Z_NULL;
-		strm.opaque = Z_NULL;
-		deflateInit(&strm, -1);
+		m_strm->zalloc = Z_NULL;
+		m_strm->zfree = Z_NULL;
+		m_strm->opaque = Z_NULL;
+		deflateInit(m_strm, -1);
 	}
 #endif
 }
@@ -106,23 +114,23 @@ void FileStream::EndStreaming()
 #ifdef HAVE_ZLIB
 	if (m_ncompress)
 	{
-		strm.avail_in = 0;
-		strm.next_in = 0;
+		m_strm->avail_in = 0;
+		m_strm->next_in = 0;
 
 		/* run deflate() on input until output buffer not full, finish
 		compression if all of source has been read in */
 		do {
-			strm.avail_out = m_bufsize;
-			strm.next_out = m_pout;
-			int ret = deflate(&strm, Z_FINISH);    /* no bad return value */
+			m_strm->avail_out = m_bufsize;
+			m_strm->next_out = m_pout;
+			int ret = deflate(m_strm, Z_FINISH);    /* no bad return value */
 			assert(ret != Z_STREAM_ERROR);  /* state not clobbered */
-			int have = m_bufsize - strm.avail_out;
+			int have = m_bufsize - m_strm->avail_out;
 			fwrite(m_pout, 1, have, m_fp);
-		} while (strm.avail_out == 0);
-		assert(strm.avail_in == 0);     /* all input will be used */
+		} while (m_strm->avail_out == 0);
+		assert(m_strm->avail_in == 0);     /* all input will be used */
 
 		// all done
-		deflateEnd(&strm);
+		deflateEnd(m_strm);
 
 		fflush(m_fp);
 	}
@@ -157,20 +165,20 @@ void FileStream::Flush()
 #ifdef HAVE_ZLIB
 	if (m_ncompress)
 	{
-		strm.avail_in = m_current;
-		strm.next_in = m_buf;
+		m_strm->avail_in = m_current;
+		m_strm->next_in = m_buf;
 
 		/* run deflate() on input until output buffer not full, finish
 		compression if all of source has been read in */
 		do {
-			strm.avail_out = m_bufsize;
-			strm.next_out = m_pout;
-			int ret = deflate(&strm, Z_NO_FLUSH);    /* no bad return value */
+			m_strm->avail_out = m_bufsize;
+			m_strm->next_out = m_pout;
+			int ret = deflate(m_strm, Z_NO_FLUSH);    /* no bad return value */
 			assert(ret != Z_STREAM_ERROR);  /* state not clobbered */
-			int have = m_bufsize - strm.avail_out;
+			int have = m_bufsize - m_strm->avail_out;
 			fwrite(m_pout, 1, have, m_fp);
-		} while (strm.avail_out == 0);
-		assert(strm.avail_in == 0);     /* all input will be used */
+		} while (m_strm->avail_out == 0);
+		assert(m_strm->avail_in == 0);     /* all input will be used */
 	}
 	else
 	{
@@ -213,6 +221,11 @@ PltArchive::PltArchive()
 	m_pRoot = 0;
 	m_pChunk = 0;
 	m_bSaving = true;
+	m_ncompress = 0;
+
+	m_basync = false;
+	m_maxJobs = 2;
+	m_bstop = false;
 }
 
 PltArchive::~PltArchive()
@@ -225,6 +238,9 @@ void PltArchive::Close()
 	if (m_bSaving)
 	{
 		if (m_pRoot) Flush();
+
+		// wait until all data is written
+		StopWriter();
 	}
 	else 
 	{
@@ -243,22 +259,104 @@ void PltArchive::Close()
 
 void PltArchive::SetCompression(int n)
 {
-	if (m_fp) m_fp->SetCompression(n);
+	// The compression is applied when the chunk tree is written
+	m_ncompress = n;
+}
+
+size_t PltArchive::BufferSize()
+{
+	size_t mem = (m_fp ? m_fp->BufferSize() : 0);
+	if (m_pRoot) mem += m_pRoot->Size();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (const WriteJob& job : m_jobs) mem += job.root->Size();
+	return mem;
+}
+
+void PltArchive::SetAsyncWriting(bool b)
+{
+	if ((b == false) && m_basync) StopWriter();
+	m_basync = b;
 }
 
 void PltArchive::Flush()
 {
-	if (m_fp && m_pRoot)
+	if ((m_fp == 0) || (m_pRoot == 0))
 	{
-		m_fp->BeginStreaming();
-		m_pRoot->Write(m_fp);
-		m_fp->EndStreaming();
+		delete m_pRoot;
+		m_pRoot = 0;
+		m_pChunk = 0;
+		return;
 	}
-	delete m_pRoot;
+
+	if (m_basync)
+	{
+		// start the writer thread, if it's not running
+		if (m_writer.joinable() == false)
+		{
+			m_bstop = false;
+			m_writer = std::thread(&PltArchive::WriterLoop, this);
+		}
+
+		// Hand the tree to the writer thread. If too many trees are waiting,
+		// we wait until the writer catches up, to limit the memory use.
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait(lock, [this]() { return m_jobs.size() < m_maxJobs; });
+		WriteJob job;
+		job.root = m_pRoot;
+		job.ncompress = m_ncompress;
+		m_jobs.push_back(job);
+		m_cv.notify_all();
+	}
+	else WriteTree(m_pRoot, m_ncompress);
+
 	m_pRoot = 0;
 	m_pChunk = 0;
 }
 
+void PltArchive::WriteTree(OBranch* root, int ncompress)
+{
+	m_fp->SetCompression(ncompress);
+	m_fp->BeginStreaming();
+	root->Write(m_fp);
+	m_fp->EndStreaming();
+	// the compression stream is closed now
+	m_fp->SetCompression(0);
+	delete root;
+}
+
+void PltArchive::WriterLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_cv.wait(lock, [this]() { return (m_jobs.empty() == false) || m_bstop; });
+		if (m_jobs.empty()) break;
+
+		// The job stays in the queue while it's being written, so that
+		// it counts towards the memory limit.
+		WriteJob job = m_jobs.front();
+		lock.unlock();
+		WriteTree(job.root, job.ncompress);
+		lock.lock();
+
+		m_jobs.pop_front();
+		m_cv.notify_all();
+	}
+}
+
+void PltArchive::StopWriter()
+{
+	if (m_writer.joinable() == false) return;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bstop = true;
+		m_cv.notify_all();
+	}
+	m_writer.join();
+	m_bstop = false;
+}
+
 bool PltArchive::Create(const char* szfile)
 {
 	// attempt to create the file
@@ -34,6 +34,13 @@ SOFTWARE.*/
 #include <list>
 #include <vector>
 #include <stack>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// zlib's stream structure
+struct z_stream_s;
 
 //-----------------------------------------------------------------------------
 enum IOResult { IO_ERROR, IO_OK, IO_END };
@@ -69,6 +76,9 @@ public:
 
 	bool IsValid() { return (m_fp != nullptr); }
 
+	// size of the (compression) buffers
+	size_t BufferSize() const { return 2*m_bufsize; }
+
 private:
 	FILE*	m_fp;
 	bool	m_fileOwner;
@@ -77,6 +87,7 @@ private:
 	unsigned char*	m_buf;	//!< buffer
 	unsigned char*	m_pout;	//!< temp buffer when writing
 	int		m_ncompress;	//!< compression level
+	z_stream_s*	m_strm;		//!< compression stream
 };
 
 class OBranch;
@@ -265,6 +276,17 @@ public:
 	// flush data to file
 	void Flush();
 
+	// Turn asynchronous writing on or off. When on, the chunk tree is handed to a
+	// background thread when the root chunk ends, which compresses it and writes it 
+	// to file, so that the caller can continue while the data is written.
+	void SetAsyncWriting(bool b);
+
+	// see if asynchronous writing is on
+	bool IsAsyncWriting() const { return m_basync; }
+
+	//! memory used by the file buffers and the chunk trees that are waiting to be written
+	size_t BufferSize();
+
 public:
 	// --- Writing ---
 
@@ -363,4 +385,33 @@ protected:
 	// read data
 	bool			m_bend;		// chunk end flag
 	std::stack<CHUNK*>	m_Chunk;
+
+private:
+	// a chunk tree that is waiting to be written
+	struct WriteJob
+	{
+		OBranch*	root;		// root of the chunk tree
+		int			ncompress;	// compression level
+	};
+
+	// write a chunk tree to the file
+	void WriteTree(OBranch* root, int ncompress);
+
+	// the function that runs on the writer thread
+	void WriterLoop();
+
+	// stop the writer thread after all pending trees are written
+	void StopWriter();
+
+private:
+	int			m_ncompress;	// compression level for the next tree
+
+	// asynchronous writing
+	bool					m_basync;	// asynchronous writing flag
+	size_t					m_maxJobs;	// max nr of trees that can be waiting
+	bool					m_bstop;	// signals the writer thread to stop
+	std::thread				m_writer;	// the writer thread
+	std::mutex				m_mutex;	// protects the job queue
+	std::condition_variable	m_cv;		// signals changes to the job queue
+	std::deque<WriteJob>	m_jobs;		// trees waiting to be written
 };
@@ -32,6 +32,8 @@ SOFTWARE.*/
 #include "FECore/mat3d.h"
 #include "FECore/tens6d.h"
 #include <FECore/log.h>
+#include <FECore/FEException.h>
+#include <algorithm>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -50,8 +52,8 @@ bool FEElasticMultiscaleDomain1O::Init()
 	FEMicroMaterial* pmat = dynamic_cast<FEMicroMaterial*>(m_pMat);
 	if (m_pMat == 0) return false;
 
-	// get the parent RVE
-	FERVEModel& rve = pmat->m_mrve;
+	// create the RVEs that will solve the material points' RVEs
+	if (pmat->InitSolverRVEs() == false) return false;
 
 	// loop over all elements
 	for (size_t i=0; i<m_Elem.size(); ++i)
@@ -64,15 +66,76 @@ bool FEElasticMultiscaleDomain1O::Init()
 			FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 			FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
 
-			// create the material point RVEs
 			mmpt.m_F_prev = pt.m_F;	// TODO: I think I can remove this line
-			mmpt.m_rve.CopyFrom(rve);
-			if (mmpt.m_rve.Init() == false) return false;
-
-			// initialize RCI solve
-			if (mmpt.m_rve.RCI_Init() == false) return false;
 		}
 	}
 
 	return true;
 }
+
+//-----------------------------------------------------------------------------
+// The cost of an element update is dominated by the RVE solves, so the elements 
+// are processed in order of decreasing cost, estimated from the number of RVE 
+// iterations of the previous solves. Threads pick up the next element when they
+// finish one, which balances the load.
+void FEElasticMultiscaleDomain1O::Update(const FETimeInfo& tp)
+{
+	int NE = Elements();
+
+	// make sure there is a solver RVE for each thread
+	FEMicroMaterial* pmat = dynamic_cast<FEMicroMaterial*>(m_pMat);
+	if (pmat->InitSolverRVEs() == false) throw FEMultiScaleException(-1, -1);
+
+	// estimate the cost of each element
+	vector<int> cost(NE, 0);
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		int nint = el.GaussPoints();
+		for (int j = 0; j < nint; ++j)
+		{
+			FEMicroMaterialPoint& mmpt = *el.GetMaterialPoint(j)->ExtractData<FEMicroMaterialPoint>();
+			cost[i] += mmpt.m_rveIters + 1;
+		}
+	}
+	if ((int)m_order.size() != NE)
+	{
+		m_order.resize(NE);
+		for (int i = 0; i < NE; ++i) m_order[i] = i;
+	}
+	std::stable_sort(m_order.begin(), m_order.end(), [&](int a, int b) { return cost[a] > cost[b]; });
+
+	bool berr = false;
+	int nerr = -1;
+	#pragma omp parallel for schedule(dynamic, 1) shared(NE, berr)
+	for (int n = 0; n < NE; ++n)
+	{
+		int i = m_order[n];
+		try
+		{
+			FESolidElement& el = Element(i);
+			if (el.isActive())
+			{
+				UpdateElementStress(i, tp);
+			}
+		}
+		catch (NegativeJacobian e)
+		{
+			#pragma omp critical
+			{
+				berr = true;
+				if (e.DoOutput()) feLogError(e.what());
+			}
+		}
+		catch (FEMultiScaleException)
+		{
+			#pragma omp critical
+			{
+				if (nerr < 0) nerr = Element(i).GetID();
+			}
+		}
+	}
+
+	if (berr) throw NegativeJacobianDetected();
+	if (nerr >= 0) throw FEMultiScaleException(nerr, -1);
+}
@@ -39,4 +39,10 @@ public:
 
 	//! initialize class
 	bool Init();
+
+	//! Update the element stresses. This solves the RVEs of all integration points.
+	void Update(const FETimeInfo& tp) override;
+
+private:
+	std::vector<int>	m_order;	//!< order in which elements are updated
 };
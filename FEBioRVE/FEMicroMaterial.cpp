@@ -34,6 +34,8 @@ SOFTWARE.*/
 #include <FECore/mat6d.h>
 #include "FEBioMech/FEBCPrescribedDeformation.h"
 #include "FERVEProbe.h"
+#include <FECore/sys.h>
+#include <FECore/FEException.h>
 #include <sstream>
 
 //=============================================================================
@@ -45,6 +47,8 @@ FEMicroMaterialPoint::FEMicroMaterialPoint()
 	
 	m_macro_energy_inc = 0.;
 	m_micro_energy_inc = 0.;
+
+	m_rveIters = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -62,8 +66,8 @@ void FEMicroMaterialPoint::Update(const FETimeInfo& timeInfo)
 	FEElasticMaterialPoint::Update(timeInfo);
 	m_F_prev = m_F;
 
-	// clear rewind stack so the next rewind won't overwrite current state
-	m_rve.RCI_ClearRewindStack();
+	// the last solved state is now the converged state
+	if (m_rveTrial.IsEmpty() == false) m_rveState = m_rveTrial;
 }
 
 //-----------------------------------------------------------------------------
@@ -86,6 +90,13 @@ void FEMicroMaterialPoint::Serialize(DumpStream& ar)
 	ar & m_energy_diff;
 	ar & m_macro_energy_inc;
 	ar & m_micro_energy_inc;
+	ar & m_rveIters;
+
+	// The RVE states are needed in shallow streams too: when a time step is rewound
+	// the trial state must go back with it, otherwise Update would promote the
+	// state of the failed step.
+	m_rveState.Serialize(ar);
+	m_rveTrial.Serialize(ar);
 }
 
 //=============================================================================
@@ -115,6 +126,8 @@ FEMicroMaterial::FEMicroMaterial(FEModel* pfem) : FEElasticMaterial(pfem)
 //-----------------------------------------------------------------------------
 FEMicroMaterial::~FEMicroMaterial(void)
 {
+	for (FERVEModel* rve : m_solverRVE) delete rve;
+	m_solverRVE.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -167,11 +180,19 @@ mat3ds FEMicroMaterial::Stress(FEMaterialPoint &mp)
 	FEMicroMaterialPoint& pt = *mp.ExtractData<FEMicroMaterialPoint>();
 	mat3d F = pt.m_F;
 
+	// set the solver RVE to the converged state of this point's RVE
+	FERVEModel& rve = SolverRVE();
+	rve.RestoreState(pt.m_rveState.IsEmpty() ? m_initState : pt.m_rveState);
+
 	// calculate the averaged Cauchy stress
-	mat3ds sa = pt.m_rve.StressAverage(F, mp);
+	mat3ds sa = rve.StressAverage(F, mp);
 	
 	// calculate the difference between the macro and micro energy for Hill-Mandel condition
-	pt.m_micro_energy = micro_energy(pt.m_rve);	
+	pt.m_micro_energy = micro_energy(rve);	
+
+	// store the new state of this point's RVE
+	pt.m_rveIters = rve.Iterations();
+	rve.SaveState(pt.m_rveTrial);
 	
 	return sa;
 }
@@ -182,8 +203,55 @@ mat3ds FEMicroMaterial::Stress(FEMaterialPoint &mp)
 // is always called prior to the tangent function.
 tens4ds FEMicroMaterial::Tangent(FEMaterialPoint &mp)
 {
-	FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
-	return mmpt.m_rve.StiffnessAverage(mp);
+	return GetRVE(mp).StiffnessAverage(mp);
+}
+
+//-----------------------------------------------------------------------------
+bool FEMicroMaterial::InitSolverRVEs()
+{
+	// Domains that share this material also share the solver RVEs. This is called
+	// again before each update, so that RVEs are added when the number of threads
+	// was raised since the last call.
+	bool bnew = m_solverRVE.empty();
+	int nthreads = omp_get_max_threads();
+	if (nthreads < 1) nthreads = 1;
+	while ((int)m_solverRVE.size() < nthreads)
+	{
+		FERVEModel* rve = new FERVEModel;
+		m_solverRVE.push_back(rve);
+
+		rve->CopyFrom(m_mrve);
+		if (rve->Init() == false) return false;
+
+		// initialize RCI solve
+		if (rve->RCI_Init() == false) return false;
+	}
+
+	// all RVEs start from the same state
+	if (bnew) m_solverRVE[0]->SaveState(m_initState);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+FERVEModel& FEMicroMaterial::SolverRVE()
+{
+	// NOTE: RVEs can't be added from inside a parallel region, so this only fails
+	// if the thread count was raised without calling InitSolverRVEs first.
+	int n = omp_get_thread_num();
+	if ((n < 0) || (n >= (int)m_solverRVE.size())) throw FEMultiScaleException(-1, -1);
+	return *m_solverRVE[n];
+}
+
+//-----------------------------------------------------------------------------
+FERVEModel& FEMicroMaterial::GetRVE(FEMaterialPoint& mp)
+{
+	FEMicroMaterialPoint& pt = *mp.ExtractData<FEMicroMaterialPoint>();
+	FERVEModel& rve = SolverRVE();
+	if      (pt.m_rveTrial.IsEmpty() == false) rve.RestoreState(pt.m_rveTrial);
+	else if (pt.m_rveState.IsEmpty() == false) rve.RestoreState(pt.m_rveState);
+	else rve.RestoreState(m_initState);
+	return rve;
 }
 
 //-----------------------------------------------------------------------------
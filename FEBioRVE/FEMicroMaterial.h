@@ -65,7 +65,11 @@ public:
 	double	   m_macro_energy_inc;	// Macroscopic strain energy increment
 	double	   m_micro_energy_inc;	// Microscopic strain energy increment
 
-	FERVEModel	m_rve;				// Local copy of the parent rve
+	// The RVE itself is solved by one of the material's solver RVEs, so each point 
+	// only stores the state of its RVE.
+	FERVEState	m_rveState;			// converged state at the end of the last time step
+	FERVEState	m_rveTrial;			// state after the last solve
+	int			m_rveIters;			// nr of iterations of the last RVE solve
 };
 
 //-----------------------------------------------------------------------------
@@ -108,6 +112,18 @@ public:
 	// average RVE energy
 	double micro_energy(FEModel& rve);
 
+public:
+	//! Create the RVEs that solve the material points' RVEs, one for each thread.
+	bool InitSolverRVEs();
+
+	//! Returns the solver RVE of the calling thread, set to the (last solved) state 
+	//! of the material point's RVE.
+	FERVEModel& GetRVE(FEMaterialPoint& mp);
+
+protected:
+	//! the solver RVE of the calling thread
+	FERVEModel& SolverRVE();
+
 public:
 	int Probes() { return (int) m_probe.size(); }
 	FERVEProbe& Probe(int i) { return *m_probe[i]; }
@@ -115,6 +131,9 @@ public:
 protected:
 	std::vector<FERVEProbe*>	m_probe;
 
+	std::vector<FERVEModel*>	m_solverRVE;	//!< solver RVEs, one per thread
+	FERVEState					m_initState;	//!< initial state of RVEs
+
 public:
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
@@ -43,9 +43,46 @@ SOFTWARE.*/
 #include <FECore/FECoreKernel.h>
 
 //-----------------------------------------------------------------------------
-FERVEModel::FERVEModel()
+void FERVEState::Clear()
+{
+	m_nodeData.clear();
+	m_data.clear();
+}
+
+//-----------------------------------------------------------------------------
+size_t FERVEState::Size() const
+{
+	return m_nodeData.size()*sizeof(double) + m_data.size();
+}
+
+//-----------------------------------------------------------------------------
+// The data is written as raw blocks, since a state can easily be several megabytes.
+void FERVEState::Serialize(DumpStream& ar)
+{
+	if (ar.IsSaving())
+	{
+		int nn = (int)m_nodeData.size();
+		int nd = (int)m_data.size();
+		ar << nn << nd;
+		if (nn > 0) ar.write(&m_nodeData[0], sizeof(double), nn);
+		if (nd > 0) ar.write(&m_data[0], 1, nd);
+	}
+	else
+	{
+		int nn = 0, nd = 0;
+		ar >> nn >> nd;
+		m_nodeData.resize(nn);
+		m_data.resize(nd);
+		if (nn > 0) ar.read(&m_nodeData[0], sizeof(double), nn);
+		if (nd > 0) ar.read(&m_data[0], 1, nd);
+	}
+}
+
+//=============================================================================
+FERVEModel::FERVEModel() : m_dmp(*this)
 {
 	m_bctype = DISPLACEMENT;
+	m_dmp.ExcludeNodalData(true);
 }
 
 //-----------------------------------------------------------------------------
@@ -59,6 +96,49 @@ void FERVEModel::SetParentModel(FEModel* fem)
 	m_parentfem = fem;
 }
 
+//-----------------------------------------------------------------------------
+void FERVEModel::SaveState(FERVEState& state)
+{
+	// copy the nodal state
+	FEMesh& mesh = GetMesh();
+	size_t nsize = 0;
+	for (int i = 0; i < mesh.Nodes(); ++i) nsize += mesh.Node(i).StateSize();
+	state.m_nodeData.resize(nsize);
+	double* pd = (nsize > 0 ? &state.m_nodeData[0] : nullptr);
+	for (int i = 0; i < mesh.Nodes(); ++i) pd = mesh.Node(i).SaveState(pd);
+
+	// the rest goes through a shallow dump
+	m_dmp.reset();
+	Serialize(m_dmp);
+	state.m_data.assign(m_dmp.data(), m_dmp.data() + m_dmp.size());
+}
+
+//-----------------------------------------------------------------------------
+void FERVEModel::RestoreState(const FERVEState& state)
+{
+	assert(state.IsEmpty() == false);
+
+	FEMesh& mesh = GetMesh();
+	const double* pd = (state.m_nodeData.empty() ? nullptr : &state.m_nodeData[0]);
+	for (int i = 0; i < mesh.Nodes(); ++i) pd = mesh.Node(i).RestoreState(pd);
+
+	m_dmp.reset();
+	m_dmp.write(&state.m_data[0], 1, state.m_data.size());
+	m_dmp.Open(false, true);
+	Serialize(m_dmp);
+
+	// the rewind stack refers to whatever state this RVE had before
+	RCI_ClearRewindStack();
+}
+
+//-----------------------------------------------------------------------------
+int FERVEModel::Iterations()
+{
+	FEAnalysis* step = GetCurrentStep();
+	FESolver* solver = (step ? step->GetFESolver() : nullptr);
+	return (solver ? solver->m_niter : 0);
+}
+
 //-----------------------------------------------------------------------------
 // copy from the parent RVE
 void FERVEModel::CopyFrom(FERVEModel& rve)
@@ -29,8 +29,32 @@ SOFTWARE.*/
 #pragma once
 #include "FECore/FEModel.h"
 #include <FECore/tens4d.h>
+#include <FECore/DumpMemStream.h>
 #include "febiorve_api.h"
 
+//-----------------------------------------------------------------------------
+// The state of an RVE, i.e. everything that changes when the RVE is solved. 
+// This can be restored to any RVE that was copied from the same master RVE.
+class FEBIORVE_API FERVEState
+{
+public:
+	FERVEState() {}
+
+	bool IsEmpty() const { return m_data.empty(); }
+
+	void Clear();
+
+	//! size (in bytes) of the state
+	size_t Size() const;
+
+	//! serialize the state
+	void Serialize(DumpStream& ar);
+
+public:
+	std::vector<double>	m_nodeData;	//!< nodal state
+	std::vector<char>	m_data;		//!< everything else (shallow dump)
+};
+
 //-----------------------------------------------------------------------------
 // Class describing the RVE model.
 // This is used by the homogenization code.
@@ -75,6 +99,15 @@ public:
 	// set the parent FEModel
 	void SetParentModel(FEModel* fem);
 
+	//! store the current state
+	void SaveState(FERVEState& state);
+
+	//! restore a state (stored from this or another copy of the same RVE)
+	void RestoreState(const FERVEState& state);
+
+	//! number of iterations of the last solve
+	int Iterations();
+
 	//! Calculate the stress average
 	mat3ds StressAverage(mat3d& F, FEMaterialPoint& mp);
 	mat3ds StressAverage(FEMaterialPoint& mp);
@@ -107,4 +140,7 @@ protected:
 	int				m_bctype;			//!< RVE type
 	FEBoundingBox	m_bb;				//!< bounding box of mesh
 	vector<int>		m_BN;				//!< boundary node flags
+
+private:
+	DumpMemStream	m_dmp;				//!< used for saving and restoring states
 };
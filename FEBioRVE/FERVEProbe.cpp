@@ -106,6 +106,8 @@ FEMicroProbe::FEMicroProbe(FEModel* fem) : FERVEProbe(fem)
 {
 	m_neid = -1;	// invalid element - this must be defined by user
 	m_ngp = -1;		// invalid gauss point
+	m_mat = nullptr;
+	m_mp = nullptr;
 }
 
 bool FEMicroProbe::Init()
@@ -145,7 +147,8 @@ bool FEMicroProbe::Init()
 		FEMaterialPoint* mp = pel->GetMaterialPoint(m_ngp);
 		FEMicroMaterialPoint* mmp = mp->ExtractData<FEMicroMaterialPoint>();
 		if (mmp == nullptr) return false;
-		SetRVEModel(&mmp->m_rve);
+		m_mat = mat;
+		m_mp = mp;
 	}
 	else
 	{
@@ -153,6 +156,20 @@ bool FEMicroProbe::Init()
 		return false;
 	}
 
+	// The material point doesn't have its own RVE model. Instead, the state of its 
+	// RVE is copied to one of the material's solver RVEs when needed (see Execute).
+	// These are not created until the domains are initialized, so we skip the check
+	// of the base class. 
+	return FECallBack::Init();
+}
+
+bool FEMicroProbe::Execute(FEModel& fem, int nwhen)
+{
+	// set the solver RVE to the state of the material point's RVE
+	if ((nwhen == CB_INIT) || (nwhen == CB_MINOR_ITERS) || (nwhen == CB_MAJOR_ITERS))
+	{
+		SetRVEModel(&m_mat->GetRVE(*m_mp));
+	}
 
-	return FERVEProbe::Init();
+	return FERVEProbe::Execute(fem, nwhen);
 }
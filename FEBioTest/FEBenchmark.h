@@ -0,0 +1,78 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include <FECore/FECoreTask.h>
+#include <chrono>
+
+//-----------------------------------------------------------------------------
+//! Base class for the microbenchmarks. The model is solved with the log blocked
+//! and Benchmark() is called once, at the first stiffness reformation, so that
+//! all the model data has been initialized. Afterwards, the results are printed
+//! with Report().
+class FEBenchmark : public FECoreTask
+{
+public:
+	FEBenchmark(FEModel* fem);
+
+	bool Init(const char* szfile) override;
+
+	bool Run() override;
+
+protected:
+	//! run the benchmark
+	virtual bool Benchmark() = 0;
+
+	//! print the results. Returns false if nothing was benchmarked or the test failed.
+	virtual bool Report() = 0;
+
+	//! Calls f repeatedly for at least minTime seconds and returns the time per call (sec).
+	template <class F> static double TimeLoop(F f, double minTime = 0.25)
+	{
+		typedef std::chrono::steady_clock clock;
+		int passes = 0;
+		double t = 0.0;
+		clock::time_point t0 = clock::now();
+		do
+		{
+			f();
+			passes++;
+			t = std::chrono::duration<double>(clock::now() - t0).count();
+		}
+		while (t < minTime);
+		return t / passes;
+	}
+
+private:
+	static bool benchmark_cb(FEModel* fem, unsigned int when, void* pd);
+
+private:
+	bool	m_bdone;
+};
@@ -36,6 +36,10 @@ SOFTWARE.*/
 #include "FEMaterialTest.h"
 #include "FEResetTest.h"
 #include "FEStiffnessDiagnostic.h"
+#include "FEStiffnessBenchmark.h"
+#include "FEDataLookupBenchmark.h"
+#include "FEParseBenchmark.h"
+#include "FESpMVBenchmark.h"
 
 namespace FEBioTest
 {
@@ -48,5 +52,9 @@ void InitModule()
 	REGISTER_FECORE_CLASS(FEResetTest, "reset_test");
 	REGISTER_FECORE_CLASS(FEMaterialTest, "material test");
 	REGISTER_FECORE_CLASS(FEStiffnessDiagnostic, "stiffness_test");
+	REGISTER_FECORE_CLASS(FEStiffnessBenchmark, "stiffness_benchmark");
+	REGISTER_FECORE_CLASS(FEDataLookupBenchmark, "data_lookup_benchmark");
+	REGISTER_FECORE_CLASS(FEParseBenchmark, "parse_benchmark");
+	REGISTER_FECORE_CLASS(FESpMVBenchmark, "spmv_benchmark");
 }
 }
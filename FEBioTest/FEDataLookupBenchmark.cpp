@@ -0,0 +1,130 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEDataLookupBenchmark.h"
+#include <FECore/FEModel.h>
+#include <FECore/FEMesh.h>
+#include <FECore/FEDomain.h>
+#include <FEBioMech/FEElasticMaterialPoint.h>
+#include <FEBioMix/FEBiphasic.h>
+#include <FEBioMix/FESolutesMaterialPoint.h>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+FEDataLookupBenchmark::FEDataLookupBenchmark(FEModel* fem) : FEBenchmark(fem)
+{
+	m_points = 0;
+	m_tlist = m_ttable = 0.0;
+	m_nlist = m_ntable = 0;
+	m_bok = true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEDataLookupBenchmark::Report()
+{
+	if (m_points == 0)
+	{
+		printf("No material points were benchmarked.\n");
+		return false;
+	}
+
+	double speedup = (m_ttable > 0 ? m_tlist / m_ttable : 0.0);
+	printf("\nMaterial point data lookup benchmark (time per lookup):\n\n");
+	printf("%12s %14s %14s %10s %12s %12s %8s\n", "points", "list (ns)", "table (ns)", "speedup", "list hits", "table hits", "same");
+	printf("%12d %14.3lf %14.3lf %10.2lf %12d %12d %8s\n", m_points, m_tlist*1e9, m_ttable*1e9, speedup, m_nlist, m_ntable, (m_bok ? "yes" : "NO"));
+
+	return m_bok;
+}
+
+//-----------------------------------------------------------------------------
+// Look up the elastic, biphasic and solute data of all material points.
+bool FEDataLookupBenchmark::Benchmark()
+{
+	// collect all the material points
+	std::vector<FEMaterialPoint*> mp;
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	for (int nd = 0; nd < mesh.Domains(); ++nd)
+	{
+		FEDomain& dom = mesh.Domain(nd);
+		for (int i = 0; i < dom.Elements(); ++i)
+		{
+			FEElement& el = dom.ElementRef(i);
+			for (int n = 0; n < el.GaussPoints(); ++n) mp.push_back(el.GetMaterialPoint(n));
+		}
+	}
+	m_points = (int)mp.size();
+	if (m_points == 0) return true;
+
+	// the head of the data list of each point
+	std::vector<FEMaterialPointData*> data(m_points);
+	for (int i = 0; i < m_points; ++i) data[i] = mp[i]->ExtractData<FEMaterialPointData>();
+
+	// compare the results
+	for (int i = 0; i < m_points; ++i)
+	{
+		if (data[i] == nullptr) continue;
+		if (mp[i]->ExtractData<FEElasticMaterialPoint>() != data[i]->ExtractData<FEElasticMaterialPoint>()) m_bok = false;
+		if (mp[i]->ExtractData<FEBiphasicMaterialPoint>() != data[i]->ExtractData<FEBiphasicMaterialPoint>()) m_bok = false;
+		if (mp[i]->ExtractData<FESolutesMaterialPoint >() != data[i]->ExtractData<FESolutesMaterialPoint >()) m_bok = false;
+	}
+
+	// The number of lookups that found data is the checksum of each pass. Storing 
+	// it also keeps the compiler from optimizing the lookups away.
+
+	// search the data lists
+	m_tlist = TimeLoop([&]() {
+		int nhits = 0;
+		for (int i = 0; i < m_points; ++i)
+		{
+			FEMaterialPointData* pd = data[i];
+			if (pd == nullptr) continue;
+			if (pd->ExtractData<FEElasticMaterialPoint>()) nhits++;
+			if (pd->ExtractData<FEBiphasicMaterialPoint>()) nhits++;
+			if (pd->ExtractData<FESolutesMaterialPoint>()) nhits++;
+		}
+		m_nlist = nhits;
+	}) / (3.0 * m_points);
+
+	// use the lookup tables
+	m_ttable = TimeLoop([&]() {
+		int nhits = 0;
+		for (int i = 0; i < m_points; ++i)
+		{
+			FEMaterialPoint& mpi = *mp[i];
+			if (mpi.ExtractData<FEElasticMaterialPoint>()) nhits++;
+			if (mpi.ExtractData<FEBiphasicMaterialPoint>()) nhits++;
+			if (mpi.ExtractData<FESolutesMaterialPoint>()) nhits++;
+		}
+		m_ntable = nhits;
+	}) / (3.0 * m_points);
+
+	if (m_nlist != m_ntable) m_bok = false;
+
+	return true;
+}
@@ -0,0 +1,56 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "FEBenchmark.h"
+
+//-----------------------------------------------------------------------------
+//! Microbenchmark for FEMaterialPoint::ExtractData. At the first stiffness
+//! reformation, the elastic, biphasic and solute data of all material points is
+//! looked up through the material point's lookup table and through a search of
+//! the material point data list. The time per lookup is reported for both, together
+//! with the number of lookups that found data (which must be the same).
+//! This is meant to be run on (multi)phasic models.
+class FEDataLookupBenchmark : public FEBenchmark
+{
+public:
+	FEDataLookupBenchmark(FEModel* fem);
+
+protected:
+	bool Benchmark() override;
+
+	bool Report() override;
+
+private:
+	int		m_points;		// number of material points
+	double	m_tlist;		// time per lookup when searching the data list (sec)
+	double	m_ttable;		// time per lookup using the lookup table (sec)
+	int		m_nlist;		// number of lookups that found data when searching the data list
+	int		m_ntable;		// number of lookups that found data using the lookup table
+	bool	m_bok;			// both methods returned the same data
+};
@@ -29,6 +29,10 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEMemoryDiagnostic.h"
 #include "FECore/log.h"
+#include <FEBioLib/febiolib_api.h>
+
+size_t FEBIOLIB_API GetPeakMemory();	// in FEBioLib/memory.cpp
+size_t FEBIOLIB_API GetCurrentMemory();	// in FEBioLib/memory.cpp
 
 FEMemoryDiagnostic::FEMemoryDiagnostic(FEModel* fem) : FEDiagnostic(fem)
 {
@@ -74,8 +78,14 @@ bool FEMemoryDiagnostic::Run()
 		fprintf(stderr, "%d/%d: ...", i+1, m_iters);
 		fem.Reset();
 		bool b = fem.Solve();
-//		system("ps -C febio.test -o rss,vsize h");
 		fprintf(stderr, "%s\n", (b?"NT" : "ET"));
+
+		// report the memory usage, so that leaks show up as growth between iterations
+		const double MB = 1048576.0;
+		FEMODEL_MEMORY_STATS mem;
+		fem.GetMemoryStats(mem);
+		fprintf(stderr, "\tresident: %.1lf MB (peak %.1lf MB)\n", GetCurrentMemory() / MB, GetPeakMemory() / MB);
+		fprintf(stderr, "\tmesh: %.1lf MB, material points: %.1lf MB, contact: %.1lf MB\n", mem.Mesh / MB, mem.MaterialPoints / MB, mem.Contact / MB);
 	}
 
 	return true;
@@ -0,0 +1,133 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FEParseBenchmark.h"
+#include <FEBioLib/FEBioModel.h>
+#include <FECore/FEMesh.h>
+#include <FECore/sys.h>
+#include <XML/XMLReader.h>
+#include <chrono>
+#include <stdio.h>
+
+//-----------------------------------------------------------------------------
+FEParseBenchmark::FEParseBenchmark(FEModel* fem) : FECoreTask(fem)
+{
+	m_nodes = m_elems = 0;
+}
+
+//-----------------------------------------------------------------------------
+bool FEParseBenchmark::Init(const char* szfile)
+{
+	FEBioModel* fem = dynamic_cast<FEBioModel*>(GetFEModel());
+	if (fem == nullptr) return false;
+	m_file = fem->GetInputFileName();
+	return (m_file.empty() == false);
+}
+
+//-----------------------------------------------------------------------------
+double FEParseBenchmark::ScanFile()
+{
+	typedef std::chrono::steady_clock clock;
+	clock::time_point t0 = clock::now();
+
+	XMLReader xml;
+	if (xml.Open(m_file.c_str()) == false) return -1.0;
+	try
+	{
+		XMLTag tag;
+		if (xml.FindTag("febio_spec", tag) == false) return -1.0;
+		xml.SkipTag(tag);
+	}
+	catch (XMLReader::Error&)
+	{
+		return -1.0;
+	}
+	xml.Close();
+
+	return std::chrono::duration<double>(clock::now() - t0).count();
+}
+
+//-----------------------------------------------------------------------------
+double FEParseBenchmark::ImportFile(int nthreads)
+{
+	typedef std::chrono::steady_clock clock;
+
+	int maxThreads = omp_get_max_threads();
+	omp_set_num_threads(nthreads);
+
+	FEBioModel* fem = new FEBioModel;
+	fem->BlockLog();
+
+	clock::time_point t0 = clock::now();
+	bool bok = fem->Input(m_file.c_str());
+	double t = std::chrono::duration<double>(clock::now() - t0).count();
+
+	if (bok)
+	{
+		FEMesh& mesh = fem->GetMesh();
+		m_nodes = mesh.Nodes();
+		m_elems = mesh.Elements();
+	}
+	delete fem;
+
+	omp_set_num_threads(maxThreads);
+
+	return (bok ? t : -1.0);
+}
+
+//-----------------------------------------------------------------------------
+bool FEParseBenchmark::Run()
+{
+	FILE* fp = fopen(m_file.c_str(), "rb");
+	if (fp == nullptr) return false;
+	fseek(fp, 0, SEEK_END);
+	double mb = (double)ftell(fp) / (1024.0*1024.0);
+	fclose(fp);
+
+	int nthreads = omp_get_max_threads();
+	double tscan = ScanFile();
+	double tserial = ImportFile(1);
+	double tparallel = ImportFile(nthreads);
+	if ((tscan < 0) || (tserial < 0) || (tparallel < 0))
+	{
+		printf("Failed reading %s\n", m_file.c_str());
+		return false;
+	}
+
+	printf("\nInput file benchmark: %s (%.1lf MB, %d nodes, %d elements)\n\n", m_file.c_str(), mb, m_nodes, m_elems);
+	printf("%-24s %10s %10s\n", "", "time (s)", "MB/s");
+	printf("%-24s %10.3lf %10.1lf\n", "XML scan", tscan, mb / tscan);
+	printf("%-24s %10.3lf %10.1lf\n", "import (1 thread)", tserial, mb / tserial);
+	char sz[32]; sprintf(sz, "import (%d threads)", nthreads);
+	printf("%-24s %10.3lf %10.1lf\n", sz, tparallel, mb / tparallel);
+
+	return true;
+}
@@ -0,0 +1,61 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include <FECore/FECoreTask.h>
+#include <string>
+
+//-----------------------------------------------------------------------------
+//! Benchmark for reading (large) febio input files. The input file of the model
+//! is read again, first with the XML reader only (i.e. all tags and values are 
+//! read, but not processed), and then imported into a new model, once on a single
+//! thread and once on all threads. The time and throughput of each are reported.
+//! This is meant to be run on models with a large mesh.
+class FEParseBenchmark : public FECoreTask
+{
+public:
+	FEParseBenchmark(FEModel* fem);
+
+	bool Init(const char* szfile) override;
+
+	bool Run() override;
+
+private:
+	// read all the tags of the file. Returns the time (sec) or a negative value on failure.
+	double ScanFile();
+
+	// import the file into a new model. Returns the time (sec) or a negative value on failure.
+	double ImportFile(int nthreads);
+
+private:
+	std::string	m_file;		// the file that is read
+	int			m_nodes;	// number of nodes of the imported model
+	int			m_elems;	// number of elements of the imported model
+};
@@ -0,0 +1,112 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FESpMVBenchmark.h"
+#include <FECore/FEModel.h>
+#include <FECore/FEAnalysis.h>
+#include <FECore/FESolver.h>
+#include <FECore/FEGlobalMatrix.h>
+#include <FECore/CompactSymmMatrix.h>
+#include <FECore/sys.h>
+#include <vector>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+FESpMVBenchmark::FESpMVBenchmark(FEModel* fem) : FEBenchmark(fem)
+{
+	m_bsymm = false;
+	m_rows = m_nnz = 0;
+	m_threads = 0;
+	m_gflops1 = m_gflopsN = 0.0;
+	m_maxdiff = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+bool FESpMVBenchmark::Report()
+{
+	if (m_rows == 0)
+	{
+		printf("No compact stiffness matrix was benchmarked.\n");
+		return false;
+	}
+
+	double speedup = (m_gflops1 > 0 ? m_gflopsN / m_gflops1 : 0.0);
+	printf("\nSparse matrix-vector product benchmark:\n\n");
+	printf("%-12s %10s %12s %14s %14s %10s %12s\n", "storage", "rows", "nonzeroes", "1 thread", "threads", "speedup", "max diff");
+	char szthreads[32]; sprintf(szthreads, "%d threads", m_threads);
+	printf("%-12s %10s %12s %14s %14s\n", "", "", "", "(GFLOP/s)", szthreads);
+	printf("%-12s %10d %12d %14.3lf %14.3lf %10.2lf %12.3lg\n", (m_bsymm ? "symmetric" : "unsymmetric"), m_rows, m_nnz, m_gflops1, m_gflopsN, speedup, m_maxdiff);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FESpMVBenchmark::Benchmark()
+{
+	FEAnalysis* step = GetFEModel()->GetCurrentStep();
+	FESolver* solver = (step ? step->GetFESolver() : nullptr);
+	FEGlobalMatrix* K = (solver ? solver->GetStiffnessMatrix() : nullptr);
+	CompactMatrix* A = (K ? dynamic_cast<CompactMatrix*>(K->GetSparseMatrixPtr()) : nullptr);
+	if ((A == nullptr) || (A->Rows() == 0)) return true;
+
+	m_bsymm = (dynamic_cast<CompactSymmMatrix*>(A) != nullptr);
+	m_rows = A->Rows();
+	m_nnz = A->NonZeroes();
+	m_threads = omp_get_max_threads();
+
+	// Only half of a symmetric matrix is stored, so each off-diagonal entry is used twice.
+	double flops = (m_bsymm ? 2.0*(2.0*m_nnz - m_rows) : 2.0*m_nnz);
+
+	std::vector<double> x(m_rows), r1(m_rows), rN(m_rows);
+	for (int i = 0; i < m_rows; ++i) x[i] = 1.0 + (double)(i % 7) / 7.0;
+
+	// the serial product
+	omp_set_num_threads(1);
+	double t1 = TimeLoop([&]() { A->mult_vector(&x[0], &r1[0]); });
+	omp_set_num_threads(m_threads);
+
+	// the parallel product
+	double tN = TimeLoop([&]() { A->mult_vector(&x[0], &rN[0]); });
+
+	m_gflops1 = flops / t1 * 1e-9;
+	m_gflopsN = flops / tN * 1e-9;
+
+	// compare the results
+	double rmax = 0.0, dmax = 0.0;
+	for (int i = 0; i < m_rows; ++i)
+	{
+		rmax = fmax(rmax, fabs(r1[i]));
+		dmax = fmax(dmax, fabs(r1[i] - rN[i]));
+	}
+	m_maxdiff = (rmax > 0 ? dmax / rmax : dmax);
+
+	return true;
+}
@@ -0,0 +1,58 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include "FEBenchmark.h"
+
+//-----------------------------------------------------------------------------
+//! Benchmark for the sparse matrix-vector product. At the first stiffness 
+//! reformation, the global stiffness matrix is multiplied with a vector on a 
+//! single thread (i.e. the serial implementation) and on all threads. The 
+//! throughput (in GFLOP/s) of both and the difference between the results are
+//! reported. This requires a solver that uses one of the compact matrix formats.
+class FESpMVBenchmark : public FEBenchmark
+{
+public:
+	FESpMVBenchmark(FEModel* fem);
+
+protected:
+	bool Benchmark() override;
+
+	bool Report() override;
+
+private:
+	bool	m_bsymm;		// symmetric storage
+	int		m_rows;			// nr of rows
+	int		m_nnz;			// nr of stored nonzeroes
+	int		m_threads;		// nr of threads of the parallel product
+	double	m_gflops1;		// GFLOP/s on a single thread
+	double	m_gflopsN;		// GFLOP/s on all threads
+	double	m_maxdiff;		// max relative difference between the results
+};
@@ -0,0 +1,150 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEStiffnessBenchmark.h"
+#include <FECore/FEModel.h>
+#include <FECore/FEMesh.h>
+#include <FECore/log.h>
+#include <FEBioMech/FEElasticSolidDomain.h>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+FEStiffnessBenchmark::FEStiffnessBenchmark(FEModel* fem) : FEBenchmark(fem)
+{
+}
+
+//-----------------------------------------------------------------------------
+static const char* shape_name(int shape)
+{
+	switch (shape)
+	{
+	case ET_TET4 : return "TET4";
+	case ET_TET10: return "TET10";
+	case ET_HEX8 : return "HEX8";
+	case ET_HEX20: return "HEX20";
+	case ET_HEX27: return "HEX27";
+	}
+	return "unknown";
+}
+
+//-----------------------------------------------------------------------------
+bool FEStiffnessBenchmark::Report()
+{
+	if (m_res.empty())
+	{
+		printf("No elastic solid elements were benchmarked.\n");
+		return false;
+	}
+
+	printf("\nMaterial stiffness benchmark (time per element):\n\n");
+	printf("%-8s %10s %14s %14s %10s %12s\n", "type", "elements", "generic (us)", "kernel (us)", "speedup", "max diff");
+	for (const Result& r : m_res)
+	{
+		double speedup = (r.tkernel > 0 ? r.tgeneric / r.tkernel : 0.0);
+		printf("%-8s %10d %14.3lf %14.3lf %10.2lf %12.3lg\n", shape_name(r.shape), r.elems, r.tgeneric*1e6, r.tkernel*1e6, speedup, r.maxdiff);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Time the material stiffness of all elastic solid elements, grouped by element shape.
+bool FEStiffnessBenchmark::Benchmark()
+{
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	for (int nd = 0; nd < mesh.Domains(); ++nd)
+	{
+		FEElasticSolidDomain* dom = dynamic_cast<FEElasticSolidDomain*>(&mesh.Domain(nd));
+		if (dom == nullptr) continue;
+
+		// the element shapes that have a specialized kernel
+		const int shapes[] = { ET_TET4, ET_TET10, ET_HEX8, ET_HEX20, ET_HEX27 };
+		for (int shape : shapes)
+		{
+			std::vector<int> elems;
+			for (int i = 0; i < dom->Elements(); ++i)
+			{
+				FESolidElement& el = dom->Element(i);
+				if (el.isActive() && (el.Shape() == shape)) elems.push_back(i);
+			}
+			if (elems.empty()) continue;
+
+			int ne = (int)elems.size();
+			matrix ke, ka;
+
+			// time the generic implementation
+			double tgen = TimeLoop([&]() {
+				for (int i = 0; i < ne; ++i)
+				{
+					FESolidElement& el = dom->Element(elems[i]);
+					int ndof = 3 * el.Nodes();
+					ke.resize(ndof, ndof); ke.zero();
+					dom->ElementMaterialStiffnessGeneric(el, ke);
+				}
+			}) / ne;
+
+			// time the specialized kernel
+			double tker = TimeLoop([&]() {
+				for (int i = 0; i < ne; ++i)
+				{
+					FESolidElement& el = dom->Element(elems[i]);
+					int ndof = 3 * el.Nodes();
+					ke.resize(ndof, ndof); ke.zero();
+					dom->FEElasticSolidDomain::ElementMaterialStiffness(el, ke);
+				}
+			}) / ne;
+
+			// compare the results
+			double maxdiff = 0.0;
+			for (int i = 0; i < ne; ++i)
+			{
+				FESolidElement& el = dom->Element(elems[i]);
+				int ndof = 3 * el.Nodes();
+				ke.resize(ndof, ndof); ke.zero();
+				ka.resize(ndof, ndof); ka.zero();
+				dom->ElementMaterialStiffnessGeneric(el, ka);
+				dom->FEElasticSolidDomain::ElementMaterialStiffness(el, ke);
+
+				double kmax = 0.0, dmax = 0.0;
+				for (int r = 0; r < ndof; ++r)
+					for (int c = 0; c < ndof; ++c)
+					{
+						kmax = fmax(kmax, fabs(ka[r][c]));
+						dmax = fmax(dmax, fabs(ka[r][c] - ke[r][c]));
+					}
+				if (kmax > 0.0) maxdiff = fmax(maxdiff, dmax / kmax);
+			}
+
+			Result res = { shape, ne, tgen, tker, maxdiff };
+			m_res.push_back(res);
+		}
+	}
+
+	return true;
+}
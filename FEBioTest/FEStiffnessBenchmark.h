@@ -0,0 +1,60 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "FEBenchmark.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Microbenchmark for the element stiffness kernels of the elastic solid domains.
+//! At the first stiffness reformation, the material stiffness of all elements is
+//! evaluated with the specialized kernels and with the generic implementation.
+//! The time per element and the difference between the two are reported for each
+//! element type.
+class FEStiffnessBenchmark : public FEBenchmark
+{
+	struct Result
+	{
+		int		shape;			// element shape
+		int		elems;			// number of elements
+		double	tgeneric;		// time per element for generic implementation (sec)
+		double	tkernel;		// time per element for specialized kernel (sec)
+		double	maxdiff;		// max relative difference
+	};
+
+public:
+	FEStiffnessBenchmark(FEModel* fem);
+
+protected:
+	bool Benchmark() override;
+
+	bool Report() override;
+
+private:
+	std::vector<Result>	m_res;
+};
@@ -114,6 +114,7 @@ FEBModel::Domain::Domain(const FEBModel::Domain& dom)
 	m_spec = dom.m_spec;
 	m_name = dom.m_name;
 	m_matName = dom.m_matName;
+	m_typeName = dom.m_typeName;
 	m_Elem = dom.m_Elem;
 	m_defaultShellThickness = dom.m_defaultShellThickness;
 }
@@ -131,6 +132,10 @@ void FEBModel::Domain::SetMaterialName(const string& name) { m_matName = name; }
 
 const string& FEBModel::Domain::MaterialName() const { return m_matName; }
 
+void FEBModel::Domain::SetTypeName(const string& typeName) { m_typeName = typeName; }
+
+const string& FEBModel::Domain::TypeName() const { return m_typeName; }
+
 void FEBModel::Domain::SetElementList(const vector<ELEMENT>& el) { m_Elem = el; }
 
 const vector<FEBModel::ELEMENT>& FEBModel::Domain::ElementList() const { return m_Elem; }
@@ -82,6 +82,10 @@ public:
 		void SetMaterialName(const std::string& name);
 		const std::string& MaterialName() const;
 
+		// the element type string as it appeared in the input file
+		void SetTypeName(const std::string& typeName);
+		const std::string& TypeName() const;
+
 		void SetElementList(const std::vector<ELEMENT>& el);
 		const std::vector<ELEMENT>& ElementList() const;
 
@@ -100,6 +104,7 @@ public:
 		FE_Element_Spec		m_spec;
 		std::string			m_name;
 		std::string			m_matName;
+		std::string			m_typeName;
 		std::vector<ELEMENT>	m_Elem;
 
 	public:
@@ -0,0 +1,551 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#include "stdafx.h"
+#include "FEBioBinaryMesh.h"
+#include "FEModelBuilder.h"
+#include "FEBioImport.h"
+#include <FECore/FEElementLibrary.h>
+#include <FECore/FEElementTraits.h>
+#include <sstream>
+#include <string.h>
+#include <stdio.h>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+//-----------------------------------------------------------------------------
+static const char FEBM_MAGIC[8] = { 'F', 'E', 'B', 'M', 'E', 'S', 'H', 0 };
+
+// header and chunk header sizes (in bytes)
+#define FEBM_HEADER_SIZE	16
+#define FEBM_CHUNK_SIZE		16
+
+// round up to a multiple of 8 bytes
+inline size_t align8(size_t n) { return (n + 7) & ~((size_t)7); }
+
+//=============================================================================
+// helper class for assembling a chunk
+class FEBMChunkWriter
+{
+public:
+	FEBMChunkWriter(uint32_t id) : m_id(id) {}
+
+	void write(const void* pd, size_t nsize)
+	{
+		const char* c = (const char*)pd;
+		m_buf.insert(m_buf.end(), c, c + nsize);
+		m_buf.resize(align8(m_buf.size()), 0);
+	}
+
+	void write(uint64_t n) { write(&n, sizeof(n)); }
+
+	void write(const string& s)
+	{
+		uint32_t l = (uint32_t)s.size();
+		vector<char> tmp(sizeof(uint32_t) + l);
+		memcpy(&tmp[0], &l, sizeof(uint32_t));
+		if (l > 0) memcpy(&tmp[sizeof(uint32_t)], s.c_str(), l);
+		write(&tmp[0], tmp.size());
+	}
+
+	void write(const vector<int>& a)
+	{
+		write((uint64_t)a.size());
+		if (a.empty() == false) write(&a[0], a.size() * sizeof(int));
+	}
+
+	bool flush(FILE* fp)
+	{
+		uint32_t hdr[2] = { m_id, 0 };
+		uint64_t size = m_buf.size();
+		if (fwrite(hdr, sizeof(hdr), 1, fp) != 1) return false;
+		if (fwrite(&size, sizeof(size), 1, fp) != 1) return false;
+		if (size && (fwrite(&m_buf[0], size, 1, fp) != 1)) return false;
+		return true;
+	}
+
+private:
+	uint32_t		m_id;
+	vector<char>	m_buf;
+};
+
+//=============================================================================
+// helper class for reading a chunk's payload
+class FEBMChunkReader
+{
+public:
+	FEBMChunkReader(const char* pd, size_t size, const string& file) : m_pd(pd), m_size(size), m_pos(0), m_file(file) {}
+
+	const char* read(size_t nsize)
+	{
+		if (m_pos + nsize > m_size) throw FEBioImport::InvalidBinaryMesh(m_file, "unexpected end of chunk");
+		const char* p = m_pd + m_pos;
+		m_pos = align8(m_pos + nsize);
+		if (m_pos > m_size) m_pos = m_size;
+		return p;
+	}
+
+	uint64_t read_uint64() { return *(const uint64_t*)read(sizeof(uint64_t)); }
+
+	string read_string()
+	{
+		// the length and the characters are stored as one aligned block
+		if (m_pos + sizeof(uint32_t) > m_size) throw FEBioImport::InvalidBinaryMesh(m_file, "unexpected end of chunk");
+		uint32_t l = *(const uint32_t*)(m_pd + m_pos);
+		const char* p = read(sizeof(uint32_t) + l);
+		return string(p + sizeof(uint32_t), l);
+	}
+
+	const int* read_ints(uint64_t n)
+	{
+		if (n == 0) return nullptr;
+		if (n > (m_size - m_pos) / sizeof(int)) throw FEBioImport::InvalidBinaryMesh(m_file, "unexpected end of chunk");
+		return (const int*)read(n * sizeof(int));
+	}
+
+	void read_ints(vector<int>& a)
+	{
+		uint64_t n = read_uint64();
+		const int* pi = read_ints(n);
+		a.assign(pi, pi + n);
+	}
+
+private:
+	const char*	m_pd;
+	size_t		m_size;
+	size_t		m_pos;
+	const string&	m_file;	// file name (for error messages)
+};
+
+//=============================================================================
+FEBioBinaryMesh::FEBioBinaryMesh()
+{
+	m_data = nullptr;
+	m_size = 0;
+	m_hfile = nullptr;
+	m_hmap = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FEBioBinaryMesh::~FEBioBinaryMesh()
+{
+	Close();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioBinaryMesh::Open(const char* szfile)
+{
+	Close();
+	m_file = szfile;
+
+#ifdef WIN32
+	HANDLE hf = CreateFileA(szfile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hf == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER fs;
+	if ((GetFileSizeEx(hf, &fs) == FALSE) || (fs.QuadPart == 0)) { CloseHandle(hf); return false; }
+
+	HANDLE hm = CreateFileMappingA(hf, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hm == NULL) { CloseHandle(hf); return false; }
+
+	void* pd = MapViewOfFile(hm, FILE_MAP_READ, 0, 0, 0);
+	if (pd == NULL) { CloseHandle(hm); CloseHandle(hf); return false; }
+
+	m_hfile = hf;
+	m_hmap = hm;
+	m_data = (const char*)pd;
+	m_size = (size_t)fs.QuadPart;
+#else
+	int fd = open(szfile, O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat st;
+	if ((fstat(fd, &st) != 0) || (st.st_size == 0)) { close(fd); return false; }
+
+	void* pd = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (pd == MAP_FAILED) return false;
+
+	// the file is read front to back exactly once
+	madvise(pd, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+	m_data = (const char*)pd;
+	m_size = (size_t)st.st_size;
+#endif
+
+	// check the header
+	if ((m_size < FEBM_HEADER_SIZE) || (memcmp(m_data, FEBM_MAGIC, 8) != 0))
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEBioBinaryMesh::Close()
+{
+	if (m_data == nullptr) return;
+
+#ifdef WIN32
+	UnmapViewOfFile(m_data);
+	CloseHandle((HANDLE)m_hmap);
+	CloseHandle((HANDLE)m_hfile);
+#else
+	munmap((void*)m_data, m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+	m_hfile = nullptr;
+	m_hmap = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// returns the payload of the chunk at pos and advances pos to the next chunk
+const char* FEBioBinaryMesh::Chunk(size_t& pos, uint32_t& id, uint64_t& size)
+{
+	if (pos + FEBM_CHUNK_SIZE > m_size) throw FEBioImport::InvalidBinaryMesh(m_file, "unexpected end of file");
+	id = *(const uint32_t*)(m_data + pos);
+	size = *(const uint64_t*)(m_data + pos + 8);
+	const char* pd = m_data + pos + FEBM_CHUNK_SIZE;
+	if (size > m_size - pos - FEBM_CHUNK_SIZE) throw FEBioImport::InvalidBinaryMesh(m_file, "unexpected end of file");
+	pos += FEBM_CHUNK_SIZE + align8((size_t)size);
+	return pd;
+}
+
+//-----------------------------------------------------------------------------
+void FEBioBinaryMesh::Read(FEBModel::Part& part, FEModelBuilder& builder)
+{
+	assert(m_data);
+	uint32_t nver = *(const uint32_t*)(m_data + 8);
+	uint32_t chunks = *(const uint32_t*)(m_data + 12);
+	if (nver != VERSION) throw FEBioImport::InvalidBinaryMesh(m_file, "unsupported version");
+
+	size_t pos = FEBM_HEADER_SIZE;
+	for (uint32_t n = 0; n < chunks; ++n)
+	{
+		uint32_t id; uint64_t size;
+		const char* pd = Chunk(pos, id, size);
+		FEBMChunkReader ar(pd, (size_t)size, m_file);
+
+		switch (id)
+		{
+		case CHUNK_NODES:
+		{
+			uint64_t N = ar.read_uint64();
+			const int* pid = ar.read_ints(N);
+			const double* pr = (N > 0 ? (const double*)ar.read(3 * N * sizeof(double)) : nullptr);
+
+			vector<FEBModel::NODE> node(N);
+			for (uint64_t i = 0; i < N; ++i)
+			{
+				FEBModel::NODE& nd = node[i];
+				nd.id = pid[i];
+				nd.r = vec3d(pr[3 * i], pr[3 * i + 1], pr[3 * i + 2]);
+			}
+			part.AddNodes(node);
+		}
+		break;
+		case CHUNK_DOMAIN:
+		{
+			string name = ar.read_string();
+			string type = ar.read_string();
+			const int* pn = (const int*)ar.read(2 * sizeof(int));
+			int neln = pn[0];
+			uint64_t NE = ar.read_uint64();
+			FE_Element_Spec espec = builder.ElementSpec(type.c_str());
+			if (FEElementLibrary::IsValid(espec) == false) throw FEBioImport::InvalidElementType();
+
+			// the connectivity must match the element type, since it's copied straight into the elements
+			FEElementTraits* traits = FEElementLibrary::GetElementTraits(espec.etype);
+			if ((traits == nullptr) || (neln != traits->m_neln) || (neln > FEElement::MAX_NODES))
+			{
+				stringstream ss;
+				ss << "domain " << name << " has " << neln << " nodes per element, which does not match element type " << type;
+				throw FEBioImport::InvalidBinaryMesh(m_file, ss.str().c_str());
+			}
+
+			const int* pid = ar.read_ints(NE);
+			const int* pc = ar.read_ints(NE * neln);
+
+			if (part.FindDomain(name)) throw FEFileException("Duplicate part name found : %s", name.c_str());
+
+			FEBModel::Domain* dom = new FEBModel::Domain(espec);
+			dom->SetName(name);
+			dom->SetTypeName(type);
+			part.AddDomain(dom);
+
+			dom->Create((int)NE);
+			vector<int> elemList(NE);
+			for (uint64_t i = 0; i < NE; ++i)
+			{
+				FEBModel::ELEMENT& el = dom->GetElement((int)i);
+				el.id = pid[i];
+				memcpy(el.node, pc + i * neln, neln * sizeof(int));
+				elemList[i] = el.id;
+			}
+
+			// for named domains, we'll also create an element set
+			FEBModel::ElementSet* pg = new FEBModel::ElementSet(name);
+			pg->SetElementList(elemList);
+			part.AddElementSet(pg);
+		}
+		break;
+		case CHUNK_NODESET:
+		{
+			string name = ar.read_string();
+			if (part.FindNodeSet(name)) throw FEBioImport::RepeatedNodeSet(name);
+
+			vector<int> nodeList;
+			ar.read_ints(nodeList);
+
+			FEBModel::NodeSet* set = new FEBModel::NodeSet(name);
+			set->SetNodeList(nodeList);
+			part.AddNodeSet(set);
+		}
+		break;
+		case CHUNK_ELEMENTSET:
+		{
+			string name = ar.read_string();
+			if (part.FindElementSet(name)) throw FEBioImport::RepeatedElementSet(name);
+
+			vector<int> elemList;
+			ar.read_ints(elemList);
+
+			FEBModel::ElementSet* set = new FEBModel::ElementSet(name);
+			set->SetElementList(elemList);
+			part.AddElementSet(set);
+		}
+		break;
+		case CHUNK_SURFACE:
+		{
+			const int M = 2 + MAX_FACET_NODES;
+			string name = ar.read_string();
+			if (part.FindSurface(name)) throw FEBioImport::RepeatedSurface(name);
+
+			uint64_t NF = ar.read_uint64();
+			const int* pf = ar.read_ints(NF * M);
+
+			FEBModel::Surface* ps = new FEBModel::Surface(name);
+			part.AddSurface(ps);
+			ps->Create((int)NF);
+			for (uint64_t i = 0; i < NF; ++i)
+			{
+				FEBModel::FACET& face = ps->GetFacet((int)i);
+				const int* fi = pf + i * M;
+				face.id = fi[0];
+				face.ntype = fi[1];
+				if ((face.ntype < 3) || (face.ntype > MAX_FACET_NODES)) throw FEBioImport::InvalidBinaryMesh(m_file, "invalid facet");
+				memcpy(face.node, fi + 2, face.ntype * sizeof(int));
+			}
+		}
+		break;
+		case CHUNK_EDGESET:
+		{
+			const int M = 2 + MAX_EDGE_NODES;
+			string name = ar.read_string();
+			if (part.FindEdgeSet(name)) throw FEBioImport::RepeatedEdgeSet(name);
+
+			uint64_t NL = ar.read_uint64();
+			const int* pl = ar.read_ints(NL * M);
+
+			vector<FEBModel::EDGE> edgeSet(NL);
+			for (uint64_t i = 0; i < NL; ++i)
+			{
+				FEBModel::EDGE& edge = edgeSet[i];
+				const int* li = pl + i * M;
+				edge.id = li[0];
+				edge.ntype = li[1];
+				if ((edge.ntype < 2) || (edge.ntype > MAX_EDGE_NODES)) throw FEBioImport::InvalidBinaryMesh(m_file, "invalid edge");
+				memcpy(edge.node, li + 2, edge.ntype * sizeof(int));
+			}
+
+			FEBModel::EdgeSet* ps = new FEBModel::EdgeSet(name);
+			ps->SetEdgeList(edgeSet);
+			part.AddEdgeSet(ps);
+		}
+		break;
+		default:
+			// skip unknown chunks so that later versions can add data
+			break;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioBinaryMesh::Write(const char* szfile, FEBModel::Part& part)
+{
+	// we need the type names to write the domains
+	for (int n = 0; n < part.Domains(); ++n)
+	{
+		const FEBModel::Domain& dom = part.GetDomain(n);
+		if (dom.TypeName().empty()) return false;
+		if (FEElementLibrary::GetElementTraits(dom.ElementSpec().etype) == nullptr) return false;
+	}
+
+	vector<FEBMChunkWriter*> chunks;
+
+	// nodes
+	int NN = part.Nodes();
+	if (NN > 0)
+	{
+		vector<int> id(NN);
+		vector<double> r(3 * NN);
+		for (int i = 0; i < NN; ++i)
+		{
+			FEBModel::NODE& nd = part.GetNode(i);
+			id[i] = nd.id;
+			r[3 * i] = nd.r.x; r[3 * i + 1] = nd.r.y; r[3 * i + 2] = nd.r.z;
+		}
+
+		FEBMChunkWriter* ar = new FEBMChunkWriter(CHUNK_NODES);
+		ar->write((uint64_t)NN);
+		ar->write(&id[0], NN * sizeof(int));
+		ar->write(&r[0], 3 * NN * sizeof(double));
+		chunks.push_back(ar);
+	}
+
+	// domains
+	for (int n = 0; n < part.Domains(); ++n)
+	{
+		const FEBModel::Domain& dom = part.GetDomain(n);
+		int neln = FEElementLibrary::GetElementTraits(dom.ElementSpec().etype)->m_neln;
+
+		int NE = dom.Elements();
+		vector<int> id(NE), conn((size_t)NE * neln);
+		for (int i = 0; i < NE; ++i)
+		{
+			const FEBModel::ELEMENT& el = dom.GetElement(i);
+			id[i] = el.id;
+			memcpy(&conn[(size_t)i * neln], el.node, neln * sizeof(int));
+		}
+
+		FEBMChunkWriter* ar = new FEBMChunkWriter(CHUNK_DOMAIN);
+		int hdr[2] = { neln, 0 };
+		ar->write(dom.Name());
+		ar->write(dom.TypeName());
+		ar->write(hdr, sizeof(hdr));
+		ar->write((uint64_t)NE);
+		if (NE > 0)
+		{
+			ar->write(&id[0], id.size() * sizeof(int));
+			ar->write(&conn[0], conn.size() * sizeof(int));
+		}
+		chunks.push_back(ar);
+	}
+
+	// node sets
+	for (int n = 0; n < part.NodeSets(); ++n)
+	{
+		FEBModel::NodeSet* set = part.GetNodeSet(n);
+		FEBMChunkWriter* ar = new FEBMChunkWriter(CHUNK_NODESET);
+		ar->write(set->Name());
+		ar->write(set->NodeList());
+		chunks.push_back(ar);
+	}
+
+	// element sets (the sets that are created for each domain are skipped)
+	for (int n = 0; n < part.ElementSets(); ++n)
+	{
+		FEBModel::ElementSet* set = part.GetElementSet(n);
+		if (part.FindDomain(set->Name())) continue;
+
+		FEBMChunkWriter* ar = new FEBMChunkWriter(CHUNK_ELEMENTSET);
+		ar->write(set->Name());
+		ar->write(set->ElementList());
+		chunks.push_back(ar);
+	}
+
+	// surfaces
+	for (int n = 0; n < part.Surfaces(); ++n)
+	{
+		const int M = 2 + MAX_FACET_NODES;
+		FEBModel::Surface* surf = part.GetSurface(n);
+		int NF = surf->Facets();
+		vector<int> face((size_t)NF * M, 0);
+		for (int i = 0; i < NF; ++i)
+		{
+			FEBModel::FACET& f = surf->GetFacet(i);
+			int* fi = &face[(size_t)i * M];
+			fi[0] = f.id;
+			fi[1] = f.ntype;
+			for (int j = 0; j < f.ntype; ++j) fi[2 + j] = f.node[j];
+		}
+
+		FEBMChunkWriter* ar = new FEBMChunkWriter(CHUNK_SURFACE);
+		ar->write(surf->Name());
+		ar->write((uint64_t)NF);
+		if (NF > 0) ar->write(&face[0], face.size() * sizeof(int));
+		chunks.push_back(ar);
+	}
+
+	// edges
+	for (int n = 0; n < part.EdgeSets(); ++n)
+	{
+		const int M = 2 + MAX_EDGE_NODES;
+		FEBModel::EdgeSet* set = part.GetEdgeSet(n);
+		const vector<FEBModel::EDGE>& edges = set->EdgeList();
+		int NL = (int)edges.size();
+		vector<int> edge((size_t)NL * M, 0);
+		for (int i = 0; i < NL; ++i)
+		{
+			const FEBModel::EDGE& e = edges[i];
+			int* li = &edge[(size_t)i * M];
+			li[0] = e.id;
+			li[1] = e.ntype;
+			for (int j = 0; j < e.ntype; ++j) li[2 + j] = e.node[j];
+		}
+
+		FEBMChunkWriter* ar = new FEBMChunkWriter(CHUNK_EDGESET);
+		ar->write(set->Name());
+		ar->write((uint64_t)NL);
+		if (NL > 0) ar->write(&edge[0], edge.size() * sizeof(int));
+		chunks.push_back(ar);
+	}
+
+	// write everything to file
+	bool bret = false;
+	FILE* fp = fopen(szfile, "wb");
+	if (fp)
+	{
+		uint32_t hdr[2] = { VERSION, (uint32_t)chunks.size() };
+		bret = (fwrite(FEBM_MAGIC, 8, 1, fp) == 1) && (fwrite(hdr, sizeof(hdr), 1, fp) == 1);
+		for (size_t i = 0; bret && (i < chunks.size()); ++i) bret = chunks[i]->flush(fp);
+		fclose(fp);
+	}
+
+	for (size_t i = 0; i < chunks.size(); ++i) delete chunks[i];
+
+	return bret;
+}
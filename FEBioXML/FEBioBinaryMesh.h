@@ -0,0 +1,90 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#pragma once
+#include "febioxml_api.h"
+#include "FEBModel.h"
+#include <stdint.h>
+
+class FEModelBuilder;
+
+//-----------------------------------------------------------------------------
+// Binary mesh file (.febm). This stores the geometry of a single mesh part
+// (nodes, element domains, node sets, element sets, surfaces, and edges) in
+// the native layout of the machine that wrote it, so that large meshes can be
+// memory-mapped and copied straight into an FEBModel::Part without parsing any
+// text. The file is referenced from the Mesh section of a version 4.0 input
+// file with the "binary" attribute, e.g. <Mesh binary="model.febm"/>.
+//
+// File layout: a header (magic, version, chunk count) followed by chunks. Each
+// chunk starts with its ID and payload size. All arrays are 8-byte aligned.
+class FEBIOXML_API FEBioBinaryMesh
+{
+public:
+	enum { VERSION = 1 };
+
+	// chunk IDs
+	enum ChunkID
+	{
+		CHUNK_NODES       = 1,
+		CHUNK_DOMAIN      = 2,
+		CHUNK_NODESET     = 3,
+		CHUNK_ELEMENTSET  = 4,
+		CHUNK_SURFACE     = 5,
+		CHUNK_EDGESET     = 6
+	};
+
+	// max nr of nodes stored per facet and per edge
+	enum { MAX_FACET_NODES = 9, MAX_EDGE_NODES = 3 };
+
+public:
+	FEBioBinaryMesh();
+	~FEBioBinaryMesh();
+
+	// map a binary mesh file into memory
+	bool Open(const char* szfile);
+
+	// release the file mapping
+	void Close();
+
+	// Copy the mesh into the part. The builder is used to resolve the element
+	// types of the domains. Throws an FEFileException on invalid files.
+	void Read(FEBModel::Part& part, FEModelBuilder& builder);
+
+public:
+	// write a part to a binary mesh file
+	static bool Write(const char* szfile, FEBModel::Part& part);
+
+private:
+	const char* Chunk(size_t& pos, uint32_t& id, uint64_t& size);
+
+private:
+	const char*	m_data;		// start of mapped file
+	size_t		m_size;		// size of mapped file
+	void*		m_hfile;	// file handle (only used on Windows)
+	void*		m_hmap;		// mapping handle (only used on Windows)
+	std::string	m_file;		// name of the file (for error messages)
+};
@@ -57,6 +57,7 @@ SOFTWARE.*/
 #include "FEBioMeshSection.h"
 #include "FEBioMeshSection4.h"
 #include "FEBioMeshDomainsSection4.h"
+#include "FEBioBinaryMesh.h"
 #include "FEBioStepSection3.h"
 #include "FECore/DataStore.h"
 #include "FECore/FEModel.h"
@@ -171,9 +172,15 @@ FEBioImport::RepeatedElementSet::RepeatedElementSet(const std::string& name)
 	SetErrorString("An element set with name \"%s\" was already defined.", name.c_str());
 }
 
+FEBioImport::InvalidBinaryMesh::InvalidBinaryMesh(const std::string& fileName, const char* szerr)
+{
+	SetErrorString("Error reading binary mesh file %s: %s", fileName.c_str(), szerr);
+}
+
 //-----------------------------------------------------------------------------
 FEBioImport::FEBioImport()
 {
+	m_szmesh[0] = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -321,12 +328,20 @@ bool FEBioImport::Load(FEModel& fem, const char* szfile)
 	// read the file
 	if (ReadFile(szfile) == false) return false;
 
+	// export the mesh, if requested
+	if (m_szmesh[0])
+	{
+		FEBModel& feb = m_builder->GetFEBModel();
+		if ((GetFileVersion() < 0x0400) || (feb.Parts() != 1)) return errf("Binary mesh export requires a version 4.0 input file.");
+		if (FEBioBinaryMesh::Write(m_szmesh, *feb.GetPart(0)) == false) return errf("FAILED writing binary mesh file %s.", m_szmesh);
+	}
+
 	// finish building
 	try {
 		bool b = m_builder->Finish();
 		if (b == false) return errf("FAILED building FEBio model.");
 	}
-	catch (std::exception e)
+	catch (std::exception& e)
 	{
 		const char* szerr = e.what();
 		if (szerr == nullptr) szerr = "(unknown exception)";
@@ -491,7 +506,7 @@ bool FEBioImport::ReadFile(const char* szfile, bool broot)
 		return errf("\"%s\" is not a valid field variable name (line %d)\n", e.what(), xml.GetCurrentLine()-1);
 	}
 	// std::exception
-	catch (std::exception e)
+	catch (std::exception& e)
 	{
 		const char* szerr = e.what();
 		if (szerr == nullptr) szerr = "(unknown exception)";
@@ -530,6 +545,7 @@ void FEBioImport::ParseVersion(XMLTag &tag)
 void FEBioImport::SetDumpfileName(const char* sz) { sprintf(m_szdmp, "%s", sz); }
 void FEBioImport::SetLogfileName (const char* sz) { sprintf(m_szlog, "%s", sz); }
 void FEBioImport::SetPlotfileName(const char* sz) { sprintf(m_szplt, "%s", sz); }
+void FEBioImport::SetMeshExportFile(const char* sz) { snprintf(m_szmesh, sizeof(m_szmesh), "%s", sz); }
 
 //-----------------------------------------------------------------------------
 void FEBioImport::AddDataRecord(DataRecord* pd)
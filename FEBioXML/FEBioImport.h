@@ -161,6 +161,12 @@ public:
 	public: RepeatedElementSet(const std::string& name);
 	};
 
+	// invalid or truncated binary mesh file
+	class InvalidBinaryMesh : public FEFileException
+	{
+	public: InvalidBinaryMesh(const std::string& fileName, const char* szerr);
+	};
+
 public:
 	//! constructor
 	FEBioImport();
@@ -182,6 +188,9 @@ public:
 	void SetLogfileName (const char* sz);
 	void SetPlotfileName(const char* sz);
 
+	// write the mesh part of the file to a binary mesh file (version 4.0 only)
+	void SetMeshExportFile(const char* sz);
+
 	void AddDataRecord(DataRecord* pd);
 
 public:
@@ -198,6 +207,7 @@ public:
 	char	m_szdmp[512];
 	char	m_szlog[512];
 	char	m_szplt[512];
+	char	m_szmesh[512];	//!< binary mesh export file
 
 public:
 	std::vector<DataRecord*>		m_data;
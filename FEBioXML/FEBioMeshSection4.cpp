@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEBioMeshSection4.h"
+#include "FEBioBinaryMesh.h"
 #include <FECore/FESolidDomain.h>
 #include <FECore/FEShellDomain.h>
 #include <FECore/FETrussDomain.h>
@@ -54,6 +55,16 @@ void FEBioMeshSection4::Parse(XMLTag& tag)
 	assert(feb.Parts() == 0);
 	FEBModel::Part* part = feb.AddPart("");
 
+	// the mesh can be stored in a binary mesh file
+	const char* szbin = tag.AttributeValue("binary", true);
+	if (szbin)
+	{
+		ParseBinaryMesh(szbin, part);
+
+		// additional mesh sections can still be defined in the file
+		if (tag.isleaf() || tag.isempty()) return;
+	}
+
 	// read all sections
 	++tag;
 	do
@@ -72,6 +83,41 @@ void FEBioMeshSection4::Parse(XMLTag& tag)
 	while (!tag.isend());
 }
 
+//-----------------------------------------------------------------------------
+// convert the text of a block of nodes to nodal coordinates
+static void ConvertNodes(const vector<string>& val, const vector<int>& line, int nb, FEBModel::NODE* node)
+{
+	int nerr = -1;
+#pragma omp parallel for shared(nerr) if (nb > 1000)
+	for (int i = 0; i < nb; ++i)
+	{
+		double r[3];
+		if (string_to_array(val[i].c_str(), r, 3) != 3)
+		{
+#pragma omp critical
+			if ((nerr == -1) || (i < nerr)) nerr = i;
+		}
+		else node[i].r = vec3d(r[0], r[1], r[2]);
+	}
+	if (nerr >= 0) throw XMLReader::XMLSyntaxError(line[nerr]);
+}
+
+//-----------------------------------------------------------------------------
+// convert the text of a block of elements to element connectivity and add
+// the elements to the domain
+static void ConvertElements(const vector<string>& val, int nb, const int* id, FEBModel::Domain* dom)
+{
+	int n0 = dom->Elements();
+	dom->Create(n0 + nb);
+#pragma omp parallel for if (nb > 1000)
+	for (int i = 0; i < nb; ++i)
+	{
+		FEBModel::ELEMENT& el = dom->GetElement(n0 + i);
+		el.id = id[i];
+		string_to_array(val[i].c_str(), el.node, FEElement::MAX_NODES);
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! Reads the Nodes section of the FEBio input file
 void FEBioMeshSection4::ParseNodeSection(XMLTag& tag, FEBModel::Part* part)
@@ -90,16 +136,19 @@ void FEBioMeshSection4::ParseNodeSection(XMLTag& tag, FEBModel::Part* part)
 	}
 
 	// allocate node
-
 	vector<FEBModel::NODE> node; node.reserve(10000);
 	vector<int> nodeList; nodeList.reserve(10000);
 
+	// The nodal coordinates are converted in blocks on multiple threads, 
+	// so only the text of each node is stored while reading.
+	vector<string> val;
+	vector<int> line;
+	int nb = 0;
+
 	// read nodal coordinates
 	++tag;
 	do {
-		// nodal coordinates
 		FEBModel::NODE nd;
-		value(tag, nd.r);
 
 		// get the nodal ID
 		tag.AttributeValue("id", nd.id);
@@ -108,9 +157,20 @@ void FEBioMeshSection4::ParseNodeSection(XMLTag& tag, FEBModel::Part* part)
 		node.push_back(nd);
 		nodeList.push_back(nd.id);
 
+		// store the text for conversion
+		if (nb == (int)val.size()) { val.emplace_back(); line.push_back(0); }
+		val[nb] = tag.m_szval;
+		line[nb] = tag.m_nstart_line;
+		if (++nb == BLOCK_SIZE)
+		{
+			ConvertNodes(val, line, nb, &node[node.size() - nb]);
+			nb = 0;
+		}
+
 		// go on to the next node
 		++tag;
 	} while (!tag.isend());
+	if (nb > 0) ConvertNodes(val, line, nb, &node[node.size() - nb]);
 
 	// add nodes to the part
 	part->AddNodes(node);
@@ -150,6 +210,7 @@ void FEBioMeshSection4::ParseElementSection(XMLTag& tag, FEBModel::Part* part)
 	// create the new domain
 	dom = new FEBModel::Domain(espec);
 	if (szname) dom->SetName(szname);
+	dom->SetTypeName(sztype);
 
 	// add domain it to the mesh
 	part->AddDomain(dom);
@@ -162,32 +223,57 @@ void FEBioMeshSection4::ParseElementSection(XMLTag& tag, FEBModel::Part* part)
 		part->AddElementSet(pg);
 	}
 
-	dom->Reserve(10000);
 	vector<int> elemList; elemList.reserve(10000);
 
+	// the element connectivity is converted in blocks on multiple threads
+	vector<string> val;
+	int nb = 0;
+
 	// read element data
 	++tag;
 	do
 	{
-		FEBModel::ELEMENT el;
-
 		// get the element ID
-		tag.AttributeValue("id", el.id);
-
-		// read the element data
-		tag.value(el.node, FEElement::MAX_NODES);
-
-		dom->AddElement(el);
-		elemList.push_back(el.id);
+		int id = -1;
+		tag.AttributeValue("id", id);
+		elemList.push_back(id);
+
+		// store the text for conversion
+		if (nb == (int)val.size()) val.emplace_back();
+		val[nb] = tag.m_szval;
+		if (++nb == BLOCK_SIZE)
+		{
+			ConvertElements(val, nb, &elemList[elemList.size() - nb], dom);
+			nb = 0;
+		}
 
 		// go to next tag
 		++tag;
 	} while (!tag.isend());
+	if (nb > 0) ConvertElements(val, nb, &elemList[elemList.size() - nb], dom);
 
 	// set the element list
 	if (pg) pg->SetElementList(elemList);
 }
 
+//-----------------------------------------------------------------------------
+//! Reads the nodes, domains and mesh sets from a binary mesh file. The file
+//! name is relative to the input file.
+void FEBioMeshSection4::ParseBinaryMesh(const char* szfile, FEBModel::Part* part)
+{
+	char szpath[1024] = { 0 };
+	const char* szroot = GetFileReader()->GetFilePath();
+	if (szroot && (szfile[0] != '/') && (szfile[0] != '\\') && (strchr(szfile, ':') == nullptr))
+		snprintf(szpath, sizeof(szpath), "%s%s", szroot, szfile);
+	else
+		snprintf(szpath, sizeof(szpath), "%s", szfile);
+
+	FEBioBinaryMesh bin;
+	if (bin.Open(szpath) == false) throw FEFileException("Failed opening binary mesh file : %s", szpath);
+
+	bin.Read(*part, *GetBuilder());
+}
+
 //-----------------------------------------------------------------------------
 //! Reads the Geometry::Groups section of the FEBio input file
 void FEBioMeshSection4::ParseNodeSetSection(XMLTag& tag, FEBModel::Part* part)
@@ -34,6 +34,9 @@ SOFTWARE.*/
 // Mesh section
 class FEBioMeshSection4 : public FEBioFileSection
 {
+	// nr of nodes or elements that are converted together
+	enum { BLOCK_SIZE = 65536 };
+
 public:
 	FEBioMeshSection4(FEBioImport* pim);
 
@@ -48,4 +51,6 @@ protected:
 	void ParseEdgeSection       (XMLTag& tag, FEBModel::Part* part);
 	void ParseSurfacePairSection(XMLTag& tag, FEBModel::Part* part);
 	void ParseDiscreteSetSection(XMLTag& tag, FEBModel::Part* part);
+
+	void ParseBinaryMesh(const char* szfile, FEBModel::Part* part);
 };
@@ -152,6 +152,15 @@ void FEBioOutputSection::ParseLogfile(XMLTag &tag)
 			else if (strcmp(szcomment, "off") == 0) bcomment = false;
 		}
 
+		// binary output (only used when the data is written to a file)
+		bool bbinary = false;
+		const char* szbinary = tag.AttributeValue("binary", true);
+		if (szbinary && (strcmp(szbinary, "on") == 0)) bbinary = true;
+
+		bool bcompress = false;
+		const char* szcompress = tag.AttributeValue("compress", true);
+		if (szcompress && (strcmp(szcompress, "on") == 0)) bcompress = true;
+
 		// get the data attribute
 		const char* szdata = tag.AttributeValue("data");
 
@@ -283,6 +292,7 @@ void FEBioOutputSection::ParseLogfile(XMLTag &tag)
 		{
 			pdr->SetData(szdata);
 			if (szname != 0) pdr->SetName(szname); else pdr->SetName(szdata);
+			pdr->SetBinary(bbinary, bcompress);
 			if (szfile) pdr->SetFileName(szfile);
 			if (szdelim != 0) pdr->SetDelim(szdelim);
 			if (szformat != 0) pdr->SetFormat(szformat);
@@ -404,6 +414,12 @@ void FEBioOutputSection::ParsePlotfile(XMLTag &tag)
 				tag.value(ncomp);
 				plotData.SetPlotCompression(ncomp);
 			}
+			else if (tag=="async_write")
+			{
+				bool b;
+				tag.value(b);
+				plotData.SetPlotAsyncWriting(b);
+			}
 			++tag;
 		}
 		while (!tag.isend());
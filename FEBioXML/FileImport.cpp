@@ -200,9 +200,10 @@ void FEFileSection::value(XMLTag& tag, bool& b)
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, vec3d& v)
 {
-	const char* sz = tag.szvalue();
-	int n = sscanf(sz, "%lg,%lg,%lg", &v.x, &v.y, &v.z);
+	double d[3];
+	int n = string_to_array(tag.szvalue(), d, 3);
 	if (n != 3) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
+	v = vec3d(d[0], d[1], d[2]);
 }
 
 //-----------------------------------------------------------------------------
@@ -309,37 +310,13 @@ void FEFileSection::value(XMLTag& tag, std::vector<double>& v)
 //-----------------------------------------------------------------------------
 int FEFileSection::value(XMLTag& tag, int* pi, int n)
 {
-	const char* sz = tag.szvalue();
-	int nr = 0;
-	for (int i = 0; i<n; ++i)
-	{
-		const char* sze = strchr(sz, ',');
-
-		pi[i] = atoi(sz);
-nr++;
-
-if (sze) sz = sze + 1;
-else break;
-	}
-	return nr;
+	return string_to_array(tag.szvalue(), pi, n);
 }
 
 //-----------------------------------------------------------------------------
 int FEFileSection::value(XMLTag& tag, double* pf, int n)
 {
-	const char* sz = tag.szvalue();
-	int nr = 0;
-	for (int i = 0; i < n; ++i)
-	{
-		const char* sze = strchr(sz, ',');
-
-		pf[i] = atof(sz);
-		nr++;
-
-		if (sze) sz = sze + 1;
-		else break;
-	}
-	return nr;
+	return string_to_array(tag.szvalue(), pf, n);
 }
 
 //-----------------------------------------------------------------------------
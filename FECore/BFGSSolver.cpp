@@ -207,3 +207,11 @@ void BFGSSolver::SolveEquations(vector<double>& x, vector<double>& b)
 		for (int j = 0; j<m_neq; ++j) x[j] += wi[j] * vr;
 	}
 }
+
+//-----------------------------------------------------------------------------
+size_t BFGSSolver::MemoryUsage() const
+{
+	size_t n = (size_t)m_V.rows()*m_V.columns() + (size_t)m_W.rows()*m_W.columns();
+	n += m_D.capacity() + m_G.capacity() + m_H.capacity() + tmp.capacity();
+	return n*sizeof(double);
+}
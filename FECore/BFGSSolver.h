@@ -52,6 +52,9 @@ public:
 	//! solve the equations
 	void SolveEquations(vector<double>& x, vector<double>& b) override;
 
+	//! memory used by the update vectors
+	size_t MemoryUsage() const override;
+
 public:
 	// keep a pointer to the linear solver
 	LinearSolver*	m_plinsolve;	//!< pointer to linear solver
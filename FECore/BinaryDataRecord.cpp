@@ -0,0 +1,295 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "BinaryDataRecord.h"
+#include <string.h>
+#include <stdint.h>
+
+#ifdef HAVE_ZLIB
+#include "zlib.h"
+#endif
+
+//-----------------------------------------------------------------------------
+// helper functions for appending data to a byte buffer
+template <typename T> static void append(std::vector<unsigned char>& buf, const T& v)
+{
+	size_t n = buf.size();
+	buf.resize(n + sizeof(T));
+	memcpy(&buf[n], &v, sizeof(T));
+}
+
+static void appendString(std::vector<unsigned char>& buf, const std::string& s)
+{
+	uint32_t n = (uint32_t)s.size();
+	append(buf, n);
+	buf.insert(buf.end(), s.begin(), s.end());
+}
+
+//=============================================================================
+BinaryDataRecordWriter::BinaryDataRecordWriter()
+{
+	m_fp = nullptr;
+	m_bheader = false;
+	m_bcompress = false;
+}
+
+//-----------------------------------------------------------------------------
+BinaryDataRecordWriter::~BinaryDataRecordWriter()
+{
+	Close();
+}
+
+//-----------------------------------------------------------------------------
+bool BinaryDataRecordWriter::CompressionSupported()
+{
+#ifdef HAVE_ZLIB
+	return true;
+#else
+	return false;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// When appending (e.g. after a restart), the compression flag is taken from the
+// header of the existing file. If the file has no valid header yet, a new header 
+// will be written.
+bool BinaryDataRecordWriter::Open(const char* szfile, bool append)
+{
+	Close();
+	m_bheader = false;
+	m_bcompress = false;
+	if (append)
+	{
+		FILE* fp = fopen(szfile, "rb");
+		if (fp)
+		{
+			uint32_t magic = 0, version = 0, flags = 0;
+			int32_t type = 0;
+			if ((fread(&magic, sizeof(magic), 1, fp) == 1) && (magic == BINARY_LOG_MAGIC) &&
+				(fread(&version, sizeof(version), 1, fp) == 1) &&
+				(fread(&type, sizeof(type), 1, fp) == 1) &&
+				(fread(&flags, sizeof(flags), 1, fp) == 1))
+			{
+				m_bheader = true;
+				m_bcompress = ((flags & BINARY_LOG_COMPRESSED) != 0);
+			}
+			fclose(fp);
+		}
+
+		// we can't write compressed blocks without zlib
+		if (m_bcompress && (CompressionSupported() == false)) return false;
+
+		// a file without a valid header is started over
+		if (m_bheader == false) append = false;
+	}
+
+	m_fp = fopen(szfile, (append ? "ab" : "wb"));
+	return (m_fp != nullptr);
+}
+
+//-----------------------------------------------------------------------------
+void BinaryDataRecordWriter::Close()
+{
+	if (m_fp) fclose(m_fp);
+	m_fp = nullptr;
+	m_bheader = false;
+}
+
+//-----------------------------------------------------------------------------
+bool BinaryDataRecordWriter::WriteHeader(int type, const char* szname, const std::vector<std::string>& columns, const std::vector<int>& items, bool compress)
+{
+	if (m_fp == nullptr) return false;
+
+	m_bcompress = (compress && CompressionSupported());
+
+	std::vector<unsigned char> buf;
+	append(buf, (uint32_t)BINARY_LOG_MAGIC);
+	append(buf, (uint32_t)BINARY_LOG_VERSION);
+	append(buf, (int32_t)type);
+	append(buf, (uint32_t)(m_bcompress ? BINARY_LOG_COMPRESSED : 0));
+	appendString(buf, (szname ? szname : ""));
+	append(buf, (uint32_t)columns.size());
+	for (size_t i = 0; i < columns.size(); ++i) appendString(buf, columns[i]);
+	append(buf, (uint32_t)items.size());
+	for (size_t i = 0; i < items.size(); ++i) append(buf, (int32_t)items[i]);
+
+	if (fwrite(&buf[0], 1, buf.size(), m_fp) != buf.size()) return false;
+	m_bheader = true;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool BinaryDataRecordWriter::WriteBlock(int step, double time, const std::vector<double>& data)
+{
+	if ((m_fp == nullptr) || (m_bheader == false)) return false;
+
+	uint64_t rawSize = data.size() * sizeof(double);
+
+	// The block header and the data are assembled in one buffer,
+	// so that the whole block is written with a single call.
+	m_buf.clear();
+	append(m_buf, (uint32_t)BINARY_LOG_BLOCK);
+	append(m_buf, (int32_t)step);
+	append(m_buf, time);
+	append(m_buf, rawSize);
+	size_t sizePos = m_buf.size();
+	append(m_buf, rawSize);
+	size_t dataPos = m_buf.size();
+
+	uint64_t storedSize = rawSize;
+#ifdef HAVE_ZLIB
+	if (m_bcompress && (rawSize > 0))
+	{
+		uLongf destLen = compressBound((uLong)rawSize);
+		m_buf.resize(dataPos + destLen);
+		if (compress2(&m_buf[dataPos], &destLen, (const Bytef*)&data[0], (uLong)rawSize, Z_BEST_SPEED) != Z_OK) return false;
+		storedSize = destLen;
+		m_buf.resize(dataPos + destLen);
+		memcpy(&m_buf[sizePos], &storedSize, sizeof(storedSize));
+	}
+	else
+#endif
+	{
+		m_buf.resize(dataPos + rawSize);
+		if (rawSize > 0) memcpy(&m_buf[dataPos], &data[0], rawSize);
+	}
+
+	if (fwrite(&m_buf[0], 1, m_buf.size(), m_fp) != m_buf.size()) return false;
+	fflush(m_fp);
+
+	return true;
+}
+
+//=============================================================================
+BinaryDataRecordReader::BinaryDataRecordReader()
+{
+	m_fp = nullptr;
+	m_type = 0;
+	m_bcompress = false;
+}
+
+//-----------------------------------------------------------------------------
+BinaryDataRecordReader::~BinaryDataRecordReader()
+{
+	Close();
+}
+
+//-----------------------------------------------------------------------------
+void BinaryDataRecordReader::Close()
+{
+	if (m_fp) fclose(m_fp);
+	m_fp = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool BinaryDataRecordReader::ReadString(std::string& s)
+{
+	uint32_t n = 0;
+	if (fread(&n, sizeof(n), 1, m_fp) != 1) return false;
+	s.resize(n);
+	if ((n > 0) && (fread(&s[0], 1, n, m_fp) != n)) return false;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool BinaryDataRecordReader::Open(const char* szfile)
+{
+	Close();
+	m_fp = fopen(szfile, "rb");
+	if (m_fp == nullptr) return false;
+
+	uint32_t magic = 0, version = 0, flags = 0;
+	int32_t type = 0;
+	if ((fread(&magic, sizeof(magic), 1, m_fp) != 1) || (magic != BINARY_LOG_MAGIC) ||
+		(fread(&version, sizeof(version), 1, m_fp) != 1) || (version != BINARY_LOG_VERSION) ||
+		(fread(&type, sizeof(type), 1, m_fp) != 1) ||
+		(fread(&flags, sizeof(flags), 1, m_fp) != 1) ||
+		(ReadString(m_name) == false))
+	{
+		Close();
+		return false;
+	}
+	m_type = type;
+	m_bcompress = ((flags & BINARY_LOG_COMPRESSED) != 0);
+
+	uint32_t ncols = 0;
+	if (fread(&ncols, sizeof(ncols), 1, m_fp) != 1) { Close(); return false; }
+	m_cols.resize(ncols);
+	for (uint32_t i = 0; i < ncols; ++i)
+	{
+		if (ReadString(m_cols[i]) == false) { Close(); return false; }
+	}
+
+	uint32_t nitems = 0;
+	if (fread(&nitems, sizeof(nitems), 1, m_fp) != 1) { Close(); return false; }
+	m_items.resize(nitems);
+	if ((nitems > 0) && (fread(&m_items[0], sizeof(int32_t), nitems, m_fp) != nitems)) { Close(); return false; }
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool BinaryDataRecordReader::ReadBlock(BLOCK& block)
+{
+	if (m_fp == nullptr) return false;
+
+	uint32_t marker = 0;
+	int32_t step = 0;
+	double time = 0.0;
+	uint64_t rawSize = 0, storedSize = 0;
+	if ((fread(&marker, sizeof(marker), 1, m_fp) != 1) || (marker != BINARY_LOG_BLOCK) ||
+		(fread(&step, sizeof(step), 1, m_fp) != 1) ||
+		(fread(&time, sizeof(time), 1, m_fp) != 1) ||
+		(fread(&rawSize, sizeof(rawSize), 1, m_fp) != 1) ||
+		(fread(&storedSize, sizeof(storedSize), 1, m_fp) != 1)) return false;
+
+	if (rawSize != m_cols.size()*m_items.size()*sizeof(double)) return false;
+
+	block.step = step;
+	block.time = time;
+	block.data.resize(rawSize / sizeof(double));
+	if (rawSize == 0) return true;
+
+	if (m_bcompress)
+	{
+#ifdef HAVE_ZLIB
+		m_buf.resize(storedSize);
+		if (fread(&m_buf[0], 1, storedSize, m_fp) != storedSize) return false;
+		uLongf destLen = (uLongf)rawSize;
+		if (uncompress((Bytef*)&block.data[0], &destLen, &m_buf[0], (uLong)storedSize) != Z_OK) return false;
+		return (destLen == rawSize);
+#else
+		return false;
+#endif
+	}
+	else
+	{
+		if (storedSize != rawSize) return false;
+		return (fread(&block.data[0], 1, rawSize, m_fp) == rawSize);
+	}
+}
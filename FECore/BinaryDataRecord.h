@@ -0,0 +1,144 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Binary, columnar format for data records. All values are stored in the
+// native byte order of the machine that wrote the file.
+//
+// header:
+//   uint32   magic (BINARY_LOG_MAGIC)
+//   uint32   version (BINARY_LOG_VERSION)
+//   int32    record type (FEDataRecordType)
+//   uint32   flags (BINARY_LOG_COMPRESSED if blocks are compressed)
+//   string   name of the record
+//   uint32   number of columns, followed by the column names
+//   uint32   number of items, followed by the item IDs (int32)
+//
+// followed by one block per written step:
+//   uint32   block marker (BINARY_LOG_BLOCK)
+//   int32    time step
+//   float64  time
+//   uint64   size of the uncompressed data (in bytes)
+//   uint64   size of the stored data (in bytes)
+//   data     column-major values (float64), i.e. all items for column 0, then column 1, etc.
+//
+// Strings are stored as a uint32 length followed by the characters (without terminating zero).
+#define BINARY_LOG_MAGIC		0x474F4C46	// "FLOG"
+#define BINARY_LOG_VERSION		1
+#define BINARY_LOG_BLOCK		0x4B434C42	// "BLCK"
+#define BINARY_LOG_COMPRESSED	0x01
+
+//-----------------------------------------------------------------------------
+//! Writes data record output in the binary log format
+class FECORE_API BinaryDataRecordWriter
+{
+public:
+	BinaryDataRecordWriter();
+	~BinaryDataRecordWriter();
+
+	//! Create a new file, or open an existing file for appending. When appending,
+	//! the blocks are written with the compression setting of the existing header.
+	bool Open(const char* szfile, bool append = false);
+
+	//! close the file
+	void Close();
+
+	//! see if the file is open
+	bool IsValid() const { return (m_fp != nullptr); }
+
+	//! see if the header was written
+	bool HasHeader() const { return m_bheader; }
+
+	//! write the file header
+	bool WriteHeader(int type, const char* szname, const std::vector<std::string>& columns, const std::vector<int>& items, bool compress);
+
+	//! write the values of one time step (column-major)
+	bool WriteBlock(int step, double time, const std::vector<double>& data);
+
+	//! returns true if this build supports compression
+	static bool CompressionSupported();
+
+private:
+	FILE*	m_fp;
+	bool	m_bheader;
+	bool	m_bcompress;
+	std::vector<unsigned char>	m_buf;	//!< block buffer
+};
+
+//-----------------------------------------------------------------------------
+//! Reads data record output in the binary log format
+class FECORE_API BinaryDataRecordReader
+{
+public:
+	struct BLOCK
+	{
+		int		step;
+		double	time;
+		std::vector<double>	data;	//!< column-major values
+	};
+
+public:
+	BinaryDataRecordReader();
+	~BinaryDataRecordReader();
+
+	//! open a file and read its header
+	bool Open(const char* szfile);
+
+	//! close the file
+	void Close();
+
+	//! read the next block. Returns false at the end of the file or if the block could not be read.
+	bool ReadBlock(BLOCK& block);
+
+public:
+	int Type() const { return m_type; }
+	bool IsCompressed() const { return m_bcompress; }
+	const std::string& Name() const { return m_name; }
+	const std::vector<std::string>& Columns() const { return m_cols; }
+	const std::vector<int>& Items() const { return m_items; }
+
+	//! value of an item (by index) and column in a block
+	double Value(const BLOCK& block, int item, int column) const { return block.data[column*m_items.size() + item]; }
+
+private:
+	bool ReadString(std::string& s);
+
+private:
+	FILE*	m_fp;
+	int		m_type;
+	bool	m_bcompress;
+	std::string					m_name;
+	std::vector<std::string>	m_cols;
+	std::vector<int>			m_items;
+	std::vector<unsigned char>	m_buf;
+};
@@ -28,8 +28,12 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "CompactMatrix.h"
+#include "sys.h"
 #include <assert.h>
 
+// matrices with fewer nonzeroes are multiplied serially
+#define MIN_PARALLEL_NNZ	50000
+
 //=============================================================================
 // CompactMatrix
 //=============================================================================
@@ -41,6 +45,7 @@ CompactMatrix::CompactMatrix(int offset)
 	m_pindices = 0;
 	m_ppointers = 0;
 	m_offset = offset;
+	m_colBlockThreads = 0;
 
 	m_bdel = false;
 }
@@ -72,6 +77,10 @@ void CompactMatrix::Clear()
 	m_pindices = 0;
 	m_ppointers = 0;
 
+	m_colBlock.clear();
+	m_colBuf.clear();
+	m_colBlockThreads = 0;
+
 	SparseMatrix::Clear();
 }
 
@@ -128,3 +137,116 @@ int CompactMatrix::bandWidth()
 
 	return kmax;
 }
+
+//-----------------------------------------------------------------------------
+void CompactMatrix::BuildColumnBlocks(int nblocks, bool bsymm)
+{
+	const int NC = Columns();
+	m_colBlock.clear();
+	m_colBlockThreads = nblocks;
+
+	// the target number of nonzeroes per block
+	size_t nnz = (size_t)(m_ppointers[NC] - m_ppointers[0]);
+	size_t nmax = nnz / nblocks + 1;
+
+	size_t bufSize = 0;
+	int c0 = 0;
+	while (c0 < NC)
+	{
+		// collect columns until the block is full
+		ColumnBlock b;
+		b.c0 = c0;
+		b.r0 = (bsymm ? c0 : Rows());
+		b.r1 = 0;
+		size_t nb = 0;
+		int c1 = c0;
+		while ((c1 < NC) && ((nb < nmax) || ((int)m_colBlock.size() == nblocks - 1)))
+		{
+			const int* pi = m_pindices + (m_ppointers[c1] - m_offset);
+			int n = m_ppointers[c1 + 1] - m_ppointers[c1];
+			for (int k = 0; k < n; ++k)
+			{
+				int i = pi[k] - m_offset;
+				if (i < b.r0) b.r0 = i;
+				if (i + 1 > b.r1) b.r1 = i + 1;
+			}
+			if (bsymm && (c1 + 1 > b.r1)) b.r1 = c1 + 1;
+			nb += n;
+			c1++;
+		}
+		b.c1 = c1;
+		if (b.r1 < b.r0) b.r0 = b.r1 = 0;
+
+		b.offset = bufSize;
+		bufSize += (size_t)(b.r1 - b.r0);
+		m_colBlock.push_back(b);
+
+		c0 = c1;
+	}
+
+	m_colBuf.assign(bufSize, 0.0);
+}
+
+//-----------------------------------------------------------------------------
+bool CompactMatrix::mult_vector_columns(const double* x, double* r, bool bsymm)
+{
+	int nt = omp_get_max_threads();
+	if ((nt < 2) || (m_nsize < MIN_PARALLEL_NNZ)) return false;
+
+	// The partition only depends on the sparsity pattern (and the number of threads).
+	// Note that there can be fewer blocks than threads for small or unbalanced matrices.
+	if (m_colBlockThreads != nt) BuildColumnBlocks(nt, bsymm);
+	const int NB = (int)m_colBlock.size();
+
+	// every block does its part of the product in its own buffer
+#pragma omp parallel for schedule(static, 1)
+	for (int nb = 0; nb < NB; ++nb)
+	{
+		const ColumnBlock& b = m_colBlock[nb];
+		double* y = m_colBuf.data() + b.offset;
+		const int r0 = b.r0;
+		for (int i = 0; i < b.r1 - b.r0; ++i) y[i] = 0.0;
+
+		for (int j = b.c0; j < b.c1; ++j)
+		{
+			const double* pv = m_pd + (m_ppointers[j] - m_offset);
+			const int* pi = m_pindices + (m_ppointers[j] - m_offset);
+			const int n = m_ppointers[j + 1] - m_ppointers[j];
+			const double xj = x[j];
+			if (bsymm)
+			{
+				if (n == 0) continue;
+
+				// the diagonal element is stored first
+				double yj = pv[0] * xj;
+				for (int k = 1; k < n; ++k)
+				{
+					const int i = pi[k] - m_offset;
+					y[i - r0] += pv[k] * xj;
+					yj += pv[k] * x[i];
+				}
+				y[j - r0] += yj;
+			}
+			else
+			{
+				for (int k = 0; k < n; ++k) y[pi[k] - m_offset - r0] += pv[k] * xj;
+			}
+		}
+	}
+
+	// add the contributions of all blocks
+	const int NR = Rows();
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < NR; ++i)
+	{
+		double ri = 0.0;
+		for (int nb = 0; nb < NB; ++nb)
+		{
+			const ColumnBlock& b = m_colBlock[nb];
+			if ((i >= b.r0) && (i < b.r1)) ri += m_colBuf[b.offset + (i - b.r0)];
+		}
+		r[i] = ri;
+	}
+
+	return true;
+}
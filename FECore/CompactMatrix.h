@@ -29,6 +29,7 @@ SOFTWARE.*/
 #pragma once
 #include "SparseMatrix.h"
 #include "CSRMatrix.h"
+#include <vector>
 
 //=============================================================================
 //! This class stores a sparse matrix in Harwell-Boeing format.
@@ -83,13 +84,61 @@ public:
 	//! calculate bandwidth of matrix
 	int bandWidth();
 
+protected:
+	//! Multithreaded matrix-vector product for column-based storage. When bsymm
+	//! is true, only the lower triangular part is stored (diagonal first) and the
+	//! upper triangular part is applied as its transpose. Returns false if the 
+	//! matrix is too small (or only one thread is available), in which case the
+	//! caller should do the serial product.
+	bool mult_vector_columns(const double* x, double* r, bool bsymm);
+
+private:
+	//! Partition the columns in blocks with roughly equal nonzeroes.
+	void BuildColumnBlocks(int nblocks, bool bsymm);
+
+	// A block of consecutive columns. Each block accumulates its contribution to 
+	// the rows [r0, r1) in its own section of the work buffer, so that the 
+	// scatter to the result vector does not need any synchronization.
+	struct ColumnBlock
+	{
+		int		c0, c1;		// column range
+		int		r0, r1;		// range of rows touched by the columns
+		size_t	offset;		// offset into work buffer
+	};
+
+	std::vector<ColumnBlock>	m_colBlock;
+	std::vector<double>			m_colBuf;
+	int							m_colBlockThreads;	// nr of threads the blocks were built for (0 = none)
+
+protected:
+	//! add a value to a matrix entry. 
+	//! This uses an atomic update, unless lock-free assembly is turned on.
+	void addValue(double& a, double v)
+	{
+		if (m_blockFree) a += v;
+		else
+		{
+			#pragma omp atomic
+			a += v;
+		}
+	}
+
+	//! set a matrix entry. 
+	//! This is done in a critical section, unless lock-free assembly is turned on.
+	void setValue(double& a, double v)
+	{
+		if (m_blockFree) a = v;
+		else
+		{
+			#pragma omp critical
+			a = v;
+		}
+	}
+
 protected:
 	double*	m_pd;			//!< matrix values
 	int*	m_pindices;		//!< indices
 	int*	m_ppointers;	//!< pointers
 	int		m_offset;		//!< adjust array indices for fortran arrays
 	bool	m_bdel;			//!< delete data arrays in destructor
-
-protected:
-	std::vector<int>	P;
 };
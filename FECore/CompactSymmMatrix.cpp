@@ -40,6 +40,9 @@ CompactSymmMatrix::CompactSymmMatrix(int offset) : CompactMatrix(offset)
 //-----------------------------------------------------------------------------
 bool CompactSymmMatrix::mult_vector(double* x, double* r)
 {
+	// large matrices are multiplied on multiple threads
+	if (mult_vector_columns(x, r, true)) return true;
+
 	// get row count
 	int N = Rows();
 	int M = Columns();
@@ -190,7 +193,8 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 
 	// find the permutation array that sorts LM in ascending order
 	// we can use this to speed up the row search (i.e. loop over n below)
-	P.resize(N);
+	// NOTE: This array is local since this function can be called from multiple threads.
+	vector<int> P(N);
 	qsort(N, &LM[0], &P[0]);
 
 	// get the data pointers 
@@ -221,8 +225,7 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == I)
 				{
-					#pragma omp atomic
-					pm[n] += ke[i][j];
+					addValue(pm[n], ke[i][j]);
 					break;
 				}
 		}
@@ -257,8 +260,7 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const
 				for (int n = 0; n<l; ++n) 
 					if (pi[n] - m_offset == I)
 					{
-						#pragma omp atomic
-						pv[n] += ke[i][j];
+						addValue(pv[n], ke[i][j]);
 						break;
 					}
 			}
@@ -289,8 +291,7 @@ void CompactSymmMatrix::add(int i, int j, double v)
 			int m = pi[n];
 			if (m == i)
 			{
-				#pragma omp atomic
-				pd[n] += v;
+				addValue(pd[n], v);
 				return;
 			}
 			else if (m < i)
@@ -347,8 +348,7 @@ void CompactSymmMatrix::set(int i, int j, double v)
 			{
 				int k = m_ppointers[j] + n;
 				k -= m_offset;
-#pragma omp critical
-				m_pd[k] = v;
+				setValue(m_pd[k], v);
 				return;
 			}
 
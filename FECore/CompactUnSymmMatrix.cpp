@@ -191,7 +191,8 @@ void CRSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 
 	// find the permutation array that sorts LM in ascending order
 	// we can use this to speed up the row search (i.e. loop over n below)
-	P.resize(N);
+	// NOTE: This array is local since this function can be called from multiple threads.
+	vector<int> P(N);
 	qsort(N, &LM[0], &P[0]);
 
 	// get the data pointers 
@@ -223,8 +224,7 @@ void CRSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == J)
 				{
-#pragma omp atomic
-					pm[n] += kij;
+					addValue(pm[n], kij);
 					break;
 				}
 		}
@@ -270,8 +270,7 @@ void CRSSparseMatrix::add(int i, int j, double v)
 		int m = pi[n];
 		if (m == j)
 		{
-#pragma omp atomic
-			pd[n] += v;
+			addValue(pd[n], v);
 			return;
 		}
 		else if (m < j)
@@ -298,8 +297,7 @@ void CRSSparseMatrix::set(int i, int j, double v)
 	{
 		if (pi[n] == j + m_offset)
 		{
-#pragma omp critical
-			m_pd[m_ppointers[i] + n - m_offset] = v;
+			setValue(m_pd[m_ppointers[i] + n - m_offset], v);
 			return;
 		}
 	}
@@ -605,7 +603,8 @@ void CCSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 
 	// find the permutation array that sorts LM in ascending order
 	// we can use this to speed up the row search (i.e. loop over n below)
-	P.resize(N);
+	// NOTE: This array is local since this function can be called from multiple threads.
+	vector<int> P(N);
 	qsort(N, &LM[0], &P[0]);
 
 	// get the data pointers 
@@ -633,8 +632,7 @@ void CCSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == I)
 				{
-#pragma omp atomic
-					pm[n] += ke[i][j];
+					addValue(pm[n], ke[i][j]);
 					break;
 				}
 		}
@@ -680,8 +678,7 @@ void CCSSparseMatrix::add(int i, int j, double v)
 		int m = pi[n];
 		if (m == i)
 		{
-#pragma omp atomic
-			pd[n] += v;
+			addValue(pd[n], v);
 			return;
 		}
 		else if (m < i)
@@ -707,8 +704,7 @@ void CCSSparseMatrix::set(int i, int j, double v)
 	{
 		if (pi[n] == i + m_offset)
 		{
-#pragma omp critical
-			m_pd[m_ppointers[j] + n - m_offset] = v;
+			setValue(m_pd[m_ppointers[j] + n - m_offset], v);
 			return;
 		}
 	}
@@ -762,6 +758,9 @@ bool CCSSparseMatrix::mult_vector(double* x, double* r)
 	const int N = Rows();
 	const int M = Columns();
 
+	// large matrices are multiplied on multiple threads
+	if (mult_vector_columns(x, r, false)) return true;
+
 	// zero r
 	for (int i=0; i<N; ++i) r[i] = 0.0;
 
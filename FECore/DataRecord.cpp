@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FEModel.h"
 #include "FEAnalysis.h"
 #include "log.h"
+#include "BinaryDataRecord.h"
 #include <sstream>
 
 //-----------------------------------------------------------------------------
@@ -50,8 +51,11 @@ DataRecord::DataRecord(FEModel* pfem, int ntype) : FECoreBase(pfem), m_type(ntyp
 	strcpy(m_szdelim, " ");
 	
 	m_bcomm = true;
+	m_bbinary = false;
+	m_bcompress = false;
 
 	m_fp = 0;
+	m_bin = nullptr;
 	m_szfile[0] = 0;
 
 }
@@ -61,9 +65,23 @@ bool DataRecord::SetFileName(const char* szfile)
 {
 	if (szfile == nullptr) return false;
 
-	strcpy(m_szfile, szfile);
-	m_fp = fopen(szfile, "wt");
-	if (m_fp == 0)
+	if (szfile != m_szfile) strcpy(m_szfile, szfile);
+	if (m_fp) { fclose(m_fp); m_fp = 0; }
+	if (m_bin) { delete m_bin; m_bin = nullptr; }
+
+	bool bok = false;
+	if (m_bbinary)
+	{
+		m_bin = new BinaryDataRecordWriter;
+		bok = m_bin->Open(szfile);
+	}
+	else
+	{
+		m_fp = fopen(szfile, "wt");
+		bok = (m_fp != 0);
+	}
+
+	if (bok == false)
 	{
 		feLogError("FAILED CREATING DATA FILE %s\n\n", szfile);
 		return false;
@@ -72,6 +90,21 @@ bool DataRecord::SetFileName(const char* szfile)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// If the file was already created, it is recreated in the new format.
+void DataRecord::SetBinary(bool b, bool compress)
+{
+	bool reopen = (m_szfile[0] != 0) && (b != m_bbinary);
+	m_bbinary = b;
+	m_bcompress = compress;
+	if (m_bcompress && (BinaryDataRecordWriter::CompressionSupported() == false))
+	{
+		feLogWarning("Compression of data record output is not supported in this build.");
+		m_bcompress = false;
+	}
+	if (reopen) SetFileName(m_szfile);
+}
+
 //-----------------------------------------------------------------------------
 DataRecord::~DataRecord()
 {
@@ -80,6 +113,8 @@ DataRecord::~DataRecord()
 		fclose(m_fp);
 		m_fp = 0;
 	}
+	delete m_bin;
+	m_bin = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -115,9 +150,10 @@ std::string DataRecord::printToString(int i)
 
 	ss << m_item[i] << m_szdelim;
 	int nd = Size();
+	int N = (int)m_item.size();
 	for (int j = 0; j<nd; ++j)
 	{
-		double val = Evaluate(m_item[i], j);
+		double val = m_val[j*N + i];
 		ss << val;
 		if (j != nd - 1) ss << m_szdelim;
 		else ss << "\n";
@@ -130,6 +166,7 @@ std::string DataRecord::printToString(int i)
 std::string DataRecord::printToFormatString(int i)
 {
 	int ndata = Size();
+	int N = (int)m_item.size();
 	char szfmt[MAX_STRING];
 	strcpy(szfmt, m_szfmt);
 
@@ -164,7 +201,7 @@ std::string DataRecord::printToFormatString(int i)
 				*ch = '%'; sz = ch + 2;
 				if (j<ndata)
 				{
-					double val = Evaluate(nitem, j++);
+					double val = m_val[N*(j++) + i];
 					ss << val;
 				}
 			}
@@ -210,7 +247,18 @@ bool DataRecord::Write()
 	feLog("Time = %.9lg\n", ftime);
 	feLog("Data = %s\n", m_szname);
 
+	// evaluate all the data
+	EvaluateAll();
+
+	// binary output is written to its own file
+	if (m_bin)
+	{
+		feLog("File = %s\n", m_szfile);
+		return WriteBinary(nstep, ftime);
+	}
+
 	// write some comments
+	std::string out;
 	FILE* fp = m_fp;
 	if (fp && m_bcomm)
 	{
@@ -218,35 +266,87 @@ bool DataRecord::Write()
 		feLog("File = %s\n", m_szfile);
 
 		// make a note in the data file
-		fprintf(fp,"*Step  = %d\n", nstep);
-		fprintf(fp,"*Time  = %.9lg\n", ftime);
-		fprintf(fp,"*Data  = %s\n", m_szname);
+		char szbuf[MAX_STRING + 64];
+		sprintf(szbuf, "*Step  = %d\n", nstep); out += szbuf;
+		sprintf(szbuf, "*Time  = %.9lg\n", ftime); out += szbuf;
+		sprintf(szbuf, "*Data  = %s\n", m_szname); out += szbuf;
 	}
 
-	// save the data
-	if (m_szfmt[0]==0)
+	// format the lines in parallel
+	int N = (int)m_item.size();
+	std::vector<std::string> lines(N);
+	bool bfmt = (m_szfmt[0] != 0);
+#pragma omp parallel for if (N > 256)
+	for (int i = 0; i < N; ++i)
 	{
-		for (size_t i=0; i<m_item.size(); ++i)
-		{
-			std::string out = printToString((int)i);
+		lines[i] = (bfmt ? printToFormatString(i) : printToString(i));
+	}
 
-			if (fp) fprintf(fp, "%s", out.c_str());
-			else feLog(out.c_str(),"");
-		}
+	// save the data
+	if (fp)
+	{
+		size_t len = out.size();
+		for (int i = 0; i < N; ++i) len += lines[i].size();
+		out.reserve(len);
+		for (int i = 0; i < N; ++i) out += lines[i];
+		fwrite(out.c_str(), 1, out.size(), fp);
+		fflush(fp);
 	}
 	else
 	{
-		// print using the format string
-		for (size_t i=0; i<m_item.size(); ++i)
+		for (int i = 0; i < N; ++i) feLog(lines[i].c_str(), "");
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Evaluates all the data of this step and stores it in m_val, column by column.
+// The items are only evaluated in parallel if the record allows it.
+void DataRecord::EvaluateAll()
+{
+	int N = (int)m_item.size();
+	int nd = Size();
+	m_val.resize((size_t)N*nd);
+
+	bool bpar = ParallelEvaluation();
+#pragma omp parallel for if (bpar && (N > 256))
+	for (int i = 0; i < N; ++i)
+	{
+		int item = m_item[i];
+		for (int j = 0; j < nd; ++j) m_val[j*N + i] = Evaluate(item, j);
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool DataRecord::WriteBinary(int nstep, double ftime)
+{
+	if (m_bin->HasHeader() == false)
+	{
+		// the column names are the entries of the data expression
+		std::vector<std::string> cols;
+		std::string data(m_szdata);
+		size_t l = 0, n;
+		do
 		{
-			std::string out = printToFormatString((int)i);
+			n = data.find(';', l);
+			cols.push_back(data.substr(l, (n == std::string::npos ? n : n - l)));
+			l = n + 1;
+		}
+		while (n != std::string::npos);
 
-			if (fp) fprintf(fp, "%s", out.c_str());
-			else feLog(out.c_str(),"");
+		if (m_bin->WriteHeader(m_type, m_szname, cols, m_item, m_bcompress) == false)
+		{
+			feLogError("Failed writing header of data file %s", m_szfile);
+			return false;
 		}
 	}
 
-	if (fp) fflush(fp);
+	if (m_bin->WriteBlock(nstep, ftime, m_val) == false)
+	{
+		feLogError("Failed writing data file %s", m_szfile);
+		return false;
+	}
 
 	return true;
 }
@@ -277,6 +377,8 @@ void DataRecord::Serialize(DumpStream &ar)
 	ar & m_szdelim;
 	ar & m_szfile;
 	ar & m_bcomm;
+	ar & m_bbinary;
+	ar & m_bcompress;
 	ar & m_item;
 	ar & m_szdata;
 
@@ -287,10 +389,20 @@ void DataRecord::Serialize(DumpStream &ar)
 
 		if (m_fp) fclose(m_fp);
 		m_fp = 0;
+		delete m_bin;
+		m_bin = nullptr;
 		if (m_szfile[0] != 0)
 		{
 			// reopen data file for appending
-			m_fp = fopen(m_szfile, "a+");
+			if (m_bbinary)
+			{
+				m_bin = new BinaryDataRecordWriter;
+				if (m_bin->Open(m_szfile, true) == false)
+				{
+					feLogError("Failed to reopen binary data file %s", m_szfile);
+				}
+			}
+			else m_fp = fopen(m_szfile, "a+");
 		}
 	}
 }
@@ -39,6 +39,7 @@ SOFTWARE.*/
 class FEModel;
 class DumpStream;
 class FEItemList;
+class BinaryDataRecordWriter;
 
 //-----------------------------------------------------------------------------
 enum FEDataRecordType {
@@ -85,15 +86,25 @@ public:
 	void SetFormat(const char* sz);
 	void SetComments(bool b) { m_bcomm = b; }
 
+	//! write the data in the binary log format (see BinaryDataRecord.h)
+	void SetBinary(bool b, bool compress = false);
+
 public:
 	virtual bool Initialize();
 	virtual double Evaluate(int item, int ndata) = 0;
+
+	//! Return true if Evaluate can be called concurrently for different items.
+	//! Records that opt in may not modify any shared state in Evaluate.
+	virtual bool ParallelEvaluation() const { return false; }
+
 	virtual void SelectAllItems() = 0;
 	virtual void Serialize(DumpStream& ar);
 	virtual void SetData(const char* sz) = 0;
 	virtual int Size() const = 0;
 
 private:
+	void EvaluateAll();
+	bool WriteBinary(int nstep, double ftime);
 	std::string printToString(int i);
 	std::string printToFormatString(int i);
 
@@ -108,10 +119,15 @@ protected:
 	char	m_szdelim[MAX_DELIM];	//!< data delimitor
 	char	m_szdata[MAX_STRING];	//!< data expression
 	char	m_szfmt[MAX_STRING];	//!< max format string
+	bool	m_bbinary;				//!< write binary output
+	bool	m_bcompress;			//!< compress binary output
 
 protected:
 	char	m_szfile[MAX_STRING];	//!< file name of data record
 	FILE*		m_fp;
+	BinaryDataRecordWriter*	m_bin;	//!< writer for binary output
+
+	std::vector<double>	m_val;	//!< values of the current step (column-major)
 };
 
 //=========================================================================
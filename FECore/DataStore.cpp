@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "log.h"
 #include "FEModel.h"
 #include "FEAnalysis.h"
+#include "FEProfiler.h"
 
 //-----------------------------------------------------------------------------
 DataStore::DataStore()
@@ -56,6 +57,7 @@ void DataStore::Write()
 	for (size_t i=0; i<m_data.size(); ++i)
 	{
 		DataRecord& DR = *m_data[i];
+		TRACK_COMPONENT(&DR, "Write");
 		DR.Write();
 	}
 }
@@ -56,6 +56,17 @@ void DumpMemStream::clear()
 	Open(true, true);
 }
 
+//-----------------------------------------------------------------------------
+// Same as clear, but the buffer is kept so that it can be reused without
+// reallocating it.
+void DumpMemStream::reset()
+{
+	m_pd = m_pb;
+	m_nsize = 0;
+
+	Open(true, true);
+}
+
 //-----------------------------------------------------------------------------
 void DumpMemStream::Open(bool bsave, bool bshallow)
 {
@@ -45,7 +45,11 @@ public: // overloaded from base class
 	void clear();
 	void Open(bool bsave, bool bshallow);
 
+	// empty the stream, but keep the allocated buffer
+	void reset();
+
 	size_t size() const { return m_nsize; }
+	const char* data() const { return m_pb; }
 	size_t reserved() const { return m_nreserved; }
 	bool EndOfStream() const;
 
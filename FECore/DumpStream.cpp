@@ -34,6 +34,7 @@ DumpStream::DumpStream(FEModel& fem) : m_fem(fem)
 {
 	m_bsave = false;
 	m_bshallow = false;
+	m_bexcludeNodes = false;
 	m_bytes_serialized = 0;
 	m_ptr_lock = false;
 
@@ -78,6 +79,20 @@ bool DumpStream::HasTypeInfo() const
 	return m_btypeInfo;
 }
 
+//-----------------------------------------------------------------------------
+// set the flag that excludes the nodal data from shallow streams
+void DumpStream::ExcludeNodalData(bool b)
+{
+	m_bexcludeNodes = b;
+}
+
+//-----------------------------------------------------------------------------
+// see if the nodal data is excluded from shallow streams
+bool DumpStream::ExcludesNodalData() const
+{
+	return m_bexcludeNodes;
+}
+
 //-----------------------------------------------------------------------------
 void DumpStream::Open(bool bsave, bool bshallow)
 {
@@ -148,6 +148,13 @@ public:
 	// see if the stream has type info
 	bool HasTypeInfo() const;
 
+	// set the flag that excludes the nodal data from shallow streams
+	// (This is used when the nodal data is stored elsewhere, e.g. by FEStateSnapshot)
+	void ExcludeNodalData(bool b);
+
+	// see if the nodal data is excluded from shallow streams
+	bool ExcludesNodalData() const;
+
 	// return total nr of bytes that was serialized
 	size_t bytesSerialized() const { return m_bytes_serialized; }
 
@@ -235,6 +242,7 @@ private:
 	bool		m_bsave;	//!< true if output stream, false for input stream
 	bool		m_bshallow;	//!< if true only shallow data needs to be serialized
 	bool		m_btypeInfo;	//!< write/read type info
+	bool		m_bexcludeNodes;	//!< exclude nodal data from shallow streams
 	FEModel&	m_fem;		//!< the FE Model that is being serialized
 
 	size_t	m_bytes_serialized;	//!< number or bytes serialized
@@ -65,11 +65,27 @@ void ElementDataRecord::SetData(const char *szexpr)
 }
 
 //-----------------------------------------------------------------------------
-double ElementDataRecord::Evaluate(int item, int ndata)
+bool ElementDataRecord::Initialize()
+{
+	if (DataRecord::Initialize() == false) return false;
+
+	// The ELT is built here and not on first use, since the items
+	// can be evaluated concurrently (see ParallelEvaluation).
+	BuildELT();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void ElementDataRecord::Serialize(DumpStream& ar)
 {
-	// make sure we have an ELT
-	if (m_ELT.empty()) BuildELT();
+	DataRecord::Serialize(ar);
+	if (ar.IsShallow()) return;
+	if (ar.IsLoading()) BuildELT();
+}
 
+//-----------------------------------------------------------------------------
+double ElementDataRecord::Evaluate(int item, int ndata)
+{
 	// find the element
 	FEMesh& mesh = GetFEModel()->GetMesh();
 	int index = item - m_offset;
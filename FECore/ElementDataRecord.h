@@ -58,7 +58,10 @@ class FECORE_API ElementDataRecord : public DataRecord
 
 public:
 	ElementDataRecord(FEModel* pfem);
+	bool Initialize() override;
 	double Evaluate(int item, int ndata);
+	bool ParallelEvaluation() const override { return true; }
+	void Serialize(DumpStream& ar) override;
 	void SetData(const char* sz) override;
 	void SelectAllItems();
 	int Size() const;
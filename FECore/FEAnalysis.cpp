@@ -34,7 +34,7 @@ SOFTWARE.*/
 #include "DOFS.h"
 #include "MatrixProfile.h"
 #include "FEBoundaryCondition.h"
-#include "DumpMemStream.h"
+#include "FEStateSnapshot.h"
 #include "FELinearConstraintManager.h"
 #include "FEShellDomain.h"
 #include "FEMeshAdaptor.h"
@@ -98,6 +98,7 @@ FEAnalysis::FEAnalysis(FEModel* fem) : FECoreBase(fem)
 	m_ntotref    = 0;		// total nr of stiffness reformations
 	m_ntotiter   = 0;		// total nr of non-linear iterations
 	m_ntimesteps = 0;		// time steps completed
+	m_snapshotSize = 0;
 	m_ntotrhs    = 0;		// total nr of right hand side evaluations
 
 	// --- I/O Data ---
@@ -218,6 +219,7 @@ void FEAnalysis::Reset()
 	m_ntotref    = 0;		// total nr of stiffness reformations
 	m_ntotiter   = 0;		// total nr of non-linear iterations
 	m_ntimesteps = 0;		// time steps completed
+	m_snapshotSize = 0;
 	m_ntotrhs    = 0;		// total nr of right hand side evaluations
 
 	m_dt = m_dt0;
@@ -406,8 +408,8 @@ bool FEAnalysis::Solve()
 		if (m_timeController) m_timeController->AutoTimeStep(0);
 	}
 
-	// dump stream for running restarts
-	DumpMemStream dmp(fem);
+	// snapshot of the model state for retrying time steps
+	FEStateSnapshot snapshot(fem);
 
 	// repeat for all timesteps
 	if (m_timeController) m_timeController->m_nretries = 0;
@@ -417,8 +419,8 @@ bool FEAnalysis::Solve()
 		// we need to retry this time step
 		if (m_timeController && (m_timeController->m_maxretries > 0))
 		{ 
-			dmp.clear();
-			fem.Serialize(dmp); 
+			snapshot.Save();
+			if (snapshot.Size() > m_snapshotSize) m_snapshotSize = snapshot.Size();
 		}
 
 		// Inform that the time is about to change. (Plugins can use 
@@ -506,8 +508,7 @@ bool FEAnalysis::Solve()
 			if (m_timeController && (m_timeController->m_nretries < m_timeController->m_maxretries))
 			{
 				// restore the previous state
-				dmp.Open(false, true);
-				fem.Serialize(dmp);
+				snapshot.Restore();
 				
 				// let's try again
 				m_timeController->Retry();
@@ -160,6 +160,8 @@ public:
 		double	m_tend;			//!< end time
 
 		FETimeStepController* m_timeController;
+
+		size_t	m_snapshotSize;	//!< size (in bytes) of the state that is kept for retrying time steps
 	//}
 
 	// --- Quasi-Newton Solver Variables ---
@@ -301,3 +301,11 @@ void FEBroydenStrategy::SolveEquations(vector<double>& x, vector<double>& b)
 	}
 }
 */
+
+//-----------------------------------------------------------------------------
+size_t FEBroydenStrategy::MemoryUsage() const
+{
+	size_t n = (size_t)m_R.rows()*m_R.columns() + (size_t)m_D.rows()*m_D.columns();
+	n += m_rho.capacity() + m_q.capacity();
+	return n*sizeof(double);
+}
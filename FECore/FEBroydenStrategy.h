@@ -50,6 +50,9 @@ public:
 	//! Presolve update
 	virtual void PreSolveUpdate() override;
 
+	//! memory used by the update vectors
+	size_t MemoryUsage() const override;
+
 private:
 	// keep a pointer to the linear solver
 	LinearSolver*	m_plinsolve;	//!< pointer to linear solver
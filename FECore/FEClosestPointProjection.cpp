@@ -51,12 +51,29 @@ FEClosestPointProjection::FEClosestPointProjection(FESurface& s) : m_surf(s)
 bool FEClosestPointProjection::Init()
 {
 	// initialize the nearest neighbor search
-	m_SNQ.Attach(&m_surf);
-	m_SNQ.Init();
+	int N = m_surf.Nodes();
+	std::vector<vec3d> r(N);
+	for (int i = 0; i < N; ++i) r[i] = m_surf.Node(i).m_rt;
+	m_tree.Build(r);
 
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+void FEClosestPointProjection::Update()
+{
+	int N = m_surf.Nodes();
+	if (m_tree.Items() != N) { Init(); return; }
+
+	std::vector<vec3d> r(N);
+	for (int i = 0; i < N; ++i) r[i] = m_surf.Node(i).m_rt;
+	m_tree.Refit(r);
+
+	// a refitted tree stays exact, but queries slow down when the nodes
+	// have moved far from where they were when the tree was built.
+	if (m_tree.Degradation() > 2.0) m_tree.Build(r);
+}
+
 //-----------------------------------------------------------------------------
 // helper function for projecting a point onto an edge
 bool Project2Edge(const vec3d& p0, const vec3d& p1, const vec3d& x, vec3d& q)
@@ -169,7 +186,7 @@ FESurfaceElement* FEClosestPointProjection::Project(const vec3d& x, vec3d& q, ve
 	FEMesh& mesh = *m_surf.GetMesh();
 
 	// let's find the closest node
-	int mn = m_SNQ.Find(x);
+	int mn = m_tree.FindNearest(x);
 	if (mn < 0) return nullptr;
 
 	// make sure it is within the search radius
@@ -218,40 +235,15 @@ FESurfaceElement* FEClosestPointProjection::Project(int nodeIndex, vec3d& q, vec
 	// Find the closest surface node to x that:
 	// 1. is within the search radius
 	// 2. its star does not contain n
-	int mn = -1;	// local index of closest node
-	double d2min;	// min squared distance
-	int N = m_surf.Nodes();
-	double R2 = m_rad * m_rad;
-	for (int i = 0; i < N; ++i)
-	{
-		if (m_surf.NodeIndex(i) != nodeIndex)
-		{
-			vec3d r = m_surf.Node(i).m_rt;
-			double d2 = (r - x)*(r - x);
-
-			// make sure the node lies within the search radius
-			if ((m_rad == 0) || (d2 <= R2))
-			{
-				bool bok = true;
+	int mn = m_tree.FindNearest(x, m_rad, [&](int i) {
+		if (m_surf.NodeIndex(i) == nodeIndex) return false;
 
-				// The node cannot be part of the star of the closest point
-				FEPatch patch(&m_surf, m_NEL.ElementList(i), m_NEL.Valence(i));
-				if (patch.HasNode(nodeIndex))
-				{
-					bok = false;
-				}
-
-				// make sure the point is closer than the last one
-				if (bok && ((mn == -1) || (d2 < d2min)))
-				{
-					d2min = d2;
-					mn = i;
-					q = r;
-				}
-			}
-		}
-	}
+		// The node cannot be part of the star of the closest point
+		FEPatch patch(&m_surf, m_NEL.ElementList(i), m_NEL.Valence(i));
+		return (patch.HasNode(nodeIndex) == false);
+	});
 	if (mn == -1) return nullptr;
+	q = m_surf.Node(mn).m_rt;
 
 	// now that we found the closest node, lets see if we can find 
 	// the best element
@@ -299,38 +291,17 @@ FESurfaceElement* FEClosestPointProjection::Project(FESurfaceElement* pse, int i
 	}
 
 	// find the closest point
-	int mn = -1;
-	double d2min;
-	double R2 = m_rad * m_rad;
-	int N = m_surf.Nodes();
-	for (int i = 0; i < N; ++i)
-	{
-		vec3d ri = m_surf.Node(i).m_rt;
-		double d2 = (ri - x)*(ri - x);
-
-		// make sure the node lies within the search radius
-		if ((R2 == 0) || (d2 <= R2))
+	int mn = m_tree.FindNearest(x, m_rad, [&](int i) {
+		if (check_self_projection)
 		{
-			bool bok = true;
-			if (check_self_projection)
-			{
-				// The pse element cannot be part of the star of the closest point
-				FEPatch patch(&m_surf, m_NEL.ElementList(i), m_NEL.Valence(i));
-				if (patch.Contains(*pse))
-				{
-					bok = false;
-				}
-			}
-
-			if (bok && ((mn == -1) || (d2 < d2min)))
-			{
-				d2min = d2;
-				mn = i;
-				q = ri;
-			}
+			// The pse element cannot be part of the star of the closest point
+			FEPatch patch(&m_surf, m_NEL.ElementList(i), m_NEL.Valence(i));
+			if (patch.Contains(*pse)) return false;
 		}
-	}
+		return true;
+	});
 	if (mn == -1) return nullptr;
+	q = m_surf.Node(mn).m_rt;
 
 	// mn is a local index, so get the global node number too
 	int m = m_surf.NodeIndex(mn);
@@ -358,6 +329,42 @@ FESurfaceElement* FEClosestPointProjection::Project(FESurfaceElement* pse, int i
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+FESurfaceElement* FEClosestPointProjection::ProjectNeighbors(FESurfaceElement& pe, const vec3d& x, vec3d& q, vec2d& r)
+{
+	// see if it still projects to the same element
+	q = m_surf.ProjectToSurface(pe, x, r[0], r[1]);
+	if (m_surf.IsInsideElement(pe, r[0], r[1], m_tol)) return &pe;
+
+	// if not, pick the closest of its neighbors
+	FESurfaceElement* pemin = nullptr;
+	double d2min = 0;
+	int nf = pe.facet_edges();
+	for (int k = 0; k < nf; ++k)
+	{
+		FESurfaceElement* pn = dynamic_cast<FESurfaceElement*>(m_EEL.Neighbor(pe.m_lid, k));
+		if (pn)
+		{
+			double rk = 0, sk = 0;
+			vec3d qk = m_surf.ProjectToSurface(*pn, x, rk, sk);
+			if (m_surf.IsInsideElement(*pn, rk, sk, m_tol))
+			{
+				double d2 = (x - qk).norm2();
+				if ((pemin == nullptr) || (d2 < d2min))
+				{
+					pemin = pn;
+					d2min = d2;
+					q = qk;
+					r[0] = rk;
+					r[1] = sk;
+				}
+			}
+		}
+	}
+
+	return pemin;
+}
+
 bool FEClosestPointProjection::ContainsElement(FESurfaceElement* el)
 {
 	if (el == nullptr) return false;
@@ -28,7 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include "FESurface.h"
-#include "FENNQuery.h"
+#include "FESpatialTree.h"
 #include "FEElemElemList.h"
 #include "FENodeElemList.h"
 
@@ -44,6 +44,11 @@ public:
 	//! Initialization
 	bool Init();
 
+	//! Update the search tree after the surface nodes have moved. The tree is
+	//! refitted to the new positions and only rebuilt when it has degraded too much.
+	//! This calls Init if the tree was not built yet.
+	void Update();
+
 	//! Project a point onto surface
 	FESurfaceElement* Project(const vec3d& x, vec3d& q, vec2d& r);
 
@@ -53,6 +58,10 @@ public:
 	//! Project a point of a surface element onto a surface
 	FESurfaceElement* Project(FESurfaceElement* pse, int intgrPoint, vec3d& q, vec2d& r);
 
+	//! Project a point onto the element pe or, if it does not project inside pe, onto
+	//! one of its neighbors. Returns nullptr if none of these elements contains the projection.
+	FESurfaceElement* ProjectNeighbors(FESurfaceElement& pe, const vec3d& x, vec3d& q, vec2d& r);
+
 public:
 	//! Set the projection tolerance
 	void SetTolerance(double t) { m_tol = t; }
@@ -81,7 +90,7 @@ protected:
 
 protected:
 	FESurface&		m_surf;		//!< reference to surface
-	FENNQuery		m_SNQ;		//!< used to find the nearest neighbour
+	FESpatialTree	m_tree;		//!< used to find the nearest neighbour
 	FENodeElemList	m_NEL;		//!< node-element tree
 	FEElemElemList	m_EEL;		//!< element neighbor list
 };
@@ -57,6 +57,13 @@ void FEDomain::CreateMaterialPointData()
 {
 	FEMaterial* pmat = GetMaterial();
 	FEMesh* mesh = GetMesh();
+
+	// This is called again when the mesh is refined, so release the previous
+	// generation of material points first.
+	ClearMaterialPointData();
+
+	// allocate all the material point data from the domain's arena
+	FEMaterialPointArena::Scope arena(m_arena);
 	if (pmat) ForEachElement([=](FEElement& el) {
 
 		vec3d r[FEElement::MAX_NODES];
@@ -73,6 +80,22 @@ void FEDomain::CreateMaterialPointData()
 	});
 }
 
+//-----------------------------------------------------------------------------
+// NOTE: When elements are given a new type, their state is reset without deleting
+// the material points. Those points were allocated from the arena, so they are
+// released when the arena is cleared.
+void FEDomain::ClearMaterialPointData()
+{
+	ForEachElement([](FEElement& el) { if (el.GetTraits()) el.ClearData(); });
+	m_arena.Clear();
+}
+
+//-----------------------------------------------------------------------------
+size_t FEDomain::MaterialPointMemory() const
+{
+	return m_arena.Size();
+}
+
 //-----------------------------------------------------------------------------
 // serialization
 void FEDomain::Serialize(DumpStream& ar)
@@ -117,7 +140,9 @@ void FEDomain::Serialize(DumpStream& ar)
 
 			int NEL = 0;
 			ar >> NEL;
+			ClearMaterialPointData();
 			Create(NEL, espec);
+			FEMaterialPointArena::Scope arena(m_arena);
 			for (int i = 0; i < NEL; ++i)
 			{
 				FEElement& el = ElementRef(i);
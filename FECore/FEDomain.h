@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include "FEMeshPartition.h"
+#include "FEMaterialPointArena.h"
 
 // forward declaration of material class
 class FEMaterial;
@@ -53,6 +54,9 @@ public:
 	//! \todo Perhaps I can make this part of the "creation" routine
 	void CreateMaterialPointData();
 
+	//! memory (in bytes) that is reserved for the material point data of this domain
+	size_t MaterialPointMemory() const;
+
 	// serialization
 	void Serialize(DumpStream& ar) override;
 
@@ -83,4 +87,14 @@ protected:
 
 	// helper function for unpacking element dofs
 	void UnpackLM(FEElement& el, const FEDofList& dof, vector<int>& lm);
+
+private:
+	// delete the material point data of all elements and release the arena
+	void ClearMaterialPointData();
+
+private:
+	// Storage for the material point data of this domain.
+	// NOTE: This must be destroyed after the elements, which is guaranteed since
+	// the element lists are members of the derived classes.
+	FEMaterialPointArena	m_arena;
 };
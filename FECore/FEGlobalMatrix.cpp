@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FEModel.h"
 #include "FEDomain.h"
 #include "FESurface.h"
+#include <algorithm>
 
 //-----------------------------------------------------------------------------
 FEElementMatrix::FEElementMatrix(const FEElement& el)
@@ -90,6 +91,9 @@ FEGlobalMatrix::FEGlobalMatrix(SparseMatrix* pK, bool del)
 	m_pMP = 0;
 	m_nlm = 0;
 	m_delA = del;
+	m_bdynamic = false;
+	m_bpatch = false;
+	m_bnewProfile = true;
 }
 
 //-----------------------------------------------------------------------------
@@ -120,6 +124,7 @@ void FEGlobalMatrix::build_begin(int neq)
 	m_pMP->CreateDiagonal();
 
 	m_nlm = 0;
+	m_bpatch = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -155,6 +160,12 @@ void FEGlobalMatrix::build_flush()
 		{
 			lm = &(m_LM[i])[0];
 			for (j=0; j<n; ++j) if (lm[j] < -1) lm[j] = -lm[j]-2;
+
+			// keep track of the columns that the dynamic elements touch
+			if (m_bdynamic)
+			{
+				for (j = 0; j<n; ++j) if (lm[j] >= 0) m_dynCols.push_back(lm[j]);
+			}
 		}
 	}
 
@@ -173,6 +184,21 @@ void FEGlobalMatrix::build_end()
 
 //-----------------------------------------------------------------------------
 bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
+{
+	// build the profile
+	if (BuildProfile(pfem, neq, breset) == false) return false;
+
+	// create the actual sparse matrix, unless we can keep the current one.
+	if (m_bnewProfile) build_end();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Builds the matrix profile from a FEM object. The sparse matrix itself is not created.
+//! Instead, the new profile is compared with the previous one, and ProfileChanged() 
+//! will return true if the sparse matrix needs to be created again with build_end().
+bool FEGlobalMatrix::BuildProfile(FEModel* pfem, int neq, bool breset)
 {
 	// The first time we come here we build the "static" profile.
 	// This static profile stores the contribution to the matrix profile
@@ -182,6 +208,57 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 	// reconstructing it every time we come here saves us a lot of time. The 
 	// static profile is stored in the variable m_MPs.
 
+	// the sparse matrix must be created again if it was cleared.
+	bool bvalid = ((m_pA->Rows() == neq) && (m_pA->NonZeroes() > 0));
+
+	// When the static profile did not change, we only need to update the columns 
+	// that are touched by the dynamic elements. Only these columns can differ 
+	// from the static profile.
+	if ((breset == false) && m_bpatch && m_pMP && (m_pMP->Rows() == neq) && (m_MPs.Rows() == neq))
+	{
+		SparseMatrixProfile& MP = *m_pMP;
+
+		// reset the old dynamic columns to the static profile, but keep a copy
+		// so we can see if anything changed.
+		vector<int> oldCols;
+		oldCols.swap(m_dynCols);
+		vector<SparseMatrixProfile::ColumnProfile> oldProf;
+		oldProf.reserve(oldCols.size());
+		for (int c : oldCols)
+		{
+			oldProf.push_back(MP.Column(c));
+			MP.Column(c) = m_MPs.Column(c);
+		}
+
+		// Add the "dynamic" profile
+		m_bdynamic = true;
+		pfem->BuildMatrixProfile(*this, false);
+		if (m_nlm > 0) build_flush();
+		m_bdynamic = false;
+		std::sort(m_dynCols.begin(), m_dynCols.end());
+		m_dynCols.erase(std::unique(m_dynCols.begin(), m_dynCols.end()), m_dynCols.end());
+
+		// see if any of the columns changed
+		bool bsame = true;
+		for (size_t i = 0; bsame && (i < oldCols.size()); ++i)
+		{
+			if (MP.Column(oldCols[i]) != oldProf[i]) bsame = false;
+		}
+		for (size_t i = 0; bsame && (i < m_dynCols.size()); ++i)
+		{
+			// new columns were identical to the static profile before
+			int c = m_dynCols[i];
+			if ((std::binary_search(oldCols.begin(), oldCols.end(), c) == false) && (MP.Column(c) != m_MPs.Column(c))) bsame = false;
+		}
+
+		m_bnewProfile = ((bsame == false) || (bvalid == false));
+		return true;
+	}
+
+	// keep the old profile so we can compare it with the new one
+	SparseMatrixProfile* oldMP = m_pMP;
+	m_pMP = nullptr;
+
 	// begin building the profile
 	build_begin(neq);
 	{
@@ -192,7 +269,7 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 		// static profile is stored in the MP object. Next time
 		// we come here we simply copy the MP object in stead
 		// of building it from scratch.
-		if (breset)
+		if (breset || (m_MPs.Rows() != neq))
 		{
 			m_MPs.Clear();
 
@@ -211,11 +288,25 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 		}
 
 		// Add the "dynamic" profile
+		m_dynCols.clear();
+		m_bdynamic = true;
 		pfem->BuildMatrixProfile(*this, false);
+		if (m_nlm > 0) build_flush();
+		m_bdynamic = false;
+		std::sort(m_dynCols.begin(), m_dynCols.end());
+		m_dynCols.erase(std::unique(m_dynCols.begin(), m_dynCols.end()), m_dynCols.end());
 	}
-	// All done! We can now finish building the profile and create 
-	// the actual sparse matrix. This is done in the following function
-	build_end();
+	m_bpatch = true;
+
+	// compare the new profile to the old one
+	bool bsame = (oldMP && (oldMP->Rows() == neq) && (oldMP->Columns() == neq));
+	for (int i = 0; bsame && (i < neq); ++i)
+	{
+		if (m_pMP->Column(i) != oldMP->Column(i)) bsame = false;
+	}
+	delete oldMP;
+
+	m_bnewProfile = ((bsame == false) || (bvalid == false));
 
 	return true;
 }
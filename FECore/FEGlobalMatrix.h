@@ -116,6 +116,13 @@ public:
 	//! construct the stiffness matrix from a FEM object
 	bool Create(FEModel* pfem, int neq, bool breset);
 
+	//! build the matrix profile from a FEM object, without creating the sparse matrix
+	bool BuildProfile(FEModel* pfem, int neq, bool breset);
+
+	//! Returns true if the sparse matrix needs to be (re)created after the last call to BuildProfile,
+	//! i.e. when the profile changed or the sparse matrix was cleared.
+	bool ProfileChanged() const { return m_bnewProfile; }
+
 	//! construct the stiffness matrix from a mesh
 	bool Create(FEMesh& mesh, int neq);
 
@@ -170,4 +177,11 @@ protected:
 	SparseMatrixProfile		m_MPs;		//!< the "static" part of the matrix profile
 	vector< vector<int> >	m_LM;		//!< used for building the stiffness matrix
 	int	m_nlm;				//!< nr of elements in m_LM array
+
+	// The following data is used to detect changes in the profile, and to only 
+	// update the "dynamic" part of the profile when the static part did not change.
+	std::vector<int>	m_dynCols;		//!< columns touched by the "dynamic" elements
+	bool	m_bdynamic;					//!< building the "dynamic" part of the profile
+	bool	m_bpatch;					//!< m_pMP was built from m_MPs and can be patched
+	bool	m_bnewProfile;				//!< the sparse matrix needs to be (re)created
 };
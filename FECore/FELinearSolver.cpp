@@ -42,6 +42,7 @@ SOFTWARE.*/
 #include "FEBodyLoad.h"
 #include "DumpStream.h"
 #include "FELinearConstraintManager.h"
+#include "FEProfiler.h"
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -183,7 +184,11 @@ bool FELinearSolver::SolveStep()
 	for (int i=0; i<nbc; ++i)
 	{
 		FEBoundaryCondition& bc = *fem.BoundaryCondition(i);
-		if (bc.IsActive()) bc.PrepStep(m_u, false);
+		if (bc.IsActive())
+		{
+			TRACK_COMPONENT(&bc, "PrepStep");
+			bc.PrepStep(m_u, false);
+		}
 	}
 
 	// build the right-hand side
@@ -353,7 +358,11 @@ void FELinearSolver::ForceVector(FEGlobalVector& R)
 	for (int i = 0; i < nml; ++i)
 	{
 		FEModelLoad& ml = *fem.ModelLoad(i);
-		if (ml.IsActive()) ml.LoadVector(R);
+		if (ml.IsActive())
+		{
+			TRACK_COMPONENT(&ml, "LoadVector");
+			ml.LoadVector(R);
+		}
 	}
 }
 
@@ -30,17 +30,24 @@ SOFTWARE.*/
 #include "FELinearSystem.h"
 #include "FELinearConstraintManager.h"
 #include "FEModel.h"
+#include "sys.h"
+#include <chrono>
+using namespace std::chrono;
 
 //-----------------------------------------------------------------------------
 FELinearSystem::FELinearSystem(FESolver* solver, FEGlobalMatrix& K, vector<double>& F, vector<double>& u, bool bsymm) : m_K(K), m_F(F), m_u(u), m_solver(solver)
 {
 	m_bsymm = bsymm;
+	m_blockFree = false;
+	m_assemblyTime.assign(omp_get_max_threads(), 0.0);
 }
 
 //-----------------------------------------------------------------------------
 FELinearSystem::~FELinearSystem()
 {
-
+	// add the assembly time to the model's assembly timer
+	FEModel* fem = (m_solver ? m_solver->GetFEModel() : nullptr);
+	if (fem) fem->GetTimer(TimerID::Timer_Assemble)->add(AssemblyTime());
 }
 
 //-----------------------------------------------------------------------------
@@ -57,12 +64,55 @@ FESolver* FELinearSystem::GetSolver()
 	return m_solver;
 }
 
+//-----------------------------------------------------------------------------
+// see if colored assembly was requested
+bool FELinearSystem::ColoredAssembly() const
+{
+	if ((m_solver == nullptr) || (m_solver->m_bcolored_assembly == false)) return false;
+
+	// Linear constraints can couple equations of nodes that are not connected
+	// by elements, so we cannot use colored assembly in that case.
+	FEModel* fem = m_solver->GetFEModel();
+	if (fem && (fem->GetLinearConstraintManager().LinearConstraints() > 0)) return false;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// turn lock-free assembly on or off
+void FELinearSystem::SetLockFreeAssembly(bool b)
+{
+	m_blockFree = b;
+	SparseMatrix* K = m_K.GetSparseMatrixPtr();
+	if (K) K->SetLockFreeAssembly(b);
+}
+
+//-----------------------------------------------------------------------------
+// Get the time spent in assembly (averaged over all threads)
+double FELinearSystem::AssemblyTime() const
+{
+	if (m_assemblyTime.empty()) return 0.0;
+	double sum = 0.0;
+	for (double ti : m_assemblyTime) sum += ti;
+	return sum / (double)m_assemblyTime.size();
+}
+
+//-----------------------------------------------------------------------------
+// add to the assembly time of the calling thread
+void FELinearSystem::AddAssemblyTime(double sec)
+{
+	int n = omp_get_thread_num();
+	if ((n >= 0) && (n < (int)m_assemblyTime.size())) m_assemblyTime[n] += sec;
+}
+
 //-----------------------------------------------------------------------------
 //! assemble global stiffness matrix
 void FELinearSystem::Assemble(const FEElementMatrix& ke)
 {
 	if ((ke.rows() == 0) || (ke.columns() == 0)) return;
 
+	time_point<steady_clock> t0 = steady_clock::now();
+
 	// assemble into the global stiffness
 	m_K.Assemble(ke);
 
@@ -88,8 +138,12 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 				if (I >= 0)
 				{
 					// dof i is not a prescribed degree of freedom
+					if (m_blockFree) m_F[I] -= ke[i][j] * m_u[J];
+					else
+					{
 #pragma omp atomic
-					m_F[I] -= ke[i][j] * m_u[J];
+						m_F[I] -= ke[i][j] * m_u[J];
+					}
 				}
 			}
 
@@ -98,16 +152,18 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 		}
 	}
 
-#pragma omp critical
-	{
 	FEModel* fem = m_solver->GetFEModel();
 	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
 	if (LCM.LinearConstraints())
 	{
+#pragma omp critical
+		{
 		const vector<int>& en = ke.Nodes();
 		LCM.AssembleStiffness(m_K, m_F, m_u, en, lmi, lmj, ke);
+		} // omp critical
 	}
-	} // omp critical
+
+	AddAssemblyTime(duration_cast<dseconds>(steady_clock::now() - t0).count());
 }
 
 //-----------------------------------------------------------------------------
@@ -55,6 +55,21 @@ public:
 	// Get the solver that is using this linear system
 	FESolver* GetSolver();
 
+public:
+	// see if colored assembly was requested
+	bool ColoredAssembly() const;
+
+	// turn lock-free assembly on or off.
+	// This should only be turned on when the caller can guarantee that
+	// no two threads assemble into the same equations at the same time.
+	void SetLockFreeAssembly(bool b);
+
+	// is lock-free assembly on?
+	bool LockFreeAssembly() const { return m_blockFree; }
+
+	// Get the time spent in assembly (averaged over all threads)
+	double AssemblyTime() const;
+
 public:
 	// Assembly routine
 	// This assembles the element stiffness matrix ke into the global matrix.
@@ -68,10 +83,18 @@ public:
 	// This assembles a vetor to the RHS
 	void AssembleRHS(std::vector<int>& lm, std::vector<double>& fe);
 
+protected:
+	// add to the assembly time of the calling thread
+	void AddAssemblyTime(double sec);
+
 protected:
 	bool					m_bsymm;	//!< symmetry flag
+	bool					m_blockFree;	//!< lock-free assembly flag
 	FESolver*				m_solver;
 	FEGlobalMatrix&			m_K;	//!< The global stiffness matrix
 	std::vector<double>&	m_F;	//!< Contributions from prescribed degrees of freedom
 	std::vector<double>&	m_u;	//!< the array with prescribed values
+
+private:
+	std::vector<double>		m_assemblyTime;	//!< time spent in assembly for each thread
 };
@@ -30,6 +30,10 @@ SOFTWARE.*/
 #include "FEMaterialPoint.h"
 #include "DumpStream.h"
 #include <string.h>
+#include <assert.h>
+#include <map>
+#include <mutex>
+#include <string>
 
 FEMaterialPointData::FEMaterialPointData(FEMaterialPointData* ppt)
 {
@@ -91,6 +95,8 @@ FEMaterialPoint::~FEMaterialPoint()
 
 void FEMaterialPoint::Init()
 {
+	// the data list is complete at this point, so we (re)start with an empty table
+	m_table.Clear();
 	if (m_data) m_data->Init();
 }
 
@@ -120,6 +126,44 @@ void FEMaterialPoint::Append(FEMaterialPointData* pt)
 	if (pt == nullptr) return;
 	assert(m_data);
 	if (m_data) m_data->Append(pt);
+	m_table.Clear();
+}
+
+//=================================================================================================
+void FEMaterialPointDataTable::Insert(int ntype, void* pd)
+{
+	for (int i = 0; i < MAX_ENTRIES; ++i)
+	{
+		int n = 0;
+		if (m_type[i].compare_exchange_strong(n, -1))
+		{
+			m_data[i] = pd;
+			m_type[i].store(ntype, std::memory_order_release);
+			return;
+		}
+
+		// another thread may have added this type already
+		if (n == ntype) return;
+	}
+
+	// The table is full. This is not an error: ExtractData will just search
+	// the data list for this type every time.
+}
+
+//-----------------------------------------------------------------------------
+int FEMaterialPointDataTable::TypeIndex(const std::type_info& type)
+{
+	static std::mutex mtx;
+	static std::map<std::string, int> types;
+
+	std::lock_guard<std::mutex> lock(mtx);
+	std::map<std::string, int>::iterator it = types.find(type.name());
+	if (it != types.end()) return it->second;
+
+	// indices start at 1, since 0 marks an empty entry
+	int ntype = (int)types.size() + 1;
+	types[type.name()] = ntype;
+	return ntype;
 }
 
 //=================================================================================================
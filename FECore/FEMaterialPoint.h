@@ -31,7 +31,10 @@ SOFTWARE.*/
 #include "mat3d.h"
 #include "quatd.h"
 #include "FETimeInfo.h"
+#include "FEMaterialPointArena.h"
 #include <vector>
+#include <atomic>
+#include <typeinfo>
 
 class FEElement;
 class FEMaterialPoint;
@@ -52,6 +55,10 @@ public:
 	FEMaterialPointData(FEMaterialPointData* ppt = 0);
 	virtual ~FEMaterialPointData();
 
+	// material point data is allocated from the active arena (see FEMaterialPointArena)
+	static void* operator new(size_t size) { return FEMaterialPointArena::Allocate(size); }
+	static void operator delete(void* p) { FEMaterialPointArena::Deallocate(p); }
+
 public:
 	//! The init function is used to intialize data
 	virtual void Init();
@@ -100,6 +107,65 @@ protected:
 	friend class FEMaterialPoint;
 };
 
+//-----------------------------------------------------------------------------
+//! Small lookup table that maps a type index to the material point data of that
+//! type. This is used by FEMaterialPoint::ExtractData so that the data list only
+//! has to be searched the first time a particular type is requested.
+//! Slots are filled once and never evicted, so they can safely be read while
+//! another thread is filling a different slot.
+class FECORE_API FEMaterialPointDataTable
+{
+public:
+	enum { MAX_ENTRIES = 8 };
+
+public:
+	FEMaterialPointDataTable() { Clear(); }
+
+	// copies start with an empty table since the data list is usually different
+	FEMaterialPointDataTable(const FEMaterialPointDataTable&) { Clear(); }
+	FEMaterialPointDataTable& operator = (const FEMaterialPointDataTable&) { Clear(); return *this; }
+
+	//! remove all entries
+	void Clear()
+	{
+		for (int i = 0; i < MAX_ENTRIES; ++i) m_type[i].store(0, std::memory_order_relaxed);
+	}
+
+	//! find the data for a type. Returns false if the type is not in the table.
+	bool Find(int ntype, void*& pd) const
+	{
+		for (int i = 0; i < MAX_ENTRIES; ++i)
+		{
+			int n = m_type[i].load(std::memory_order_acquire);
+			if (n == ntype) { pd = m_data[i]; return true; }
+			if (n == 0) return false;
+		}
+		return false;
+	}
+
+	//! add an entry. Does nothing if the table is full, in which case the caller
+	//! has to keep searching the data list for that type.
+	void Insert(int ntype, void* pd);
+
+	//! Returns the index of a type. The indices are assigned by a single registry
+	//! in FECore (keyed on the type name), so that all modules (and plugins) use
+	//! the same index for the same type.
+	static int TypeIndex(const std::type_info& type);
+
+private:
+	std::atomic<int>	m_type[MAX_ENTRIES];	//!< type index (0 = empty, -1 = being filled)
+	void*				m_data[MAX_ENTRIES];	//!< data for the corresponding type
+};
+
+//-----------------------------------------------------------------------------
+//! returns the type index of material point data of type T.
+//! The index is looked up in the registry once and then cached.
+template <class T> inline int FEMaterialPointTypeIndex()
+{
+	static const int ntype = FEMaterialPointDataTable::TypeIndex(typeid(T));
+	return ntype;
+}
+
 //-----------------------------------------------------------------------------
 class FECORE_API FEMaterialPoint
 {
@@ -107,6 +173,10 @@ public:
 	FEMaterialPoint(FEMaterialPointData* data = nullptr);
 	virtual ~FEMaterialPoint();
 
+	// material points are allocated from the active arena (see FEMaterialPointArena)
+	static void* operator new(size_t size) { return FEMaterialPointArena::Allocate(size); }
+	static void operator delete(void* p) { FEMaterialPointArena::Deallocate(p); }
+
 	//! The init function is used to intialize data
 	virtual void Init();
 
@@ -150,6 +220,9 @@ public:
 
 protected:
 	FEMaterialPointData* m_data;
+
+private:
+	mutable FEMaterialPointDataTable	m_table;	//!< results of previous ExtractData calls
 };
 
 //-----------------------------------------------------------------------------
@@ -221,15 +294,34 @@ template <class T> inline const T* FEMaterialPointData::ExtractData() const
 }
 
 //-----------------------------------------------------------------------------
+//! The data list is only searched the first time a type is requested. If the data
+//! is found, it is stored in the lookup table of this material point. Types that
+//! are not found are not stored, so they don't take up slots of the table.
 template <class T> inline T* FEMaterialPoint::ExtractData()
 {
-	return (m_data ? m_data->ExtractData<T>() : nullptr);
+	if (m_data == nullptr) return nullptr;
+
+	const int ntype = FEMaterialPointTypeIndex<T>();
+	void* pd = nullptr;
+	if (m_table.Find(ntype, pd)) return static_cast<T*>(pd);
+
+	T* p = m_data->ExtractData<T>();
+	if (p) m_table.Insert(ntype, const_cast<void*>(static_cast<const void*>(p)));
+	return p;
 }
 
 //-----------------------------------------------------------------------------
 template <class T> inline const T* FEMaterialPoint::ExtractData() const
 {
-	return (m_data ? m_data->ExtractData<T>() : nullptr);
+	if (m_data == nullptr) return nullptr;
+
+	const int ntype = FEMaterialPointTypeIndex<T>();
+	void* pd = nullptr;
+	if (m_table.Find(ntype, pd)) return static_cast<const T*>(pd);
+
+	const T* p = m_data->ExtractData<T>();
+	if (p) m_table.Insert(ntype, const_cast<void*>(static_cast<const void*>(p)));
+	return p;
 }
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,170 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEMaterialPointArena.h"
+#include <new>
+#include <assert.h>
+
+// Each allocation is preceded by a header that records where the memory came from
+// and the size of the object. The header size also preserves the alignment of the 
+// returned memory.
+static const size_t HEADER_SIZE = 16;
+static const size_t ALIGNMENT = 16;
+static const size_t BLOCK_SIZE = 65536;
+
+enum AllocationType { HEAP_ALLOCATION = 0x48454150, ARENA_ALLOCATION = 0x4152454e };
+
+// the active arena of each thread
+static thread_local FEMaterialPointArena* activeArena = nullptr;
+
+//-----------------------------------------------------------------------------
+FEMaterialPointArena::Scope::Scope(FEMaterialPointArena& arena)
+{
+	m_prev = activeArena;
+	activeArena = &arena;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPointArena::Scope::~Scope()
+{
+	activeArena = m_prev;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPointArena::FEMaterialPointArena()
+{
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPointArena::~FEMaterialPointArena()
+{
+	Clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointArena::Clear()
+{
+	assert(activeArena != this);
+	for (Pool& pool : m_pool)
+	{
+		for (char* block : pool.blocks) ::operator delete(block);
+	}
+	m_pool.clear();
+}
+
+//-----------------------------------------------------------------------------
+size_t FEMaterialPointArena::Size() const
+{
+	size_t size = 0;
+	for (const Pool& pool : m_pool)
+	{
+		size_t blockSize = (pool.stride > BLOCK_SIZE ? pool.stride : (BLOCK_SIZE / pool.stride)*pool.stride);
+		size += pool.blocks.size()*blockSize;
+	}
+	return size;
+}
+
+//-----------------------------------------------------------------------------
+size_t FEMaterialPointArena::Blocks() const
+{
+	size_t n = 0;
+	for (const Pool& pool : m_pool) n += pool.blocks.size();
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+void* FEMaterialPointArena::NewObject(size_t size)
+{
+	size_t stride = ((size + HEADER_SIZE + ALIGNMENT - 1) / ALIGNMENT)*ALIGNMENT;
+
+	// find the pool for this size
+	Pool* pool = nullptr;
+	for (Pool& p : m_pool)
+	{
+		if (p.stride == stride) { pool = &p; break; }
+	}
+	if (pool == nullptr)
+	{
+		Pool p;
+		p.stride = stride;
+		p.used = 0;
+		m_pool.push_back(p);
+		pool = &m_pool.back();
+	}
+
+	// see if we need a new block
+	size_t blockSize = (stride > BLOCK_SIZE ? stride : (BLOCK_SIZE / stride)*stride);
+	if (pool->blocks.empty() || (pool->used + stride > blockSize))
+	{
+		pool->blocks.push_back((char*) ::operator new(blockSize));
+		pool->used = 0;
+	}
+
+	char* p = pool->blocks.back() + pool->used;
+	pool->used += stride;
+	return p;
+}
+
+//-----------------------------------------------------------------------------
+void* FEMaterialPointArena::Allocate(size_t size)
+{
+	char* p = nullptr;
+	if (activeArena)
+	{
+		p = (char*)activeArena->NewObject(size);
+		*((int*)p) = ARENA_ALLOCATION;
+	}
+	else
+	{
+		p = (char*) ::operator new(size + HEADER_SIZE);
+		*((int*)p) = HEAP_ALLOCATION;
+	}
+	*((size_t*)(p + sizeof(size_t))) = size;
+	return p + HEADER_SIZE;
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointArena::Deallocate(void* pv)
+{
+	if (pv == nullptr) return;
+	char* p = (char*)pv - HEADER_SIZE;
+
+	// arena memory is released when the arena is cleared
+	int ntype = *((int*)p);
+	assert((ntype == HEAP_ALLOCATION) || (ntype == ARENA_ALLOCATION));
+	if (ntype == HEAP_ALLOCATION) ::operator delete(p);
+}
+
+//-----------------------------------------------------------------------------
+size_t FEMaterialPointArena::AllocationSize(const void* pv)
+{
+	if (pv == nullptr) return 0;
+	const char* p = (const char*)pv - HEADER_SIZE;
+	return *((const size_t*)(p + sizeof(size_t)));
+}
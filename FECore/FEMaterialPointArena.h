@@ -0,0 +1,98 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+#include <stddef.h>
+
+//-----------------------------------------------------------------------------
+//! Slab allocator for material point data.
+//! Objects are allocated from large blocks that are grouped by object size, so
+//! that the material point data of a domain is laid out contiguously and the data
+//! of the same type is stored together. The memory is only returned when the
+//! arena is cleared or destroyed, which must happen after all objects allocated
+//! from the arena have been deleted.
+//!
+//! The FEMaterialPoint and FEMaterialPointData classes allocate from the arena
+//! that is active on the calling thread (see FEMaterialPointArena::Scope), or from
+//! the heap when no arena is active.
+class FECORE_API FEMaterialPointArena
+{
+	// Data for all objects of a particular size
+	struct Pool
+	{
+		size_t				stride;		// size of an allocation, including the header
+		size_t				used;		// nr of bytes used in the last block
+		std::vector<char*>	blocks;		// memory blocks
+	};
+
+public:
+	//! Makes an arena the active arena of the calling thread for the lifetime of this object
+	class FECORE_API Scope
+	{
+	public:
+		Scope(FEMaterialPointArena& arena);
+		~Scope();
+
+	private:
+		FEMaterialPointArena*	m_prev;
+	};
+
+public:
+	FEMaterialPointArena();
+	~FEMaterialPointArena();
+
+	//! release all memory
+	void Clear();
+
+	//! number of bytes reserved by this arena
+	size_t Size() const;
+
+	//! number of blocks allocated by this arena
+	size_t Blocks() const;
+
+public:
+	//! allocate memory for a material point object from the active arena, or the heap
+	static void* Allocate(size_t size);
+
+	//! release memory that was obtained with Allocate
+	static void Deallocate(void* p);
+
+	//! the size that was requested when the object was allocated with Allocate
+	static size_t AllocationSize(const void* p);
+
+private:
+	void* NewObject(size_t size);
+
+	FEMaterialPointArena(const FEMaterialPointArena&) = delete;
+	void operator = (const FEMaterialPointArena&) = delete;
+
+private:
+	std::vector<Pool>	m_pool;
+};
@@ -44,6 +44,7 @@ SOFTWARE.*/
 #include "FENodeDataMap.h"
 #include "DumpStream.h"
 #include "FECoreKernel.h"
+#include "FEProfiler.h"
 #include <algorithm>
 
 //-----------------------------------------------------------------------------
@@ -91,12 +92,16 @@ void FEMesh::Serialize(DumpStream& ar)
 
 	// we don't want to store pointers to all the nodes
 	// mostly for efficiency, so we tell the archive not to store the pointers
-	ar.LockPointerTable();
+	// (In a shallow archive, the nodal data may be stored elsewhere.)
+	if ((ar.IsShallow() == false) || (ar.ExcludesNodalData() == false))
 	{
-		// store the node list
-		ar & m_Node;
+		ar.LockPointerTable();
+		{
+			// store the node list
+			ar & m_Node;
+		}
+		ar.UnlockPointerTable();
 	}
-	ar.UnlockPointerTable();
 
 	// stream domain data
 	ar & m_Domain;
@@ -927,7 +932,11 @@ void FEMesh::Update(const FETimeInfo& tp)
 	for (int i = 0; i<Domains(); ++i)
 	{
 		FEDomain& dom = Domain(i);
-		if (dom.IsActive()) dom.Update(tp);
+		if (dom.IsActive())
+		{
+			TRACK_COMPONENT(&dom, "Update");
+			dom.Update(tp);
+		}
 	}
 }
 
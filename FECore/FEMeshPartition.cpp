@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include <string.h>
 #include "FEModel.h"
 #include "DumpStream.h"
+#include "FELinearSystem.h"
 
 //-----------------------------------------------------------------------------
 FEMeshPartition::FEMeshPartition(int nclass, FEModel* fem) : FECoreBase(fem), m_nclass(nclass)
@@ -112,6 +113,9 @@ bool FEMeshPartition::Init()
 	// make sure that there are elements in this domain
 	if (Elements() == 0) return false;
 
+	// the element coloring (if any) will need to be recreated
+	m_elemColor.clear();
+
 	// get the mesh to which this domain belongs
 	FEMesh& mesh = *GetMesh();
 
@@ -182,3 +186,93 @@ void FEMeshPartition::ForEachElement(std::function<void(FEElement& el)> f)
 	int NE = Elements();
 	for (int i = 0; i < NE; ++i) f(ElementRef(i));
 }
+
+//-----------------------------------------------------------------------------
+void FEMeshPartition::AssembleElements(FELinearSystem& LS, std::function<void(int iel)> f)
+{
+	int NE = Elements();
+	if (LS.ColoredAssembly() == false)
+	{
+#pragma omp parallel for shared(f)
+		for (int i = 0; i < NE; ++i) f(i);
+	}
+	else
+	{
+		// create the coloring the first time we get here
+		if (m_elemColor.empty()) CreateElementColoring();
+
+		// Elements of the same color do not share any nodes, so 
+		// they can be assembled concurrently without any locks.
+		LS.SetLockFreeAssembly(true);
+		int colors = ElementColors();
+		for (int c = 0; c < colors; ++c)
+		{
+			const std::vector<int>& elemList = m_elemColor[c];
+			int nc = (int)elemList.size();
+#pragma omp parallel for shared(f)
+			for (int i = 0; i < nc; ++i) f(elemList[i]);
+		}
+		LS.SetLockFreeAssembly(false);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// This creates the coloring with a simple greedy algorithm: each element gets 
+// the smallest color that is not used yet by any element it shares a node with.
+void FEMeshPartition::CreateElementColoring()
+{
+	m_elemColor.clear();
+	int NE = Elements();
+	int NN = Nodes();
+	if ((NE == 0) || (NN == 0)) return;
+
+	// build the (local) node-element adjacency
+	vector<int> pn(NN + 1, 0);
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement& el = ElementRef(i);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j) pn[el.m_lnode[j] + 1]++;
+	}
+	for (int i = 0; i < NN; ++i) pn[i + 1] += pn[i];
+
+	vector<int> nodeElem(pn[NN]);
+	vector<int> pos(pn.begin(), pn.end() - 1);
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement& el = ElementRef(i);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j) nodeElem[pos[el.m_lnode[j]]++] = i;
+	}
+
+	// assign the colors
+	vector<int> color(NE, -1);
+	vector<int> tag;
+	for (int i = 0; i < NE; ++i)
+	{
+		// tag all colors used by the neighbors of this element
+		FEElement& el = ElementRef(i);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j)
+		{
+			int nj = el.m_lnode[j];
+			for (int k = pn[nj]; k < pn[nj + 1]; ++k)
+			{
+				int ck = color[nodeElem[k]];
+				if (ck >= 0) tag[ck] = i;
+			}
+		}
+
+		// find the first color that is not used
+		int c = 0;
+		while ((c < (int)tag.size()) && (tag[c] == i)) c++;
+		if (c == (int)tag.size())
+		{
+			tag.push_back(-1);
+			m_elemColor.push_back(vector<int>());
+		}
+
+		color[i] = c;
+		m_elemColor[c].push_back(i);
+	}
+}
@@ -42,6 +42,7 @@ class FEMesh;
 class FEDataExport;
 class FEGlobalMatrix;
 class FEElementSet;
+class FELinearSystem;
 
 //-----------------------------------------------------------------------------
 //! This class describes a mesh partition, that is, a group of elements that represent
@@ -123,6 +124,23 @@ public:
 	// Loop over all elements
 	void ForEachElement(std::function<void(FEElement& el)> f);
 
+	// Loop over all elements in parallel and assemble their contributions into the linear system.
+	// The function f is called with the (local) element index and must do the assembly.
+	// If the linear system requests colored assembly, the elements are processed one color at a time
+	// and the assembly into the global matrix is done without any locks.
+	void AssembleElements(FELinearSystem& LS, std::function<void(int iel)> f);
+
+public:
+	//! Create an element coloring, i.e. a partition of the elements into groups
+	//! (colors) such that no two elements of the same color share a node.
+	void CreateElementColoring();
+
+	//! return the number of element colors (zero if no coloring was created)
+	int ElementColors() const { return (int)m_elemColor.size(); }
+
+	//! return the list of (local) element indices of a color
+	const std::vector<int>& ElementColor(int n) const { return m_elemColor[n]; }
+
 public:
 	// This is an experimental feature.
 	// The idea is to let the class define what data it wants to export
@@ -147,4 +165,6 @@ protected:
 
 private:
 	vector<FEDataExport*>	m_Data;	//!< list of data export classes
+
+	std::vector< std::vector<int> >	m_elemColor;	//!< element coloring (used for colored assembly)
 };
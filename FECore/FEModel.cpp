@@ -54,8 +54,12 @@ SOFTWARE.*/
 #include <map>
 #include "DumpStream.h"
 #include "LinearSolver.h"
+#include "FESolver.h"
+#include "FEGlobalMatrix.h"
+#include "FESurface.h"
 #include "FETimeStepController.h"
 #include "Timer.h"
+#include "FEProfiler.h"
 #include "DumpMemStream.h"
 #include "FEPlotDataStore.h"
 #include "FESolidDomain.h"
@@ -139,7 +143,7 @@ public:
 
 		// allocate timers
 		// Make sure enough timers are allocated for all the TimerIds!
-		m_timers.resize(7);
+		m_timers.resize(9);
 	}
 
 	void Serialize(DumpStream& ar);
@@ -190,6 +194,7 @@ public:
 
 	std::vector<LoadParam>		m_Param;	//!< list of parameters controller by load controllers
 	std::vector<Timer>			m_timers;	// list of timers
+	FEProfiler					m_profiler;	// profiler for regions and model components
 
 public:
 	FEAnalysis*		m_pStep;	//!< pointer to current analysis step
@@ -637,28 +642,44 @@ void FEModel::Update()
 	for (int i = 0; i < nvel; ++i)
 	{
 		FEBoundaryCondition& bc = *BoundaryCondition(i);
-		if (bc.IsActive()) bc.UpdateModel();
+		if (bc.IsActive())
+		{
+			TRACK_COMPONENT(&bc, "UpdateModel");
+			bc.UpdateModel();
+		}
 	}
 
 	// update all model loads
 	for (int i = 0; i < ModelLoads(); ++i)
 	{
 		FEModelLoad* pml = ModelLoad(i);
-		if (pml && pml->IsActive()) pml->Update();
+		if (pml && pml->IsActive())
+		{
+			TRACK_COMPONENT(pml, "Update");
+			pml->Update();
+		}
 	}
 
 	// update all paired-interfaces
 	for (int i = 0; i < SurfacePairConstraints(); ++i)
 	{
 		FESurfacePairConstraint* psc = SurfacePairConstraint(i);
-		if (psc && psc->IsActive()) psc->Update();
+		if (psc && psc->IsActive())
+		{
+			TRACK_COMPONENT(psc, "Update");
+			psc->Update();
+		}
 	}
 
 	// update all constraints
 	for (int i = 0; i < NonlinearConstraints(); ++i)
 	{
 		FENLConstraint* pc = NonlinearConstraint(i);
-		if (pc && pc->IsActive()) pc->Update();
+		if (pc && pc->IsActive())
+		{
+			TRACK_COMPONENT(pc, "Update");
+			pc->Update();
+		}
 	}
 
     // some of the loads may alter the prescribed dofs, so we update the mesh again
@@ -2311,6 +2332,7 @@ void FEModel::ResetAllTimers()
 		Timer& ti = m_imp->m_timers[i];
 		ti.reset();
 	}
+	m_imp->m_profiler.Reset();
 }
 
 //-----------------------------------------------------------------------------
@@ -2325,6 +2347,103 @@ Timer* FEModel::GetTimer(int i)
 	return &(m_imp->m_timers[i]);
 }
 
+//-----------------------------------------------------------------------------
+FEProfiler& FEModel::GetProfiler()
+{
+	return m_imp->m_profiler;
+}
+
+//-----------------------------------------------------------------------------
+// memory used by an element's own data (not including the material point data)
+static size_t ElementMemory(FEElement& el)
+{
+	size_t mem = (el.m_node.capacity() + el.m_lnode.capacity())*sizeof(int) + el.GaussPoints()*sizeof(FEMaterialPoint*);
+	FESolidElement* solid = dynamic_cast<FESolidElement*>(&el);
+	if (solid) mem += sizeof(FESolidElement) + solid->m_J0i.capacity()*sizeof(mat3d);
+	else if (dynamic_cast<FEShellElement*>(&el)) mem += sizeof(FEShellElement);
+	else if (dynamic_cast<FESurfaceElement*>(&el)) mem += sizeof(FESurfaceElement);
+	else mem += sizeof(FEElement);
+	return mem;
+}
+
+//-----------------------------------------------------------------------------
+// memory of a surface's elements and integration point data
+static size_t SurfaceMemory(FESurface& surf)
+{
+	size_t mem = 0;
+	for (int i = 0; i < surf.Elements(); ++i)
+	{
+		FESurfaceElement& el = surf.Element(i);
+		mem += ElementMemory(el);
+		for (int n = 0; n < el.GaussPoints(); ++n)
+		{
+			mem += FEMaterialPointArena::AllocationSize(el.GetMaterialPoint(n));
+		}
+	}
+	return mem;
+}
+
+//-----------------------------------------------------------------------------
+// The stiffness matrix, linear and nonlinear solver data are those of the current step.
+// The element sizes are estimates, since derived element classes may store additional data.
+void FEModel::GetMemoryStats(FEMODEL_MEMORY_STATS& stats)
+{
+	stats = FEMODEL_MEMORY_STATS();
+
+	// nodes
+	FEMesh& mesh = GetMesh();
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		FENode& node = mesh.Node(i);
+		size_t ndofs = (size_t)node.dofs();
+
+		// each node stores two integer and three double arrays of size dofs
+		stats.Mesh += sizeof(FENode) + ndofs*(2*sizeof(int) + 3*sizeof(double));
+	}
+
+	// domains
+	for (int i = 0; i < mesh.Domains(); ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		for (int j = 0; j < dom.Elements(); ++j) stats.Mesh += ElementMemory(dom.ElementRef(j));
+
+		size_t mp = dom.MaterialPointMemory();
+		stats.MaterialPoints += mp;
+		stats.DomainData.push_back(std::pair<std::string, size_t>(dom.GetName(), mp));
+	}
+
+	// contact surfaces
+	for (int i = 0; i < SurfacePairConstraints(); ++i)
+	{
+		FESurfacePairConstraint* pc = SurfacePairConstraint(i);
+		FESurface* ps = pc->GetPrimarySurface();
+		FESurface* ss = pc->GetSecondarySurface();
+		if (ps) stats.Contact += SurfaceMemory(*ps);
+		if (ss && (ss != ps)) stats.Contact += SurfaceMemory(*ss);
+	}
+
+	// solver data
+	FEAnalysis* step = GetCurrentStep();
+	FESolver* solver = (step ? step->GetFESolver() : nullptr);
+	if (solver)
+	{
+		FEGlobalMatrix* K = solver->GetStiffnessMatrix();
+		if (K && K->GetSparseMatrixPtr()) stats.StiffnessMatrix = K->GetSparseMatrixPtr()->MemoryUsage();
+
+		LinearSolver* ls = solver->GetLinearSolver();
+		if (ls) stats.LinearSolver = ls->MemoryUsage();
+
+		stats.NonLinSolver = solver->MemoryUsage();
+	}
+
+	// state snapshots
+	for (int i = 0; i < Steps(); ++i)
+	{
+		size_t snap = GetStep(i)->m_snapshotSize;
+		if (snap > stats.Output) stats.Output = snap;
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! return number of mesh adaptors
 int FEModel::MeshAdaptors()
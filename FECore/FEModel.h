@@ -52,16 +52,27 @@ class FELinearConstraintManager;
 class FEDataArray;
 class FEMeshAdaptor;
 class Timer;
+class FEProfiler;
 class FEPlotDataStore;
 class FEMeshDataGenerator;
 
 //-----------------------------------------------------------------------------
-// struct that breaks down memory usage of FEModel
+// struct that breaks down memory usage of FEModel (all sizes are in bytes)
 struct FEMODEL_MEMORY_STATS {
-	size_t		StiffnessMatrix;
-	size_t		Mesh;
-	size_t		LinearSolver;
-	size_t		NonLinSolver;
+	size_t		StiffnessMatrix;	//!< global stiffness matrix
+	size_t		Mesh;				//!< nodes and elements
+	size_t		LinearSolver;		//!< linear solver data (e.g. factorization)
+	size_t		NonLinSolver;		//!< solution vectors and quasi-Newton updates
+	size_t		MaterialPoints;		//!< material point data of all domains
+	size_t		Contact;			//!< surfaces and integration point data of contact interfaces
+	size_t		Output;				//!< plot file and state snapshot buffers
+
+	//! material point data of each domain
+	std::vector< std::pair<std::string, size_t> >	DomainData;
+
+	FEMODEL_MEMORY_STATS() { StiffnessMatrix = Mesh = LinearSolver = NonLinSolver = MaterialPoints = Contact = Output = 0; }
+
+	size_t Total() const { return StiffnessMatrix + Mesh + LinearSolver + NonLinSolver + MaterialPoints + Contact + Output; }
 };
 
 //-----------------------------------------------------------------------------
@@ -419,6 +430,12 @@ public:
 	// return a timer by index
 	Timer* GetTimer(int i);
 
+	// return the profiler
+	FEProfiler& GetProfiler();
+
+	// get a breakdown of the memory that is held by the model's data structures
+	virtual void GetMemoryStats(FEMODEL_MEMORY_STATS& stats);
+
 	// get the number of calls to Update()
 	int UpdateCounter() const;
 
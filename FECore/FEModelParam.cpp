@@ -102,6 +102,13 @@ FEScalarValuator* FEParamDouble::valuator()
 	return m_val;
 }
 
+// evaluate the parameter at npts material points
+void FEParamDouble::BatchValue(FEMaterialPoint** mp, int npts, double* val)
+{
+	m_val->BatchValue(mp, npts, val);
+	if (m_scl != 1.0) for (int i = 0; i < npts; ++i) val[i] *= m_scl;
+}
+
 // is this a const value
 bool FEParamDouble::isConst() const { return m_val->isConst(); };
 
@@ -83,6 +83,9 @@ public:
 	// evaluate the parameter at a material point
 	double operator () (const FEMaterialPoint& pt) { return m_scl*(*m_val)(pt); }
 
+	// evaluate the parameter at npts material points
+	void BatchValue(FEMaterialPoint** mp, int npts, double* val);
+
 	// is this a const value
 	bool isConst() const;
 
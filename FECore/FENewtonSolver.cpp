@@ -39,6 +39,7 @@ SOFTWARE.*/
 #include "FEDomain.h"
 #include "DumpStream.h"
 #include "FELinearSystem.h"
+#include "FEProfiler.h"
 
 //-----------------------------------------------------------------------------
 // define the parameter list
@@ -273,23 +274,35 @@ std::vector<double> FENewtonSolver::GetSolutionVector() const
 //! \todo Can we move this to the FEGlobalMatrix::Create function?
 bool FENewtonSolver::CreateStiffness(bool breset)
 {
+	bool bnewProfile = true;
 	{
 		TRACK_TIME(TimerID::Timer_Reform);
-		// clean up the solver
-		m_plinsolve->Destroy();
-
-		// clean up the stiffness matrix
-		m_pK->Clear();
 
-		// create the stiffness matrix
+		// build the profile of the stiffness matrix
 		feLog("===== reforming stiffness matrix:\n");
-		if (m_pK->Create(GetFEModel(), m_neq, breset) == false)
+		if (m_pK->BuildProfile(GetFEModel(), m_neq, breset) == false)
 		{
 			feLogError("An error occured while building the stiffness matrix\n\n");
 			return false;
 		}
 		else
 		{
+			// If the profile did not change, we keep the stiffness matrix, and the
+			// linear solver can keep its symbolic factorization.
+			bnewProfile = m_pK->ProfileChanged();
+			if (bnewProfile)
+			{
+				// clean up the solver
+				m_plinsolve->Destroy();
+
+				// clean up the stiffness matrix
+				m_pK->Clear();
+
+				// create the stiffness matrix
+				m_pK->build_end();
+			}
+			else feLog("\tMatrix profile unchanged; reusing stiffness matrix\n");
+
 			// output some information about the direct linear solver
 			int neq = m_pK->Rows();
 			int nnz = m_pK->NonZeroes();
@@ -309,6 +322,7 @@ bool FENewtonSolver::CreateStiffness(bool breset)
 	}
 
 	// Do the preprocessing of the solver
+	if (bnewProfile)
 	{
 		TRACK_TIME(TimerID::Timer_LinSolve);
 		if (!m_plinsolve->PreProcess())
@@ -329,6 +343,15 @@ LinearSolver* FENewtonSolver::GetLinearSolver()
 	return m_plinsolve;
 }
 
+//-----------------------------------------------------------------------------
+size_t FENewtonSolver::MemoryUsage() const
+{
+	size_t n = m_R0.capacity() + m_R1.capacity() + m_ui.capacity() + m_Ut.capacity() + m_Ui.capacity() + m_up.capacity() + m_Fd.capacity();
+	size_t mem = n*sizeof(double);
+	if (m_qnstrategy) mem += m_qnstrategy->MemoryUsage();
+	return mem;
+}
+
 //-----------------------------------------------------------------------------
 bool FENewtonSolver::AllocateLinearSystem()
 {
@@ -754,7 +777,11 @@ void FENewtonSolver::PrepStep()
 	for (int i = 0; i<nbc; ++i)
 	{
 		FEBoundaryCondition& dc = *fem.BoundaryCondition(i);
-		if (dc.IsActive()) dc.PrepStep(ui);
+		if (dc.IsActive())
+		{
+			TRACK_COMPONENT(&dc, "PrepStep");
+			dc.PrepStep(ui);
+		}
 	}
 
 	// intialize material point data
@@ -1033,7 +1060,11 @@ void FENewtonSolver::Update(std::vector<double>& ui)
 	for (int i = 0; i<nbc; ++i)
 	{
 		FEBoundaryCondition& dc = *fem.BoundaryCondition(i);
-		if (dc.IsActive()) dc.Update();
+		if (dc.IsActive())
+		{
+			TRACK_COMPONENT(&dc, "Update");
+			dc.Update();
+		}
 	}
 
 	// update element degrees of freedom
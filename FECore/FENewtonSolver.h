@@ -194,6 +194,9 @@ public:
 	//! return the linear solver
 	LinearSolver* GetLinearSolver() override;
 
+	//! memory used by the solution vectors and the quasi-Newton update data
+	size_t MemoryUsage() const override;
+
 	//! Add a solution variable from a doflist
 	void AddSolutionVariable(FEDofList* dofs, int order, const char* szname, double tol);
 
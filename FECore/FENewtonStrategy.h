@@ -74,6 +74,9 @@ public:
 	//! calculate the residual
 	virtual bool Residual(std::vector<double>& R, bool binit);
 
+	//! memory (in bytes) used for storing the update data
+	virtual size_t MemoryUsage() const { return 0; }
+
 public:
 	int		m_maxups;		//!< max nr of QN iters permitted between stiffness reformations
 	int		m_max_buf_size;	//!< max buffer size for update vector storage
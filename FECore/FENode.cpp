@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FENode.h"
 #include "DumpStream.h"
+#include <string.h>
 
 //=============================================================================
 // FENode
@@ -127,6 +128,61 @@ void FENode::Serialize(DumpStream& ar)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// helper functions for copying state data to and from a buffer
+static inline double* copy_to(double* pd, const vec3d& r)
+{
+	pd[0] = r.x; pd[1] = r.y; pd[2] = r.z;
+	return pd + 3;
+}
+
+static inline double* copy_to(double* pd, const std::vector<double>& v)
+{
+	if (v.empty() == false) memcpy(pd, &v[0], v.size()*sizeof(double));
+	return pd + v.size();
+}
+
+static inline const double* copy_from(const double* pd, vec3d& r)
+{
+	r.x = pd[0]; r.y = pd[1]; r.z = pd[2];
+	return pd + 3;
+}
+
+static inline const double* copy_from(const double* pd, std::vector<double>& v)
+{
+	if (v.empty() == false) memcpy(&v[0], pd, v.size()*sizeof(double));
+	return pd + v.size();
+}
+
+//-----------------------------------------------------------------------------
+size_t FENode::StateSize() const
+{
+	// rt, at, rp, vp, ap, dt, dp
+	return 21 + m_Fr.size() + m_val_t.size() + m_val_p.size();
+}
+
+//-----------------------------------------------------------------------------
+double* FENode::SaveState(double* pd) const
+{
+	pd = copy_to(pd, m_rt); pd = copy_to(pd, m_at);
+	pd = copy_to(pd, m_rp); pd = copy_to(pd, m_vp); pd = copy_to(pd, m_ap);
+	pd = copy_to(pd, m_Fr);
+	pd = copy_to(pd, m_val_t); pd = copy_to(pd, m_val_p);
+	pd = copy_to(pd, m_dt); pd = copy_to(pd, m_dp);
+	return pd;
+}
+
+//-----------------------------------------------------------------------------
+const double* FENode::RestoreState(const double* pd)
+{
+	pd = copy_from(pd, m_rt); pd = copy_from(pd, m_at);
+	pd = copy_from(pd, m_rp); pd = copy_from(pd, m_vp); pd = copy_from(pd, m_ap);
+	pd = copy_from(pd, m_Fr);
+	pd = copy_from(pd, m_val_t); pd = copy_from(pd, m_val_p);
+	pd = copy_from(pd, m_dt); pd = copy_from(pd, m_dp);
+	return pd;
+}
+
 //-----------------------------------------------------------------------------
 //! Update nodal values, which copies the current values to the previous array
 void FENode::UpdateValues()
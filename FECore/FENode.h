@@ -93,6 +93,16 @@ public:
 	// Serialize
 	void Serialize(DumpStream& ar);
 
+	//! nr of doubles needed to store the mutable state of this node
+	//! (i.e. the data that a shallow Serialize would store, except the ID)
+	size_t StateSize() const;
+
+	//! copy the mutable state to a buffer, returns a pointer past the copied data
+	double* SaveState(double* pd) const;
+
+	//! copy the mutable state from a buffer, returns a pointer past the copied data
+	const double* RestoreState(const double* pd);
+
 	//! Update nodal values, which copies the current values to the previous array
 	void UpdateValues();
 
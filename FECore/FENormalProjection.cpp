@@ -35,13 +35,49 @@ FENormalProjection::FENormalProjection(FESurface& s) : m_surf(s)
 {
 	m_tol = 0.0;
 	m_rad = 0.0;
+	m_bneighbors = false;
 }
 
 //-----------------------------------------------------------------------------
 void FENormalProjection::Init()
 {
-	m_OT.Attach(&m_surf);
-	m_OT.Init(m_tol);
+	vector<FESpatialTree::BOX> box;
+	ElementBoxes(box);
+	m_tree.Build(box);
+
+	if (m_bneighbors) m_EEL.Create(&m_surf);
+}
+
+//-----------------------------------------------------------------------------
+void FENormalProjection::Update()
+{
+	if (m_tree.Items() != m_surf.Elements()) { Init(); return; }
+
+	vector<FESpatialTree::BOX> box;
+	ElementBoxes(box);
+	m_tree.Refit(box);
+
+	// rebuild if the elements moved too far from where the tree was built
+	if (m_tree.Degradation() > 2.0) m_tree.Build(box);
+}
+
+//-----------------------------------------------------------------------------
+// Calculate the element bounding boxes. The boxes are inflated since
+// Intersect accepts intersections slightly outside of the element.
+void FENormalProjection::ElementBoxes(std::vector<FESpatialTree::BOX>& box)
+{
+	FEMesh& mesh = *m_surf.GetMesh();
+	int NE = m_surf.Elements();
+	box.resize(NE);
+#pragma omp parallel for
+	for (int i = 0; i < NE; ++i)
+	{
+		FESurfaceElement& el = m_surf.Element(i);
+		FESpatialTree::BOX& b = box[i];
+		b = FESpatialTree::BOX(mesh.Node(el.m_node[0]).m_rt);
+		for (int j = 1; j < el.Nodes(); ++j) b.add(mesh.Node(el.m_node[j]).m_rt);
+		b.inflate(b.radius()*(m_tol > 1e-6 ? m_tol : 1e-6));
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -53,12 +89,12 @@ void FENormalProjection::Init()
 FESurfaceElement* FENormalProjection::Project(vec3d r, vec3d n, double rs[2])
 {
 	// let's find all the candidate surface elements
-	set<int>selist;
-	m_OT.FindCandidateSurfaceElements(r, n, selist, m_rad);
+	vector<int> selist;
+	m_tree.FindRayCandidates(r, n, m_rad, selist);
 	
 	// now that we found candidate surface elements, lets see if we can find 
 	// those that intersect the ray, then pick the closest intersection
-	set<int>::iterator it;
+	vector<int>::iterator it;
 	bool found = false;
 	double rsl[2], gl, g = 0;
 	FESurfaceElement* pei = 0;
@@ -88,6 +124,39 @@ FESurfaceElement* FENormalProjection::Project(vec3d r, vec3d n, double rs[2])
 	return 0;
 }
 
+//-----------------------------------------------------------------------------
+//! This function checks if the ray (r,n) still intersects the element pe. If not,
+//! the neighbors of pe are searched, using the same criterion as Project.
+//! This requires that the neighbor list was built (see SetNeighborSearch).
+//!
+FESurfaceElement* FENormalProjection::ProjectNeighbors(FESurfaceElement& pe, const vec3d& r, const vec3d& n, double rs[2])
+{
+	double g;
+	if (m_surf.Intersect(pe, r, n, rs, g, m_tol)) return &pe;
+
+	bool found = false;
+	double rsl[2], gl;
+	FESurfaceElement* pei = 0;
+	int nf = pe.facet_edges();
+	for (int k = 0; k < nf; ++k)
+	{
+		FESurfaceElement* pn = dynamic_cast<FESurfaceElement*>(m_EEL.Neighbor(pe.m_lid, k));
+		if (pn && m_surf.Intersect(*pn, r, n, rsl, gl, m_tol) && (gl > -m_rad))
+		{
+			if ((!found) || (gl < g))
+			{
+				found = true;
+				g = gl;
+				rs[0] = rsl[0];
+				rs[1] = rsl[1];
+				pei = pn;
+			}
+		}
+	}
+
+	return pei;
+}
+
 //-----------------------------------------------------------------------------
 //! This function finds the element which is intersected by the ray (r,n).
 //! It returns a pointer to the element, as well as the isoparametric coordinates
@@ -97,12 +166,12 @@ FESurfaceElement* FENormalProjection::Project(vec3d r, vec3d n, double rs[2])
 FESurfaceElement* FENormalProjection::Project2(vec3d r, vec3d n, double rs[2])
 {
 	// let's find all the candidate surface elements
-	set<int>selist;
-	m_OT.FindCandidateSurfaceElements(r, n, selist, m_rad);
+	vector<int> selist;
+	m_tree.FindRayCandidates(r, n, m_rad, selist);
 	
 	// now that we found candidate surface elements, lets see if we can find 
 	// those that intersect the ray, then pick the closest intersection
-	set<int>::iterator it;
+	vector<int>::iterator it;
 	bool found = false;
 	double rsl[2], gl, g = 0;
 	FESurfaceElement* pei = 0;
@@ -140,15 +209,15 @@ FESurfaceElement* FENormalProjection::Project2(vec3d r, vec3d n, double rs[2])
 FESurfaceElement* FENormalProjection::Project3(const vec3d& r, const vec3d& n, double rs[2], int* pei)
 {
 	// let's find all the candidate surface elements
-	set<int>selist;
-	m_OT.FindCandidateSurfaceElements(r, n, selist, m_rad);
+	vector<int> selist;
+	m_tree.FindRayCandidates(r, n, m_rad, selist);
 
 	double g, gmax = -1e99, r2[2] = {rs[0], rs[1]};
 	int imin = -1;
 	FESurfaceElement* pme = 0;
 
 	// loop over all surface element
-	set<int>::iterator it;
+	vector<int>::iterator it;
 	for (it = selist.begin(); it != selist.end(); ++it)
 	{
 		FESurfaceElement& el = m_surf.Element(*it);
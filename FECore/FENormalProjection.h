@@ -28,7 +28,8 @@ SOFTWARE.*/
 
 #pragma once
 #include "FESurface.h"
-#include "FEOctree.h"
+#include "FESpatialTree.h"
+#include "FEElemElemList.h"
 
 //-----------------------------------------------------------------------------
 //! This class calculates the normal projection on to a surface.
@@ -42,9 +43,15 @@ public:
 	// initialization
 	void Init();
 
+	//! refit the element boxes to the current nodal positions (calls Init if needed)
+	void Update();
+
 	void SetTolerance(double tol) { m_tol = tol; }
 	void SetSearchRadius(double srad) { m_rad = srad; }
 
+	//! set if Init should build the element neighbor list (needed by ProjectNeighbors)
+	void SetNeighborSearch(bool b) { m_bneighbors = b; }
+
 public:
 	//! find the intersection of a ray with the surface
 	FESurfaceElement* Project(vec3d r, vec3d n, double rs[2]);
@@ -54,11 +61,20 @@ public:
 	vec3d Project(const vec3d& r, const vec3d& N);
 	vec3d Project2(const vec3d& r, const vec3d& N);
 
+	//! find the intersection of a ray with the element pe or, if the ray misses pe, with
+	//! one of its neighbors. Returns nullptr if the ray does not intersect any of these elements.
+	FESurfaceElement* ProjectNeighbors(FESurfaceElement& pe, const vec3d& r, const vec3d& n, double rs[2]);
+
+private:
+	void ElementBoxes(std::vector<FESpatialTree::BOX>& box);
+
 private:
 	double	m_tol;	//!< projection tolerance
 	double	m_rad;	//!< search radius
+	bool	m_bneighbors;	//!< build the element neighbor list
 
 private:
-	FESurface&	m_surf;	//!< the target surface
-	FEOctree	m_OT;	//!< used to optimize ray-surface intersections
+	FESurface&		m_surf;	//!< the target surface
+	FESpatialTree	m_tree;	//!< used to optimize ray-surface intersections
+	FEElemElemList	m_EEL;	//!< element neighbor list
 };
@@ -27,41 +27,18 @@ SOFTWARE.*/
 
 #include "vec3d.h"
 #include "vector.h"
-#include <set>
+#include "FESpatialTree.h"
 
 class FEElement;
 class FEMesh;
 class FEDomain;
 
 //-----------------------------------------------------------------------------
-//! This class is a helper class to find ray intersection with a surface
+//! This class is a helper class to find the element that contains a point.
+//! The search uses the reference coordinates of the mesh.
 
 class FECORE_API FEOctreeSearch
 {
-	class Block
-	{
-	public:
-		Block(FEMesh* mesh, int level);
-		Block(Block* parent, int level);
-		~Block();
-		void Clear();
-		void CreateChildren(int max_level, int max_elem);
-		void FillBlock();
-		bool ElementIntersectsNode(FEElement* pe);
-
-		FEElement* FindElement(const vec3d& y, double r[3]);
-
-		bool IsInside(const vec3d& r) const;
-
-	public:
-		int					m_level;		//!< node level
-		vec3d				m_cmin, m_cmax;	//!< node bounding box
-		std::vector<FEElement*>	m_selist;		//!< list of surface elements inside this node
-		std::vector<Block*>		m_children;		//!< children of this node
-		FEMesh*				m_mesh;			//!< the mesh to search
-		Block*				m_parent;
-	};
-
 public:
 	FEOctreeSearch(FEMesh* mesh);
 	FEOctreeSearch(FEDomain* domain);
@@ -70,12 +47,14 @@ public:
 	//! initialize search structures
 	bool Init(double inflate = 0.005);
 
+	//! find the element that contains x and return the iso-parametric coordinates in r.
+	//! This function can be called from multiple threads.
 	FEElement* FindElement(const vec3d& x, double r[3]);
 
 protected:
 	FEMesh*		m_mesh;			//!< the mesh
 	FEDomain*	m_dom;			//!< the domain to search (if null whole mesh will be searched)
-	Block*		m_root;			//!< root node in octree
-	int			m_max_level;	//!< maximum allowable number of levels in octree
-	int			m_max_elem;		//!< maximum allowable number of elements in any node
+
+	std::vector<FEElement*>	m_elem;	//!< list of elements to search
+	FESpatialTree			m_tree;	//!< search tree of element bounding boxes
 };
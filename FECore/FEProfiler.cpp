@@ -0,0 +1,410 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEProfiler.h"
+#include "FECoreBase.h"
+#include "FEModel.h"
+#include "sys.h"
+#include <chrono>
+#include <functional>
+#include <stdio.h>
+using namespace std;
+
+// max nr of threads that are tracked
+#define MAX_PROFILER_THREADS	256
+
+// max nr of timeline events that are recorded per thread
+#define MAX_TRACE_EVENTS		1000000
+
+//-----------------------------------------------------------------------------
+// returns the time in seconds
+static double profiler_clock()
+{
+	return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//-----------------------------------------------------------------------------
+// writes a string to a JSON file
+static void write_json_string(FILE* fp, const string& s)
+{
+	fputc('"', fp);
+	for (char c : s)
+	{
+		if ((c == '"') || (c == '\\')) { fputc('\\', fp); fputc(c, fp); }
+		else if ((unsigned char)c < 0x20) fprintf(fp, "\\u%04x", (int)c);
+		else fputc(c, fp);
+	}
+	fputc('"', fp);
+}
+
+//-----------------------------------------------------------------------------
+// node of a call tree
+struct ProfilerNode
+{
+	int			region;
+	int			attach;		// for top-level nodes of worker threads, the main thread's node they belong to
+	vector<int>	children;
+	long long	calls;
+	double		time;
+};
+
+// an entry of the timeline
+struct TraceEvent
+{
+	int		region;
+	double	start;
+	double	duration;
+};
+
+struct FEProfiler::ThreadData
+{
+	vector<ProfilerNode>	node;	// node 0 is the root
+	vector<int>				stack;	// the regions that are currently entered
+	vector<double>			start;	// start times of those regions
+	vector<TraceEvent>		trace;
+
+	ThreadData()
+	{
+		ProfilerNode root = { -1, -1, vector<int>(), 0, 0.0 };
+		node.push_back(root);
+	}
+};
+
+//-----------------------------------------------------------------------------
+FEProfiler::FEProfiler() : m_masterNode(0)
+{
+	m_enabled = false;
+	m_trace = false;
+	m_thread.assign(MAX_PROFILER_THREADS, nullptr);
+	m_t0 = profiler_clock();
+}
+
+//-----------------------------------------------------------------------------
+FEProfiler::~FEProfiler()
+{
+	for (ThreadData* td : m_thread) delete td;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Enable(bool b)
+{
+	m_enabled = b;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::RecordTrace(bool b)
+{
+	m_trace = b;
+}
+
+//-----------------------------------------------------------------------------
+// This should not be called while any region is entered.
+void FEProfiler::Reset()
+{
+	for (size_t i = 0; i < m_thread.size(); ++i)
+	{
+		delete m_thread[i];
+		m_thread[i] = nullptr;
+	}
+	m_masterNode = 0;
+	m_componentMap.clear();
+	m_t0 = profiler_clock();
+}
+
+//-----------------------------------------------------------------------------
+int FEProfiler::Region(const std::string& name)
+{
+	lock_guard<mutex> lock(m_mutex);
+	map<string, int>::iterator it = m_regionMap.find(name);
+	if (it != m_regionMap.end()) return it->second;
+
+	int id = (int)m_regions.size();
+	m_regions.push_back(name);
+	m_regionMap[name] = id;
+	return id;
+}
+
+//-----------------------------------------------------------------------------
+// The region's name is made up of the component's name and type, and the function.
+int FEProfiler::Region(FECoreBase* pc, const char* szfunction)
+{
+	pair<const void*, const char*> key(pc, szfunction);
+	{
+		lock_guard<mutex> lock(m_mutex);
+		map<pair<const void*, const char*>, int>::iterator it = m_componentMap.find(key);
+		if (it != m_componentMap.end()) return it->second;
+	}
+
+	string name;
+	const char* sztype = pc->GetTypeStr();
+	const string& compName = pc->GetName();
+	if (compName.empty() == false)
+	{
+		name = compName;
+		if (sztype) name += string(" (") + sztype + ")";
+	}
+	else name = (sztype ? sztype : "component");
+	name += string("::") + szfunction;
+
+	int id = Region(name);
+
+	lock_guard<mutex> lock(m_mutex);
+	m_componentMap[key] = id;
+	return id;
+}
+
+//-----------------------------------------------------------------------------
+// Only the thread itself creates its data, so this does not need to be locked.
+FEProfiler::ThreadData* FEProfiler::GetThreadData()
+{
+	int tid = omp_get_thread_num();
+	if ((tid < 0) || (tid >= MAX_PROFILER_THREADS)) return nullptr;
+	if (m_thread[tid] == nullptr) m_thread[tid] = new ThreadData;
+	return m_thread[tid];
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Begin(int region)
+{
+	if (m_enabled == false) return;
+	ThreadData* td = GetThreadData();
+	if (td == nullptr) return;
+	bool bmaster = (td == m_thread[0]);
+
+	// top-level regions of worker threads are attached to the main thread's current region
+	int cur = (td->stack.empty() ? 0 : td->stack.back());
+	int attach = -1;
+	if ((cur == 0) && !bmaster) attach = m_masterNode.load(memory_order_relaxed);
+
+	int child = -1;
+	for (int c : td->node[cur].children)
+	{
+		const ProfilerNode& n = td->node[c];
+		if ((n.region == region) && (n.attach == attach)) { child = c; break; }
+	}
+	if (child == -1)
+	{
+		child = (int)td->node.size();
+		ProfilerNode n = { region, attach, vector<int>(), 0, 0.0 };
+		td->node.push_back(n);
+		td->node[cur].children.push_back(child);
+	}
+
+	td->stack.push_back(child);
+	td->start.push_back(profiler_clock());
+	if (bmaster) m_masterNode.store(child, memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::End()
+{
+	ThreadData* td = GetThreadData();
+	if ((td == nullptr) || td->stack.empty()) return;
+	bool bmaster = (td == m_thread[0]);
+
+	double t1 = profiler_clock();
+	int n = td->stack.back();
+	double t0 = td->start.back();
+	td->stack.pop_back();
+	td->start.pop_back();
+
+	ProfilerNode& node = td->node[n];
+	node.calls++;
+	node.time += t1 - t0;
+
+	if (m_trace && (td->trace.size() < MAX_TRACE_EVENTS))
+	{
+		TraceEvent e = { node.region, t0 - m_t0, t1 - t0 };
+		td->trace.push_back(e);
+	}
+
+	if (bmaster) m_masterNode.store(td->stack.empty() ? 0 : td->stack.back(), memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+// Merges the call trees of all threads. Regions that are still entered are 
+// included with the time spent in them so far.
+std::vector<FEProfiler::Entry> FEProfiler::Report() const
+{
+	struct MergedNode
+	{
+		int			region;
+		vector<int>	children;
+		long long	calls;
+		double		time;
+		double		childTime;	// time of child regions on the same thread
+	};
+	vector<MergedNode> M;
+	M.push_back({ -1, vector<int>(), 0, 0.0, 0.0 });
+
+	auto findChild = [&](int parent, int region) {
+		for (int c : M[parent].children) if (M[c].region == region) return c;
+		int c = (int)M.size();
+		M.push_back({ region, vector<int>(), 0, 0.0, 0.0 });
+		M[parent].children.push_back(c);
+		return c;
+	};
+
+	double now = profiler_clock();
+	vector<int> map0;
+	for (size_t t = 0; t < m_thread.size(); ++t)
+	{
+		const ThreadData* td = m_thread[t];
+		if (td == nullptr) continue;
+
+		// the node times, including the regions that are still entered
+		vector<double> time(td->node.size());
+		vector<long long> calls(td->node.size());
+		for (size_t i = 0; i < td->node.size(); ++i) { time[i] = td->node[i].time; calls[i] = td->node[i].calls; }
+		for (size_t i = 0; i < td->stack.size(); ++i) { time[td->stack[i]] += now - td->start[i]; calls[td->stack[i]]++; }
+
+		vector<int> nodeMap(td->node.size(), 0);
+		function<void(int)> merge = [&](int n) {
+			for (int c : td->node[n].children)
+			{
+				const ProfilerNode& nc = td->node[c];
+				int parent = nodeMap[n];
+				if ((n == 0) && (nc.attach >= 0) && (nc.attach < (int)map0.size())) parent = map0[nc.attach];
+				else if (n != 0) M[parent].childTime += time[c];
+
+				int mc = findChild(parent, nc.region);
+				M[mc].calls += calls[c];
+				M[mc].time += time[c];
+				nodeMap[c] = mc;
+				merge(c);
+			}
+		};
+		merge(0);
+
+		if (t == 0) map0 = nodeMap;
+	}
+
+	// flatten the tree
+	vector<Entry> entries;
+	function<void(int, int)> flatten = [&](int n, int depth) {
+		for (int c : M[n].children)
+		{
+			const MergedNode& mc = M[c];
+			Entry e;
+			e.name = m_regions[mc.region];
+			e.depth = depth;
+			e.calls = mc.calls;
+			e.time = mc.time;
+			e.self = mc.time - mc.childTime;
+			entries.push_back(e);
+			flatten(c, depth + 1);
+		}
+	};
+	flatten(0, 0);
+
+	return entries;
+}
+
+//-----------------------------------------------------------------------------
+bool FEProfiler::WriteJSON(const char* szfile) const
+{
+	FILE* fp = fopen(szfile, "wt");
+	if (fp == nullptr) return false;
+
+	vector<Entry> entries = Report();
+
+	fprintf(fp, "{\n\"regions\": [");
+	int depth = -1;
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		const Entry& e = entries[i];
+
+		// close the regions that are done
+		if (e.depth <= depth)
+		{
+			for (int d = depth; d >= e.depth; --d) fprintf(fp, "]}");
+			fprintf(fp, ",");
+		}
+
+		fprintf(fp, "\n%*s{\"name\": ", 2 * (e.depth + 1), "");
+		write_json_string(fp, e.name);
+		fprintf(fp, ", \"calls\": %lld, \"time\": %.6lg, \"self\": %.6lg, \"children\": [", e.calls, e.time, e.self);
+		depth = e.depth;
+	}
+	for (int d = depth; d >= 0; --d) fprintf(fp, "]}");
+	fprintf(fp, "\n]\n}\n");
+
+	fclose(fp);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEProfiler::WriteTrace(const char* szfile) const
+{
+	FILE* fp = fopen(szfile, "wt");
+	if (fp == nullptr) return false;
+
+	fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+	bool bfirst = true;
+	for (size_t t = 0; t < m_thread.size(); ++t)
+	{
+		const ThreadData* td = m_thread[t];
+		if (td == nullptr) continue;
+		for (const TraceEvent& e : td->trace)
+		{
+			fprintf(fp, (bfirst ? "\n{\"name\": " : ",\n{\"name\": "));
+			write_json_string(fp, m_regions[e.region]);
+			fprintf(fp, ", \"ph\": \"X\", \"pid\": 0, \"tid\": %d, \"ts\": %.3lf, \"dur\": %.3lf}", (int)t, e.start*1e6, e.duration*1e6);
+			bfirst = false;
+		}
+	}
+	fprintf(fp, "\n]}\n");
+
+	fclose(fp);
+	return true;
+}
+
+//=============================================================================
+FEProfileScope::FEProfileScope(FEModel* fem, const char* szregion) : m_prof(nullptr)
+{
+	if (fem == nullptr) return;
+	FEProfiler& prof = fem->GetProfiler();
+	if (prof.IsEnabled() == false) return;
+	prof.Begin(prof.Region(szregion));
+	m_prof = &prof;
+}
+
+FEProfileScope::FEProfileScope(FECoreBase* pc, const char* szfunction) : m_prof(nullptr)
+{
+	FEModel* fem = (pc ? pc->GetFEModel() : nullptr);
+	if (fem == nullptr) return;
+	FEProfiler& prof = fem->GetProfiler();
+	if (prof.IsEnabled() == false) return;
+	prof.Begin(prof.Region(pc, szfunction));
+	m_prof = &prof;
+}
+
+FEProfileScope::~FEProfileScope()
+{
+	if (m_prof) m_prof->End();
+}
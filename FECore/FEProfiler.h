@@ -0,0 +1,134 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <mutex>
+#include <atomic>
+
+class FECoreBase;
+class FEModel;
+
+//-----------------------------------------------------------------------------
+//! The profiler collects timings of nested, named regions. 
+
+//! Regions are registered once (by name) and then entered and exited with Begin 
+//! and End, usually through the FEProfileScope class. Each thread keeps its own call 
+//! tree, so no locking is needed when regions are entered or exited. A region that 
+//! a worker thread enters outside of any other region is attached to the region that 
+//! the main thread is in at that time, so work done in parallel loops ends up in the 
+//! right place of the hierarchy. Since the times of all threads are added, the time of 
+//! a region that was (partially) executed in parallel can exceed the wall time of 
+//! its parent.
+class FECORE_API FEProfiler
+{
+public:
+	// an entry of the (merged) call tree
+	struct Entry
+	{
+		std::string	name;
+		int			depth;
+		long long	calls;
+		double		time;	//!< total time (in seconds)
+		double		self;	//!< time that was not spent in child regions
+	};
+
+public:
+	FEProfiler();
+	~FEProfiler();
+
+	//! turn profiling on or off (profiling is off by default)
+	void Enable(bool b);
+	bool IsEnabled() const { return m_enabled; }
+
+	//! record a timeline of all regions (needed for the trace file)
+	void RecordTrace(bool b);
+
+	//! clear all timings
+	void Reset();
+
+	//! get the id of a region with the given name (registers the region if needed)
+	int Region(const std::string& name);
+
+	//! get the id of a region for a function of a model component
+	int Region(FECoreBase* pc, const char* szfunction);
+
+	//! enter a region
+	void Begin(int region);
+
+	//! exit the region that was entered last (on this thread)
+	void End();
+
+public:
+	//! get the call tree in depth-first order (times of all threads are merged)
+	std::vector<Entry> Report() const;
+
+	//! write the call tree to a JSON file
+	bool WriteJSON(const char* szfile) const;
+
+	//! write the recorded timeline in the Chrome trace event format
+	bool WriteTrace(const char* szfile) const;
+
+private:
+	struct ThreadData;
+	ThreadData* GetThreadData();
+
+private:
+	bool	m_enabled;
+	bool	m_trace;
+
+	std::vector<std::string>	m_regions;	// region names
+	std::map<std::string, int>	m_regionMap;
+	std::map<std::pair<const void*, const char*>, int>	m_componentMap;
+	std::mutex					m_mutex;	// protects the region registry
+
+	std::vector<ThreadData*>	m_thread;	// call tree of each thread
+	std::atomic<int>			m_masterNode;	// the node the main thread is currently in
+	double						m_t0;		// time of last reset
+};
+
+//-----------------------------------------------------------------------------
+//! Helper class that enters a profiler region and exits it when it goes out of scope.
+class FECORE_API FEProfileScope
+{
+public:
+	FEProfileScope(FEModel* fem, const char* szregion);
+	FEProfileScope(FECoreBase* pc, const char* szfunction);
+	~FEProfileScope();
+
+private:
+	FEProfiler*	m_prof;
+};
+
+//! Profile the rest of the current scope as a region with the given name
+#define TRACK_REGION(szregion) FEProfileScope _profScope(GetFEModel(), szregion);
+
+//! Profile the rest of the current scope as a function call of a model component
+#define TRACK_COMPONENT(pc, szfunction) FEProfileScope _profComponent(pc, szfunction);
@@ -37,7 +37,11 @@ SOFTWARE.*/
 //=============================================================================
 bool FEMathExpression::Init(const std::string& expr, FECoreBase* pc)
 {
+	// remove the previous expression, including its compiled program, so that 
+	// a failed Init does not leave the old program around
 	Clear();
+	m_vars.clear();
+	m_prog.Clear();
 
 	AddVariable("X");
 	AddVariable("Y");
@@ -106,6 +110,11 @@ bool FEMathExpression::Init(const std::string& expr, FECoreBase* pc)
 	}
 
 	assert(b);
+
+	// compile the expression so that we don't need to walk the expression tree 
+	// at every evaluation
+	if (b) m_prog.Compile(*this);
+
 	return b;
 }
 
@@ -113,40 +122,80 @@ void FEMathExpression::operator = (const FEMathExpression& me)
 {
 	MSimpleExpression::operator=(me);
 	m_vars = me.m_vars;
+	m_prog = me.m_prog;
 }
 
-double FEMathExpression::value(FEModel* fem, const FEMaterialPoint& pt)
+void FEMathExpression::setVariables(double time, const FEMaterialPoint& pt, double* var)
 {
-	std::vector<double> var(4 + m_vars.size());
 	var[0] = pt.m_r0.x;
 	var[1] = pt.m_r0.y;
 	var[2] = pt.m_r0.z;
-	var[3] = fem->GetTime().currentTime;
-	if (m_vars.empty() == false)
+	var[3] = time;
+	for (int i = 0; i < (int)m_vars.size(); ++i)
 	{
-		for (int i = 0; i < (int)m_vars.size(); ++i)
+		MathParam& mp = m_vars[i];
+		if (mp.type == 0)
 		{
-			MathParam& mp = m_vars[i];
-			if (mp.type == 0)
+			FEParam* pi = mp.pp;
+			switch (pi->type())
 			{
-				FEParam* pi = mp.pp;
-				switch (pi->type())
-				{
-				case FE_PARAM_INT: var[4 + i] = (double)pi->value<int>(); break;
-				case FE_PARAM_DOUBLE: var[4 + i] = pi->value<double>(); break;
-				case FE_PARAM_DOUBLE_MAPPED: var[4 + i] = pi->value<FEParamDouble>()(pt); break;
-				}
-			}
-			else
-			{
-				FEDataMap& map = *mp.map;
-				var[4 + i] = map.value(pt);
+			case FE_PARAM_INT: var[4 + i] = (double)pi->value<int>(); break;
+			case FE_PARAM_DOUBLE: var[4 + i] = pi->value<double>(); break;
+			case FE_PARAM_DOUBLE_MAPPED: var[4 + i] = pi->value<FEParamDouble>()(pt); break;
 			}
 		}
+		else
+		{
+			FEDataMap& map = *mp.map;
+			var[4 + i] = map.value(pt);
+		}
+	}
+}
+
+double FEMathExpression::value(FEModel* fem, const FEMaterialPoint& pt)
+{
+	const int nvar = 4 + (int)m_vars.size();
+	double time = fem->GetTime().currentTime;
+
+	// use the compiled program if we can
+	if (m_prog.IsValid() && (nvar <= MAX_VARIABLES))
+	{
+		double var[MAX_VARIABLES];
+		setVariables(time, pt, var);
+		return m_prog.value(var);
 	}
+
+	std::vector<double> var(nvar);
+	setVariables(time, pt, &var[0]);
 	return value_s(var);
 }
 
+void FEMathExpression::value(FEModel* fem, FEMaterialPoint** mp, int npts, double* val)
+{
+	const int nvar = 4 + (int)m_vars.size();
+	if ((m_prog.IsValid() == false) || (nvar > MAX_VARIABLES))
+	{
+		for (int i = 0; i < npts; ++i) val[i] = value(fem, *mp[i]);
+		return;
+	}
+
+	double time = fem->GetTime().currentTime;
+	const int NB = MProgram::BATCH_SIZE;
+	double var[MAX_VARIABLES * NB];
+	for (int i0 = 0; i0 < npts; i0 += NB)
+	{
+		int n = (npts - i0 < NB ? npts - i0 : NB);
+		for (int i = 0; i < n; ++i) setVariables(time, *mp[i0 + i], var + i*nvar);
+		m_prog.value(n, var, val + i0);
+	}
+}
+
+//=============================================================================
+void FEScalarValuator::BatchValue(FEMaterialPoint** mp, int npts, double* val)
+{
+	for (int i = 0; i < npts; ++i) val[i] = (*this)(*mp[i]);
+}
+
 //=============================================================================
 BEGIN_FECORE_CLASS(FEConstValue, FEScalarValuator)
 	ADD_PARAMETER(m_val, "const");
@@ -239,6 +288,11 @@ double FEMathValue::operator()(const FEMaterialPoint& pt)
 	return m_math.value(GetFEModel(), pt);
 }
 
+void FEMathValue::BatchValue(FEMaterialPoint** mp, int npts, double* val)
+{
+	m_math.value(GetFEModel(), mp, npts, val);
+}
+
 //---------------------------------------------------------------------------------------
 
 FEMappedValue::FEMappedValue(FEModel* fem) : FEScalarValuator(fem), m_val(nullptr)
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #pragma once
 #include "FEValuator.h"
 #include "MathObject.h"
+#include "MProgram.h"
 #include "FEDataMap.h"
 #include "FENodeDataMap.h"
 
@@ -46,6 +47,10 @@ public:
 
 	virtual FEScalarValuator* copy() = 0;
 
+	// evaluate the valuator at npts material points at once
+	// The default implementation evaluates one point at a time.
+	virtual void BatchValue(FEMaterialPoint** mp, int npts, double* val);
+
 	virtual bool isConst() { return false; }
 
 	virtual double* constValue() { return nullptr; }
@@ -87,8 +92,19 @@ public:
 
 	double value(FEModel* fem, const FEMaterialPoint& pt);
 
+	// evaluate the expression at npts material points
+	void value(FEModel* fem, FEMaterialPoint** mp, int npts, double* val);
+
+private:
+	// max nr of variables for which the compiled program is used
+	enum { MAX_VARIABLES = 32 };
+
+	// fill in the values of the variables at a material point
+	void setVariables(double time, const FEMaterialPoint& pt, double* var);
+
 private:
 	std::vector<MathParam>	m_vars;
+	MProgram				m_prog;	// compiled expression
 };
 
 //---------------------------------------------------------------------------------------
@@ -99,6 +115,8 @@ public:
 	~FEMathValue();
 	double operator()(const FEMaterialPoint& pt) override;
 
+	void BatchValue(FEMaterialPoint** mp, int npts, double* val) override;
+
 	bool Init() override;
 
 	FEScalarValuator* copy() override;
@@ -44,6 +44,7 @@ BEGIN_FECORE_CLASS(FESolver, FECoreBase)
 		ADD_PARAMETER(m_eq_scheme, "equation_scheme", 0, "staggered\0block\0");
 		ADD_PARAMETER(m_eq_order , "equation_order", 0, "default\0reverse\0febio2\0");
 		ADD_PARAMETER(m_bwopt    , "optimize_bw");
+		ADD_PARAMETER(m_bcolored_assembly, "colored_assembly");
 	END_PARAM_GROUP();
 END_FECORE_CLASS();
 
@@ -61,6 +62,7 @@ FESolver::FESolver(FEModel* fem) : FECoreBase(fem)
 	m_neq = 0;
 
 	m_bwopt = false;
+	m_bcolored_assembly = false;
 
 	m_eq_scheme = EQUATION_SCHEME::STAGGERED;
 	m_eq_order = EQUATION_ORDER::NORMAL_ORDER;
@@ -127,6 +129,12 @@ LinearSolver* FESolver::GetLinearSolver()
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+size_t FESolver::MemoryUsage() const
+{
+	return 0;
+}
+
 //-----------------------------------------------------------------------------
 //! Matrix symmetry flag
 int FESolver::MatrixSymmetryFlag() const
@@ -161,6 +161,9 @@ public:
 	// get the linear solver
 	virtual LinearSolver* GetLinearSolver();
 
+	//! memory (in bytes) held by the solver's own data (excluding the stiffness matrix and linear solver)
+	virtual size_t MemoryUsage() const;
+
 	//! Matrix symmetry flag
 	int MatrixSymmetryFlag() const;
 
@@ -188,6 +191,7 @@ public:
 
 public: //TODO Move these parameters elsewhere
 	bool				m_bwopt;	    //!< bandwidth optimization flag
+	bool				m_bcolored_assembly;	//!< use colored (lock-free) assembly of domain stiffness matrices
 	int					m_msymm;		//!< matrix symmetry flag for linear solver allocation
 	int					m_eq_scheme;	//!< equation number scheme (used in InitEquations)
 	int					m_eq_order;		//!< normal or reverse ordering
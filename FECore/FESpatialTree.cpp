@@ -0,0 +1,504 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FESpatialTree.h"
+#include "sys.h"
+#include <algorithm>
+#include <float.h>
+#include <assert.h>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+// Number of nodes in a tree with n items. Since we always split at the median,
+// this only depends on n and the leaf size.
+static int nodeCount(int n, int leafSize)
+{
+	if (n <= leafSize) return 1;
+	return 1 + nodeCount(n / 2, leafSize) + nodeCount(n - n / 2, leafSize);
+}
+
+// max depth of the traversal stack. The tree is balanced, so this is plenty.
+#define MAX_STACK	128
+
+//-----------------------------------------------------------------------------
+FESpatialTree::FESpatialTree()
+{
+	m_cost0 = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+void FESpatialTree::Clear()
+{
+	m_node.clear();
+	m_box.clear();
+	m_item.clear();
+	m_cost0 = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+size_t FESpatialTree::MemoryUsage() const
+{
+	return m_node.capacity()*sizeof(NODE) + m_box.capacity()*sizeof(BOX) + m_item.capacity()*sizeof(int);
+}
+
+//-----------------------------------------------------------------------------
+void FESpatialTree::Build(const std::vector<vec3d>& points, int leafSize)
+{
+	int N = (int)points.size();
+	m_box.resize(N);
+	for (int i = 0; i < N; ++i)
+	{
+		m_box[i].r0 = points[i];
+		m_box[i].r1 = points[i];
+	}
+	BuildTree(leafSize);
+}
+
+//-----------------------------------------------------------------------------
+void FESpatialTree::Build(const std::vector<BOX>& boxes, int leafSize)
+{
+	m_box = boxes;
+	BuildTree(leafSize);
+}
+
+//-----------------------------------------------------------------------------
+// On entry, m_box contains the item boxes in the original order.
+void FESpatialTree::BuildTree(int leafSize)
+{
+	if (leafSize < 1) leafSize = 1;
+
+	int N = (int)m_box.size();
+	m_item.resize(N);
+	for (int i = 0; i < N; ++i) m_item[i] = i;
+	m_node.clear();
+	m_cost0 = 0.0;
+	if (N == 0) return;
+
+	// the items are sorted by their box centers
+	vector<vec3d> c(N);
+	for (int i = 0; i < N; ++i) c[i] = (m_box[i].r0 + m_box[i].r1)*0.5;
+
+	// Since the layout of the tree is fixed by the item count, we can allocate
+	// all nodes now and let each thread fill in its own subtrees.
+	m_node.resize(nodeCount(N, leafSize));
+
+	// build the top of the tree and collect the subtrees that are left
+	int minJob = N / (4 * omp_get_max_threads());
+	if (minJob < 1024) minJob = 1024;
+	vector<int> jobs;
+	BuildNode(0, 0, N, leafSize, c, (N > minJob ? &jobs : nullptr));
+
+	int njobs = (int)jobs.size() / 3;
+#pragma omp parallel for schedule(dynamic)
+	for (int i = 0; i < njobs; ++i)
+	{
+		BuildNode(jobs[3 * i], jobs[3 * i + 1], jobs[3 * i + 2], leafSize, c, nullptr);
+	}
+
+	// store the boxes in leaf order
+	vector<BOX> box(m_box);
+#pragma omp parallel for
+	for (int i = 0; i < N; ++i) m_box[i] = box[m_item[i]];
+
+	UpdateBoxes();
+	m_cost0 = Cost();
+}
+
+//-----------------------------------------------------------------------------
+// Build the subtree for items [i0, i1). If jobs is not null, subtrees that are small
+// enough are not built, but added to the jobs list, so they can be processed in parallel.
+void FESpatialTree::BuildNode(int node, int i0, int i1, int leafSize, std::vector<vec3d>& c, std::vector<int>* jobs)
+{
+	int n = i1 - i0;
+	NODE& nd = m_node[node];
+	if (n <= leafSize)
+	{
+		nd.first = i0;
+		nd.count = n;
+		return;
+	}
+
+	if (jobs && (n * 4 * omp_get_max_threads() <= (int)m_box.size()))
+	{
+		jobs->push_back(node);
+		jobs->push_back(i0);
+		jobs->push_back(i1);
+		return;
+	}
+
+	// find the longest axis of the box around the item centers
+	vec3d c0 = c[m_item[i0]], c1 = c0;
+	for (int i = i0 + 1; i < i1; ++i)
+	{
+		const vec3d& ci = c[m_item[i]];
+		if (ci.x < c0.x) c0.x = ci.x; if (ci.x > c1.x) c1.x = ci.x;
+		if (ci.y < c0.y) c0.y = ci.y; if (ci.y > c1.y) c1.y = ci.y;
+		if (ci.z < c0.z) c0.z = ci.z; if (ci.z > c1.z) c1.z = ci.z;
+	}
+	vec3d d = c1 - c0;
+	int axis = 0;
+	if ((d.y > d.x) && (d.y >= d.z)) axis = 1;
+	else if ((d.z > d.x) && (d.z > d.y)) axis = 2;
+
+	// split at the median
+	int m = i0 + n / 2;
+	nth_element(m_item.begin() + i0, m_item.begin() + m, m_item.begin() + i1, [&](int a, int b) {
+		double ca = (axis == 0 ? c[a].x : (axis == 1 ? c[a].y : c[a].z));
+		double cb = (axis == 0 ? c[b].x : (axis == 1 ? c[b].y : c[b].z));
+		return (ca < cb) || ((ca == cb) && (a < b));
+	});
+
+	// the left child follows this node, the right child follows the left subtree
+	int left = node + 1;
+	int right = left + nodeCount(m - i0, leafSize);
+	nd.first = right;
+	nd.count = 0;
+
+	BuildNode(left, i0, m, leafSize, c, jobs);
+	BuildNode(right, m, i1, leafSize, c, jobs);
+}
+
+//-----------------------------------------------------------------------------
+void FESpatialTree::Refit(const std::vector<BOX>& boxes)
+{
+	assert(boxes.size() == m_box.size());
+	int N = (int)m_box.size();
+#pragma omp parallel for
+	for (int i = 0; i < N; ++i) m_box[i] = boxes[m_item[i]];
+
+	UpdateBoxes();
+}
+
+//-----------------------------------------------------------------------------
+void FESpatialTree::Refit(const std::vector<vec3d>& points)
+{
+	assert(points.size() == m_box.size());
+	int N = (int)m_box.size();
+#pragma omp parallel for
+	for (int i = 0; i < N; ++i)
+	{
+		const vec3d& r = points[m_item[i]];
+		m_box[i].r0 = r;
+		m_box[i].r1 = r;
+	}
+
+	UpdateBoxes();
+}
+
+//-----------------------------------------------------------------------------
+double FESpatialTree::Degradation() const
+{
+	if (m_cost0 <= 0.0) return 1.0;
+	return Cost() / m_cost0;
+}
+
+//-----------------------------------------------------------------------------
+// Sum of the (half) surface areas of all node boxes, divided by that of the root.
+double FESpatialTree::Cost() const
+{
+	int NN = (int)m_node.size();
+	if (NN == 0) return 0.0;
+
+	double sum = 0.0;
+#pragma omp parallel for reduction(+:sum)
+	for (int i = 0; i < NN; ++i)
+	{
+		vec3d d = m_node[i].r1 - m_node[i].r0;
+		sum += d.x*d.y + d.y*d.z + d.z*d.x;
+	}
+
+	vec3d d = m_node[0].r1 - m_node[0].r0;
+	double A = d.x*d.y + d.y*d.z + d.z*d.x;
+	return (A > 0.0 ? sum / A : 0.0);
+}
+
+//-----------------------------------------------------------------------------
+// Update the node boxes from the item boxes.
+void FESpatialTree::UpdateBoxes()
+{
+	int NN = (int)m_node.size();
+
+	// leaves first
+#pragma omp parallel for
+	for (int i = 0; i < NN; ++i)
+	{
+		NODE& nd = m_node[i];
+		if (nd.count > 0)
+		{
+			nd.r0 = m_box[nd.first].r0;
+			nd.r1 = m_box[nd.first].r1;
+			for (int j = 1; j < nd.count; ++j)
+			{
+				const BOX& b = m_box[nd.first + j];
+				if (b.r0.x < nd.r0.x) nd.r0.x = b.r0.x; if (b.r1.x > nd.r1.x) nd.r1.x = b.r1.x;
+				if (b.r0.y < nd.r0.y) nd.r0.y = b.r0.y; if (b.r1.y > nd.r1.y) nd.r1.y = b.r1.y;
+				if (b.r0.z < nd.r0.z) nd.r0.z = b.r0.z; if (b.r1.z > nd.r1.z) nd.r1.z = b.r1.z;
+			}
+		}
+	}
+
+	// children are stored after their parent, so a reverse sweep updates the internal nodes
+	for (int i = NN - 1; i >= 0; --i)
+	{
+		NODE& nd = m_node[i];
+		if (nd.count == 0)
+		{
+			const NODE& a = m_node[i + 1];
+			const NODE& b = m_node[nd.first];
+			nd.r0 = vec3d(min(a.r0.x, b.r0.x), min(a.r0.y, b.r0.y), min(a.r0.z, b.r0.z));
+			nd.r1 = vec3d(max(a.r1.x, b.r1.x), max(a.r1.y, b.r1.y), max(a.r1.z, b.r1.z));
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// squared distance from x to a box (zero if x is inside)
+double FESpatialTree::BoxDistance2(const vec3d& r0, const vec3d& r1, const vec3d& x) const
+{
+	double dx = (x.x < r0.x ? r0.x - x.x : (x.x > r1.x ? x.x - r1.x : 0.0));
+	double dy = (x.y < r0.y ? r0.y - x.y : (x.y > r1.y ? x.y - r1.y : 0.0));
+	double dz = (x.z < r0.z ? r0.z - x.z : (x.z > r1.z ? x.z - r1.z : 0.0));
+	return dx*dx + dy*dy + dz*dz;
+}
+
+//-----------------------------------------------------------------------------
+int FESpatialTree::FindNearest(const vec3d& x) const
+{
+	return FindNearest(x, 0.0, [](int) { return true; });
+}
+
+//-----------------------------------------------------------------------------
+int FESpatialTree::FindNearest(const vec3d& x, double R, std::function<bool(int)> accept) const
+{
+	if (m_node.empty()) return -1;
+
+	double dmin = (R > 0 ? R*R : DBL_MAX);
+	int imin = -1;
+
+	int stack[MAX_STACK];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		int inode = stack[--ns];
+		const NODE& nd = m_node[inode];
+		if (BoxDistance2(nd.r0, nd.r1, x) > dmin) continue;
+
+		if (nd.count > 0)
+		{
+			for (int i = nd.first; i < nd.first + nd.count; ++i)
+			{
+				double d2 = BoxDistance2(m_box[i].r0, m_box[i].r1, x);
+				int item = m_item[i];
+
+				// ties are resolved by the item index, so that the result does not depend on the tree
+				if ((d2 < dmin) || ((d2 == dmin) && ((imin == -1) || (item < imin))))
+				{
+					if (accept(item))
+					{
+						dmin = d2;
+						imin = item;
+					}
+				}
+			}
+		}
+		else
+		{
+			// visit the closest child first
+			int a = inode + 1;
+			int b = nd.first;
+			double da = BoxDistance2(m_node[a].r0, m_node[a].r1, x);
+			double db = BoxDistance2(m_node[b].r0, m_node[b].r1, x);
+			if (da <= db) { stack[ns++] = b; stack[ns++] = a; }
+			else { stack[ns++] = a; stack[ns++] = b; }
+		}
+	}
+
+	return imin;
+}
+
+//-----------------------------------------------------------------------------
+int FESpatialTree::FindNearest(const vec3d& x, int k, std::vector<int>& items) const
+{
+	int N = (int)m_box.size();
+	if (k > N) k = N;
+	items.resize(k);
+	if (k <= 0) return 0;
+
+	// the k best candidates so far, sorted by distance
+	vector<double> dist(k, DBL_MAX);
+	int n = 0;
+
+	int stack[MAX_STACK];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		int inode = stack[--ns];
+		const NODE& nd = m_node[inode];
+		if ((n == k) && (BoxDistance2(nd.r0, nd.r1, x) > dist[k - 1])) continue;
+
+		if (nd.count > 0)
+		{
+			for (int i = nd.first; i < nd.first + nd.count; ++i)
+			{
+				double d2 = BoxDistance2(m_box[i].r0, m_box[i].r1, x);
+				int item = m_item[i];
+				if ((n == k) && ((d2 > dist[k - 1]) || ((d2 == dist[k - 1]) && (item > items[k - 1])))) continue;
+
+				// insert the item
+				int m = (n < k ? n++ : k - 1);
+				while ((m > 0) && ((d2 < dist[m - 1]) || ((d2 == dist[m - 1]) && (item < items[m - 1]))))
+				{
+					dist[m] = dist[m - 1];
+					items[m] = items[m - 1];
+					m--;
+				}
+				dist[m] = d2;
+				items[m] = item;
+			}
+		}
+		else
+		{
+			int a = inode + 1;
+			int b = nd.first;
+			double da = BoxDistance2(m_node[a].r0, m_node[a].r1, x);
+			double db = BoxDistance2(m_node[b].r0, m_node[b].r1, x);
+			if (da <= db) { stack[ns++] = b; stack[ns++] = a; }
+			else { stack[ns++] = a; stack[ns++] = b; }
+		}
+	}
+
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+void FESpatialTree::FindInRadius(const vec3d& x, double R, std::vector<int>& items) const
+{
+	items.clear();
+	if (m_node.empty()) return;
+
+	double R2 = R*R;
+	int stack[MAX_STACK];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		int inode = stack[--ns];
+		const NODE& nd = m_node[inode];
+		if (BoxDistance2(nd.r0, nd.r1, x) > R2) continue;
+
+		if (nd.count > 0)
+		{
+			for (int i = nd.first; i < nd.first + nd.count; ++i)
+			{
+				if (BoxDistance2(m_box[i].r0, m_box[i].r1, x) <= R2) items.push_back(m_item[i]);
+			}
+		}
+		else
+		{
+			stack[ns++] = nd.first;
+			stack[ns++] = inode + 1;
+		}
+	}
+	sort(items.begin(), items.end());
+}
+
+//-----------------------------------------------------------------------------
+void FESpatialTree::FindContaining(const vec3d& x, std::vector<int>& items) const
+{
+	FindInRadius(x, 0.0, items);
+}
+
+//-----------------------------------------------------------------------------
+// check if the line p + t*n intersects the box
+static bool lineIntersectsBox(const vec3d& r0, const vec3d& r1, const vec3d& p, const vec3d& n)
+{
+	double tmin = -DBL_MAX, tmax = DBL_MAX;
+	const double P[3] = { p.x, p.y, p.z };
+	const double N[3] = { n.x, n.y, n.z };
+	const double A[3] = { r0.x, r0.y, r0.z };
+	const double B[3] = { r1.x, r1.y, r1.z };
+	for (int i = 0; i < 3; ++i)
+	{
+		if (N[i] == 0.0)
+		{
+			if ((P[i] < A[i]) || (P[i] > B[i])) return false;
+		}
+		else
+		{
+			double t0 = (A[i] - P[i]) / N[i];
+			double t1 = (B[i] - P[i]) / N[i];
+			if (t0 > t1) { double t = t0; t0 = t1; t1 = t; }
+			if (t0 > tmin) tmin = t0;
+			if (t1 < tmax) tmax = t1;
+			if (tmin > tmax) return false;
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FESpatialTree::FindRayCandidates(const vec3d& p, const vec3d& n, double srad, std::vector<int>& items) const
+{
+	items.clear();
+	if (m_node.empty()) return;
+
+	int stack[MAX_STACK];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		int inode = stack[--ns];
+		const NODE& nd = m_node[inode];
+
+		// check if the node is within the search radius and is hit by the ray
+		if ((nd.r0.x - srad > p.x) || (nd.r1.x + srad < p.x) ||
+			(nd.r0.y - srad > p.y) || (nd.r1.y + srad < p.y) ||
+			(nd.r0.z - srad > p.z) || (nd.r1.z + srad < p.z)) continue;
+		if (lineIntersectsBox(nd.r0, nd.r1, p, n) == false) continue;
+
+		if (nd.count > 0)
+		{
+			for (int i = nd.first; i < nd.first + nd.count; ++i)
+			{
+				const BOX& b = m_box[i];
+				if ((b.r0.x - srad > p.x) || (b.r1.x + srad < p.x) ||
+					(b.r0.y - srad > p.y) || (b.r1.y + srad < p.y) ||
+					(b.r0.z - srad > p.z) || (b.r1.z + srad < p.z)) continue;
+				if (lineIntersectsBox(b.r0, b.r1, p, n)) items.push_back(m_item[i]);
+			}
+		}
+		else
+		{
+			stack[ns++] = nd.first;
+			stack[ns++] = inode + 1;
+		}
+	}
+	sort(items.begin(), items.end());
+}
@@ -0,0 +1,152 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "vec3d.h"
+#include "fecore_api.h"
+#include <vector>
+#include <functional>
+
+//-----------------------------------------------------------------------------
+//! A bounding volume hierarchy over a set of points or axis-aligned boxes.
+//! The tree is built top-down with median splits along the longest axis, so
+//! its layout only depends on the number of items. Nodes are stored in a flat
+//! array in depth-first order and the items are reordered so that each leaf
+//! references a contiguous block. Subtrees are built in parallel.
+//! All queries are const and use no shared scratch data, so they can be called
+//! concurrently from inside OpenMP loops.
+class FECORE_API FESpatialTree
+{
+public:
+	//! axis-aligned box of an item
+	struct BOX
+	{
+		vec3d	r0, r1;
+
+		BOX() {}
+		BOX(const vec3d& r) : r0(r), r1(r) {}
+
+		// grow the box to include r
+		void add(const vec3d& r)
+		{
+			if (r.x < r0.x) r0.x = r.x; if (r.x > r1.x) r1.x = r.x;
+			if (r.y < r0.y) r0.y = r.y; if (r.y > r1.y) r1.y = r.y;
+			if (r.z < r0.z) r0.z = r.z; if (r.z > r1.z) r1.z = r.z;
+		}
+
+		// max dimension
+		double radius() const
+		{
+			vec3d d = r1 - r0;
+			double R = d.x;
+			if (d.y > R) R = d.y;
+			if (d.z > R) R = d.z;
+			return R;
+		}
+
+		// inflate the box by d in all directions
+		void inflate(double d)
+		{
+			r0 -= vec3d(d, d, d);
+			r1 += vec3d(d, d, d);
+		}
+	};
+
+	//! tree node
+	struct NODE
+	{
+		vec3d	r0, r1;		//!< bounding box of node
+		int		first;		//!< leaf: first item in m_item; internal: index of right child
+		int		count;		//!< number of items (zero for internal nodes)
+	};
+
+public:
+	FESpatialTree();
+
+	//! build the tree for a set of points
+	void Build(const std::vector<vec3d>& points, int leafSize = 8);
+
+	//! build the tree for a set of boxes
+	void Build(const std::vector<BOX>& boxes, int leafSize = 4);
+
+	//! update the item boxes without changing the tree topology.
+	//! This keeps all queries exact, but the tree degrades if the items move a lot.
+	void Refit(const std::vector<BOX>& boxes);
+
+	//! update the item positions of a tree that was built for a set of points
+	void Refit(const std::vector<vec3d>& points);
+
+	//! Ratio of the current tree cost to its cost right after the last build. The cost
+	//! is the total surface area of the node boxes, relative to the root box, so it
+	//! does not change when all items move or stretch uniformly. A refitted tree for
+	//! which this grows well beyond one should be rebuilt.
+	double Degradation() const;
+
+	//! clear all data
+	void Clear();
+
+	//! number of items in the tree
+	int Items() const { return (int)m_box.size(); }
+
+	//! memory used by the tree (in bytes)
+	size_t MemoryUsage() const;
+
+public:
+	//! find the nearest item to x. Returns -1 if the tree is empty.
+	int FindNearest(const vec3d& x) const;
+
+	//! find the nearest item within a distance R of x (R <= 0 means no limit)
+	//! for which accept returns true. Returns -1 if no such item was found.
+	int FindNearest(const vec3d& x, double R, std::function<bool(int)> accept) const;
+
+	//! find the k nearest items, sorted by increasing distance. Returns the number of items found.
+	int FindNearest(const vec3d& x, int k, std::vector<int>& items) const;
+
+	//! find all items within a distance R of x (in increasing item order)
+	void FindInRadius(const vec3d& x, double R, std::vector<int>& items) const;
+
+	//! find all items whose box contains x (in increasing item order)
+	void FindContaining(const vec3d& x, std::vector<int>& items) const;
+
+	//! find all items whose box intersects the line through p along n, and that lie
+	//! within a distance srad of p, measured along each axis (in increasing item order).
+	void FindRayCandidates(const vec3d& p, const vec3d& n, double srad, std::vector<int>& items) const;
+
+private:
+	void BuildTree(int leafSize);
+	void BuildNode(int node, int i0, int i1, int leafSize, std::vector<vec3d>& c, std::vector<int>* jobs);
+	void UpdateBoxes();
+	double Cost() const;
+
+	double BoxDistance2(const vec3d& r0, const vec3d& r1, const vec3d& x) const;
+
+private:
+	std::vector<NODE>	m_node;		//!< tree nodes in depth-first order
+	std::vector<BOX>	m_box;		//!< item boxes, in leaf order
+	std::vector<int>	m_item;		//!< original item index, in leaf order
+	double				m_cost0;	//!< tree cost after the last build
+};
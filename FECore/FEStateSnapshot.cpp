@@ -0,0 +1,115 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEStateSnapshot.h"
+#include "FEModel.h"
+#include "FEMesh.h"
+#include "Timer.h"
+#include <assert.h>
+
+//-----------------------------------------------------------------------------
+FEStateSnapshot::FEStateSnapshot(FEModel& fem) : m_fem(fem), m_dmp(fem)
+{
+	m_dmp.ExcludeNodalData(true);
+	m_bvalid = false;
+}
+
+//-----------------------------------------------------------------------------
+void FEStateSnapshot::Clear()
+{
+	m_dmp.reset();
+	m_bvalid = false;
+}
+
+//-----------------------------------------------------------------------------
+size_t FEStateSnapshot::Size() const
+{
+	if (m_bvalid == false) return 0;
+	return m_nodeData.size()*sizeof(double) + m_dmp.size();
+}
+
+//-----------------------------------------------------------------------------
+size_t FEStateSnapshot::NodeDataSize() const
+{
+	FEMesh& mesh = m_fem.GetMesh();
+	size_t n = 0;
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		n += mesh.Node(i).StateSize();
+	}
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+void FEStateSnapshot::Save()
+{
+	TimerTracker t(&m_fem, TimerID::Timer_Snapshot);
+
+	// copy the nodal state
+	// (The buffer only needs to be resized when the number of nodes or dofs changes.)
+	FEMesh& mesh = m_fem.GetMesh();
+	size_t nsize = NodeDataSize();
+	if (m_nodeData.size() != nsize) m_nodeData.resize(nsize);
+	double* pd = (m_nodeData.empty() ? nullptr : &m_nodeData[0]);
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		pd = mesh.Node(i).SaveState(pd);
+	}
+
+	// store everything else in the dump stream
+	m_dmp.reset();
+	m_fem.Serialize(m_dmp);
+
+	m_bvalid = true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEStateSnapshot::Restore()
+{
+	if (m_bvalid == false) return false;
+
+	TimerTracker t(&m_fem, TimerID::Timer_Snapshot);
+
+	// the mesh cannot change between saving and restoring
+	assert(m_nodeData.size() == NodeDataSize());
+
+	// restore the nodal state
+	FEMesh& mesh = m_fem.GetMesh();
+	const double* pd = (m_nodeData.empty() ? nullptr : &m_nodeData[0]);
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		pd = mesh.Node(i).RestoreState(pd);
+	}
+
+	// restore everything else
+	m_dmp.Open(false, true);
+	m_fem.Serialize(m_dmp);
+
+	return true;
+}
@@ -0,0 +1,69 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "DumpMemStream.h"
+#include <vector>
+
+class FEModel;
+
+//-----------------------------------------------------------------------------
+//! Records the mutable state of a model so that it can be restored later, e.g.
+//! when a time step needs to be retried.
+//! The nodal state is copied into a flat array. The remaining state (material
+//! point history, contact, rigid bodies, solver data) is stored in a shallow
+//! dump stream. Both buffers are kept between calls, so taking a snapshot does
+//! not allocate memory once the buffers have reached their final size.
+class FECORE_API FEStateSnapshot
+{
+public:
+	FEStateSnapshot(FEModel& fem);
+
+	//! record the current state of the model
+	void Save();
+
+	//! restore the model to the last recorded state
+	//! returns false if no state was recorded
+	bool Restore();
+
+	//! discard the recorded state (the buffers are kept)
+	void Clear();
+
+	//! size (in bytes) of the recorded state
+	size_t Size() const;
+
+private:
+	//! nr of doubles that is stored per node
+	size_t NodeDataSize() const;
+
+private:
+	FEModel&			m_fem;
+	std::vector<double>	m_nodeData;	//!< nodal state
+	DumpMemStream		m_dmp;		//!< remaining state
+	bool				m_bvalid;	//!< true if a state was recorded
+};
@@ -50,6 +50,7 @@ class FECORE_API FaceDataRecord : public DataRecord
 public:
 	FaceDataRecord(FEModel* pfem);
 	double Evaluate(int item, int ndata) override;
+	bool ParallelEvaluation() const override { return true; }
 	bool Initialize() override;
 	void SetData(const char* sz) override;
 	void SelectAllItems() override;
@@ -28,6 +28,11 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "LinearSolver.h"
+#include <float.h>
+#include <math.h>
+
+// max nr of iterations of the mixed-precision iterative refinement
+#define MAX_REFINEMENT_ITERS	30
 
 //-----------------------------------------------------------------------------
 LinearSolver::LinearSolver(FEModel* fem) : FECoreBase(fem)
@@ -48,6 +53,12 @@ bool LinearSolver::IsIterative() const
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+size_t LinearSolver::MemoryUsage() const
+{
+	return 0;
+}
+
 //-----------------------------------------------------------------------------
 bool LinearSolver::PreProcess()
 { 
@@ -102,6 +113,52 @@ void LinearSolver::UpdateStats(int iterations)
 	m_stats.iterations += iterations;
 }
 
+//-----------------------------------------------------------------------------
+// The refinement is considered converged when the normwise backward error is 
+// at the level of double precision, i.e. ||r|| <= sqrt(n)*eps*||A||*||x|| (which
+// is the same test as LAPACK's mixed-precision drivers). Since each step should 
+// reduce the residual by roughly a factor cond(A)*eps(float), the refinement 
+// is considered to stall if that factor drops below two.
+bool LinearSolver::IterativeRefinement(SparseMatrix* A, double normA, double* x, double* b, int* iterations)
+{
+	const int n = A->Rows();
+	if (n == 0) return true;
+	std::vector<double> r(n), dx(n);
+
+	const double eps = sqrt((double)n) * DBL_EPSILON * normA;
+	double rnorm0 = 0.0;
+	if (iterations) *iterations = 0;
+	for (int k = 0; k <= MAX_REFINEMENT_ITERS; ++k)
+	{
+		// residual (in double precision)
+		if (A->mult_vector(x, &r[0]) == false) return false;
+		double rnorm = 0.0, xnorm = 0.0;
+		for (int i = 0; i < n; ++i)
+		{
+			r[i] = b[i] - r[i];
+			rnorm = fmax(rnorm, fabs(r[i]));
+			xnorm = fmax(xnorm, fabs(x[i]));
+		}
+		if (rnorm != rnorm) return false;
+		if (rnorm <= eps * xnorm) return true;
+		if ((k > 0) && (rnorm > 0.5*rnorm0)) return false;
+		rnorm0 = rnorm;
+
+		// correction (with the low precision factorization)
+		if (k == MAX_REFINEMENT_ITERS) break;
+		if (SolveCorrection(&dx[0], &r[0]) == false) return false;
+		for (int i = 0; i < n; ++i) x[i] += dx[i];
+		if (iterations) (*iterations)++;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool LinearSolver::SolveCorrection(double* dx, double* r)
+{
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 void LinearSolver::Destroy()
 {
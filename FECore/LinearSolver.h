@@ -113,6 +113,10 @@ public:
 	// returns whether this is an iterative solver or not
 	virtual bool IsIterative() const;
 
+	//! memory (in bytes) held by the solver, e.g. for the factorization or preconditioner.
+	//! This does not include the sparse matrix.
+	virtual size_t MemoryUsage() const;
+
 public:
 	const LinearSolverStats& GetStats() const;
 
@@ -123,6 +127,17 @@ protected:
 	// Should be called after each backsolve. Will increment backsolves by one and add iterations
 	void UpdateStats(int iterations);
 
+	//! Mixed-precision iterative refinement. Solvers that factor in single precision
+	//! call this from BackSolve after the low precision solve of A*x = b. The residuals
+	//! are evaluated in double precision with A (normA is its inf-norm) and the 
+	//! corrections are calculated with SolveCorrection. This returns false when the
+	//! refinement stalls, in which case the solver should fall back to double precision.
+	//! The number of correction steps is returned in iterations (optional).
+	bool IterativeRefinement(SparseMatrix* A, double normA, double* x, double* b, int* iterations = nullptr);
+
+	//! Solve A*dx = r with the low precision factorization (see IterativeRefinement)
+	virtual bool SolveCorrection(double* dx, double* r);
+
 protected:
 	std::vector<int>	m_part;		//!< partitions of linear system.
 
@@ -0,0 +1,282 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "MProgram.h"
+#include "MEvaluate.h"
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+MProgram::MProgram()
+{
+	m_nvar = 0;
+}
+
+//-----------------------------------------------------------------------------
+void MProgram::Clear()
+{
+	m_code.clear();
+	m_nvar = 0;
+}
+
+//-----------------------------------------------------------------------------
+bool MProgram::Compile(const MSimpleExpression& e)
+{
+	Clear();
+
+	const MITEM& item = e.GetExpression();
+	if (item.ItemPtr() == nullptr) return false;
+
+	// first, try to simplify the expression
+	bool bok = false;
+	try {
+		MITEM s = MEvaluate(item);
+		bok = compile(s.ItemPtr(), 0);
+	}
+	catch (...)
+	{
+		bok = false;
+	}
+
+	// if that fails, compile the original expression
+	if (bok == false)
+	{
+		m_code.clear();
+		bok = compile(item.ItemPtr(), 0);
+	}
+
+	if (bok == false)
+	{
+		Clear();
+		return false;
+	}
+
+	m_nvar = e.Variables();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void MProgram::emit(int op, int r, int n, double c, FUNCPTR f1, FUNC2PTR f2)
+{
+	Instruction i;
+	i.op = op;
+	i.r = r;
+	i.n = n;
+	i.c = c;
+	i.f1 = f1;
+	i.f2 = f2;
+	m_code.push_back(i);
+}
+
+//-----------------------------------------------------------------------------
+// see if an item evaluates to a constant, and if so, evaluate it
+bool MProgram::constValue(const MItem* pi, double& v) const
+{
+	switch (pi->Type())
+	{
+	case MCONST:
+	case MFRAC:
+	case MNAMED: v = mnumber(pi)->value(); return true;
+	case MVAR: return false;
+	case MNEG:
+		if (constValue(munary(pi)->Item(), v) == false) return false;
+		v = -v;
+		return true;
+	case MF1D:
+		if (constValue(munary(pi)->Item(), v) == false) return false;
+		v = (mfnc1d(pi)->funcptr())(v);
+		return true;
+	case MADD: case MSUB: case MMUL: case MDIV: case MPOW: case MF2D:
+	{
+		double a, b;
+		if (constValue(mbinary(pi)->LeftItem(), a) == false) return false;
+		if (constValue(mbinary(pi)->RightItem(), b) == false) return false;
+		switch (pi->Type())
+		{
+		case MADD: v = a + b; break;
+		case MSUB: v = a - b; break;
+		case MMUL: v = a * b; break;
+		case MDIV: v = a / b; break;
+		case MPOW: v = pow(a, b); break;
+		case MF2D: v = (mfnc2d(pi)->funcptr())(a, b); break;
+		}
+		return true;
+	}
+	case MSFNC: return constValue(msfncnd(pi)->Value(), v);
+	default:
+		return false;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Generate the code that evaluates the item into register r.
+// Registers above r may be used as temporaries.
+bool MProgram::compile(const MItem* pi, int r)
+{
+	if (r >= MAX_REGISTERS) return false;
+
+	double c;
+	if (constValue(pi, c)) { emit(OP_CONST, r, 0, c); return true; }
+
+	switch (pi->Type())
+	{
+	case MVAR:
+		emit(OP_VAR, r, mvar(pi)->index());
+		return true;
+	case MNEG:
+		if (compile(munary(pi)->Item(), r) == false) return false;
+		emit(OP_NEG, r);
+		return true;
+	case MF1D:
+		if (compile(munary(pi)->Item(), r) == false) return false;
+		emit(OP_F1D, r, 0, 0.0, mfnc1d(pi)->funcptr());
+		return true;
+	case MADD: case MSUB: case MMUL: case MDIV: case MPOW:
+	{
+		const MItem* pl = mbinary(pi)->LeftItem();
+		const MItem* pr = mbinary(pi)->RightItem();
+		if (compile(pl, r) == false) return false;
+
+		// use the immediate form when the right operand is constant
+		if (constValue(pr, c))
+		{
+			switch (pi->Type())
+			{
+			case MADD: emit(OP_ADDC, r, 0, c); break;
+			case MSUB: emit(OP_SUBC, r, 0, c); break;
+			case MMUL: emit(OP_MULC, r, 0, c); break;
+			case MDIV: emit(OP_DIVC, r, 0, c); break;
+			case MPOW: if (c == 2.0) emit(OP_SQR, r); else emit(OP_POWC, r, 0, c); break;
+			}
+			return true;
+		}
+
+		if (compile(pr, r + 1) == false) return false;
+		switch (pi->Type())
+		{
+		case MADD: emit(OP_ADD, r); break;
+		case MSUB: emit(OP_SUB, r); break;
+		case MMUL: emit(OP_MUL, r); break;
+		case MDIV: emit(OP_DIV, r); break;
+		case MPOW: emit(OP_POW, r); break;
+		}
+		return true;
+	}
+	case MF2D:
+		if (compile(mbinary(pi)->LeftItem(), r) == false) return false;
+		if (compile(mbinary(pi)->RightItem(), r + 1) == false) return false;
+		emit(OP_F2D, r, 0, 0.0, nullptr, mfnc2d(pi)->funcptr());
+		return true;
+	case MSFNC:
+		return compile(msfncnd(pi)->Value(), r);
+	default:
+		// not supported
+		return false;
+	}
+}
+
+//-----------------------------------------------------------------------------
+double MProgram::value(const double* var) const
+{
+	double reg[MAX_REGISTERS];
+	const int N = (int)m_code.size();
+	const Instruction* code = (N > 0 ? &m_code[0] : nullptr);
+	for (int i = 0; i < N; ++i)
+	{
+		const Instruction& in = code[i];
+		double& a = reg[in.r];
+		switch (in.op)
+		{
+		case OP_CONST: a = in.c; break;
+		case OP_VAR  : a = var[in.n]; break;
+		case OP_NEG  : a = -a; break;
+		case OP_ADD  : a += reg[in.r + 1]; break;
+		case OP_SUB  : a -= reg[in.r + 1]; break;
+		case OP_MUL  : a *= reg[in.r + 1]; break;
+		case OP_DIV  : a /= reg[in.r + 1]; break;
+		case OP_POW  : a = pow(a, reg[in.r + 1]); break;
+		case OP_ADDC : a += in.c; break;
+		case OP_SUBC : a -= in.c; break;
+		case OP_MULC : a *= in.c; break;
+		case OP_DIVC : a /= in.c; break;
+		case OP_POWC : a = pow(a, in.c); break;
+		case OP_SQR  : a *= a; break;
+		case OP_F1D  : a = in.f1(a); break;
+		case OP_F2D  : a = in.f2(a, reg[in.r + 1]); break;
+		}
+	}
+	return (N > 0 ? reg[0] : 0.0);
+}
+
+//-----------------------------------------------------------------------------
+// The points are processed in blocks of BATCH_SIZE, so that the instructions 
+// are decoded once per block, and the inner loops can be vectorized.
+void MProgram::value(int npts, const double* var, double* val) const
+{
+	double reg[MAX_REGISTERS][BATCH_SIZE];
+	const int N = (int)m_code.size();
+	if (N == 0)
+	{
+		for (int k = 0; k < npts; ++k) val[k] = 0.0;
+		return;
+	}
+
+	const int nvar = m_nvar;
+	for (int k0 = 0; k0 < npts; k0 += BATCH_SIZE)
+	{
+		const int nk = (npts - k0 < BATCH_SIZE ? npts - k0 : BATCH_SIZE);
+		const double* vk = var + k0*nvar;
+		for (int i = 0; i < N; ++i)
+		{
+			const Instruction& in = m_code[i];
+			double* a = reg[in.r];
+			const double* b = (in.r + 1 < MAX_REGISTERS ? reg[in.r + 1] : nullptr);
+			const double c = in.c;
+			switch (in.op)
+			{
+			case OP_CONST: for (int k = 0; k < nk; ++k) a[k] = c; break;
+			case OP_VAR  : for (int k = 0; k < nk; ++k) a[k] = vk[k*nvar + in.n]; break;
+			case OP_NEG  : for (int k = 0; k < nk; ++k) a[k] = -a[k]; break;
+			case OP_ADD  : for (int k = 0; k < nk; ++k) a[k] += b[k]; break;
+			case OP_SUB  : for (int k = 0; k < nk; ++k) a[k] -= b[k]; break;
+			case OP_MUL  : for (int k = 0; k < nk; ++k) a[k] *= b[k]; break;
+			case OP_DIV  : for (int k = 0; k < nk; ++k) a[k] /= b[k]; break;
+			case OP_POW  : for (int k = 0; k < nk; ++k) a[k] = pow(a[k], b[k]); break;
+			case OP_ADDC : for (int k = 0; k < nk; ++k) a[k] += c; break;
+			case OP_SUBC : for (int k = 0; k < nk; ++k) a[k] -= c; break;
+			case OP_MULC : for (int k = 0; k < nk; ++k) a[k] *= c; break;
+			case OP_DIVC : for (int k = 0; k < nk; ++k) a[k] /= c; break;
+			case OP_POWC : for (int k = 0; k < nk; ++k) a[k] = pow(a[k], c); break;
+			case OP_SQR  : for (int k = 0; k < nk; ++k) a[k] *= a[k]; break;
+			case OP_F1D  : for (int k = 0; k < nk; ++k) a[k] = in.f1(a[k]); break;
+			case OP_F2D  : for (int k = 0; k < nk; ++k) a[k] = in.f2(a[k], b[k]); break;
+			}
+		}
+		for (int k = 0; k < nk; ++k) val[k0 + k] = reg[0][k];
+	}
+}
@@ -0,0 +1,113 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "MathObject.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// A simple expression that is compiled into a linear list of register
+// instructions. Evaluating a program does not walk the expression tree and does
+// not allocate any memory, so the evaluation functions are thread safe.
+// The variables are passed in the same order as the variables of the expression.
+class FECORE_API MProgram
+{
+public:
+	// max nr of registers, which limits the depth of the expression tree
+	enum { MAX_REGISTERS = 32 };
+
+	// max nr of points that are processed at once by the batched evaluation
+	enum { BATCH_SIZE = 16 };
+
+private:
+	enum OpCode {
+		OP_CONST,	// r = c
+		OP_VAR,		// r = var[n]
+		OP_NEG,		// r = -r
+		OP_ADD,		// r = r + r'
+		OP_SUB,		// r = r - r'
+		OP_MUL,		// r = r * r'
+		OP_DIV,		// r = r / r'
+		OP_POW,		// r = pow(r, r')
+		OP_ADDC,	// r = r + c
+		OP_SUBC,	// r = r - c
+		OP_MULC,	// r = r * c
+		OP_DIVC,	// r = r / c
+		OP_POWC,	// r = pow(r, c)
+		OP_SQR,		// r = r * r
+		OP_F1D,		// r = f(r)
+		OP_F2D		// r = f(r, r')
+	};
+
+	// (r' is the register following r)
+	struct Instruction
+	{
+		int			op;		// op code
+		int			r;		// target register
+		int			n;		// variable index
+		double		c;		// constant
+		FUNCPTR		f1;		// 1D function
+		FUNC2PTR	f2;		// 2D function
+	};
+
+public:
+	MProgram();
+
+	// compile an expression. Constants are folded with MEvaluate first.
+	// Returns false if the expression cannot be compiled (e.g. it contains 
+	// items that are not supported), in which case the program is empty.
+	bool Compile(const MSimpleExpression& e);
+
+	// clear the program
+	void Clear();
+
+	// see if the program is valid
+	bool IsValid() const { return (m_code.empty() == false); }
+
+	// nr of variables the program expects
+	int Variables() const { return m_nvar; }
+
+	// nr of instructions
+	int Instructions() const { return (int)m_code.size(); }
+
+	// evaluate the program
+	double value(const double* var) const;
+
+	// evaluate the program at npts points. The variables for point i are
+	// stored at var[i*Variables()], and the result is stored in val[i]
+	void value(int npts, const double* var, double* val) const;
+
+private:
+	bool compile(const MItem* pi, int r);
+	bool constValue(const MItem* pi, double& v) const;
+	void emit(int op, int r, int n = 0, double c = 0.0, FUNCPTR f1 = nullptr, FUNC2PTR f2 = nullptr);
+
+private:
+	std::vector<Instruction>	m_code;
+	int							m_nvar;
+};
@@ -36,6 +36,16 @@ SparseMatrixProfile::ColumnProfile::ColumnProfile(const SparseMatrixProfile::Col
 	m_data = a.m_data;
 }
 
+bool SparseMatrixProfile::ColumnProfile::operator == (const SparseMatrixProfile::ColumnProfile& a) const
+{
+	if (m_data.size() != a.m_data.size()) return false;
+	for (size_t i = 0; i < m_data.size(); ++i)
+	{
+		if ((m_data[i].start != a.m_data[i].start) || (m_data[i].end != a.m_data[i].end)) return false;
+	}
+	return true;
+}
+
 void SparseMatrixProfile::ColumnProfile::insertRow(int row)
 {
 	// first, check if empty
@@ -85,6 +85,10 @@ public:
 		// add row index to column profile
 		void insertRow(int row);
 
+		// see if two column profiles are identical
+		bool operator == (const ColumnProfile& a) const;
+		bool operator != (const ColumnProfile& a) const { return !(*this == a); }
+
 	private:
 		std::vector<RowEntry>	m_data;	// the column profile data
 	};
@@ -54,6 +54,7 @@ class FECORE_API NodeDataRecord : public DataRecord
 public:
 	NodeDataRecord(FEModel* pfem);
 	double Evaluate(int item, int ndata);
+	bool ParallelEvaluation() const override { return true; }
 	void SetData(const char* sz) override;
 	void SelectAllItems();
 	int Size() const;
@@ -36,6 +36,7 @@ SparseMatrix::SparseMatrix()
 {
 	m_nrow = m_ncol = 0;
 	m_nsize = 0;
+	m_blockFree = false;
 }
 
 SparseMatrix::~SparseMatrix()
@@ -48,6 +49,14 @@ void SparseMatrix::Clear()
 	m_nsize = 0;
 }
 
+//! memory used by the matrix data
+size_t SparseMatrix::MemoryUsage() const
+{
+	if (m_nsize == 0) return 0;
+	size_t n = (size_t)(m_nrow > m_ncol ? m_nrow : m_ncol);
+	return (size_t)m_nsize*(sizeof(double) + sizeof(int)) + (n + 1)*sizeof(int);
+}
+
 //! scale matrix
 void SparseMatrix::scale(const vector<double>& L, const vector<double>& R)
 {
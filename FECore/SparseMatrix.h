@@ -95,6 +95,20 @@ public: // functions to be overwritten in derived classes
 	//! scale matrix
 	virtual void scale(const std::vector<double>& L, const std::vector<double>& R);
 
+	//! memory (in bytes) used for storing the matrix
+	//! The default assumes a compressed row (or column) format.
+	virtual size_t MemoryUsage() const;
+
+public:
+	//! Turn lock-free assembly on or off.
+	//! When on, the caller guarantees that no two threads assemble into the same 
+	//! matrix entries at the same time (e.g. by coloring the elements), so that
+	//! the assembly routines can skip the atomic updates.
+	void SetLockFreeAssembly(bool b) { m_blockFree = b; }
+
+	//! is lock-free assembly on?
+	bool LockFreeAssembly() const { return m_blockFree; }
+
 public:
 	//! multiply with vector
 	bool mult_vector(double* x, double* r) override { assert(false); return false; }
@@ -111,4 +125,5 @@ protected:
 	// NOTE: These values are set by derived classes
 	int	m_nrow, m_ncol;		//!< dimension of matrix
 	int	m_nsize;			//!< number of nonzeroes (i.e. matrix elements actually allocated)
+	bool	m_blockFree;	//!< lock-free assembly flag
 };
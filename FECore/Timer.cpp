@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include <stdio.h>
 #include <string>
 #include "FEModel.h"
+#include "FEProfiler.h"
 
 using namespace std::chrono;
 
@@ -79,6 +80,12 @@ void Timer::reset()
 	m_brunning = false;
 }
 
+//-----------------------------------------------------------------------------
+void Timer::add(double sec)
+{
+	m_total += dseconds(sec);
+}
+
 //-----------------------------------------------------------------------------
 double Timer::peek()
 {
@@ -132,9 +139,31 @@ void Timer::time_str(double fsec, char* sz)
 }
 
 //============================================================================
-TimerTracker::TimerTracker(FEModel* fem, int timerId) : TimerTracker(fem->GetTimer(timerId)) {}
+// profiler region names of the timers (in the order of the TimerID enum)
+static const char* szTimerRegion[] = {
+	"Update",
+	"Linear solve",
+	"Reform",
+	"Residual",
+	"Stiffness",
+	"QN update",
+	"Model solve",
+	"Assemble",
+	"Snapshot"
+};
+
+TimerTracker::TimerTracker(FEModel* fem, int timerId) : TimerTracker(fem->GetTimer(timerId)) 
+{
+	if (m_timer == nullptr) return;
+	FEProfiler& prof = fem->GetProfiler();
+	if (prof.IsEnabled() && (timerId >= 0) && (timerId < (int)(sizeof(szTimerRegion) / sizeof(const char*))))
+	{
+		prof.Begin(prof.Region(szTimerRegion[timerId]));
+		m_prof = &prof;
+	}
+}
 
-TimerTracker::TimerTracker(Timer* timer) 
+TimerTracker::TimerTracker(Timer* timer) : m_prof(nullptr)
 {
 	if (timer && (timer->isRunning() == false)) { m_timer = timer; timer->start(); }
 	else m_timer = nullptr;
@@ -142,5 +171,6 @@ TimerTracker::TimerTracker(Timer* timer)
 
 TimerTracker::~TimerTracker() 
 { 
+	if (m_prof) m_prof->End();
 	if (m_timer) m_timer->stop(); 
 }
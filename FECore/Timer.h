@@ -62,6 +62,10 @@ public:
 	//! Reset the timer
 	void reset();
 
+	//! Add time (in seconds) to the timer
+	//! This can be used for times that are not tracked with start/stop (e.g. times that are averaged over threads)
+	void add(double sec);
+
 	//! Get the elapsed time
 	void GetTime(int& nhour, int& nmin, int& nsec);
 
@@ -90,6 +94,7 @@ private:
 
 //-----------------------------------------------------------------------------
 class FEModel;
+class FEProfiler;
 
 //-----------------------------------------------------------------------------
 // Timer IDs
@@ -100,7 +105,9 @@ enum TimerID {
 	Timer_Residual,
 	Timer_Stiffness,
 	Timer_QNUpdate,
-	Timer_ModelSolve
+	Timer_ModelSolve,
+	Timer_Assemble,
+	Timer_Snapshot
 };
 
 //-----------------------------------------------------------------------------
@@ -109,6 +116,7 @@ enum TimerID {
 // have to be called at every exit point of a function.
 // In addition, it will also check if the timer is already running (e.g. from a function
 // higher in the call stack) in which case it will track the timer. 
+// The model timers are also entered as regions in the model's profiler.
 class FECORE_API TimerTracker
 {
 public:
@@ -117,7 +125,8 @@ public:
 	~TimerTracker();
 
 private:
-	Timer*	m_timer;
+	Timer*		m_timer;
+	FEProfiler*	m_prof;
 };
 
 #define TRACK_TIME(timerId) TimerTracker _trackTimer(GetFEModel(), timerId);
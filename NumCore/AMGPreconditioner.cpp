@@ -0,0 +1,851 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#include "stdafx.h"
+#include "AMGPreconditioner.h"
+#include <FECore/CompactSymmMatrix.h>
+#include <FECore/CompactUnSymmMatrix.h>
+#include <FECore/FEModel.h>
+#include <FECore/FEMesh.h>
+#include <FECore/log.h>
+#include <math.h>
+using namespace std;
+
+typedef AMGPreconditioner::LevelMatrix	LevelMatrix;
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(AMGPreconditioner, Preconditioner)
+	ADD_PARAMETER(m_maxLevels  , "max_levels");
+	ADD_PARAMETER(m_coarseSize , "coarse_size");
+	ADD_PARAMETER(m_theta      , "strength_threshold");
+	ADD_PARAMETER(m_omega      , "prolongator_damping");
+	ADD_PARAMETER(m_degree     , "smoother_degree");
+	ADD_PARAMETER(m_reuse      , "reuse_aggregates");
+	ADD_PARAMETER(m_print_level, "print_level");
+END_FECORE_CLASS();
+
+//=============================================================================
+// sparse matrix helper functions
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+void LevelMatrix::mult(const double* x, double* y) const
+{
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < rows; ++i)
+	{
+		double yi = 0.0;
+		for (int k = ptr[i]; k < ptr[i + 1]; ++k) yi += val[k] * x[ind[k]];
+		y[i] = yi;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// copy any of the compact matrix formats into a (full) CSR matrix
+static bool ConvertMatrix(CompactMatrix* K, LevelMatrix& A)
+{
+	const int N = K->Rows();
+	const int M = K->Columns();
+	const int off = K->Offset();
+	const int* pp = K->Pointers();
+	const int* pi = K->Indices();
+	const double* pv = K->Values();
+
+	A.rows = N;
+	A.cols = M;
+
+	// row-based unsymmetric: just copy
+	if (K->isRowBased() && !K->isSymmetric())
+	{
+		int nnz = pp[N] - pp[0];
+		A.ptr.resize(N + 1);
+		A.ind.resize(nnz);
+		A.val.resize(nnz);
+		for (int i = 0; i <= N; ++i) A.ptr[i] = pp[i] - off;
+		for (int k = 0; k < nnz; ++k) { A.ind[k] = pi[k] - off; A.val[k] = pv[k]; }
+		return true;
+	}
+
+	// column-based (possibly only lower triangular): transpose into rows
+	if (K->isRowBased()) return false;
+	bool bsymm = K->isSymmetric();
+
+	A.ptr.assign(N + 1, 0);
+	for (int j = 0; j < M; ++j)
+	{
+		for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+		{
+			int i = pi[k] - off;
+			A.ptr[i + 1]++;
+			if (bsymm && (i != j)) A.ptr[j + 1]++;
+		}
+	}
+	for (int i = 0; i < N; ++i) A.ptr[i + 1] += A.ptr[i];
+
+	int nnz = A.ptr[N];
+	A.ind.resize(nnz);
+	A.val.resize(nnz);
+	vector<int> pos(A.ptr.begin(), A.ptr.end() - 1);
+	for (int j = 0; j < M; ++j)
+	{
+		for (int k = pp[j] - off; k < pp[j + 1] - off; ++k)
+		{
+			int i = pi[k] - off;
+			int n = pos[i]++;
+			A.ind[n] = j; A.val[n] = pv[k];
+			if (bsymm && (i != j))
+			{
+				n = pos[j]++;
+				A.ind[n] = i; A.val[n] = pv[k];
+			}
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// T = A^T
+static void Transpose(const LevelMatrix& A, LevelMatrix& T)
+{
+	T.rows = A.cols;
+	T.cols = A.rows;
+	T.ptr.assign(T.rows + 1, 0);
+	for (size_t k = 0; k < A.ind.size(); ++k) T.ptr[A.ind[k] + 1]++;
+	for (int i = 0; i < T.rows; ++i) T.ptr[i + 1] += T.ptr[i];
+
+	T.ind.resize(A.ind.size());
+	T.val.resize(A.val.size());
+	vector<int> pos(T.ptr.begin(), T.ptr.end() - 1);
+	for (int i = 0; i < A.rows; ++i)
+	{
+		for (int k = A.ptr[i]; k < A.ptr[i + 1]; ++k)
+		{
+			int n = pos[A.ind[k]]++;
+			T.ind[n] = i;
+			T.val[n] = A.val[k];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// C = A*B. The rows of C are computed in parallel, first counting the nonzeroes
+// and then filling in the values.
+static void Multiply(const LevelMatrix& A, const LevelMatrix& B, LevelMatrix& C)
+{
+	assert(A.cols == B.rows);
+	const int N = A.rows;
+	C.rows = N;
+	C.cols = B.cols;
+	C.ptr.assign(N + 1, 0);
+
+	#pragma omp parallel
+	{
+		vector<int> mark(B.cols, -1);
+		#pragma omp for schedule(dynamic, 256)
+		for (int i = 0; i < N; ++i)
+		{
+			int n = 0;
+			for (int k = A.ptr[i]; k < A.ptr[i + 1]; ++k)
+			{
+				int a = A.ind[k];
+				for (int l = B.ptr[a]; l < B.ptr[a + 1]; ++l)
+				{
+					int j = B.ind[l];
+					if (mark[j] != i) { mark[j] = i; n++; }
+				}
+			}
+			C.ptr[i + 1] = n;
+		}
+	}
+	for (int i = 0; i < N; ++i) C.ptr[i + 1] += C.ptr[i];
+
+	C.ind.resize(C.ptr[N]);
+	C.val.resize(C.ptr[N]);
+
+	#pragma omp parallel
+	{
+		vector<int> mark(B.cols, -1);
+		vector<int> pos(B.cols);
+		#pragma omp for schedule(dynamic, 256)
+		for (int i = 0; i < N; ++i)
+		{
+			int n = C.ptr[i];
+			for (int k = A.ptr[i]; k < A.ptr[i + 1]; ++k)
+			{
+				int a = A.ind[k];
+				double va = A.val[k];
+				for (int l = B.ptr[a]; l < B.ptr[a + 1]; ++l)
+				{
+					int j = B.ind[l];
+					if (mark[j] != i)
+					{
+						mark[j] = i;
+						pos[j] = n;
+						C.ind[n] = j;
+						C.val[n] = va * B.val[l];
+						n++;
+					}
+					else C.val[pos[j]] += va * B.val[l];
+				}
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// C = A + s*D*B, where D is a diagonal matrix
+static void AddScaled(const LevelMatrix& A, double s, const vector<double>& D, const LevelMatrix& B, LevelMatrix& C)
+{
+	assert((A.rows == B.rows) && (A.cols == B.cols));
+	const int N = A.rows;
+	C.rows = N;
+	C.cols = A.cols;
+	C.ptr.assign(N + 1, 0);
+
+	#pragma omp parallel
+	{
+		vector<int> mark(A.cols, -1);
+		#pragma omp for schedule(static)
+		for (int i = 0; i < N; ++i)
+		{
+			int n = 0;
+			for (int k = A.ptr[i]; k < A.ptr[i + 1]; ++k) if (mark[A.ind[k]] != i) { mark[A.ind[k]] = i; n++; }
+			for (int k = B.ptr[i]; k < B.ptr[i + 1]; ++k) if (mark[B.ind[k]] != i) { mark[B.ind[k]] = i; n++; }
+			C.ptr[i + 1] = n;
+		}
+	}
+	for (int i = 0; i < N; ++i) C.ptr[i + 1] += C.ptr[i];
+
+	C.ind.resize(C.ptr[N]);
+	C.val.resize(C.ptr[N]);
+
+	#pragma omp parallel
+	{
+		vector<int> mark(A.cols, -1);
+		vector<int> pos(A.cols);
+		#pragma omp for schedule(static)
+		for (int i = 0; i < N; ++i)
+		{
+			int n = C.ptr[i];
+			for (int k = A.ptr[i]; k < A.ptr[i + 1]; ++k)
+			{
+				int j = A.ind[k];
+				if (mark[j] != i) { mark[j] = i; pos[j] = n; C.ind[n] = j; C.val[n] = A.val[k]; n++; }
+				else C.val[pos[j]] += A.val[k];
+			}
+			double si = s * D[i];
+			for (int k = B.ptr[i]; k < B.ptr[i + 1]; ++k)
+			{
+				int j = B.ind[k];
+				if (mark[j] != i) { mark[j] = i; pos[j] = n; C.ind[n] = j; C.val[n] = si * B.val[k]; n++; }
+				else C.val[pos[j]] += si * B.val[k];
+			}
+		}
+	}
+}
+
+//=============================================================================
+// AMGPreconditioner
+//=============================================================================
+
+AMGPreconditioner::AMGPreconditioner(FEModel* fem) : Preconditioner(fem)
+{
+	m_maxLevels = 10;
+	m_coarseSize = 500;
+	m_theta = 0.08;
+	m_omega = 4.0 / 3.0;
+	m_degree = 2;
+	m_reuse = true;
+	m_print_level = 0;
+
+	m_K = nullptr;
+	m_nnz = 0;
+	m_k = 1;
+}
+
+//-----------------------------------------------------------------------------
+SparseMatrix* AMGPreconditioner::CreateSparseMatrix(Matrix_Type ntype)
+{
+	if (ntype == REAL_SYMMETRIC) m_K = new CompactSymmMatrix(0);
+	else m_K = new CRSSparseMatrix(0);
+	return m_K;
+}
+
+//-----------------------------------------------------------------------------
+void AMGPreconditioner::Destroy()
+{
+	m_level.clear();
+	m_LU.clear();
+	m_piv.clear();
+	m_nnz = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Group the equations in nodal blocks and setup the near-nullspace. For 
+// structural problems, the rigid body modes are calculated from the current
+// nodal coordinates.
+void AMGPreconditioner::BuildNodalBlocks(Level& L)
+{
+	const int neq = L.A.rows;
+	vector<int> dofBlock(neq, -1);
+
+	L.blockPtr.clear();
+	L.blockDof.clear();
+	L.blockPtr.push_back(0);
+
+	// first, see if we have displacement degrees of freedom
+	m_k = 1;
+	vector<double> nodeR;	// position relative to centroid for each dof in a nodal block
+	vector<int> nodeDir;	// coordinate direction for each dof in a nodal block
+	FEModel* fem = GetFEModel();
+	if (fem)
+	{
+		int dof[3] = { fem->GetDOFIndex("x"), fem->GetDOFIndex("y"), fem->GetDOFIndex("z") };
+		if ((dof[0] >= 0) && (dof[1] >= 0) && (dof[2] >= 0))
+		{
+			FEMesh& mesh = fem->GetMesh();
+			const int NN = mesh.Nodes();
+
+			// the rotations are taken about the centroid, which keeps the modes well scaled
+			vec3d c(0, 0, 0);
+			for (int i = 0; i < NN; ++i) c += mesh.Node(i).m_rt;
+			if (NN > 0) c /= (double)NN;
+
+			for (int i = 0; i < NN; ++i)
+			{
+				FENode& node = mesh.Node(i);
+				if (node.dofs() <= dof[2]) continue;
+				vec3d r = node.m_rt - c;
+				int n0 = (int)L.blockDof.size();
+				for (int j = 0; j < 3; ++j)
+				{
+					int eq = node.m_ID[dof[j]];
+					if ((eq >= 0) && (eq < neq) && (dofBlock[eq] == -1))
+					{
+						dofBlock[eq] = (int)L.blockPtr.size() - 1;
+						L.blockDof.push_back(eq);
+						nodeDir.push_back(j);
+						nodeR.push_back(r.x); nodeR.push_back(r.y); nodeR.push_back(r.z);
+					}
+				}
+				if ((int)L.blockDof.size() > n0) L.blockPtr.push_back((int)L.blockDof.size());
+			}
+
+			if (L.blockDof.empty() == false) m_k = 6;
+		}
+	}
+	const int nodalDofs = (int)L.blockDof.size();
+
+	// all other equations form their own block
+	for (int i = 0; i < neq; ++i)
+	{
+		if (dofBlock[i] == -1)
+		{
+			dofBlock[i] = (int)L.blockPtr.size() - 1;
+			L.blockDof.push_back(i);
+			L.blockPtr.push_back((int)L.blockDof.size());
+		}
+	}
+
+	// setup the near-nullspace
+	const int k = m_k;
+	L.B.assign((size_t)neq * k, 0.0);
+	for (int n = 0; n < (int)L.blockDof.size(); ++n)
+	{
+		double* b = &L.B[(size_t)L.blockDof[n] * k];
+		if (n < nodalDofs)
+		{
+			const double* r = &nodeR[3 * n];
+			switch (nodeDir[n])
+			{
+			case 0: b[0] = 1.0; b[4] =  r[2]; b[5] = -r[1]; break;
+			case 1: b[1] = 1.0; b[3] = -r[2]; b[5] =  r[0]; break;
+			case 2: b[2] = 1.0; b[3] =  r[1]; b[4] = -r[0]; break;
+			}
+		}
+		else b[0] = 1.0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Aggregate the blocks of the fine level and build the tentative prolongator.
+// This also defines the blocks and near-nullspace of the coarse level.
+bool AMGPreconditioner::Coarsen(Level& fine, Level& coarse, double theta)
+{
+	const LevelMatrix& A = fine.A;
+	const int NB = (int)fine.blockPtr.size() - 1;
+	const int k = m_k;
+
+	vector<int> dofBlock(A.rows);
+	for (int i = 0; i < NB; ++i)
+		for (int n = fine.blockPtr[i]; n < fine.blockPtr[i + 1]; ++n) dofBlock[fine.blockDof[n]] = i;
+
+	// Frobenius norms (squared) of the diagonal blocks
+	vector<double> dnorm(NB, 0.0);
+	#pragma omp parallel for schedule(static)
+	for (int I = 0; I < NB; ++I)
+	{
+		double s = 0.0;
+		for (int n = fine.blockPtr[I]; n < fine.blockPtr[I + 1]; ++n)
+		{
+			int i = fine.blockDof[n];
+			for (int l = A.ptr[i]; l < A.ptr[i + 1]; ++l)
+				if (dofBlock[A.ind[l]] == I) s += A.val[l] * A.val[l];
+		}
+		dnorm[I] = s;
+	}
+
+	// find the strong connections between blocks
+	vector< vector<int> > strong(NB);
+	const double theta2 = theta * theta;
+	#pragma omp parallel
+	{
+		vector<double> acc(NB, 0.0);
+		vector<int> mark(NB, -1);
+		vector<int> list;
+		#pragma omp for schedule(dynamic, 256)
+		for (int I = 0; I < NB; ++I)
+		{
+			list.clear();
+			for (int n = fine.blockPtr[I]; n < fine.blockPtr[I + 1]; ++n)
+			{
+				int i = fine.blockDof[n];
+				for (int l = A.ptr[i]; l < A.ptr[i + 1]; ++l)
+				{
+					int J = dofBlock[A.ind[l]];
+					if (J == I) continue;
+					if (mark[J] != I) { mark[J] = I; acc[J] = 0.0; list.push_back(J); }
+					acc[J] += A.val[l] * A.val[l];
+				}
+			}
+
+			for (size_t m = 0; m < list.size(); ++m)
+			{
+				int J = list[m];
+				if (acc[J] > theta2 * sqrt(dnorm[I] * dnorm[J])) strong[I].push_back(J);
+			}
+		}
+	}
+
+	// phase 1: blocks whose strong neighbors are all free form a new aggregate
+	vector<int> agg(NB, -1);
+	int na = 0;
+	for (int I = 0; I < NB; ++I)
+	{
+		if (agg[I] != -1) continue;
+		bool bfree = true;
+		for (int J : strong[I]) if (agg[J] != -1) { bfree = false; break; }
+		if (bfree)
+		{
+			agg[I] = na;
+			for (int J : strong[I]) agg[J] = na;
+			na++;
+		}
+	}
+
+	// phase 2: add the remaining blocks to a neighboring aggregate
+	vector<int> agg1(agg);
+	for (int I = 0; I < NB; ++I)
+	{
+		if (agg1[I] != -1) continue;
+		for (int J : strong[I]) if (agg1[J] != -1) { agg[I] = agg1[J]; break; }
+	}
+
+	// phase 3: whatever is left forms new aggregates
+	for (int I = 0; I < NB; ++I)
+	{
+		if (agg[I] != -1) continue;
+		agg[I] = na;
+		for (int J : strong[I]) if (agg[J] == -1) agg[J] = na;
+		na++;
+	}
+
+	// see if we are making any progress
+	if (na == 0) return false;
+
+	// collect the dofs of each aggregate
+	vector<int> aggPtr(na + 1, 0);
+	for (int I = 0; I < NB; ++I) aggPtr[agg[I] + 1] += fine.blockPtr[I + 1] - fine.blockPtr[I];
+	for (int a = 0; a < na; ++a) aggPtr[a + 1] += aggPtr[a];
+	vector<int> aggDof(aggPtr[na]);
+	vector<int> pos(aggPtr.begin(), aggPtr.end() - 1);
+	for (int I = 0; I < NB; ++I)
+		for (int n = fine.blockPtr[I]; n < fine.blockPtr[I + 1]; ++n) aggDof[pos[agg[I]]++] = fine.blockDof[n];
+
+	// Orthonormalize the near-nullspace on each aggregate (modified Gram-Schmidt).
+	// Columns that are (nearly) linearly dependent are dropped, so the number of
+	// coarse dofs per aggregate (nc) can be less than k.
+	vector<int> nc(na, 0);
+	vector<double> Q((size_t)aggPtr[na] * k, 0.0);	// same layout as aggDof
+	vector<double> Rc((size_t)na * k * k, 0.0);
+	#pragma omp parallel for schedule(dynamic, 64)
+	for (int a = 0; a < na; ++a)
+	{
+		const int m = aggPtr[a + 1] - aggPtr[a];
+		double* q = &Q[(size_t)aggPtr[a] * k];	// column c of q is q[i*k + c]
+		double* R = &Rc[(size_t)a * k * k];		// R[c*k + j]
+		int r = 0;
+		for (int j = 0; j < k; ++j)
+		{
+			// copy column j of the nullspace into column r of q
+			double norm0 = 0.0;
+			for (int i = 0; i < m; ++i)
+			{
+				double v = fine.B[(size_t)aggDof[aggPtr[a] + i] * k + j];
+				q[i*k + r] = v;
+				norm0 += v*v;
+			}
+			norm0 = sqrt(norm0);
+			if (norm0 == 0.0) continue;
+
+			// orthogonalize (twice, for stability)
+			for (int pass = 0; pass < 2; ++pass)
+			{
+				for (int c = 0; c < r; ++c)
+				{
+					double s = 0.0;
+					for (int i = 0; i < m; ++i) s += q[i*k + c] * q[i*k + r];
+					for (int i = 0; i < m; ++i) q[i*k + r] -= s*q[i*k + c];
+					R[c*k + j] += s;
+				}
+			}
+
+			double norm = 0.0;
+			for (int i = 0; i < m; ++i) norm += q[i*k + r] * q[i*k + r];
+			norm = sqrt(norm);
+			if ((norm > 1e-10*norm0) && (r < m))
+			{
+				for (int i = 0; i < m; ++i) q[i*k + r] /= norm;
+				R[r*k + j] = norm;
+				r++;
+			}
+		}
+		nc[a] = r;
+	}
+
+	// coarse dof numbering
+	vector<int> coff(na + 1, 0);
+	for (int a = 0; a < na; ++a) coff[a + 1] = coff[a] + nc[a];
+	const int NC = coff[na];
+	if ((NC == 0) || (NC >= A.rows)) return false;
+
+	// tentative prolongator
+	LevelMatrix& P = fine.Ptent;
+	P.rows = A.rows;
+	P.cols = NC;
+	P.ptr.assign(A.rows + 1, 0);
+	for (int a = 0; a < na; ++a)
+		for (int n = aggPtr[a]; n < aggPtr[a + 1]; ++n) P.ptr[aggDof[n] + 1] = nc[a];
+	for (int i = 0; i < A.rows; ++i) P.ptr[i + 1] += P.ptr[i];
+	P.ind.resize(P.ptr[A.rows]);
+	P.val.resize(P.ptr[A.rows]);
+	for (int a = 0; a < na; ++a)
+	{
+		for (int n = aggPtr[a]; n < aggPtr[a + 1]; ++n)
+		{
+			int i = aggDof[n];
+			for (int c = 0; c < nc[a]; ++c)
+			{
+				P.ind[P.ptr[i] + c] = coff[a] + c;
+				P.val[P.ptr[i] + c] = Q[(size_t)n * k + c];
+			}
+		}
+	}
+
+	// coarse blocks and near-nullspace
+	coarse.blockPtr.resize(na + 1);
+	coarse.blockDof.resize(NC);
+	for (int a = 0; a <= na; ++a) coarse.blockPtr[a] = coff[a];
+	for (int i = 0; i < NC; ++i) coarse.blockDof[i] = i;
+	coarse.B.assign((size_t)NC * k, 0.0);
+	for (int a = 0; a < na; ++a)
+		for (int c = 0; c < nc[a]; ++c)
+			for (int j = 0; j < k; ++j) coarse.B[(size_t)(coff[a] + c) * k + j] = Rc[(size_t)a*k*k + c*k + j];
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Smooth the tentative prolongator and form the coarse operator
+void AMGPreconditioner::BuildOperators(Level& fine, Level& coarse)
+{
+	// P = (I - w/lmax D^-1 A) Ptent
+	LevelMatrix AP;
+	Multiply(fine.A, fine.Ptent, AP);
+	AddScaled(fine.Ptent, -m_omega / fine.lmax, fine.dinv, AP, fine.P);
+	Transpose(fine.P, fine.R);
+
+	// Ac = R A P
+	Multiply(fine.A, fine.P, AP);
+	Multiply(fine.R, AP, coarse.A);
+}
+
+//-----------------------------------------------------------------------------
+// calculate the inverse diagonal and bound the spectral radius of D^-1 A
+void AMGPreconditioner::SetupSmoother(Level& L)
+{
+	const LevelMatrix& A = L.A;
+	const int N = A.rows;
+	L.dinv.assign(N, 0.0);
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = A.ptr[i]; k < A.ptr[i + 1]; ++k)
+			if (A.ind[k] == i) { if (A.val[k] != 0.0) L.dinv[i] = 1.0 / A.val[k]; break; }
+	}
+
+	L.x.assign(N, 0.0);
+	L.b.assign(N, 0.0);
+	L.r.assign(N, 0.0);
+	L.d.assign(N, 0.0);
+
+	// Gershgorin bound of D^-1 A. This is a safe upper bound, which matters since
+	// the Chebyshev polynomial amplifies any modes above the estimate.
+	double lmax = 0.0;
+	for (int i = 0; i < N; ++i)
+	{
+		double s = 0.0;
+		for (int k = A.ptr[i]; k < A.ptr[i + 1]; ++k) s += fabs(A.val[k]);
+		s *= fabs(L.dinv[i]);
+		if (s > lmax) lmax = s;
+	}
+	L.lmax = (lmax > 0.0 ? lmax : 1.0);
+}
+
+//-----------------------------------------------------------------------------
+// dense LU factorization (with partial pivoting) of the coarsest operator
+bool AMGPreconditioner::FactorCoarse(Level& L)
+{
+	const int N = L.A.rows;
+	m_LU.assign((size_t)N * N, 0.0);
+	m_piv.resize(N);
+	double amax = 0.0;
+	for (int i = 0; i < N; ++i)
+		for (int k = L.A.ptr[i]; k < L.A.ptr[i + 1]; ++k)
+		{
+			m_LU[(size_t)i*N + L.A.ind[k]] += L.A.val[k];
+			amax = max(amax, fabs(L.A.val[k]));
+		}
+
+	// Tiny pivots are replaced, since the coarse operator can be (nearly)
+	// singular when part of the model is not constrained.
+	const double eps = 1e-14 * (amax > 0.0 ? amax : 1.0);
+	double* a = &m_LU[0];
+	for (int k = 0; k < N; ++k)
+	{
+		int p = k;
+		for (int i = k + 1; i < N; ++i) if (fabs(a[(size_t)i*N + k]) > fabs(a[(size_t)p*N + k])) p = i;
+		m_piv[k] = p;
+		if (p != k) for (int j = 0; j < N; ++j) swap(a[(size_t)k*N + j], a[(size_t)p*N + j]);
+
+		double akk = a[(size_t)k*N + k];
+		if (fabs(akk) < eps) akk = a[(size_t)k*N + k] = (akk < 0 ? -eps : eps);
+
+		#pragma omp parallel for schedule(static) if (N - k > 256)
+		for (int i = k + 1; i < N; ++i)
+		{
+			double lik = a[(size_t)i*N + k] / akk;
+			a[(size_t)i*N + k] = lik;
+			if (lik != 0.0)
+				for (int j = k + 1; j < N; ++j) a[(size_t)i*N + j] -= lik * a[(size_t)k*N + j];
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool AMGPreconditioner::Factor()
+{
+	SparseMatrix* K = GetSparseMatrix();
+	if (K == nullptr) K = m_K;
+	CompactMatrix* C = dynamic_cast<CompactMatrix*>(K);
+	if (C == nullptr) return false;
+
+	// see if we can reuse the aggregates
+	bool reuse = m_reuse && (m_level.empty() == false) && (m_level[0].A.rows == C->Rows()) && (m_nnz == C->NonZeroes());
+	m_nnz = C->NonZeroes();
+
+	if (reuse == false) m_level.assign(1, Level());
+	if (ConvertMatrix(C, m_level[0].A) == false) return false;
+
+	if (reuse == false)
+	{
+		BuildNodalBlocks(m_level[0]);
+
+		double theta = m_theta;
+		while (((int)m_level.size() < m_maxLevels) && (m_level.back().A.rows > m_coarseSize))
+		{
+			Level& fine = m_level.back();
+			SetupSmoother(fine);
+
+			Level coarse;
+			if (Coarsen(fine, coarse, theta) == false) break;
+
+			// stop if the coarsening stalls
+			if (coarse.blockDof.size() > 0.9 * fine.A.rows) break;
+
+			BuildOperators(fine, coarse);
+			m_level.push_back(coarse);
+			theta *= 0.5;
+		}
+	}
+	else
+	{
+		for (size_t l = 0; l + 1 < m_level.size(); ++l)
+		{
+			SetupSmoother(m_level[l]);
+			BuildOperators(m_level[l], m_level[l + 1]);
+		}
+	}
+
+	// setup the coarsest level
+	Level& Lc = m_level.back();
+	SetupSmoother(Lc);
+	if (Lc.A.rows <= 4 * m_coarseSize) FactorCoarse(Lc);
+	else { m_LU.clear(); m_piv.clear(); }
+
+	if (m_print_level > 0)
+	{
+		size_t nnz0 = m_level[0].A.nonZeroes(), nnz = 0;
+		feLog("AMG hierarchy (%s):\n", (reuse ? "reused" : "new"));
+		for (size_t l = 0; l < m_level.size(); ++l)
+		{
+			feLog("  level %d: rows = %d, nonzeroes = %d\n", (int)l, m_level[l].A.rows, (int)m_level[l].A.nonZeroes());
+			nnz += m_level[l].A.nonZeroes();
+		}
+		feLog("  operator complexity: %lg\n", (nnz0 > 0 ? (double)nnz / (double)nnz0 : 0.0));
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Chebyshev smoother for D^-1 A on the interval [lmax/30, lmax]
+void AMGPreconditioner::Smooth(Level& L, const double* b, double* x)
+{
+	const int N = L.A.rows;
+	double* r = &L.r[0];
+	double* d = &L.d[0];
+	double* t = &L.b[0];
+
+	const double lmax = L.lmax;
+	const double lmin = lmax / 30.0;
+	const double theta = 0.5*(lmax + lmin);
+	const double delta = 0.5*(lmax - lmin);
+	const double sigma = theta / delta;
+	double rho = 1.0 / sigma;
+
+	// r = b - A x
+	L.A.mult(x, r);
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < N; ++i) { r[i] = b[i] - r[i]; d[i] = L.dinv[i] * r[i] / theta; }
+
+	for (int k = 0; k < m_degree; ++k)
+	{
+		#pragma omp parallel for schedule(static)
+		for (int i = 0; i < N; ++i) x[i] += d[i];
+		if (k == m_degree - 1) break;
+
+		L.A.mult(d, t);
+		double rho_new = 1.0 / (2.0*sigma - rho);
+		double c1 = rho_new * rho;
+		double c2 = 2.0*rho_new / delta;
+		#pragma omp parallel for schedule(static)
+		for (int i = 0; i < N; ++i)
+		{
+			r[i] -= t[i];
+			d[i] = c1 * d[i] + c2 * L.dinv[i] * r[i];
+		}
+		rho = rho_new;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void AMGPreconditioner::Cycle(int l, const double* b, double* x)
+{
+	Level& L = m_level[l];
+	const int N = L.A.rows;
+
+	// coarsest level
+	if (l == (int)m_level.size() - 1)
+	{
+		if (m_LU.empty())
+		{
+			// no direct solver, so just smooth a couple of times
+			for (int i = 0; i < N; ++i) x[i] = 0.0;
+			for (int i = 0; i < 10; ++i) Smooth(L, b, x);
+			return;
+		}
+
+		const double* a = &m_LU[0];
+		for (int i = 0; i < N; ++i) x[i] = b[i];
+		for (int k = 0; k < N; ++k) if (m_piv[k] != k) swap(x[k], x[m_piv[k]]);
+		for (int i = 0; i < N; ++i)
+		{
+			double s = x[i];
+			for (int j = 0; j < i; ++j) s -= a[(size_t)i*N + j] * x[j];
+			x[i] = s;
+		}
+		for (int i = N - 1; i >= 0; --i)
+		{
+			double s = x[i];
+			for (int j = i + 1; j < N; ++j) s -= a[(size_t)i*N + j] * x[j];
+			x[i] = s / a[(size_t)i*N + i];
+		}
+		return;
+	}
+
+	Level& C = m_level[l + 1];
+
+	// pre-smoothing
+	for (int i = 0; i < N; ++i) x[i] = 0.0;
+	Smooth(L, b, x);
+
+	// restrict the residual
+	double* r = &L.r[0];
+	L.A.mult(x, r);
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < N; ++i) r[i] = b[i] - r[i];
+	vector<double> bc(C.A.rows), xc(C.A.rows);
+	L.R.mult(r, &bc[0]);
+
+	// coarse grid correction
+	Cycle(l + 1, &bc[0], &xc[0]);
+	L.P.mult(&xc[0], r);
+	#pragma omp parallel for schedule(static)
+	for (int i = 0; i < N; ++i) x[i] += r[i];
+
+	// post-smoothing
+	Smooth(L, b, x);
+}
+
+//-----------------------------------------------------------------------------
+bool AMGPreconditioner::BackSolve(double* x, double* y)
+{
+	if (m_level.empty()) return false;
+	Cycle(0, y, x);
+	return true;
+}
@@ -0,0 +1,122 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#pragma once
+#include <FECore/Preconditioner.h>
+#include <vector>
+
+class CompactMatrix;
+
+//-----------------------------------------------------------------------------
+// Smoothed-aggregation algebraic multigrid preconditioner. This does not require
+// any external libraries. For structural problems, the equations are grouped
+// in nodal blocks and the rigid body modes, computed from the nodal coordinates,
+// are used as the near-nullspace. For all other problems, each equation forms 
+// its own block with a constant near-nullspace. One V-cycle with Chebyshev 
+// smoothing is applied per call to BackSolve.
+//
+// The aggregates and tentative prolongators only depend on the sparsity pattern
+// and are reused when the matrix is refactored with the same pattern, so that a
+// stiffness reformation only needs to recompute the Galerkin products.
+class AMGPreconditioner : public Preconditioner
+{
+public:
+	// simple compressed row storage used on all levels
+	struct LevelMatrix
+	{
+		int	rows, cols;
+		std::vector<int>	ptr;
+		std::vector<int>	ind;
+		std::vector<double>	val;
+
+		LevelMatrix() : rows(0), cols(0) {}
+		size_t nonZeroes() const { return ind.size(); }
+		void mult(const double* x, double* y) const;
+	};
+
+	// a level of the multigrid hierarchy
+	struct Level
+	{
+		LevelMatrix	A;			// the operator on this level
+		LevelMatrix	Ptent;		// tentative prolongator (to next level)
+		LevelMatrix	P;			// smoothed prolongator
+		LevelMatrix	R;			// restriction (P transpose)
+
+		std::vector<int>	blockPtr;	// nodal blocks: dofs of block i are blockDof[blockPtr[i]...blockPtr[i+1]-1]
+		std::vector<int>	blockDof;
+		std::vector<double>	B;			// near-nullspace (rows x k, row-major)
+
+		std::vector<double>	dinv;		// inverse diagonal
+		double				lmax;		// estimate of largest eigenvalue of D^-1*A
+
+		std::vector<double>	x, b, r, d;	// work vectors
+	};
+
+public:
+	AMGPreconditioner(FEModel* fem);
+
+	// create a sparse matrix that can be used with this preconditioner
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	// set up the multigrid hierarchy
+	bool Factor() override;
+
+	// apply one V-cycle to vector: x = M^-1 y
+	bool BackSolve(double* x, double* y) override;
+
+	// free all memory
+	void Destroy() override;
+
+private:
+	void BuildNodalBlocks(Level& L);
+	bool Coarsen(Level& fine, Level& coarse, double theta);
+	void BuildOperators(Level& fine, Level& coarse);
+	void SetupSmoother(Level& L);
+	bool FactorCoarse(Level& L);
+
+	void Smooth(Level& L, const double* b, double* x);
+	void Cycle(int l, const double* b, double* x);
+
+public:
+	int		m_maxLevels;	// max nr of levels
+	int		m_coarseSize;	// levels of this size or smaller are solved directly
+	double	m_theta;		// strength of connection threshold
+	double	m_omega;		// prolongator damping (scaled by 1/lmax)
+	int		m_degree;		// degree of Chebyshev smoother
+	bool	m_reuse;		// reuse aggregates when the pattern does not change
+	int		m_print_level;
+
+private:
+	SparseMatrix*		m_K;		// the matrix created by this preconditioner
+	std::vector<Level>	m_level;	// the multigrid hierarchy
+	int					m_nnz;		// nr of nonzeroes of the fine matrix at last setup
+	int					m_k;		// near-nullspace dimension
+
+	std::vector<double>	m_LU;		// dense factorization of coarsest operator
+	std::vector<int>	m_piv;
+
+	DECLARE_FECORE_CLASS();
+};
@@ -0,0 +1,862 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "DomainDecompositionSolver.h"
+#include "SupernodalSolver.h"
+#include "RCICGSolver.h"
+#include "FGMRESSolver.h"
+#include <FECore/CompactSymmMatrix.h>
+#include <FECore/CompactUnSymmMatrix.h>
+#include <FECore/Preconditioner.h>
+#include <FECore/FEModel.h>
+#include <FECore/FEMesh.h>
+#include <FECore/FENodeNodeList.h>
+#include <FECore/log.h>
+#include <FECore/sys.h>
+#include <algorithm>
+using namespace std;
+
+BEGIN_FECORE_CLASS(DomainDecompositionSolver, LinearSolver)
+	ADD_PARAMETER(m_printLevel, "print_level");
+	ADD_PARAMETER(m_nsub      , "subdomains");
+	ADD_PARAMETER(m_maxiter   , "max_iter");
+	ADD_PARAMETER(m_tol       , "tol");
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+// Sparse block in compressed row format (zero-based) that couples the interior 
+// equations of a subdomain to the interface equations, or vice versa.
+struct CouplingBlock
+{
+	vector<int>		ptr;
+	vector<int>		ind;
+	vector<double>	val;
+
+	int Rows() const { return (ptr.empty() ? 0 : (int)ptr.size() - 1); }
+
+	size_t MemoryUsage() const { return (ptr.capacity() + ind.capacity())*sizeof(int) + val.capacity()*sizeof(double); }
+
+	// y = A*x
+	void mult(const double* x, double* y) const
+	{
+		int n = Rows();
+		for (int i = 0; i < n; ++i)
+		{
+			double s = 0.0;
+			for (int k = ptr[i]; k < ptr[i + 1]; ++k) s += val[k] * x[ind[k]];
+			y[i] = s;
+		}
+	}
+
+	// y = A^T*x, where ncols is the size of y
+	void multT(const double* x, double* y, int ncols) const
+	{
+		for (int j = 0; j < ncols; ++j) y[j] = 0.0;
+		int n = Rows();
+		for (int i = 0; i < n; ++i)
+		{
+			double xi = x[i];
+			for (int k = ptr[i]; k < ptr[i + 1]; ++k) y[ind[k]] += val[k] * xi;
+		}
+	}
+};
+
+//-----------------------------------------------------------------------------
+struct Subdomain
+{
+	vector<int>			eq;		// global equation numbers of the interior equations
+	vector<int>			gamma;	// interface equations (interface numbering) this subdomain couples to
+	CompactMatrix*		A;		// interior block
+	SupernodalSolver*	solver;	// solver for the interior block
+	CouplingBlock		AIB;	// interior-interface block (rows: eq, columns: gamma)
+	CouplingBlock		ABI;	// interface-interior block (rows: gamma, columns: eq), unsymmetric matrices only
+
+	// work vectors
+	vector<double>	bi, wi;		// size of eq
+	vector<double>	xb, zb;		// size of gamma
+
+	Subdomain() : A(nullptr), solver(nullptr) {}
+	~Subdomain() { delete solver; delete A; }
+
+	// wi = A_II^-1 * bi
+	bool SolveInterior()
+	{
+		if (eq.empty()) return true;
+		return solver->BackSolve(&wi[0], &bi[0]);
+	}
+
+	// zb = A_BI * wi
+	void MultBI(bool bsymm)
+	{
+		if (gamma.empty()) return;
+		if (bsymm) AIB.multT(wi.data(), &zb[0], (int)gamma.size());
+		else ABI.mult(wi.data(), &zb[0]);
+	}
+};
+
+//-----------------------------------------------------------------------------
+class DomainDecompositionSolver::Imp
+{
+public:
+	class InterfaceOperator;
+
+public:
+	CompactMatrix*	K = nullptr;	// the global matrix
+	bool			bsymm = true;
+
+	vector<Subdomain*>	sub;
+	vector<int>			ifc;		// global equation numbers of the interface equations
+	CompactMatrix*		ABB = nullptr;	// interface block
+	SupernodalSolver*	ABBsolver = nullptr;
+
+	// For each value of the global matrix, the block it belongs to and its position in 
+	// that block. Blocks [0, ns) are the interior blocks, [ns, 2ns) the A_IB blocks, 
+	// [2ns, 3ns) the A_BI blocks and 3ns is the interface block.
+	vector<int>		blk;
+	vector<int>		pos;
+
+	// interface solver
+	IterativeLinearSolver*	iter = nullptr;
+	SparseMatrix*			S = nullptr;
+	Preconditioner*			PS = nullptr;
+
+public:
+	~Imp() { Clear(); }
+
+	void Clear();
+
+	// loop over all (row, col, src) entries of the global matrix
+	template <class F> void ForEachEntry(F f)
+	{
+		int n = K->Rows();
+		int* pp = K->Pointers();
+		int* pi = K->Indices();
+		int off = K->Offset();
+		for (int a = 0; a < n; ++a)
+		{
+			for (int k = pp[a] - off; k < pp[a + 1] - off; ++k)
+			{
+				int b = pi[k] - off;
+				// symmetric matrices are stored column-wise, unsymmetric row-wise
+				if (bsymm) f(b, a, k); else f(a, b, k);
+			}
+		}
+	}
+
+	void Partition(FEModel* fem, int nparts, vector<int>& eqPart);
+
+	bool Setup(FEModel* fem, int nparts);
+
+	void ScatterValues();
+
+	bool ApplySchur(const double* x, double* r);
+};
+
+//-----------------------------------------------------------------------------
+// The Schur complement S = A_BB - sum A_BI*A_II^-1*A_IB of the interface equations. 
+// Only the matrix-vector product is implemented.
+class DomainDecompositionSolver::Imp::InterfaceOperator : public SparseMatrix
+{
+public:
+	InterfaceOperator(Imp* imp, int n) : m_imp(imp) { m_nrow = m_ncol = n; m_nsize = 0; }
+
+	bool mult_vector(double* x, double* r) override { return m_imp->ApplySchur(x, r); }
+
+private: // we need to override these functions although we don't want to use them
+	void Zero() override { assert(false); }
+	void Create(SparseMatrixProfile& MP) override { assert(false); }
+	void Assemble(const matrix& ke, const std::vector<int>& lm) override { assert(false); }
+	void Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj) override { assert(false); }
+	bool check(int i, int j) override { assert(false); return false; }
+	void set(int i, int j, double v) override { assert(false); }
+	void add(int i, int j, double v) override { assert(false); }
+	double diag(int i) override { assert(false); return 0.0; }
+
+private:
+	Imp*	m_imp;
+};
+
+//-----------------------------------------------------------------------------
+// Preconditioner for the Schur complement, which solves with the interface block.
+class InterfacePreconditioner : public Preconditioner
+{
+public:
+	InterfacePreconditioner(FEModel* fem, LinearSolver* solver) : Preconditioner(fem), m_solver(solver) {}
+
+	bool Factor() override { return m_solver->Factor(); }
+
+	bool BackSolve(double* x, double* y) override { return m_solver->BackSolve(x, y); }
+
+private:
+	LinearSolver*	m_solver;
+};
+
+//-----------------------------------------------------------------------------
+// Split a graph into nparts parts of roughly equal weight by recursive bisection.
+// Each bisection orders the vertices of the subgraph by a BFS from a pseudo-peripheral
+// vertex and splits this ordering at the weighted median. On meshes, this gives 
+// compact parts with relatively short boundaries.
+static void PartitionGraph(const vector<int>& xadj, const vector<int>& adj, const vector<int>& wgt, int nparts, vector<int>& part)
+{
+	int nv = (int)xadj.size() - 1;
+	part.assign(nv, 0);
+	if ((nparts <= 1) || (nv <= 0)) return;
+
+	vector<int> where(nv, -1);	// stamp of the subgraph a vertex belongs to
+	vector<int> level(nv, -1);
+	vector<int> queue; queue.reserve(nv);
+	int stamp = 0;
+
+	// BFS restricted to the current subgraph, which appends to the queue. 
+	// Returns the number of levels.
+	auto bfs = [&](int r, int st) {
+		size_t q0 = queue.size();
+		queue.push_back(r); level[r] = 0;
+		int nlevels = 1;
+		for (size_t q = q0; q < queue.size(); ++q)
+		{
+			int v = queue[q];
+			for (int k = xadj[v]; k < xadj[v + 1]; ++k)
+			{
+				int w = adj[k];
+				if ((where[w] == st) && (level[w] < 0))
+				{
+					level[w] = level[v] + 1;
+					if (level[w] + 1 > nlevels) nlevels = level[w] + 1;
+					queue.push_back(w);
+				}
+			}
+		}
+		return nlevels;
+	};
+
+	struct Part { vector<int> v; int first, nparts; };
+	vector<Part> stack;
+	{
+		Part P; P.first = 0; P.nparts = nparts;
+		P.v.resize(nv);
+		for (int i = 0; i < nv; ++i) P.v[i] = i;
+		stack.push_back(move(P));
+	}
+
+	while (stack.empty() == false)
+	{
+		Part P = move(stack.back()); stack.pop_back();
+		if ((P.nparts == 1) || (P.v.size() <= 1))
+		{
+			for (int v : P.v) part[v] = P.first;
+			continue;
+		}
+
+		// order the vertices by BFS, one connected component after the other
+		int st = stamp++;
+		for (int v : P.v) { where[v] = st; level[v] = -1; }
+		queue.clear();
+		for (int v : P.v)
+		{
+			if (level[v] >= 0) continue;
+
+			// restart from the last vertex until the number of levels no longer increases,
+			// so that we start the BFS from a pseudo-peripheral vertex
+			size_t q0 = queue.size();
+			int nlev = bfs(v, st);
+			for (int iter = 0; iter < 4; ++iter)
+			{
+				int r = queue.back();
+				for (size_t q = q0; q < queue.size(); ++q) level[queue[q]] = -1;
+				queue.resize(q0);
+				int nlev2 = bfs(r, st);
+				if (nlev2 <= nlev) break;
+				nlev = nlev2;
+			}
+		}
+
+		// split at the weighted median
+		int nA = P.nparts / 2;
+		double wtot = 0.0;
+		for (int v : P.v) wtot += wgt[v];
+		double wA = wtot * nA / P.nparts;
+
+		Part A, B;
+		A.first = P.first; A.nparts = nA;
+		B.first = P.first + nA; B.nparts = P.nparts - nA;
+		double w = 0.0;
+		for (int v : queue)
+		{
+			if (w < wA) { A.v.push_back(v); w += wgt[v]; }
+			else B.v.push_back(v);
+		}
+		stack.push_back(move(A));
+		stack.push_back(move(B));
+	}
+}
+
+//-----------------------------------------------------------------------------
+void DomainDecompositionSolver::Imp::Clear()
+{
+	for (Subdomain* s : sub) delete s;
+	sub.clear();
+	ifc.clear();
+	blk.clear();
+	pos.clear();
+	delete iter; iter = nullptr;
+	delete PS; PS = nullptr;
+	delete S; S = nullptr;
+	delete ABBsolver; ABBsolver = nullptr;
+	delete ABB; ABB = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Assign each equation to a subdomain, or to the interface (-1).
+void DomainDecompositionSolver::Imp::Partition(FEModel* fem, int nparts, vector<int>& eqPart)
+{
+	int neq = K->Rows();
+
+	// Set up the graph that is partitioned. If we have a mesh, the vertices are the nodes,
+	// so that all the equations of a node end up in the same subdomain. Otherwise, we 
+	// partition the graph of the matrix. Equations that are not attached to a node 
+	// (e.g. rigid body or Lagrange multiplier equations) are placed on the interface.
+	vector<int> eqVertex(neq, -1);
+	vector<int> xadj, adj, wgt;
+	int nv = 0;
+	if (fem)
+	{
+		FEMesh& mesh = fem->GetMesh();
+		int NN = mesh.Nodes();
+		int nmapped = 0;
+		for (int i = 0; i < NN; ++i)
+		{
+			FENode& node = mesh.Node(i);
+			for (int id : node.m_ID)
+			{
+				if ((id >= 0) && (id < neq)) { eqVertex[id] = i; nmapped++; }
+			}
+		}
+
+		if (nmapped > 0)
+		{
+			FENodeNodeList NNL;
+			NNL.Create(mesh);
+
+			nv = NN;
+			xadj.assign(nv + 1, 0);
+			for (int i = 0; i < nv; ++i) xadj[i + 1] = xadj[i] + NNL.Valence(i);
+			adj.resize(xadj[nv]);
+			for (int i = 0; i < nv; ++i)
+			{
+				int* nl = NNL.NodeList(i);
+				copy(nl, nl + NNL.Valence(i), adj.begin() + xadj[i]);
+			}
+
+			wgt.assign(nv, 0);
+			for (int i = 0; i < neq; ++i) if (eqVertex[i] >= 0) wgt[eqVertex[i]]++;
+		}
+		else eqVertex.assign(neq, -1);
+	}
+
+	if (nv == 0)
+	{
+		nv = neq;
+		for (int i = 0; i < neq; ++i) eqVertex[i] = i;
+
+		xadj.assign(nv + 1, 0);
+		ForEachEntry([&](int i, int j, int k) {
+			if (i != j) { xadj[i + 1]++; xadj[j + 1]++; }
+		});
+		for (int i = 0; i < nv; ++i) xadj[i + 1] += xadj[i];
+		adj.resize(xadj[nv]);
+		vector<int> pos(xadj.begin(), xadj.end() - 1);
+		ForEachEntry([&](int i, int j, int k) {
+			if (i != j) { adj[pos[i]++] = j; adj[pos[j]++] = i; }
+		});
+
+		wgt.assign(nv, 1);
+	}
+
+	vector<int> vpart;
+	PartitionGraph(xadj, adj, wgt, nparts, vpart);
+
+	// The partition of the graph does not need to match the couplings in the matrix
+	// (e.g. contact). So, we build the vertex separator from the matrix: for each 
+	// entry that couples two subdomains, one of its vertices is moved to the interface.
+	vector<char> vifc(nv, 0);
+	ForEachEntry([&](int i, int j, int k) {
+		int vi = eqVertex[i];
+		int vj = eqVertex[j];
+		if ((vi < 0) || (vj < 0) || vifc[vi] || vifc[vj]) return;
+		int pi = vpart[vi];
+		int pj = vpart[vj];
+		if (pi > pj) vifc[vi] = 1;
+		else if (pj > pi) vifc[vj] = 1;
+	});
+
+	eqPart.resize(neq);
+	for (int i = 0; i < neq; ++i)
+	{
+		int v = eqVertex[i];
+		eqPart[i] = ((v < 0) || vifc[v] ? -1 : vpart[v]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Partition the equations and set up the block structures and the solvers.
+bool DomainDecompositionSolver::Imp::Setup(FEModel* fem, int nparts)
+{
+	Clear();
+
+	int neq = K->Rows();
+	vector<int> eqPart;
+	Partition(fem, nparts, eqPart);
+
+	// number the equations locally and drop empty subdomains
+	vector<int> local(neq);
+	vector<int> nlocal(nparts, 0);
+	for (int i = 0; i < neq; ++i)
+	{
+		int p = eqPart[i];
+		if (p >= 0) local[i] = nlocal[p]++;
+		else { local[i] = (int)ifc.size(); ifc.push_back(i); }
+	}
+	vector<int> subId(nparts, -1);
+	for (int p = 0; p < nparts; ++p)
+	{
+		if (nlocal[p] > 0) { subId[p] = (int)sub.size(); sub.push_back(new Subdomain); }
+	}
+	for (int i = 0; i < neq; ++i)
+	{
+		int p = eqPart[i];
+		if (p >= 0) { eqPart[i] = subId[p]; sub[subId[p]]->eq.push_back(i); }
+	}
+	int ns = (int)sub.size();
+	int nb = (int)ifc.size();
+
+	// find the interface equations that each subdomain couples to
+	ForEachEntry([&](int i, int j, int k) {
+		int pi = eqPart[i];
+		int pj = eqPart[j];
+		if ((pi >= 0) && (pj < 0)) sub[pi]->gamma.push_back(local[j]);
+		else if ((pi < 0) && (pj >= 0)) sub[pj]->gamma.push_back(local[i]);
+	});
+	for (Subdomain* s : sub)
+	{
+		vector<int>& g = s->gamma;
+		sort(g.begin(), g.end());
+		g.erase(unique(g.begin(), g.end()), g.end());
+	}
+	auto gammaIndex = [&](int s, int b) {
+		const vector<int>& g = sub[s]->gamma;
+		return (int)(lower_bound(g.begin(), g.end(), b) - g.begin());
+	};
+
+	// collect the entries of all blocks
+	struct Entry { int row, col, src; };
+	vector< vector<Entry> > E(3 * ns + 1);
+	ForEachEntry([&](int i, int j, int k) {
+		int pi = eqPart[i];
+		int pj = eqPart[j];
+		if ((pi >= 0) && (pj >= 0))
+		{
+			assert(pi == pj);
+			E[pi].push_back({ local[i], local[j], k });
+		}
+		else if ((pi < 0) && (pj < 0)) E[3 * ns].push_back({ local[i], local[j], k });
+		else if (pi >= 0) E[ns + pi].push_back({ local[i], gammaIndex(pi, local[j]), k });
+		else if (bsymm)
+		{
+			// only the lower triangle is stored, so this is the transpose of an A_IB entry
+			E[ns + pj].push_back({ local[j], gammaIndex(pj, local[i]), k });
+		}
+		else E[2 * ns + pj].push_back({ gammaIndex(pj, local[i]), local[j], k });
+	});
+
+	blk.assign(K->NonZeroes(), -1);
+	pos.assign(K->NonZeroes(), -1);
+
+	// build a diagonal block in the same format as the global matrix
+	auto buildMatrix = [&](vector<Entry>& e, int n, int b) {
+		if (bsymm) sort(e.begin(), e.end(), [](const Entry& a, const Entry& b) { return (a.col < b.col) || ((a.col == b.col) && (a.row < b.row)); });
+		else sort(e.begin(), e.end(), [](const Entry& a, const Entry& b) { return (a.row < b.row) || ((a.row == b.row) && (a.col < b.col)); });
+
+		int nnz = (int)e.size();
+		double* pv = new double[nnz];
+		int* pi = new int[nnz];
+		int* pp = new int[n + 1];
+		for (int a = 0; a <= n; ++a) pp[a] = 0;
+		for (int k = 0; k < nnz; ++k)
+		{
+			const Entry& ek = e[k];
+			pp[(bsymm ? ek.col : ek.row) + 1]++;
+			pi[k] = (bsymm ? ek.row : ek.col);
+			pv[k] = 0.0;
+			blk[ek.src] = b;
+			pos[ek.src] = k;
+		}
+		for (int a = 0; a < n; ++a) pp[a + 1] += pp[a];
+
+		CompactMatrix* A = nullptr;
+		if (bsymm) A = new CompactSymmMatrix(0); else A = new CRSSparseMatrix(0);
+		A->alloc(n, n, nnz, pv, pi, pp);
+		vector<Entry>().swap(e);
+		return A;
+	};
+
+	// build a coupling block
+	auto buildCoupling = [&](vector<Entry>& e, int nrows, CouplingBlock& C, int b) {
+		sort(e.begin(), e.end(), [](const Entry& a, const Entry& b) { return (a.row < b.row) || ((a.row == b.row) && (a.col < b.col)); });
+		int nnz = (int)e.size();
+		C.ptr.assign(nrows + 1, 0);
+		C.ind.resize(nnz);
+		C.val.assign(nnz, 0.0);
+		for (int k = 0; k < nnz; ++k)
+		{
+			const Entry& ek = e[k];
+			C.ptr[ek.row + 1]++;
+			C.ind[k] = ek.col;
+			blk[ek.src] = b;
+			pos[ek.src] = k;
+		}
+		for (int i = 0; i < nrows; ++i) C.ptr[i + 1] += C.ptr[i];
+		vector<Entry>().swap(e);
+	};
+
+	for (int s = 0; s < ns; ++s)
+	{
+		Subdomain& D = *sub[s];
+		int ni = (int)D.eq.size();
+		int ng = (int)D.gamma.size();
+		D.A = buildMatrix(E[s], ni, s);
+		buildCoupling(E[ns + s], ni, D.AIB, ns + s);
+		if (bsymm == false) buildCoupling(E[2 * ns + s], ng, D.ABI, 2 * ns + s);
+
+		D.bi.resize(ni);
+		D.wi.resize(ni);
+		D.xb.resize(ng);
+		D.zb.resize(ng);
+
+		D.solver = new SupernodalSolver(fem);
+		D.solver->SetSparseMatrix(D.A);
+	}
+
+	// the symbolic factorizations of the subdomains are independent
+	bool bok = true;
+#pragma omp parallel for schedule(dynamic)
+	for (int s = 0; s < ns; ++s)
+	{
+		if (sub[s]->solver->PreProcess() == false)
+		{
+#pragma omp critical
+			bok = false;
+		}
+	}
+	if (bok == false) return false;
+
+	// set up the interface solver
+	if (nb > 0)
+	{
+		ABB = buildMatrix(E[3 * ns], nb, 3 * ns);
+		ABBsolver = new SupernodalSolver(fem);
+		ABBsolver->SetSparseMatrix(ABB);
+		if (ABBsolver->PreProcess() == false) return false;
+
+		S = new InterfaceOperator(this, nb);
+		PS = new InterfacePreconditioner(fem, ABBsolver);
+		if (bsymm) iter = new RCICGSolver(fem);
+		else iter = new FGMRESSolver(fem);
+		iter->SetSparseMatrix(S);
+		iter->SetLeftPreconditioner(PS);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// copy the values of the global matrix to the blocks
+void DomainDecompositionSolver::Imp::ScatterValues()
+{
+	int ns = (int)sub.size();
+	int nnz = K->NonZeroes();
+	const double* v = K->Values();
+	for (int k = 0; k < nnz; ++k)
+	{
+		int b = blk[k];
+		int p = pos[k];
+		if (b < ns) sub[b]->A->Values()[p] = v[k];
+		else if (b < 2 * ns) sub[b - ns]->AIB.val[p] = v[k];
+		else if (b < 3 * ns) sub[b - 2 * ns]->ABI.val[p] = v[k];
+		else ABB->Values()[p] = v[k];
+	}
+}
+
+//-----------------------------------------------------------------------------
+// r = S*x, where S is the Schur complement of the interface equations
+bool DomainDecompositionSolver::Imp::ApplySchur(const double* x, double* r)
+{
+	int ns = (int)sub.size();
+	bool bok = true;
+#pragma omp parallel for schedule(dynamic)
+	for (int s = 0; s < ns; ++s)
+	{
+		Subdomain& D = *sub[s];
+		int ng = (int)D.gamma.size();
+		for (int k = 0; k < ng; ++k) D.xb[k] = x[D.gamma[k]];
+		D.AIB.mult(D.xb.data(), D.bi.data());
+		if (D.SolveInterior() == false)
+		{
+#pragma omp critical
+			bok = false;
+		}
+		D.MultBI(bsymm);
+	}
+	if (bok == false) return false;
+
+	ABB->mult_vector(const_cast<double*>(x), r);
+	for (int s = 0; s < ns; ++s)
+	{
+		const Subdomain& D = *sub[s];
+		int ng = (int)D.gamma.size();
+		for (int k = 0; k < ng; ++k) r[D.gamma[k]] -= D.zb[k];
+	}
+	return true;
+}
+
+//=============================================================================
+DomainDecompositionSolver::DomainDecompositionSolver(FEModel* fem) : LinearSolver(fem), m(new DomainDecompositionSolver::Imp)
+{
+	m_printLevel = 0;
+	m_nsub = 0;
+	m_maxiter = 1000;
+	m_tol = 1e-10;
+}
+
+//-----------------------------------------------------------------------------
+DomainDecompositionSolver::~DomainDecompositionSolver()
+{
+	delete m;
+}
+
+//-----------------------------------------------------------------------------
+void DomainDecompositionSolver::SetPrintLevel(int n)
+{
+	m_printLevel = n;
+}
+
+//-----------------------------------------------------------------------------
+// memory of the subdomain and interface blocks and their factorizations
+size_t DomainDecompositionSolver::MemoryUsage() const
+{
+	size_t mem = (m->ifc.capacity() + m->blk.capacity() + m->pos.capacity())*sizeof(int);
+	for (const Subdomain* s : m->sub)
+	{
+		mem += (s->eq.capacity() + s->gamma.capacity())*sizeof(int);
+		mem += (s->bi.capacity() + s->wi.capacity() + s->xb.capacity() + s->zb.capacity())*sizeof(double);
+		mem += s->AIB.MemoryUsage() + s->ABI.MemoryUsage();
+		if (s->A) mem += s->A->MemoryUsage();
+		if (s->solver) mem += s->solver->MemoryUsage();
+	}
+	if (m->ABB) mem += m->ABB->MemoryUsage();
+	if (m->ABBsolver) mem += m->ABBsolver->MemoryUsage();
+	return mem;
+}
+
+//-----------------------------------------------------------------------------
+SparseMatrix* DomainDecompositionSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	// we use the same formats as the supernodal solver, which factors the subdomains
+	switch (ntype)
+	{
+	case REAL_SYMMETRIC     : m->K = new CompactSymmMatrix(0); m->bsymm = true; break;
+	case REAL_UNSYMMETRIC   : m->K = new CRSSparseMatrix(0); m->bsymm = false; break;
+	case REAL_SYMM_STRUCTURE: m->K = new CRSSparseMatrix(0); m->bsymm = false; break;
+	default:
+		assert(false);
+		m->K = nullptr;
+	}
+	return m->K;
+}
+
+//-----------------------------------------------------------------------------
+bool DomainDecompositionSolver::SetSparseMatrix(SparseMatrix* pA)
+{
+	CompactSymmMatrix* pS = dynamic_cast<CompactSymmMatrix*>(pA);
+	CRSSparseMatrix* pU = dynamic_cast<CRSSparseMatrix*>(pA);
+	if (pS) { m->K = pS; m->bsymm = true; }
+	else if (pU) { m->K = pU; m->bsymm = false; }
+	else return false;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool DomainDecompositionSolver::PreProcess()
+{
+	if (m->K == nullptr) return false;
+
+	int nparts = (m_nsub > 0 ? m_nsub : omp_get_max_threads());
+	if (m->Setup(GetFEModel(), nparts) == false) return false;
+
+	if (m->iter)
+	{
+		if (m->bsymm)
+		{
+			RCICGSolver* cg = dynamic_cast<RCICGSolver*>(m->iter);
+			cg->SetMaxIterations(m_maxiter);
+			cg->SetTolerance(m_tol);
+		}
+		else
+		{
+			FGMRESSolver* gmres = dynamic_cast<FGMRESSolver*>(m->iter);
+			gmres->SetMaxIterations(m_maxiter);
+			gmres->SetNonRestartedIterations(100);
+			gmres->SetRelativeResidualTolerance(m_tol);
+		}
+		if (m_printLevel > 1) m->iter->SetPrintLevel(1);
+		if (m->iter->PreProcess() == false) return false;
+	}
+
+	if (m_printLevel > 0)
+	{
+		int nmin = m->K->Rows(), nmax = 0;
+		for (Subdomain* s : m->sub)
+		{
+			int ni = (int)s->eq.size();
+			if (ni < nmin) nmin = ni;
+			if (ni > nmax) nmax = ni;
+		}
+		if (m->sub.empty()) nmin = 0;
+		feLog("\tdomain decomposition solver:\n");
+		feLog("\t\tNr of subdomains .......................... : %d\n", (int)m->sub.size());
+		feLog("\t\tNr of interior equations per subdomain .... : %d - %d\n", nmin, nmax);
+		feLog("\t\tNr of interface equations ................. : %d\n", (int)m->ifc.size());
+	}
+
+	return LinearSolver::PreProcess();
+}
+
+//-----------------------------------------------------------------------------
+bool DomainDecompositionSolver::Factor()
+{
+	if ((m->K == nullptr) || (m->K->Rows() == 0)) return true;
+
+	m->ScatterValues();
+
+	// factor the interior blocks in parallel
+	int ns = (int)m->sub.size();
+	bool bok = true;
+#pragma omp parallel for schedule(dynamic)
+	for (int s = 0; s < ns; ++s)
+	{
+		if (m->sub[s]->solver->Factor() == false)
+		{
+#pragma omp critical
+			bok = false;
+		}
+	}
+	if (bok == false) return false;
+
+	// this factors the interface block for the preconditioner
+	if (m->iter && (m->iter->Factor() == false)) return false;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool DomainDecompositionSolver::BackSolve(double* x, double* b)
+{
+	if ((m->K == nullptr) || (m->K->Rows() == 0)) return true;
+
+	int ns = (int)m->sub.size();
+	int nb = (int)m->ifc.size();
+
+	// eliminate the interior equations: g = b_B - sum A_BI*A_II^-1*b_I
+	bool bok = true;
+#pragma omp parallel for schedule(dynamic)
+	for (int s = 0; s < ns; ++s)
+	{
+		Subdomain& D = *m->sub[s];
+		int ni = (int)D.eq.size();
+		for (int k = 0; k < ni; ++k) D.bi[k] = b[D.eq[k]];
+		if (D.SolveInterior() == false)
+		{
+#pragma omp critical
+			bok = false;
+		}
+		D.MultBI(m->bsymm);
+	}
+	if (bok == false) return false;
+
+	vector<double> g(nb), xb(nb, 0.0);
+	for (int k = 0; k < nb; ++k) g[k] = b[m->ifc[k]];
+	for (int s = 0; s < ns; ++s)
+	{
+		const Subdomain& D = *m->sub[s];
+		int ng = (int)D.gamma.size();
+		for (int k = 0; k < ng; ++k) g[D.gamma[k]] -= D.zb[k];
+	}
+
+	// solve the interface problem
+	int niter = 0;
+	if (nb > 0)
+	{
+		int n0 = m->iter->GetStats().iterations;
+		if (m->iter->BackSolve(&xb[0], &g[0]) == false) return false;
+		niter = m->iter->GetStats().iterations - n0;
+	}
+
+	// solve for the interior equations: A_II*x_I = b_I - A_IB*x_B
+#pragma omp parallel for schedule(dynamic)
+	for (int s = 0; s < ns; ++s)
+	{
+		Subdomain& D = *m->sub[s];
+		int ni = (int)D.eq.size();
+		int ng = (int)D.gamma.size();
+		for (int k = 0; k < ng; ++k) D.xb[k] = xb[D.gamma[k]];
+		D.AIB.mult(D.xb.data(), D.wi.data());
+		for (int k = 0; k < ni; ++k) D.bi[k] = b[D.eq[k]] - D.wi[k];
+		if (D.SolveInterior() == false)
+		{
+#pragma omp critical
+			bok = false;
+		}
+		for (int k = 0; k < ni; ++k) x[D.eq[k]] = D.wi[k];
+	}
+	if (bok == false) return false;
+
+	for (int k = 0; k < nb; ++k) x[m->ifc[k]] = xb[k];
+
+	if (m_printLevel > 0) feLog("\tdomain decomposition solver: %d interface iterations\n", niter);
+
+	UpdateStats(niter);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void DomainDecompositionSolver::Destroy()
+{
+	for (Subdomain* s : m->sub) s->solver->Destroy();
+	if (m->ABBsolver) m->ABBsolver->Destroy();
+}
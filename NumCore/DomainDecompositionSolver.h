@@ -0,0 +1,73 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+
+//-----------------------------------------------------------------------------
+//! Non-overlapping domain decomposition solver for shared memory machines.
+
+//! The mesh is split into a number of subdomains by partitioning the node-node 
+//! graph of the mesh (or the graph of the matrix if no mesh is available). The 
+//! equations that couple to another subdomain form the interface and all other 
+//! equations are interior to a subdomain. The interior blocks are independent and
+//! are factored in parallel with the supernodal solver. The interface problem 
+//! (i.e. the Schur complement system) is solved iteratively with CG (symmetric 
+//! matrices) or GMRES (unsymmetric matrices), preconditioned by the factored
+//! interface block. Each product with the Schur complement does one solve per 
+//! subdomain, which again are done in parallel.
+//! Since the interior and interface blocks are factored with the supernodal solver,
+//! the same restrictions apply: there is no pivoting (see SupernodalSolver).
+class DomainDecompositionSolver : public LinearSolver
+{
+	class Imp;
+
+public:
+	DomainDecompositionSolver(FEModel* fem);
+	~DomainDecompositionSolver();
+	bool PreProcess() override;
+	bool Factor() override;
+	bool BackSolve(double* x, double* y) override;
+	void Destroy() override;
+
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+	bool SetSparseMatrix(SparseMatrix* pA) override;
+
+	void SetPrintLevel(int n) override;
+
+	size_t MemoryUsage() const override;
+
+protected:
+	Imp*	m;
+
+	int		m_printLevel;	//!< print level
+	int		m_nsub;			//!< nr of subdomains (0 = nr of threads)
+	int		m_maxiter;		//!< max nr of iterations of interface solver
+	double	m_tol;			//!< relative residual tolerance of interface solver
+
+	DECLARE_FECORE_CLASS();
+};
@@ -190,7 +190,6 @@ void FGMRESSolver::DoJacobiPreconditioning(bool b)
 //-----------------------------------------------------------------------------
 SparseMatrix* FGMRESSolver::CreateSparseMatrix(Matrix_Type ntype)
 {
-#ifdef MKL_ISS
 	// Cleanup if necessary
 	if (m_pA) delete m_pA; 
 	m_pA = nullptr;
@@ -224,9 +223,6 @@ SparseMatrix* FGMRESSolver::CreateSparseMatrix(Matrix_Type ntype)
 
 	// return the matrix (Can be null if matrix format not supported!)
 	return m_pA;
-#else
-	return 0;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -265,7 +261,10 @@ bool FGMRESSolver::PreProcess()
 
 	return true; 
 #else
-	return false;
+	int N = m_pA->Rows();
+	m_Rv.resize(N);
+	m_W.resize(N, 1.0);
+	return true;
 #endif
 }
 
@@ -443,7 +442,185 @@ bool FGMRESSolver::BackSolve(double* x, double* b)
 	return bconverged;
 
 #else
-	return false;
+	// make sure we have a matrix
+	if (m_pA == 0) return false;
+
+	// number of equations
+	int N = m_pA->Rows();
+
+	// use the same defaults as MKL's dfgmres
+	int M = (N < 150 ? N : 150);
+
+	int nrestart = M;
+	if (m_nrestart > 0) nrestart = m_nrestart;
+	else if (m_maxiter > 0) nrestart = m_maxiter;
+
+	int maxIter = M;
+	if (m_maxiter > 0) maxIter = m_maxiter;
+
+	double reltol = (m_reltol > 0 ? m_reltol : 1e-6);
+	double abstol = (m_abstol > 0 ? m_abstol : 0.0);
+	const double zeroNorm = 1e-12;
+
+	// scale rhs
+	vector<double> F(N);
+	for (int i = 0; i < N; ++i) F[i] = m_W[i] * b[i];
+
+	// zero solution vector
+	for (int i = 0; i < N; ++i) x[i] = 0.0;
+
+	if (m_print_level > 0) feLog("FGMRES:\n");
+
+	// Krylov basis (V) and, since the preconditioner is applied on the right 
+	// and can change between iterations, the preconditioned basis (Z)
+	vector<double> V((size_t)(nrestart + 1)*N);
+	vector<double> Z(m_P ? (size_t)nrestart*N : 0);
+	vector<double> H((size_t)(nrestart + 1)*nrestart, 0.0);
+	vector<double> cs(nrestart), sn(nrestart), g(nrestart + 1), y(nrestart);
+	vector<double> w(N);
+
+	// w = A*R*z
+	auto applyOperator = [&](double* z, double* w) {
+		if (m_R)
+		{
+			m_R->mult_vector(z, &m_Rv[0]);
+			m_pA->mult_vector(&m_Rv[0], w);
+		}
+		else m_pA->mult_vector(z, w);
+	};
+
+	auto dot = [=](const double* a, const double* b) {
+		double s = 0.0;
+		#pragma omp parallel for reduction(+:s)
+		for (int i = 0; i < N; ++i) s += a[i] * b[i];
+		return s;
+	};
+
+	double norm0 = sqrt(dot(&F[0], &F[0]));
+	double tol = reltol*norm0 + abstol;
+	double rnorm = norm0;
+
+	int itercount = 0;
+	bool bdone = (norm0 == 0.0);
+	bool bconverged = bdone;
+	while (!bdone)
+	{
+		// residual r = F - A*x
+		double* r = &V[0];
+		if (itercount == 0) for (int i = 0; i < N; ++i) r[i] = F[i];
+		else
+		{
+			applyOperator(x, r);
+			for (int i = 0; i < N; ++i) r[i] = F[i] - r[i];
+		}
+		double beta = sqrt(dot(r, r));
+		if (m_doResidualTest && (beta <= tol)) { bconverged = true; break; }
+		for (int i = 0; i < N; ++i) r[i] /= beta;
+		g.assign(nrestart + 1, 0.0);
+		g[0] = beta;
+
+		// Arnoldi process
+		int k = 0;
+		bool bstop = false;
+		while ((k < nrestart) && (itercount < maxIter) && !bstop)
+		{
+			double* vk = &V[(size_t)k*N];
+			double* zk = vk;
+			if (m_P)
+			{
+				zk = &Z[(size_t)k*N];
+				if (m_P->mult_vector(vk, zk) == false) { bdone = true; bconverged = false; break; }
+			}
+			applyOperator(zk, &w[0]);
+
+			// modified Gram-Schmidt
+			double* hk = &H[(size_t)k*(nrestart + 1)];
+			for (int j = 0; j <= k; ++j)
+			{
+				double* vj = &V[(size_t)j*N];
+				double h = dot(&w[0], vj);
+				hk[j] = h;
+				#pragma omp parallel for
+				for (int i = 0; i < N; ++i) w[i] -= h*vj[i];
+			}
+			double hn = sqrt(dot(&w[0], &w[0]));
+			hk[k + 1] = hn;
+
+			// apply the Givens rotations
+			for (int j = 0; j < k; ++j)
+			{
+				double t = cs[j] * hk[j] + sn[j] * hk[j + 1];
+				hk[j + 1] = -sn[j] * hk[j] + cs[j] * hk[j + 1];
+				hk[j] = t;
+			}
+			double d = sqrt(hk[k] * hk[k] + hn*hn);
+			cs[k] = (d != 0.0 ? hk[k] / d : 1.0);
+			sn[k] = (d != 0.0 ? hn / d : 0.0);
+			hk[k] = d;
+			hk[k + 1] = 0.0;
+			g[k + 1] = -sn[k] * g[k];
+			g[k] = cs[k] * g[k];
+
+			rnorm = fabs(g[k + 1]);
+			k++;
+			itercount++;
+
+			if (m_print_level > 1) feLog("%3d = %lg (%lg)\n", itercount, rnorm, tol);
+
+			if (m_doResidualTest && (rnorm <= tol)) { bconverged = true; bstop = true; }
+			else if (m_doZeroNormTest && (hn <= zeroNorm)) { bconverged = true; bstop = true; }
+			else
+			{
+				double* vn = &V[(size_t)k*N];
+				#pragma omp parallel for
+				for (int i = 0; i < N; ++i) vn[i] = w[i] / hn;
+			}
+		}
+
+		// update the solution
+		for (int j = k - 1; j >= 0; --j)
+		{
+			double s = g[j];
+			for (int l = j + 1; l < k; ++l) s -= H[(size_t)l*(nrestart + 1) + j] * y[l];
+			y[j] = (H[(size_t)j*(nrestart + 1) + j] != 0.0 ? s / H[(size_t)j*(nrestart + 1) + j] : 0.0);
+		}
+		const vector<double>& U = (m_P ? Z : V);
+		for (int j = 0; j < k; ++j)
+		{
+			const double* uj = &U[(size_t)j*N];
+			double yj = y[j];
+			#pragma omp parallel for
+			for (int i = 0; i < N; ++i) x[i] += yj*uj[i];
+		}
+
+		if (bstop) bdone = true;
+		else if (!bdone && (itercount >= maxIter))
+		{
+			bdone = true;
+			bconverged = !m_maxIterFail;
+		}
+	}
+
+	if (m_do_jacobi)
+	{
+		for (int i = 0; i < N; ++i) x[i] *= m_W[i];
+	}
+
+	if (m_R)
+	{
+		m_R->mult_vector(&x[0], &m_Rv[0]);
+		for (int i = 0; i < N; ++i) x[i] = m_Rv[i];
+	}
+
+	if (m_print_level > 0)
+	{
+		feLog("%3d = %lg (%lg)\n", itercount, rnorm, tol);
+	}
+
+	// update stats
+	UpdateStats(itercount);
+
+	return bconverged;
 #endif // MKL_ISS
 }
 
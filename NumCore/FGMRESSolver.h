@@ -30,6 +30,7 @@ SOFTWARE.*/
 //-----------------------------------------------------------------------------
 //! This class implements an interface to the MKL FGMRES iterative solver for 
 //! nonsymmetric indefinite matrices (without pre-conditioning).
+//! When MKL is not available, a native restarted (flexible) GMRES is used instead.
 class FGMRESSolver : public IterativeLinearSolver
 {
 public:
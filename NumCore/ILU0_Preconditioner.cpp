@@ -118,6 +118,72 @@ bool ILU0_Preconditioner::BackSolve(double* x, double* y)
 }
 
 #else
-bool ILU0_Preconditioner::Factor() { return false; }
-bool ILU0_Preconditioner::BackSolve(double* x, double* y) { return false; }
+// Native ILU(0) factorization. The factors are stored in the sparsity pattern
+// of the matrix, as with MKL's dcsrilu0, with a unit lower triangle and an 
+// upper triangle that includes the diagonal.
+bool ILU0_Preconditioner::Factor()
+{
+	if (m_K == 0) return false;
+
+	int N = m_K->Rows();
+	int NNZ = m_K->NonZeroes();
+	int offset = m_K->Offset();
+
+	double* pa = m_K->Values();
+	int* ia = m_K->Pointers();
+	int* ja = m_K->Indices();
+
+	m_tmp.resize(N, 0.0);
+	m_bilu0.assign(pa, pa + NNZ);
+	double* a = &m_bilu0[0];
+
+	// find the diagonals (the column indices are sorted)
+	vector<int> diag(N, -1);
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = ia[i] - offset; k < ia[i + 1] - offset; ++k)
+			if (ja[k] - offset == i) { diag[i] = k; break; }
+		if (diag[i] == -1) return false;
+	}
+
+	vector<int> pos(N, -1);
+	for (int i = 0; i < N; ++i)
+	{
+		int k0 = ia[i] - offset;
+		int k1 = ia[i + 1] - offset;
+		for (int k = k0; k < k1; ++k) pos[ja[k] - offset] = k;
+
+		// eliminate the lower part of row i with the rows above it
+		for (int k = k0; k < diag[i]; ++k)
+		{
+			int j = ja[k] - offset;
+			double lij = (a[k] /= a[diag[j]]);
+			for (int m = diag[j] + 1; m < ia[j + 1] - offset; ++m)
+			{
+				int p = pos[ja[m] - offset];
+				if (p >= 0) a[p] -= lij * a[m];
+			}
+		}
+
+		// check the pivot
+		double& aii = a[diag[i]];
+		if (m_checkZeroDiagonal && (fabs(aii) < m_zeroThreshold)) aii = m_zeroReplace;
+		if (aii == 0.0) return false;
+
+		for (int k = k0; k < k1; ++k) pos[ja[k] - offset] = -1;
+	}
+
+	// setup the triangular solves
+	if (m_L.Create(N, a, ja, ia, offset, SparseTriangle::LOWER, true) == false) return false;
+	if (m_U.Create(N, a, ja, ia, offset, SparseTriangle::UPPER) == false) return false;
+
+	return true;
+}
+
+bool ILU0_Preconditioner::BackSolve(double* x, double* y)
+{
+	m_L.Solve(y, &m_tmp[0]);
+	m_U.Solve(&m_tmp[0], x);
+	return true;
+}
 #endif
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include <FECore/Preconditioner.h>
+#include "SparseTriangle.h"
 
 //-----------------------------------------------------------------------------
 class ILU0_Preconditioner : public Preconditioner
@@ -54,5 +55,8 @@ private:
 	vector<double>		m_tmp;
 	CRSSparseMatrix*	m_K;
 
+	SparseTriangle		m_L;	// unit lower factor (when MKL is not available)
+	SparseTriangle		m_U;	// upper factor
+
 	DECLARE_FECORE_CLASS();
 };
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "ILUT_Preconditioner.h"
 #include <FECore/CompactUnSymmMatrix.h>
+#include <algorithm>
 
 // We must undef PARDISO since it is defined as a function in mkl_solver.h
 #ifdef MKL_ISS
@@ -56,6 +57,8 @@ ILUT_Preconditioner::ILUT_Preconditioner(FEModel* fem) : Preconditioner(fem)
 	m_checkZeroDiagonal = true;
 	m_zeroThreshold = 1e-16;
 	m_zeroReplace = 1e-10;
+
+	m_K = 0;
 }
 
 SparseMatrix* ILUT_Preconditioner::CreateSparseMatrix(Matrix_Type ntype)
@@ -123,6 +126,112 @@ bool ILUT_Preconditioner::BackSolve(double* x, double* y)
 	return true;
 }
 #else
-bool ILUT_Preconditioner::Factor() { return false; }
-bool ILUT_Preconditioner::BackSolve(double* x, double* y) { return false; }
+// Native ILUT factorization (Saad's dual threshold algorithm). Entries smaller
+// than filltol times the norm of the row are dropped and at most maxfill entries
+// are kept in the lower and upper part of each row. The factors are stored
+// (zero-based) in one compressed row matrix, as with MKL's dcsrilut.
+bool ILUT_Preconditioner::Factor()
+{
+	if (m_K == 0) return false;
+
+	int N = m_K->Rows();
+	int offset = m_K->Offset();
+
+	double* pa = m_K->Values();
+	int* ia = m_K->Pointers();
+	int* ja = m_K->Indices();
+
+	const int maxfill = (m_maxfill > 0 ? m_maxfill : 0);
+
+	m_tmp.resize(N, 0.0);
+	m_bilut.clear();
+	m_jbilut.clear();
+	m_ibilut.assign(N + 1, 0);
+	m_bilut.reserve((2 * maxfill + 1)*N);
+	m_jbilut.reserve((2 * maxfill + 1)*N);
+	vector<int> udiag(N);
+
+	vector<double> w(N, 0.0);
+	vector<int> mark(N, -1);
+	vector<int> lcol, ucol;
+	vector<int> heap;
+	for (int i = 0; i < N; ++i)
+	{
+		// load the row
+		lcol.clear();
+		ucol.clear();
+		heap.clear();
+		double norm = 0.0;
+		mark[i] = i; w[i] = 0.0;
+		for (int k = ia[i] - offset; k < ia[i + 1] - offset; ++k)
+		{
+			int j = ja[k] - offset;
+			w[j] = pa[k];
+			norm += pa[k] * pa[k];
+			if (j < i) { mark[j] = i; heap.push_back(-j); }
+			else if (j > i) { mark[j] = i; ucol.push_back(j); }
+		}
+		norm = sqrt(norm);
+		double tol = m_fillTol * norm;
+
+		// eliminate the lower part in increasing column order
+		std::make_heap(heap.begin(), heap.end());
+		while (heap.empty() == false)
+		{
+			std::pop_heap(heap.begin(), heap.end());
+			int j = -heap.back(); heap.pop_back();
+
+			double lij = w[j] / m_bilut[udiag[j]];
+			if (fabs(lij) < tol) { w[j] = 0.0; continue; }
+			w[j] = lij;
+			lcol.push_back(j);
+
+			for (int m = udiag[j] + 1; m < m_ibilut[j + 1]; ++m)
+			{
+				int c = m_jbilut[m];
+				if (mark[c] != i)
+				{
+					mark[c] = i;
+					w[c] = 0.0;
+					if (c < i) { heap.push_back(-c); std::push_heap(heap.begin(), heap.end()); }
+					else if (c > i) ucol.push_back(c);
+				}
+				w[c] -= lij * m_bilut[m];
+			}
+		}
+
+		// apply the dropping rules and keep the largest entries
+		auto bigger = [&](int a, int b) { return fabs(w[a]) > fabs(w[b]); };
+		ucol.erase(std::remove_if(ucol.begin(), ucol.end(), [&](int c) { return fabs(w[c]) < tol; }), ucol.end());
+		if ((int)lcol.size() > maxfill) { std::nth_element(lcol.begin(), lcol.begin() + maxfill, lcol.end(), bigger); lcol.resize(maxfill); }
+		if ((int)ucol.size() > maxfill) { std::nth_element(ucol.begin(), ucol.begin() + maxfill, ucol.end(), bigger); ucol.resize(maxfill); }
+		std::sort(lcol.begin(), lcol.end());
+		std::sort(ucol.begin(), ucol.end());
+
+		// check the pivot
+		double wii = w[i];
+		if (m_checkZeroDiagonal && (fabs(wii) < m_zeroThreshold)) wii = m_zeroThreshold;
+		if (wii == 0.0) return false;
+
+		// store the row
+		for (int j : lcol) { m_jbilut.push_back(j); m_bilut.push_back(w[j]); }
+		udiag[i] = (int)m_bilut.size();
+		m_jbilut.push_back(i); m_bilut.push_back(wii);
+		for (int j : ucol) { m_jbilut.push_back(j); m_bilut.push_back(w[j]); }
+		m_ibilut[i + 1] = (int)m_bilut.size();
+	}
+
+	// setup the triangular solves
+	if (m_L.Create(N, &m_bilut[0], &m_jbilut[0], &m_ibilut[0], 0, SparseTriangle::LOWER, true) == false) return false;
+	if (m_U.Create(N, &m_bilut[0], &m_jbilut[0], &m_ibilut[0], 0, SparseTriangle::UPPER) == false) return false;
+
+	return true;
+}
+
+bool ILUT_Preconditioner::BackSolve(double* x, double* y)
+{
+	m_L.Solve(y, &m_tmp[0]);
+	m_U.Solve(&m_tmp[0], x);
+	return true;
+}
 #endif
\ No newline at end of file
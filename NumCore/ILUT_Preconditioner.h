@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include <FECore/Preconditioner.h>
+#include "SparseTriangle.h"
 
 //-----------------------------------------------------------------------------
 class ILUT_Preconditioner : public Preconditioner
@@ -57,5 +58,8 @@ private:
 	vector<int>		m_ibilut;
 	vector<double>	m_tmp;
 
+	SparseTriangle	m_L;	// unit lower factor (when MKL is not available)
+	SparseTriangle	m_U;	// upper factor
+
 	DECLARE_FECORE_CLASS();
 };
@@ -155,6 +155,13 @@ bool IncompleteCholesky::Factor()
 		assert(Lii != 0.0);
 	}
 
+#ifndef MKL_ISS
+	// The columns of L are the rows of L^T, so the factor can be used as an
+	// upper triangular matrix in compressed row format.
+	if (m_lower.CreateTranspose(N, val, row, col, offset, SparseTriangle::UPPER) == false) return false;
+	if (m_upper.Create(N, val, row, col, offset, SparseTriangle::UPPER) == false) return false;
+#endif
+
 	return true;
 }
 
@@ -177,6 +184,9 @@ bool IncompleteCholesky::BackSolve(double* x, double* y)
 
 	return true;
 #else 
+	// solve L z = y and L^T x = z
+	m_lower.Solve(y, &z[0]);
+	m_upper.Solve(&z[0], x);
 	return true;
 #endif
 }
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include <FECore/Preconditioner.h>
+#include "SparseTriangle.h"
 
 class CompactSymmMatrix;
 
@@ -48,4 +49,7 @@ public:
 private:
 	CompactSymmMatrix*	m_L;
 	vector<double>		z;
+
+	SparseTriangle		m_lower;	// L and L^T for the solves without MKL
+	SparseTriangle		m_upper;
 };
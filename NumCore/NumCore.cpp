@@ -36,6 +36,7 @@ SOFTWARE.*/
 #include "Hypre_PCG_AMG.h"
 #include "SchurSolver.h"
 #include "IncompleteCholesky.h"
+#include "AMGPreconditioner.h"
 #include "BoomerAMGSolver.h"
 #include "BlockSolver.h"
 #include "BiCGStabSolver.h"
@@ -48,6 +49,8 @@ SOFTWARE.*/
 #include "AccelerateSparseSolver.h"
 #include "SuperLU_MT.h"
 #include "MKLDSSolver.h"
+#include "SupernodalSolver.h"
+#include "DomainDecompositionSolver.h"
 #include "numcore_api.h"
 
 //=============================================================================
@@ -71,11 +74,17 @@ NUMCORE_API void NumCore::InitModule()
     REGISTER_FECORE_CLASS(AccelerateSparseSolver, "accelerate");
     REGISTER_FECORE_CLASS(SuperLU_MT_Solver     , "superlu_mt");
     REGISTER_FECORE_CLASS(MKLDSSolver           , "mkl_dss");
+	// NOTE: the supernodal solver does not pivot (tiny pivots are perturbed instead),
+	// so it is not suited for symmetric indefinite matrices. This also applies to the
+	// domain decomposition solver, which uses it for the interior and interface blocks.
+	REGISTER_FECORE_CLASS(SupernodalSolver      , "supernodal");
+	REGISTER_FECORE_CLASS(DomainDecompositionSolver, "domain_decomposition");
 
 	// register preconditioners
 	REGISTER_FECORE_CLASS(ILU0_Preconditioner, "ilu0");
 	REGISTER_FECORE_CLASS(ILUT_Preconditioner, "ilut");
 	REGISTER_FECORE_CLASS(IncompleteCholesky , "ichol");
+	REGISTER_FECORE_CLASS(AMGPreconditioner  , "amg");
 
 	// register eigen solvers
 	REGISTER_FECORE_CLASS(FEASTEigenSolver, "feast");
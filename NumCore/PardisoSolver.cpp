@@ -90,6 +90,7 @@ void print_err(int nerror)
 BEGIN_FECORE_CLASS(PardisoSolver, LinearSolver)
 	ADD_PARAMETER(m_print_cn, "print_condition_number");
 	ADD_PARAMETER(m_iparm3  , "precondition");
+	ADD_PARAMETER(m_mixedPrecision, "mixed_precision");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -99,6 +100,11 @@ PardisoSolver::PardisoSolver(FEModel* fem) : LinearSolver(fem), m_pA(0)
 	m_mtype = -2;
 	m_iparm3 = false;
 	m_isFactored = false;
+	m_isAnalyzed = false;
+	m_mixedPrecision = false;
+	m_doublePrecision = false;
+	m_isSingle = false;
+	m_normA = 0.0;
 }
 
 //-----------------------------------------------------------------------------
@@ -142,7 +148,7 @@ SparseMatrix* PardisoSolver::CreateSparseMatrix(Matrix_Type ntype)
 //-----------------------------------------------------------------------------
 bool PardisoSolver::SetSparseMatrix(SparseMatrix* pA)
 {
-	if (m_pA && m_isFactored) Destroy();
+	if (m_pA && (m_isFactored || m_isAnalyzed)) Destroy();
 	m_pA = dynamic_cast<CompactMatrix*>(pA);
 	m_mtype = -2;
 	if (dynamic_cast<CRSSparseMatrix*>(pA)) m_mtype = 11;
@@ -157,6 +163,7 @@ bool PardisoSolver::PreProcess()
 	//fprintf(stderr, "In PreProcess\n");
 	assert(m_isFactored == false);
 	pardisoinit(m_pt, &m_mtype, m_iparm);
+	m_isAnalyzed = false;
 
 	m_n = m_pA->Rows();
 	m_nnz = m_pA->NonZeroes();
@@ -182,20 +189,43 @@ bool PardisoSolver::Factor()
 
 // ------------------------------------------------------------------------------
 // Reordering and Symbolic Factorization.  This step also allocates all memory
-// that is necessary for the factorization.
+// that is necessary for the factorization. This only needs to be done once
+// for a given sparsity pattern (i.e. until Destroy or PreProcess is called).
 // ------------------------------------------------------------------------------
 
+	// In mixed precision mode, we factor in single precision (iparm[27] = 1), 
+	// unless we had to fall back to double precision before. Since the precision 
+	// must be the same for all phases, changing it requires a new analysis.
+	bool singlePrecision = (m_mixedPrecision && !m_doublePrecision);
+	if (m_isAnalyzed && (singlePrecision != m_isSingle)) Destroy();
+	m_isSingle = singlePrecision;
+	m_iparm[27] = (m_isSingle ? 1 : 0);
+
+	void* pa = m_pA->Values();
+	if (m_isSingle)
+	{
+		const double* v = m_pA->Values();
+		m_Af.assign(v, v + m_nnz);
+		pa = &m_Af[0];
+		m_normA = m_pA->infNorm();
+	}
+	else vector<float>().swap(m_Af);
+
 	int phase = 11;
 
 	int error = 0;
-	pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, m_pA->Values(), m_pA->Pointers(), m_pA->Indices(),
-		 NULL, &m_nrhs, m_iparm, &m_msglvl, NULL, NULL, &error);
-
-	if (error)
+	if (m_isAnalyzed == false)
 	{
-		fprintf(stderr, "\nERROR during symbolic factorization: ");
-		print_err(error);
-		exit(2);
+		pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, pa, m_pA->Pointers(), m_pA->Indices(),
+			 NULL, &m_nrhs, m_iparm, &m_msglvl, NULL, NULL, &error);
+
+		if (error)
+		{
+			fprintf(stderr, "\nERROR during symbolic factorization: ");
+			print_err(error);
+			exit(2);
+		}
+		m_isAnalyzed = true;
 	}
 
 // ------------------------------------------------------------------------------
@@ -206,9 +236,16 @@ bool PardisoSolver::Factor()
 
 	m_iparm[3] = (m_iparm3 ? 61 : 0);
 	error = 0;
-	pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, m_pA->Values(), m_pA->Pointers(), m_pA->Indices(),
+	pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, pa, m_pA->Pointers(), m_pA->Indices(),
 		 NULL, &m_nrhs, m_iparm, &m_msglvl, NULL, NULL, &error);
 
+	if (error && m_isSingle)
+	{
+		feLogWarning("Single precision factorization failed. Switching to double precision.");
+		m_doublePrecision = true;
+		return Factor();
+	}
+
 	if (error)
 	{
 		fprintf(stderr, "\nERROR during factorization: ");
@@ -234,6 +271,23 @@ bool PardisoSolver::BackSolve(double* x, double* b)
 	// make sure we have work to do
 	if (m_pA->Rows() == 0) return true;
 
+	if (m_isSingle)
+	{
+		// solve with the single precision factor and recover double precision accuracy
+		int iters = 0;
+		if (SolveSinglePrecision(x, b) && IterativeRefinement(m_pA, m_normA, x, b, &iters))
+		{
+			UpdateStats(1 + iters);
+			return true;
+		}
+
+		// The refinement stalled, so the matrix is too ill-conditioned for a single
+		// precision factor. Refactor in double precision and continue in double precision.
+		feLogWarning("Iterative refinement stalled. Switching to double precision.");
+		m_doublePrecision = true;
+		if (Factor() == false) return false;
+	}
+
 	int phase = 33;
 
 	m_iparm[7] = 1;	/* Maximum number of iterative refinement steps */
@@ -255,6 +309,31 @@ bool PardisoSolver::BackSolve(double* x, double* b)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// solve with the single precision factorization
+bool PardisoSolver::SolveSinglePrecision(double* x, const double* b)
+{
+	m_bf.assign(b, b + m_n);
+	m_xf.resize(m_n);
+
+	int phase = 33;
+	m_iparm[7] = 0;	/* the iterative refinement is done in double precision by the caller */
+
+	int error = 0;
+	pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, &m_Af[0], m_pA->Pointers(), m_pA->Indices(),
+		 NULL, &m_nrhs, m_iparm, &m_msglvl, &m_bf[0], &m_xf[0], &error);
+	if (error) return false;
+
+	for (int i = 0; i < m_n; ++i) x[i] = m_xf[i];
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool PardisoSolver::SolveCorrection(double* dx, double* r)
+{
+	return SolveSinglePrecision(dx, r);
+}
+
 //-----------------------------------------------------------------------------
 // This algorithm (naively) estimates the condition number. It is based on the observation that
 // for a linear system of equations A.x = b, the following holds
@@ -306,17 +385,30 @@ void PardisoSolver::Destroy()
 
 	int error = 0;
 
-	if (m_pA && m_pA->Pointers() && m_isFactored)
+	if (m_pA && m_pA->Pointers() && (m_isFactored || m_isAnalyzed))
 	{
 		pardiso(m_pt, &m_maxfct, &m_mnum, &m_mtype, &phase, &m_n, NULL, m_pA->Pointers(), m_pA->Indices(),
 			NULL, &m_nrhs, m_iparm, &m_msglvl, NULL, NULL, &error);
 	}
 	m_isFactored = false;
+	m_isAnalyzed = false;
+}
+
+//-----------------------------------------------------------------------------
+// PARDISO reports the permanent memory of the analysis (iparm[15]) and the memory 
+// of the factorization (iparm[16]) in KB.
+size_t PardisoSolver::MemoryUsage() const
+{
+	size_t mem = (m_Af.capacity() + m_bf.capacity() + m_xf.capacity())*sizeof(float);
+	if (m_isAnalyzed) mem += (size_t)m_iparm[15] * 1024;
+	if (m_isFactored) mem += (size_t)m_iparm[16] * 1024;
+	return mem;
 }
 #else 
 BEGIN_FECORE_CLASS(PardisoSolver, LinearSolver)
 	ADD_PARAMETER(m_print_cn, "print_condition_number");
 	ADD_PARAMETER(m_iparm3, "precondition");
+	ADD_PARAMETER(m_mixedPrecision, "mixed_precision");
 END_FECORE_CLASS();
 
 PardisoSolver::PardisoSolver(FEModel* fem) : LinearSolver(fem) {}
@@ -330,4 +422,7 @@ bool PardisoSolver::SetSparseMatrix(SparseMatrix* pA) { return false; }
 void PardisoSolver::PrintConditionNumber(bool b) {}
 double PardisoSolver::condition_number() { return 0; }
 void PardisoSolver::UseIterativeFactorization(bool b) {}
+bool PardisoSolver::SolveCorrection(double* dx, double* r) { return false; }
+bool PardisoSolver::SolveSinglePrecision(double* x, const double* b) { return false; }
+size_t PardisoSolver::MemoryUsage() const { return 0; }
 #endif
@@ -55,6 +55,13 @@ public:
 
 	void UseIterativeFactorization(bool b);
 
+	size_t MemoryUsage() const override;
+
+protected:
+	bool SolveCorrection(double* dx, double* r) override;
+
+	bool SolveSinglePrecision(double* x, const double* b);
+
 protected:
 
 	CompactMatrix*	m_pA;
@@ -72,7 +79,16 @@ protected:
 
 	bool	m_print_cn;	// estimate and print the condition number
 
+	// mixed precision mode: factor in single precision and use iterative refinement
+	bool	m_mixedPrecision;
+	bool	m_doublePrecision;	// set when mixed precision failed
+	bool	m_isSingle;			// the current factorization is in single precision
+	double	m_normA;			// inf-norm of matrix (for the refinement stopping test)
+	std::vector<float>	m_Af;	// single precision copy of matrix values
+	std::vector<float>	m_bf, m_xf;
+
 	bool	m_isFactored;
+	bool	m_isAnalyzed;	// symbolic factorization was done
 
 	void* m_pt[64]; // Internal solver memory pointer
 
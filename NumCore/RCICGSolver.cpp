@@ -62,14 +62,10 @@ RCICGSolver::RCICGSolver(FEModel* fem) : IterativeLinearSolver(fem), m_pA(0), m_
 //-----------------------------------------------------------------------------
 SparseMatrix* RCICGSolver::CreateSparseMatrix(Matrix_Type ntype)
 {
-#ifdef MKL_ISS
 	if (ntype != REAL_SYMMETRIC) return 0;
 	m_pA = new CompactSymmMatrix(1);
 	if (m_P) m_P->SetSparseMatrix(m_pA);
 	return m_pA;
-#else
-	return 0;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -209,7 +205,81 @@ bool RCICGSolver::BackSolve(double* x, double* b)
 
 	return (m_fail_max_iters ? bsuccess : true);
 #else
-	return false;
+	// Native preconditioned conjugate gradient, which uses the same defaults 
+	// and stopping test as MKL's dcg.
+	if (m_pA == 0) return false;
+
+	int n = m_pA->Rows();
+	int maxiter = (m_maxiter > 0 ? m_maxiter : (n < 150 ? n : 150));
+
+	vector<double> r(n), z(n), p(n), q(n);
+	double rnorm = 0.0;
+	for (int i = 0; i < n; ++i)
+	{
+		x[i] = 0.0;
+		r[i] = b[i];
+		rnorm += r[i] * r[i];
+	}
+	rnorm = sqrt(rnorm);
+	double tol = m_tol * rnorm;
+
+	bool bsuccess = (rnorm <= tol);
+	int niter = 0;
+	double rz = 0.0;
+	while (!bsuccess && (niter < maxiter))
+	{
+		// apply the preconditioner
+		if (m_P) m_P->mult_vector(&r[0], &z[0]);
+		else z = r;
+
+		double rz_new = 0.0;
+		#pragma omp parallel for reduction(+:rz_new)
+		for (int i = 0; i < n; ++i) rz_new += r[i] * z[i];
+
+		if (niter == 0) p = z;
+		else
+		{
+			double beta = rz_new / rz;
+			#pragma omp parallel for
+			for (int i = 0; i < n; ++i) p[i] = z[i] + beta * p[i];
+		}
+		rz = rz_new;
+
+		if (m_pA->mult_vector(&p[0], &q[0]) == false) break;
+
+		double pq = 0.0;
+		#pragma omp parallel for reduction(+:pq)
+		for (int i = 0; i < n; ++i) pq += p[i] * q[i];
+		if (pq == 0.0) break;
+		double alpha = rz / pq;
+
+		rnorm = 0.0;
+		#pragma omp parallel for reduction(+:rnorm)
+		for (int i = 0; i < n; ++i)
+		{
+			x[i] += alpha * p[i];
+			r[i] -= alpha * q[i];
+			rnorm += r[i] * r[i];
+		}
+		rnorm = sqrt(rnorm);
+		niter++;
+
+		if (m_print_level == 1)
+		{
+			fprintf(stderr, "%3d = %lg (%lg)\n", niter, rnorm, tol);
+		}
+
+		if (rnorm <= tol) bsuccess = true;
+	}
+
+	if (m_print_level > 0)
+	{
+		fprintf(stderr, "%3d = %lg (%lg)\n", niter, rnorm, tol);
+	}
+
+	UpdateStats(niter);
+
+	return (m_fail_max_iters ? bsuccess : true);
 #endif // MKL_ISS
 }
 
@@ -0,0 +1,237 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#include "stdafx.h"
+#include "SparseTriangle.h"
+#include <FECore/sys.h>
+#include <algorithm>
+
+// levels with fewer rows than this are solved by a single thread
+#define MIN_PARALLEL_ROWS	256
+
+//-----------------------------------------------------------------------------
+SparseTriangle::SparseTriangle()
+{
+	m_N = 0;
+	m_part = LOWER;
+	m_levels = 0;
+}
+
+//-----------------------------------------------------------------------------
+void SparseTriangle::Clear()
+{
+	m_N = 0;
+	m_levels = 0;
+	m_ptr.clear();
+	m_ind.clear();
+	m_val.clear();
+	m_dinv.clear();
+	m_row.clear();
+	m_stage.clear();
+	m_parallel.clear();
+}
+
+//-----------------------------------------------------------------------------
+bool SparseTriangle::Create(int N, const double* val, const int* ind, const int* ptr, int offset, Part part, bool unitDiagonal)
+{
+	m_N = N;
+	m_part = part;
+	m_ptr.assign(N + 1, 0);
+	m_dinv.assign(N, (unitDiagonal ? 1.0 : 0.0));
+
+	for (int i = 0; i < N; ++i)
+	{
+		int n = 0;
+		for (int k = ptr[i] - offset; k < ptr[i + 1] - offset; ++k)
+		{
+			int j = ind[k] - offset;
+			if ((part == LOWER ? j < i : j > i)) n++;
+			else if ((j == i) && !unitDiagonal) m_dinv[i] = val[k];
+		}
+		m_ptr[i + 1] = m_ptr[i] + n;
+	}
+
+	m_ind.resize(m_ptr[N]);
+	m_val.resize(m_ptr[N]);
+	for (int i = 0; i < N; ++i)
+	{
+		int n = m_ptr[i];
+		for (int k = ptr[i] - offset; k < ptr[i + 1] - offset; ++k)
+		{
+			int j = ind[k] - offset;
+			if ((part == LOWER ? j < i : j > i))
+			{
+				m_ind[n] = j;
+				m_val[n] = val[k];
+				n++;
+			}
+		}
+	}
+
+	return BuildSchedule();
+}
+
+//-----------------------------------------------------------------------------
+bool SparseTriangle::CreateTranspose(int N, const double* val, const int* ind, const int* ptr, int offset, Part part, bool unitDiagonal)
+{
+	// the transpose of the lower part is upper triangular and vice versa
+	m_N = N;
+	m_part = (part == LOWER ? UPPER : LOWER);
+	m_ptr.assign(N + 1, 0);
+	m_dinv.assign(N, (unitDiagonal ? 1.0 : 0.0));
+
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = ptr[i] - offset; k < ptr[i + 1] - offset; ++k)
+		{
+			int j = ind[k] - offset;
+			if ((part == LOWER ? j < i : j > i)) m_ptr[j + 1]++;
+			else if ((j == i) && !unitDiagonal) m_dinv[i] = val[k];
+		}
+	}
+	for (int i = 0; i < N; ++i) m_ptr[i + 1] += m_ptr[i];
+
+	m_ind.resize(m_ptr[N]);
+	m_val.resize(m_ptr[N]);
+	std::vector<int> pos(m_ptr.begin(), m_ptr.end() - 1);
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = ptr[i] - offset; k < ptr[i + 1] - offset; ++k)
+		{
+			int j = ind[k] - offset;
+			if ((part == LOWER ? j < i : j > i))
+			{
+				int n = pos[j]++;
+				m_ind[n] = i;
+				m_val[n] = val[k];
+			}
+		}
+	}
+
+	return BuildSchedule();
+}
+
+//-----------------------------------------------------------------------------
+bool SparseTriangle::BuildSchedule()
+{
+	const int N = m_N;
+
+	// invert the diagonal
+	for (int i = 0; i < N; ++i)
+	{
+		if (m_dinv[i] == 0.0) return false;
+		m_dinv[i] = 1.0 / m_dinv[i];
+	}
+
+	// assign each row to the level after the last level it depends on
+	std::vector<int> level(N, 0);
+	m_levels = (N > 0 ? 1 : 0);
+	for (int n = 0; n < N; ++n)
+	{
+		int i = (m_part == LOWER ? n : N - 1 - n);
+		int l = 0;
+		for (int k = m_ptr[i]; k < m_ptr[i + 1]; ++k) l = std::max(l, level[m_ind[k]] + 1);
+		level[i] = l;
+		if (l + 1 > m_levels) m_levels = l + 1;
+	}
+
+	// sort the rows by level
+	std::vector<int> levelPtr(m_levels + 1, 0);
+	for (int i = 0; i < N; ++i) levelPtr[level[i] + 1]++;
+	for (int l = 0; l < m_levels; ++l) levelPtr[l + 1] += levelPtr[l];
+	m_row.resize(N);
+	std::vector<int> pos(levelPtr.begin(), levelPtr.end() - 1);
+	for (int n = 0; n < N; ++n)
+	{
+		int i = (m_part == LOWER ? n : N - 1 - n);
+		m_row[pos[level[i]]++] = i;
+	}
+
+	// Group the levels into stages. Large levels are solved in parallel and runs
+	// of small levels are solved sequentially, which avoids a synchronization 
+	// for every small level.
+	m_stage.clear();
+	m_parallel.clear();
+	for (int l = 0; l < m_levels; ++l)
+	{
+		bool bpar = (levelPtr[l + 1] - levelPtr[l] >= MIN_PARALLEL_ROWS);
+		if (bpar || m_parallel.empty() || m_parallel.back())
+		{
+			m_stage.push_back(levelPtr[l]);
+			m_parallel.push_back(bpar);
+		}
+	}
+	m_stage.push_back(N);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void SparseTriangle::SolveRows(int n0, int n1, const double* b, double* x) const
+{
+	for (int n = n0; n < n1; ++n)
+	{
+		int i = m_row[n];
+		double s = b[i];
+		for (int k = m_ptr[i]; k < m_ptr[i + 1]; ++k) s -= m_val[k] * x[m_ind[k]];
+		x[i] = s * m_dinv[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+void SparseTriangle::Solve(const double* b, double* x) const
+{
+	const int stages = (int)m_parallel.size();
+	bool bpar = (omp_get_max_threads() > 1) && (std::find(m_parallel.begin(), m_parallel.end(), true) != m_parallel.end());
+	if (bpar == false)
+	{
+		SolveRows(0, m_N, b, x);
+		return;
+	}
+
+	#pragma omp parallel
+	{
+		for (int s = 0; s < stages; ++s)
+		{
+			if (m_parallel[s])
+			{
+				#pragma omp for schedule(static)
+				for (int n = m_stage[s]; n < m_stage[s + 1]; ++n)
+				{
+					int i = m_row[n];
+					double v = b[i];
+					for (int k = m_ptr[i]; k < m_ptr[i + 1]; ++k) v -= m_val[k] * x[m_ind[k]];
+					x[i] = v * m_dinv[i];
+				}
+			}
+			else
+			{
+				#pragma omp single
+				SolveRows(m_stage[s], m_stage[s + 1], b, x);
+			}
+		}
+	}
+}
@@ -0,0 +1,80 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#pragma once
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Sparse triangular factor that is solved with level scheduling. The rows are
+// grouped in levels so that a row only depends on rows in earlier levels, which
+// allows the rows of a level to be solved in parallel. Consecutive levels with
+// only a few rows are combined into a stage that is solved by a single thread.
+// This is used for the back-substitutions of the incomplete factorizations.
+class SparseTriangle
+{
+public:
+	enum Part { LOWER, UPPER };
+
+public:
+	SparseTriangle();
+
+	// Copy the lower or upper triangle of a compressed row matrix. If unitDiagonal
+	// is set, the diagonal is assumed to be one (e.g. the L factor of an ILU).
+	bool Create(int N, const double* val, const int* ind, const int* ptr, int offset, Part part, bool unitDiagonal = false);
+
+	// Same as Create, but for the transpose of the given part. So, this can be 
+	// used to solve with a triangle that is stored in compressed column format.
+	bool CreateTranspose(int N, const double* val, const int* ind, const int* ptr, int offset, Part part, bool unitDiagonal = false);
+
+	// solve T*x = b. (x and b can be the same array.)
+	void Solve(const double* b, double* x) const;
+
+	// number of rows
+	int Rows() const { return m_N; }
+
+	// number of levels in the schedule
+	int Levels() const { return m_levels; }
+
+	void Clear();
+
+private:
+	bool BuildSchedule();
+	void SolveRows(int n0, int n1, const double* b, double* x) const;
+
+private:
+	int		m_N;
+	Part	m_part;
+	int		m_levels;
+
+	std::vector<int>	m_ptr;		// off-diagonal entries (zero-based)
+	std::vector<int>	m_ind;
+	std::vector<double>	m_val;
+	std::vector<double>	m_dinv;		// inverse of diagonal
+
+	std::vector<int>	m_row;		// rows in order of the schedule
+	std::vector<int>	m_stage;	// stage i contains rows m_row[m_stage[i]] ... m_row[m_stage[i+1]-1]
+	std::vector<bool>	m_parallel;	// solve stage in parallel or not
+};
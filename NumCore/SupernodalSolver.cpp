@@ -0,0 +1,1215 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "SupernodalSolver.h"
+#include <FECore/CompactSymmMatrix.h>
+#include <FECore/CompactUnSymmMatrix.h>
+#include <FECore/log.h>
+#include <FECore/sys.h>
+#include <algorithm>
+#include <string.h>
+using namespace std;
+
+BEGIN_FECORE_CLASS(SupernodalSolver, LinearSolver)
+	ADD_PARAMETER(m_printLevel, "print_level");
+	ADD_PARAMETER(m_leafSize, FE_RANGE_GREATER(0), "nd_leaf_size");
+	ADD_PARAMETER(m_mixedPrecision, "mixed_precision");
+	ADD_PARAMETER(m_pivotEps, FE_RANGE_GREATER_OR_EQUAL(0.0), "pivot_perturbation");
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+// A supernode is a group of consecutive columns of the factor that share 
+// the same row structure (below the diagonal block).
+struct Supernode
+{
+	int		first;		// first column of supernode
+	int		ncols;		// number of columns
+	int		parent;		// parent in the assembly tree (-1 for roots)
+	size_t	loff;		// offset into L storage
+	size_t	uoff;		// offset into U storage (unsymmetric only)
+	vector<int>	rows;		// row structure (starts with the supernode's own columns)
+	vector<int>	relmap;		// location of the update rows in the parent's row structure
+	vector<int>	children;	// child supernodes
+};
+
+//-----------------------------------------------------------------------------
+// This maps a value of the sparse matrix to a location in the frontal matrix
+struct FrontEntry
+{
+	int	src;	// index into value array of sparse matrix
+	int	row;	// row in front
+	int	col;	// column in front
+};
+
+//-----------------------------------------------------------------------------
+class SupernodalSolver::Imp
+{
+public:
+	CompactMatrix*	A = nullptr;
+	bool			bsymm = true;
+
+	// symbolic factorization
+	int							neq = 0;
+	vector<int>					perm;	// new to old equation number
+	vector<Supernode>			sn;		// supernodes (in postorder)
+	vector< vector<FrontEntry> >	amap;	// matrix values assembled into each front
+	vector< vector<int> >		levels;	// supernodes grouped by level in the assembly tree
+	size_t						Lsize = 0;
+	size_t						Usize = 0;
+	bool						bsymbolic = false;
+
+	// fingerprint of the sparsity pattern that was used for the symbolic factorization
+	int					fp_neq = -1;
+	int					fp_nnz = -1;
+	unsigned long long	fp_hash = 0;
+
+	// numerical factorization
+	vector<double>	L;
+	vector<double>	U;
+	bool			bfactored = false;
+	double			pivtol = 0.0;	// pivots smaller than this are perturbed
+	int				npert = 0;		// nr of perturbed pivots in the last factorization
+
+	// single precision factorization (used in mixed precision mode)
+	vector<float>	Lf;
+	vector<float>	Uf;
+	bool			bsingle = false;
+
+	// work vector
+	vector<double>	y;
+
+public:
+	// loop over all (row, col, src) entries of the sparse matrix
+	template <class F> void ForEachEntry(F f)
+	{
+		int n = A->Rows();
+		int* pp = A->Pointers();
+		int* pi = A->Indices();
+		int off = A->Offset();
+		for (int a = 0; a < n; ++a)
+		{
+			for (int k = pp[a] - off; k < pp[a + 1] - off; ++k)
+			{
+				int b = pi[k] - off;
+				// symmetric matrices are stored column-wise, unsymmetric row-wise
+				if (bsymm) f(b, a, k); else f(a, b, k);
+			}
+		}
+	}
+
+	unsigned long long PatternHash();
+
+	void NestedDissection(int leafSize);
+
+	bool Symbolic(int leafSize);
+
+	bool Numeric(bool singlePrecision);
+
+	void Solve(double* x, const double* b);
+
+	template <typename T> bool NumericT(vector<T>& L, vector<T>& U);
+
+	template <typename T> bool FactorSupernode(int s, vector< vector<T> >& upd, vector<T>& L, vector<T>& U, bool parallel);
+
+	template <typename T> void SolveT(const vector<T>& L, const vector<T>& U, double* x, const double* b);
+};
+
+//-----------------------------------------------------------------------------
+// calculate a hash of the sparsity pattern (FNV-1a)
+unsigned long long SupernodalSolver::Imp::PatternHash()
+{
+	unsigned long long h = 14695981039346656037ULL;
+	int n = A->Rows();
+	int nnz = A->NonZeroes();
+	const int* pp = A->Pointers();
+	const int* pi = A->Indices();
+	for (int i = 0; i <= n; ++i) { h ^= (unsigned long long)pp[i]; h *= 1099511628211ULL; }
+	for (int i = 0; i < nnz; ++i) { h ^= (unsigned long long)pi[i]; h *= 1099511628211ULL; }
+	return h;
+}
+
+//-----------------------------------------------------------------------------
+// Calculate a nested-dissection ordering of the (symmetrized) graph of the matrix.
+// Equations with identical structure (e.g. the dofs of a node) are first merged into
+// supervariables. The graph of supervariables is then recursively split with a 
+// level-structure separator, taken from the middle of a BFS from a pseudo-peripheral vertex.
+// Subgraphs with no more than leafSize vertices are not split further.
+void SupernodalSolver::Imp::NestedDissection(int leafSize)
+{
+	int n = neq;
+
+	// build the adjacency graph (without the diagonal)
+	vector<int> xadj(n + 1, 0);
+	ForEachEntry([&](int i, int j, int k) {
+		if (i != j) { xadj[i + 1]++; xadj[j + 1]++; }
+	});
+	for (int i = 0; i < n; ++i) xadj[i + 1] += xadj[i];
+	vector<int> adj(xadj[n]);
+	{
+		vector<int> pos(xadj.begin(), xadj.end() - 1);
+		ForEachEntry([&](int i, int j, int k) {
+			if (i != j) { adj[pos[i]++] = j; adj[pos[j]++] = i; }
+		});
+	}
+
+	// sort and remove duplicates (unsymmetric matrices store both (i,j) and (j,i))
+	{
+		int nz = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			int* a = &adj[0] + xadj[i];
+			int na = xadj[i + 1] - xadj[i];
+			sort(a, a + na);
+			int nu = (int)(unique(a, a + na) - a);
+			for (int k = 0; k < nu; ++k) adj[nz + k] = a[k];
+			xadj[i] = nz;
+			nz += nu;
+		}
+		xadj[n] = nz;
+		adj.resize(nz);
+	}
+
+	// merge consecutive equations with identical structure into supervariables
+	vector<int> svStart; svStart.reserve(n + 1);
+	vector<int> sv(n);
+	for (int i = 0; i < n; ++i)
+	{
+		bool bsame = false;
+		if (i > 0)
+		{
+			int p = svStart.back();
+			int na = xadj[i + 1] - xadj[i];
+			int nb = xadj[p + 1] - xadj[p];
+			if (na == nb)
+			{
+				// compare the structures including the diagonal
+				const int* a = &adj[0] + xadj[i];
+				const int* b = &adj[0] + xadj[p];
+				int ia = 0, ib = 0;
+				bsame = true;
+				while (bsame && ((ia < na) || (ib < nb)))
+				{
+					int va = (ia < na ? a[ia] : n);
+					int vb = (ib < nb ? b[ib] : n);
+					if (va == p) { ia++; continue; }
+					if (vb == i) { ib++; continue; }
+					if (va != vb) bsame = false; else { ia++; ib++; }
+				}
+			}
+		}
+		if (bsame == false) svStart.push_back(i);
+		sv[i] = (int)svStart.size() - 1;
+	}
+	int ns = (int)svStart.size();
+	svStart.push_back(n);
+
+	// build the graph of supervariables
+	vector<int> cxadj(ns + 1, 0);
+	vector<int> cadj; cadj.reserve(adj.size() / 2);
+	{
+		vector<int> tag(ns, -1);
+		for (int s = 0; s < ns; ++s)
+		{
+			tag[s] = s;
+			int i = svStart[s];
+			for (int k = xadj[i]; k < xadj[i + 1]; ++k)
+			{
+				int t = sv[adj[k]];
+				if (tag[t] != s) { tag[t] = s; cadj.push_back(t); }
+			}
+			cxadj[s + 1] = (int)cadj.size();
+		}
+	}
+	vector<int>().swap(adj);
+	vector<int>().swap(xadj);
+
+	// do the nested dissection
+	vector<int> order(ns, -1);
+	vector<int> where(ns, -1);	// stamp of the subgraph a vertex belongs to
+	vector<int> level(ns, -1);
+	int stamp = 0;
+
+	struct Part { vector<int> v; int pos; };
+	vector<Part> stack;
+	{
+		Part p; p.pos = 0; p.v.resize(ns);
+		for (int i = 0; i < ns; ++i) p.v[i] = i;
+		stack.push_back(p);
+	}
+
+	vector<int> queue; queue.reserve(ns);
+
+	// BFS restricted to the current subgraph, returns the number of levels
+	auto bfs = [&](int r, int st) {
+		queue.clear();
+		queue.push_back(r); level[r] = 0;
+		int nlevels = 1;
+		for (size_t q = 0; q < queue.size(); ++q)
+		{
+			int v = queue[q];
+			for (int k = cxadj[v]; k < cxadj[v + 1]; ++k)
+			{
+				int w = cadj[k];
+				if ((where[w] == st) && (level[w] < 0))
+				{
+					level[w] = level[v] + 1;
+					if (level[w] + 1 > nlevels) nlevels = level[w] + 1;
+					queue.push_back(w);
+				}
+			}
+		}
+		return nlevels;
+	};
+
+	while (stack.empty() == false)
+	{
+		Part P = stack.back(); stack.pop_back();
+		vector<int>& S = P.v;
+		int nv = (int)S.size();
+		if (nv == 0) continue;
+
+		bool bleaf = (nv <= leafSize);
+		if (bleaf == false)
+		{
+			int st = stamp++;
+			for (int v : S) { where[v] = st; level[v] = -1; }
+
+			// find a pseudo-peripheral vertex
+			int r = S[0];
+			int nlev = bfs(r, st);
+			if ((int)queue.size() < nv)
+			{
+				// the subgraph is not connected, so split off this component
+				Part A, B;
+				A.v = queue;
+				for (int v : S) if (level[v] < 0) B.v.push_back(v);
+				A.pos = P.pos;
+				B.pos = P.pos + (int)A.v.size();
+				stack.push_back(A);
+				stack.push_back(B);
+				continue;
+			}
+			for (int iter = 0; iter < 4; ++iter)
+			{
+				// pick the vertex of smallest degree in the last level
+				int rmin = queue.back(), dmin = ns + 1;
+				for (int q = (int)queue.size() - 1; (q >= 0) && (level[queue[q]] == nlev - 1); --q)
+				{
+					int w = queue[q];
+					int dw = cxadj[w + 1] - cxadj[w];
+					if (dw < dmin) { dmin = dw; rmin = w; }
+				}
+				for (int v : S) level[v] = -1;
+				int nlev2 = bfs(rmin, st);
+				if (nlev2 <= nlev) { nlev = nlev2; r = rmin; break; }
+				nlev = nlev2; r = rmin;
+			}
+
+			if (nlev < 3) bleaf = true;
+			else
+			{
+				// find the smallest level that still gives a reasonably balanced split
+				vector<int> lcount(nlev, 0);
+				for (int v : S) lcount[level[v]]++;
+				int m = -1, sum = lcount[0];
+				for (int l = 1; l < nlev - 1; ++l)
+				{
+					if ((sum >= 3 * nv / 10) && (sum + lcount[l] <= 7 * nv / 10))
+					{
+						if ((m == -1) || (lcount[l] < lcount[m])) m = l;
+					}
+					sum += lcount[l];
+				}
+				if (m == -1)
+				{
+					// take the middle level
+					m = 0; sum = 0;
+					while ((m < nlev - 2) && (sum + lcount[m] < nv / 2)) sum += lcount[m++];
+					if (m == 0) m = 1;
+				}
+
+				// The separator consists of the vertices of the middle level that
+				// are connected to the next level. 
+				Part A, B;
+				vector<int> sep;
+				for (int v : S)
+				{
+					int lv = level[v];
+					if (lv < m) A.v.push_back(v);
+					else if (lv > m) B.v.push_back(v);
+					else
+					{
+						bool bsep = false;
+						for (int k = cxadj[v]; k < cxadj[v + 1]; ++k)
+						{
+							int w = cadj[k];
+							if ((where[w] == st) && (level[w] == m + 1)) { bsep = true; break; }
+						}
+						if (bsep) sep.push_back(v); else A.v.push_back(v);
+					}
+				}
+
+				if (A.v.empty() || B.v.empty()) bleaf = true;
+				else
+				{
+					// the separator is numbered last
+					A.pos = P.pos;
+					B.pos = P.pos + (int)A.v.size();
+					int pos = B.pos + (int)B.v.size();
+					for (int v : sep) order[pos++] = v;
+					stack.push_back(A);
+					stack.push_back(B);
+				}
+			}
+		}
+
+		if (bleaf)
+		{
+			for (int i = 0; i < nv; ++i) order[P.pos + i] = S[i];
+		}
+	}
+
+	// expand the supervariables
+	perm.resize(n);
+	int k = 0;
+	for (int i = 0; i < ns; ++i)
+	{
+		int s = order[i];
+		for (int j = svStart[s]; j < svStart[s + 1]; ++j) perm[k++] = j;
+	}
+	assert(k == n);
+}
+
+//-----------------------------------------------------------------------------
+// The symbolic factorization. This calculates the ordering, the elimination tree,
+// the supernodes and their row structures, and all the index maps needed by the 
+// numerical factorization.
+bool SupernodalSolver::Imp::Symbolic(int leafSize)
+{
+	bsymbolic = false;
+	bfactored = false;
+	sn.clear();
+	amap.clear();
+	levels.clear();
+
+	neq = A->Rows();
+	int n = neq;
+	if (n == 0) { bsymbolic = true; return true; }
+
+	// fill-reducing ordering
+	NestedDissection(leafSize);
+
+	vector<int> iperm(n);
+	for (int i = 0; i < n; ++i) iperm[perm[i]] = i;
+
+	// build the structure of the permuted matrix: for each row the columns in the lower triangle
+	vector<int> rp(n + 1, 0);
+	ForEachEntry([&](int i, int j, int k) {
+		int r = iperm[i], c = iperm[j];
+		if (r != c) rp[max(r, c) + 1]++;
+	});
+	for (int i = 0; i < n; ++i) rp[i + 1] += rp[i];
+	vector<int> rc(rp[n]);
+	{
+		vector<int> pos(rp.begin(), rp.end() - 1);
+		ForEachEntry([&](int i, int j, int k) {
+			int r = iperm[i], c = iperm[j];
+			if (r != c) rc[pos[max(r, c)]++] = min(r, c);
+		});
+	}
+
+	// elimination tree
+	vector<int> parent(n, -1), ancestor(n, -1);
+	for (int k = 0; k < n; ++k)
+	{
+		for (int l = rp[k]; l < rp[k + 1]; ++l)
+		{
+			int i = rc[l];
+			while ((i != -1) && (i < k))
+			{
+				int next = ancestor[i];
+				ancestor[i] = k;
+				if (next == -1) { parent[i] = k; break; }
+				i = next;
+			}
+		}
+	}
+	vector<int>().swap(ancestor);
+
+	// postorder the tree
+	vector<int> post(n);
+	{
+		vector<int> head(n, -1), next(n, -1);
+		for (int j = n - 1; j >= 0; --j)
+		{
+			if (parent[j] != -1) { next[j] = head[parent[j]]; head[parent[j]] = j; }
+		}
+		vector<int> stack; stack.reserve(n);
+		int k = 0;
+		for (int j = 0; j < n; ++j)
+		{
+			if (parent[j] != -1) continue;
+			stack.push_back(j);
+			while (stack.empty() == false)
+			{
+				int p = stack.back();
+				int c = head[p];
+				if (c == -1) { stack.pop_back(); post[p] = k++; }
+				else { head[p] = next[c]; stack.push_back(c); }
+			}
+		}
+		assert(k == n);
+	}
+
+	// apply the postorder to the permutation and the tree
+	{
+		vector<int> perm2(n), parent2(n, -1);
+		for (int j = 0; j < n; ++j)
+		{
+			perm2[post[j]] = perm[j];
+			if (parent[j] != -1) parent2[post[j]] = post[parent[j]];
+		}
+		perm.swap(perm2);
+		parent.swap(parent2);
+		for (int i = 0; i < n; ++i) iperm[perm[i]] = i;
+	}
+	vector<int>().swap(post);
+
+	// build the column structure of the permuted lower triangle
+	vector<int> cp(n + 1, 0);
+	ForEachEntry([&](int i, int j, int k) {
+		int r = iperm[i], c = iperm[j];
+		if (r != c) cp[min(r, c) + 1]++;
+	});
+	for (int i = 0; i < n; ++i) cp[i + 1] += cp[i];
+	vector<int> cr(cp[n]);
+	{
+		vector<int> pos(cp.begin(), cp.end() - 1);
+		ForEachEntry([&](int i, int j, int k) {
+			int r = iperm[i], c = iperm[j];
+			if (r != c) cr[pos[min(r, c)]++] = max(r, c);
+		});
+	}
+	vector<int>().swap(rp);
+	vector<int>().swap(rc);
+
+	// children lists
+	vector<int> nchild(n, 0);
+	vector<int> chead(n, -1), cnext(n, -1);
+	for (int j = n - 1; j >= 0; --j)
+	{
+		int p = parent[j];
+		if (p != -1) { nchild[p]++; cnext[j] = chead[p]; chead[p] = j; }
+	}
+
+	// column counts of the factor
+	vector<int> cnt(n, 0);
+	{
+		vector< vector<int> > cs(n);
+		vector<int> mark(n, -1);
+		for (int j = 0; j < n; ++j)
+		{
+			vector<int>& s = cs[j];
+			for (int l = cp[j]; l < cp[j + 1]; ++l)
+			{
+				int i = cr[l];
+				if (mark[i] != j) { mark[i] = j; s.push_back(i); }
+			}
+			for (int c = chead[j]; c != -1; c = cnext[c])
+			{
+				for (int i : cs[c]) if ((i != j) && (mark[i] != j)) { mark[i] = j; s.push_back(i); }
+				vector<int>().swap(cs[c]);
+			}
+			cnt[j] = (int)s.size();
+		}
+	}
+
+	// find the (fundamental) supernodes
+	vector<int> colsn(n);
+	for (int j = 0; j < n; ++j)
+	{
+		if ((j > 0) && (parent[j - 1] == j) && (nchild[j] == 1) && (cnt[j - 1] == cnt[j] + 1))
+		{
+			sn.back().ncols++;
+		}
+		else
+		{
+			Supernode s;
+			s.first = j;
+			s.ncols = 1;
+			s.parent = -1;
+			s.loff = s.uoff = 0;
+			sn.push_back(s);
+		}
+		colsn[j] = (int)sn.size() - 1;
+	}
+	int nsn = (int)sn.size();
+
+	// supernode tree
+	for (int s = 0; s < nsn; ++s)
+	{
+		Supernode& S = sn[s];
+		int p = parent[S.first + S.ncols - 1];
+		if (p != -1)
+		{
+			S.parent = colsn[p];
+			sn[S.parent].children.push_back(s);
+		}
+	}
+
+	// row structures of the supernodes
+	{
+		vector<int> mark(n, -1);
+		for (int s = 0; s < nsn; ++s)
+		{
+			Supernode& S = sn[s];
+			int f = S.first;
+			int l = f + S.ncols;
+			vector<int>& rows = S.rows;
+			rows.reserve(S.ncols + cnt[f]);
+			for (int j = f; j < l; ++j) { rows.push_back(j); mark[j] = s; }
+			for (int j = f; j < l; ++j)
+			{
+				for (int k = cp[j]; k < cp[j + 1]; ++k)
+				{
+					int i = cr[k];
+					if (mark[i] != s) { mark[i] = s; rows.push_back(i); }
+				}
+			}
+			for (int c : S.children)
+			{
+				Supernode& C = sn[c];
+				for (size_t k = C.ncols; k < C.rows.size(); ++k)
+				{
+					int i = C.rows[k];
+					if (mark[i] != s) { mark[i] = s; rows.push_back(i); }
+				}
+			}
+			sort(rows.begin() + S.ncols, rows.end());
+		}
+	}
+
+	// relative indices of the update rows in the parent's structure
+	for (int s = 0; s < nsn; ++s)
+	{
+		Supernode& S = sn[s];
+		if (S.parent == -1) continue;
+		const vector<int>& prows = sn[S.parent].rows;
+		int mu = (int)S.rows.size() - S.ncols;
+		S.relmap.resize(mu);
+		int k = 0;
+		for (int i = 0; i < mu; ++i)
+		{
+			int r = S.rows[S.ncols + i];
+			while (prows[k] != r) k++;
+			S.relmap[i] = k;
+		}
+	}
+
+	// map the matrix values to the fronts
+	amap.resize(nsn);
+	ForEachEntry([&](int i, int j, int src) {
+		int r = iperm[i], c = iperm[j];
+		int k = min(r, c), o = max(r, c);
+		int s = colsn[k];
+		Supernode& S = sn[s];
+		int kl = k - S.first;
+		int ol = (int)(lower_bound(S.rows.begin(), S.rows.end(), o) - S.rows.begin());
+		FrontEntry e;
+		e.src = src;
+		if (bsymm || (r >= c)) { e.row = ol; e.col = kl; }
+		else { e.row = kl; e.col = ol; }
+		amap[s].push_back(e);
+	});
+
+	// storage offsets
+	Lsize = Usize = 0;
+	for (int s = 0; s < nsn; ++s)
+	{
+		Supernode& S = sn[s];
+		size_t m = S.rows.size();
+		S.loff = Lsize; Lsize += m * S.ncols;
+		S.uoff = Usize; if (bsymm == false) Usize += (m - S.ncols) * S.ncols;
+	}
+
+	// group the supernodes by their level in the tree (leaves first)
+	{
+		vector<int> lev(nsn, 0);
+		int maxLevel = 0;
+		for (int s = 0; s < nsn; ++s)
+		{
+			for (int c : sn[s].children) lev[s] = max(lev[s], lev[c] + 1);
+			maxLevel = max(maxLevel, lev[s]);
+		}
+		levels.assign(maxLevel + 1, vector<int>());
+		for (int s = 0; s < nsn; ++s) levels[lev[s]].push_back(s);
+	}
+
+	bsymbolic = true;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// There is no pivoting, since the elimination order is fixed by the symbolic
+// factorization. Instead, pivots smaller than tol (in absolute value) are replaced 
+// by +/-tol (static pivot perturbation) and counted in npert. The error this 
+// introduces is removed by iterative refinement in the back solve.
+template <typename T> static inline bool check_pivot(T& d, T tol, int& npert)
+{
+	if (d != d) return false;
+	if ((d < 0 ? -d : d) < tol)
+	{
+		d = (d < 0 ? -tol : tol);
+		npert++;
+	}
+	return (d != 0);
+}
+
+//-----------------------------------------------------------------------------
+// Dense LDL^T factorization of the first nc columns of the (column-major) frontal
+// matrix F of size m x m. Only the lower triangle is referenced. On return, the first 
+// nc columns contain the unit lower factor (with D on the diagonal) and the trailing 
+// block contains the update (Schur complement) matrix.
+template <typename T> static bool ldlt_front(T* F, int m, int nc, T tol, int& npert, bool parallel)
+{
+	const int NB = 32;
+	for (int k0 = 0; k0 < nc; k0 += NB)
+	{
+		int k1 = min(k0 + NB, nc);
+
+		// factor the panel
+		for (int k = k0; k < k1; ++k)
+		{
+			T* Fk = F + (size_t)k*m;
+			if (check_pivot(Fk[k], tol, npert) == false) return false;
+			T d = Fk[k];
+
+			for (int j = k + 1; j < k1; ++j)
+			{
+				T* Fj = F + (size_t)j*m;
+				T ljk = Fk[j] / d;
+				for (int i = j; i < m; ++i) Fj[i] -= Fk[i] * ljk;
+			}
+
+			T di = 1 / d;
+			for (int i = k + 1; i < m; ++i) Fk[i] *= di;
+		}
+
+		// update the trailing columns
+#pragma omp parallel for schedule(dynamic, 4) if (parallel && (m - k1 > 256))
+		for (int j = k1; j < m; ++j)
+		{
+			T* Fj = F + (size_t)j*m;
+			for (int p = k0; p < k1; ++p)
+			{
+				const T* Fp = F + (size_t)p*m;
+				T c = Fp[j] * Fp[p];
+				if (c == 0) continue;
+				for (int i = j; i < m; ++i) Fj[i] -= Fp[i] * c;
+			}
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Dense LU factorization (with static pivot perturbation) of the first nc columns and
+// rows of the (column-major) frontal matrix F of size m x m. On return, the first nc 
+// columns contain L (unit lower) and U, the first nc rows contain U, and the trailing
+// block contains the update matrix.
+template <typename T> static bool lu_front(T* F, int m, int nc, T tol, int& npert, bool parallel)
+{
+	const int NB = 32;
+	for (int k0 = 0; k0 < nc; k0 += NB)
+	{
+		int k1 = min(k0 + NB, nc);
+
+		// factor the panel
+		for (int k = k0; k < k1; ++k)
+		{
+			T* Fk = F + (size_t)k*m;
+			if (check_pivot(Fk[k], tol, npert) == false) return false;
+			T piv = Fk[k];
+
+			T di = 1 / piv;
+			for (int i = k + 1; i < m; ++i) Fk[i] *= di;
+
+			for (int j = k + 1; j < k1; ++j)
+			{
+				T* Fj = F + (size_t)j*m;
+				T u = Fj[k];
+				if (u == 0) continue;
+				for (int i = k + 1; i < m; ++i) Fj[i] -= Fk[i] * u;
+			}
+		}
+
+		// update the trailing columns
+#pragma omp parallel for schedule(dynamic, 4) if (parallel && (m - k1 > 256))
+		for (int j = k1; j < m; ++j)
+		{
+			T* Fj = F + (size_t)j*m;
+			for (int p = k0; p < k1; ++p)
+			{
+				T u = Fj[p];
+				if (u == 0) continue;
+				const T* Fp = F + (size_t)p*m;
+				for (int i = p + 1; i < m; ++i) Fj[i] -= Fp[i] * u;
+			}
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// assemble, factor and store the front of supernode s
+template <typename T>
+bool SupernodalSolver::Imp::FactorSupernode(int s, vector< vector<T> >& upd, vector<T>& L, vector<T>& U, bool parallel)
+{
+	Supernode& S = sn[s];
+	int m = (int)S.rows.size();
+	int nc = S.ncols;
+	int mu = m - nc;
+
+	// assemble the matrix values
+	vector<T> F((size_t)m*m, 0);
+	const double* val = A->Values();
+	for (const FrontEntry& e : amap[s]) F[(size_t)e.col*m + e.row] += (T)val[e.src];
+
+	// extend-add the update matrices of the children
+	for (int c : S.children)
+	{
+		Supernode& C = sn[c];
+		int mc = (int)C.relmap.size();
+		const vector<int>& rm = C.relmap;
+		const T* Uc = &upd[c][0];
+		for (int j = 0; j < mc; ++j)
+		{
+			T* Fj = &F[0] + (size_t)rm[j] * m;
+			const T* Ucj = Uc + (size_t)j*mc;
+			for (int i = (bsymm ? j : 0); i < mc; ++i) Fj[rm[i]] += Ucj[i];
+		}
+		vector<T>().swap(upd[c]);
+	}
+
+	// factor the front
+	int np = 0;
+	T tol = (T)pivtol;
+	bool bok = (bsymm ? ldlt_front(&F[0], m, nc, tol, np, parallel) : lu_front(&F[0], m, nc, tol, np, parallel));
+	if (np > 0)
+	{
+#pragma omp atomic
+		npert += np;
+	}
+	if (bok == false) return false;
+
+	// store the factor
+	memcpy(&L[S.loff], &F[0], sizeof(T)*m*nc);
+	if (bsymm == false)
+	{
+		for (int j = 0; j < mu; ++j)
+			for (int i = 0; i < nc; ++i) U[S.uoff + (size_t)j*nc + i] = F[(size_t)(nc + j)*m + i];
+	}
+
+	// store the update matrix
+	if ((S.parent != -1) && (mu > 0))
+	{
+		vector<T>& Us = upd[s];
+		Us.resize((size_t)mu*mu);
+		for (int j = 0; j < mu; ++j) memcpy(&Us[(size_t)j*mu], &F[(size_t)(nc + j)*m + nc], sizeof(T)*mu);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// The numerical factorization. The fronts are processed level by level. Fronts on
+// the same level are independent and are factored in parallel. When there are fewer 
+// fronts than threads (near the root) the dense kernels are parallelized instead.
+// In single precision mode, the fronts are factored in single precision and only
+// the single precision factor is stored.
+bool SupernodalSolver::Imp::Numeric(bool singlePrecision)
+{
+	bfactored = false;
+	bsingle = singlePrecision;
+	npert = 0;
+	if (bsingle)
+	{
+		vector<double>().swap(L);
+		vector<double>().swap(U);
+		bfactored = NumericT(Lf, Uf);
+	}
+	else
+	{
+		vector<float>().swap(Lf);
+		vector<float>().swap(Uf);
+		bfactored = NumericT(L, U);
+	}
+	return bfactored;
+}
+
+//-----------------------------------------------------------------------------
+template <typename T>
+bool SupernodalSolver::Imp::NumericT(vector<T>& L, vector<T>& U)
+{
+	L.resize(Lsize);
+	U.resize(Usize);
+
+	int nsn = (int)sn.size();
+	vector< vector<T> > upd(nsn);
+	int nthreads = omp_get_max_threads();
+
+	for (size_t l = 0; l < levels.size(); ++l)
+	{
+		const vector<int>& lev = levels[l];
+		int nl = (int)lev.size();
+		bool bok = true;
+		if (nl < nthreads)
+		{
+			for (int i = 0; i < nl; ++i)
+			{
+				if (FactorSupernode(lev[i], upd, L, U, true) == false) { bok = false; break; }
+			}
+		}
+		else
+		{
+#pragma omp parallel for schedule(dynamic)
+			for (int i = 0; i < nl; ++i)
+			{
+				if (FactorSupernode(lev[i], upd, L, U, false) == false)
+				{
+#pragma omp critical
+					bok = false;
+				}
+			}
+		}
+		if (bok == false) return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalSolver::Imp::Solve(double* x, const double* b)
+{
+	if (bsingle) SolveT(Lf, Uf, x, b);
+	else SolveT(L, U, x, b);
+}
+
+//-----------------------------------------------------------------------------
+// The substitutions are always done in double precision.
+template <typename T>
+void SupernodalSolver::Imp::SolveT(const vector<T>& L, const vector<T>& U, double* x, const double* b)
+{
+	int n = neq;
+	y.resize(n);
+	for (int k = 0; k < n; ++k) y[k] = b[perm[k]];
+
+	int nsn = (int)sn.size();
+
+	// forward substitution (L is unit lower triangular)
+	for (int s = 0; s < nsn; ++s)
+	{
+		const Supernode& S = sn[s];
+		int m = (int)S.rows.size();
+		const int* rows = &S.rows[0];
+		const T* Ls = &L[S.loff];
+		for (int c = 0; c < S.ncols; ++c)
+		{
+			double yc = y[S.first + c];
+			if (yc == 0.0) continue;
+			const T* Lc = Ls + (size_t)c*m;
+			for (int i = c + 1; i < m; ++i) y[rows[i]] -= Lc[i] * yc;
+		}
+	}
+
+	if (bsymm)
+	{
+		// diagonal
+		for (int s = 0; s < nsn; ++s)
+		{
+			const Supernode& S = sn[s];
+			int m = (int)S.rows.size();
+			const T* Ls = &L[S.loff];
+			for (int c = 0; c < S.ncols; ++c) y[S.first + c] /= Ls[(size_t)c*m + c];
+		}
+
+		// backward substitution with L^T
+		for (int s = nsn - 1; s >= 0; --s)
+		{
+			const Supernode& S = sn[s];
+			int m = (int)S.rows.size();
+			const int* rows = &S.rows[0];
+			const T* Ls = &L[S.loff];
+			for (int c = S.ncols - 1; c >= 0; --c)
+			{
+				const T* Lc = Ls + (size_t)c*m;
+				double sum = y[S.first + c];
+				for (int i = c + 1; i < m; ++i) sum -= Lc[i] * y[rows[i]];
+				y[S.first + c] = sum;
+			}
+		}
+	}
+	else
+	{
+		// backward substitution with U
+		for (int s = nsn - 1; s >= 0; --s)
+		{
+			const Supernode& S = sn[s];
+			int m = (int)S.rows.size();
+			int nc = S.ncols;
+			const int* rows = &S.rows[0];
+			const T* Ls = &L[S.loff];
+			const T* Us = (U.empty() ? nullptr : &U[S.uoff]);
+			for (int c = nc - 1; c >= 0; --c)
+			{
+				double sum = y[S.first + c];
+				for (int j = c + 1; j < nc; ++j) sum -= Ls[(size_t)j*m + c] * y[S.first + j];
+				for (int j = nc; j < m; ++j) sum -= Us[(size_t)(j - nc)*nc + c] * y[rows[j]];
+				y[S.first + c] = sum / Ls[(size_t)c*m + c];
+			}
+		}
+	}
+
+	for (int k = 0; k < n; ++k) x[perm[k]] = y[k];
+}
+
+//=============================================================================
+SupernodalSolver::SupernodalSolver(FEModel* fem) : LinearSolver(fem), m(new SupernodalSolver::Imp)
+{
+	m_printLevel = 0;
+	m_leafSize = 64;
+	m_mixedPrecision = false;
+	m_doublePrecision = false;
+	m_pivotEps = 1e-8;
+	m_normA = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+SupernodalSolver::~SupernodalSolver()
+{
+	Destroy();
+	delete m;
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalSolver::SetPrintLevel(int n)
+{
+	m_printLevel = n;
+}
+
+//-----------------------------------------------------------------------------
+// memory of the symbolic and numerical factorization
+size_t SupernodalSolver::MemoryUsage() const
+{
+	size_t mem = (m->L.capacity() + m->U.capacity() + m->y.capacity())*sizeof(double);
+	mem += (m->Lf.capacity() + m->Uf.capacity())*sizeof(float);
+	mem += m->perm.capacity()*sizeof(int);
+	for (const Supernode& s : m->sn)
+	{
+		mem += sizeof(Supernode) + (s.rows.capacity() + s.relmap.capacity() + s.children.capacity())*sizeof(int);
+	}
+	for (const vector<FrontEntry>& a : m->amap) mem += a.capacity()*sizeof(FrontEntry);
+	for (const vector<int>& l : m->levels) mem += l.capacity()*sizeof(int);
+	return mem;
+}
+
+//-----------------------------------------------------------------------------
+SparseMatrix* SupernodalSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	// allocate the correct matrix format depending on matrix symmetry type
+	switch (ntype)
+	{
+	case REAL_SYMMETRIC     : m->A = new CompactSymmMatrix(0); m->bsymm = true; break;
+	case REAL_UNSYMMETRIC   : m->A = new CRSSparseMatrix(0); m->bsymm = false; break;
+	case REAL_SYMM_STRUCTURE: m->A = new CRSSparseMatrix(0); m->bsymm = false; break;
+	default:
+		assert(false);
+		m->A = nullptr;
+	}
+
+	// a new matrix requires a new symbolic factorization
+	m->bsymbolic = false;
+
+	return m->A;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::SetSparseMatrix(SparseMatrix* pA)
+{
+	CompactSymmMatrix* pS = dynamic_cast<CompactSymmMatrix*>(pA);
+	CRSSparseMatrix* pU = dynamic_cast<CRSSparseMatrix*>(pA);
+	if (pS) { m->A = pS; m->bsymm = true; }
+	else if (pU) { m->A = pU; m->bsymm = false; }
+	else return false;
+
+	m->bsymbolic = false;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::PreProcess()
+{
+	if (m->A == nullptr) return false;
+
+	// see if the sparsity pattern has changed since the last symbolic factorization
+	int neq = m->A->Rows();
+	int nnz = m->A->NonZeroes();
+	unsigned long long hash = m->PatternHash();
+	if (m->bsymbolic && (neq == m->fp_neq) && (nnz == m->fp_nnz) && (hash == m->fp_hash))
+	{
+		if (m_printLevel > 0) feLog("\tsupernodal solver: reusing symbolic factorization\n");
+		return LinearSolver::PreProcess();
+	}
+
+	if (m->Symbolic(m_leafSize) == false) return false;
+	m->fp_neq = neq;
+	m->fp_nnz = nnz;
+	m->fp_hash = hash;
+
+	if (m_printLevel > 0)
+	{
+		size_t nnzL = 0;
+		for (const Supernode& S : m->sn)
+		{
+			size_t ms = S.rows.size();
+			nnzL += ms*S.ncols - (S.ncols*(S.ncols - 1)) / 2;
+		}
+		feLog("\tsupernodal solver: symbolic factorization\n");
+		feLog("\t\tNr of supernodes .......................... : %d\n", (int)m->sn.size());
+		feLog("\t\tNr of levels in assembly tree ............. : %d\n", (int)m->levels.size());
+		feLog("\t\tNr of nonzeroes in factor ................. : %lg\n", (double)nnzL);
+	}
+
+	return LinearSolver::PreProcess();
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::Factor()
+{
+	// make sure we have work to do
+	if ((m->A == nullptr) || (m->A->Rows() == 0)) return true;
+
+	if (m->bsymbolic == false)
+	{
+		if (PreProcess() == false) return false;
+	}
+
+	// pivots that are tiny compared to the matrix norm are perturbed
+	m_normA = m->A->infNorm();
+	m->pivtol = m_pivotEps*m_normA;
+
+	// In mixed precision mode, we factor in single precision, unless we had to 
+	// fall back to double precision before.
+	bool singlePrecision = (m_mixedPrecision && !m_doublePrecision);
+	bool bok = false;
+	if (singlePrecision)
+	{
+		bok = m->Numeric(true);
+		if (bok == false)
+		{
+			feLogWarning("Single precision factorization failed. Switching to double precision.");
+			m_doublePrecision = true;
+		}
+	}
+	if (bok == false) bok = m->Numeric(false);
+
+	if (bok && (m->npert > 0) && (m_printLevel > 0))
+	{
+		feLog("\tsupernodal solver: %d pivots perturbed\n", m->npert);
+	}
+
+	return bok;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::BackSolve(double* x, double* b)
+{
+	// make sure we have work to do
+	if ((m->A == nullptr) || (m->A->Rows() == 0)) return true;
+	if (m->bfactored == false) return false;
+
+	m->Solve(x, b);
+
+	// Recover double precision accuracy. This is needed for a single precision
+	// factor and for a factor with perturbed pivots.
+	int iters = 0;
+	bool brefine = (m->bsingle || (m->npert > 0));
+	if (brefine && (IterativeRefinement(m->A, m_normA, x, b, &iters) == false))
+	{
+		if (m->bsingle)
+		{
+			// The refinement stalled, which means the matrix is too ill-conditioned 
+			// for a single precision factor. So, we refactor in double precision and
+			// continue in double precision from now on.
+			feLogWarning("Iterative refinement stalled. Switching to double precision.");
+			m_doublePrecision = true;
+			if (m->Numeric(false) == false) return false;
+			m->Solve(x, b);
+
+			// the stalled refinement steps are not part of the returned solution
+			iters = 0;
+		}
+
+		if ((m->npert > 0) && (IterativeRefinement(m->A, m_normA, x, b, &iters) == false))
+		{
+			// the perturbed factor is too far off, so the matrix is (nearly) singular
+			feLogError("Supernodal solver: iterative refinement failed after perturbing %d tiny pivots.\nThe matrix is probably singular.", m->npert);
+			return false;
+		}
+	}
+	else if (brefine && (m_printLevel > 0))
+	{
+		feLog("	supernodal solver: %d refinement steps\n", iters);
+	}
+
+	// update stats
+	UpdateStats(1 + iters);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::SolveCorrection(double* dx, double* r)
+{
+	m->Solve(dx, r);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// This releases the numerical factor. The symbolic factorization is kept, since
+// it can be reused if the sparsity pattern does not change.
+void SupernodalSolver::Destroy()
+{
+	vector<double>().swap(m->L);
+	vector<double>().swap(m->U);
+	vector<float>().swap(m->Lf);
+	vector<float>().swap(m->Uf);
+	m->bfactored = false;
+	LinearSolver::Destroy();
+}
@@ -0,0 +1,85 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include <FECore/CompactMatrix.h>
+
+//-----------------------------------------------------------------------------
+//! Native, multithreaded supernodal direct solver. 
+
+//! This solver does not depend on any third-party libraries. It computes a 
+//! nested-dissection ordering, a symbolic factorization and then a multifrontal 
+//! numerical factorization (LDL^T for symmetric matrices and LU for unsymmetric
+//! matrices). The supernodes are processed one level of the assembly tree at a time
+//! so that independent fronts are factored in parallel. 
+//! The symbolic factorization is only redone when the sparsity pattern changes.
+//! In mixed precision mode, the factor is computed and stored in single precision 
+//! and the solution is improved to double precision accuracy by iterative refinement.
+//! If the refinement stalls, the solver switches to a double precision factor.
+//! NOTE: There is no (numerical) pivoting. Pivots smaller than pivot_perturbation 
+//! times the matrix norm are perturbed, and iterative refinement is used to recover 
+//! the solution. This works well for the (nearly) positive definite and diagonally
+//! dominant matrices of most models, but symmetric indefinite matrices (e.g. from 
+//! Lagrange multipliers) or matrices with many zero pivots may fail to converge,
+//! in which case the solve fails with an error. Use pardiso for such models.
+class SupernodalSolver : public LinearSolver
+{
+	class Imp;
+
+public:
+	SupernodalSolver(FEModel* fem);
+	~SupernodalSolver();
+	bool PreProcess() override;
+	bool Factor() override;
+	bool BackSolve(double* x, double* y) override;
+	void Destroy() override;
+
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+	bool SetSparseMatrix(SparseMatrix* pA) override;
+
+	void SetPrintLevel(int n) override;
+
+	size_t MemoryUsage() const override;
+
+protected:
+	bool SolveCorrection(double* dx, double* r) override;
+
+protected:
+	Imp*	m;
+
+	int		m_printLevel;	//!< print level
+	int		m_leafSize;		//!< max size of subgraphs that are not further dissected
+	bool	m_mixedPrecision;	//!< factor in single precision and use iterative refinement
+	double	m_pivotEps;			//!< relative size of tiny pivots that are perturbed
+
+	bool	m_doublePrecision;	//!< set when mixed precision failed
+	double	m_normA;			//!< inf-norm of matrix (for the refinement stopping test)
+
+	DECLARE_FECORE_CLASS();
+};
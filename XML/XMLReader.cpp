@@ -28,8 +28,164 @@ SOFTWARE.*/
 #include <stdarg.h>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <stdint.h>
+#include <stdlib.h>
+#include <locale.h>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
 using namespace std;
 
+//=============================================================================
+// Number conversion
+//=============================================================================
+
+// Powers of ten that are exactly representable as doubles
+static const double xml_pow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool xml_isspace(char c) { return ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || (c == '\f') || (c == '\v')); }
+inline bool xml_isdigit(char c) { return ((c >= '0') && (c <= '9')); }
+
+//-----------------------------------------------------------------------------
+// Reads an integer from the start of the string (like atoi). Leading whitespace
+// is skipped. Returns a pointer past the number, or nullptr if no number was found.
+static const char* xml_read_int(const char* sz, int& n)
+{
+	while (xml_isspace(*sz)) ++sz;
+	bool neg = false;
+	if      (*sz == '-') { neg = true; ++sz; }
+	else if (*sz == '+') ++sz;
+	if (!xml_isdigit(*sz)) { n = 0; return nullptr; }
+
+	int v = 0;
+	while (xml_isdigit(*sz)) v = 10*v + (*sz++ - '0');
+	n = (neg ? -v : v);
+	return sz;
+}
+
+//-----------------------------------------------------------------------------
+// strtod in the "C" locale, so that the decimal separator is always a '.'
+static double xml_strtod(const char* sz, char** se)
+{
+#ifdef WIN32
+	static _locale_t loc = _create_locale(LC_NUMERIC, "C");
+	return _strtod_l(sz, se, loc);
+#else
+	static locale_t loc = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+	return strtod_l(sz, se, loc);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Reads a floating point number from the start of the string (like atof), but 
+// does not depend on the locale. Numbers with at most 19 significant digits
+// and a small exponent are converted exactly, all others are passed to strtod 
+// (in the "C" locale).
+static const char* xml_read_double(const char* sz, double& v)
+{
+	const char* s = sz;
+	while (xml_isspace(*s)) ++s;
+	bool neg = false;
+	if      (*s == '-') { neg = true; ++s; }
+	else if (*s == '+') ++s;
+
+	uint64_t m = 0;
+	int nd = 0, e10 = 0, ndigits = 0;
+	while (xml_isdigit(*s))
+	{
+		if ((m != 0) || (*s != '0')) { m = 10*m + (*s - '0'); nd++; }
+		++s; ndigits++;
+	}
+	if (*s == '.')
+	{
+		++s;
+		while (xml_isdigit(*s))
+		{
+			if ((m != 0) || (*s != '0')) { m = 10*m + (*s - '0'); nd++; }
+			e10--;
+			++s; ndigits++;
+		}
+	}
+
+	// things like inf, nan, or hex floats are left to strtod
+	if ((ndigits == 0) || (nd > 19))
+	{
+		char* se = nullptr;
+		v = xml_strtod(sz, &se);
+		return (se == sz ? nullptr : se);
+	}
+
+	if ((*s == 'e') || (*s == 'E'))
+	{
+		const char* se = s + 1;
+		bool eneg = false;
+		if      (*se == '-') { eneg = true; ++se; }
+		else if (*se == '+') ++se;
+		if (xml_isdigit(*se))
+		{
+			int e = 0;
+			while (xml_isdigit(*se)) { if (e < 10000) e = 10*e + (*se - '0'); ++se; }
+			e10 += (eneg ? -e : e);
+			s = se;
+		}
+	}
+
+	if ((m <= ((uint64_t)1 << 53)) && (e10 >= -22) && (e10 <= 22))
+	{
+		// both m and 10^e10 are exact, so the result is correctly rounded
+		double d = (double) m;
+		if (e10 < 0) d /= xml_pow10[-e10]; else d *= xml_pow10[e10];
+		v = (neg ? -d : d);
+		return s;
+	}
+
+	char* se = nullptr;
+	v = xml_strtod(sz, &se);
+	return se;
+}
+
+//-----------------------------------------------------------------------------
+// Reads a comma-separated list of at most n values. Returns the number of values
+// that were converted. Conversion stops at the first field that is not a number.
+int string_to_array(const char* sz, int* pi, int n)
+{
+	int nr = 0;
+	for (int i = 0; i < n; ++i)
+	{
+		const char* sze = xml_read_int(sz, pi[i]);
+		if (sze == nullptr) break;
+		nr++;
+
+		// find the next comma
+		while (*sze && (*sze != ',')) ++sze;
+		if (*sze == ',') sz = sze + 1;
+		else break;
+	}
+	return nr;
+}
+
+//-----------------------------------------------------------------------------
+int string_to_array(const char* sz, double* pf, int n)
+{
+	int nr = 0;
+	for (int i = 0; i < n; ++i)
+	{
+		const char* sze = xml_read_double(sz, pf[i]);
+		if (sze == nullptr) { pf[i] = 0.0; break; }
+		nr++;
+
+		// find the next comma
+		while (*sze && (*sze != ',')) ++sze;
+		if (*sze == ',') sz = sze + 1;
+		else break;
+	}
+	return nr;
+}
+
 //=============================================================================
 // XMLAtt
 //=============================================================================
@@ -56,19 +212,7 @@ bool XMLAtt::operator != (const char* szval)
 
 int XMLAtt::value(double* pf, int n)
 {
-	const char* sz = m_val.c_str();
-	int nr = 0;
-	for (int i = 0; i < n; ++i)
-	{
-		const char* sze = strchr(sz, ',');
-
-		pf[i] = atof(sz);
-		nr++;
-
-		if (sze) sz = sze + 1;
-		else break;
-	}
-	return nr;
+	return string_to_array(m_val.c_str(), pf, n);
 }
 
 //=============================================================================
@@ -135,19 +279,7 @@ std::string XMLTag::relpath(const char* szroot) const
 //!
 int XMLTag::value(double* pf, int n)
 {
-	const char* sz = m_szval.c_str();
-	int nr = 0;
-	for (int i=0; i<n; ++i)
-	{
-		const char* sze = strchr(sz, ',');
-
-		pf[i] = atof(sz);
-		nr++;
-
-		if (sze) sz = sze+1;
-		else break;
-	}
-	return nr;
+	return string_to_array(m_szval.c_str(), pf, n);
 }
 
 //-----------------------------------------------------------------------------
@@ -162,7 +294,9 @@ int XMLTag::value(float* pf, int n)
 	{
 		const char* sze = strchr(sz, ',');
 
-		pf[i] = (float) atof(sz);
+		double v = 0.0;
+		if (xml_read_double(sz, v) == nullptr) break;
+		pf[i] = (float) v;
 		nr++;
 
 		if (sze) sz = sze+1;
@@ -177,19 +311,7 @@ int XMLTag::value(float* pf, int n)
 //!
 int XMLTag::value(int* pi, int n)
 {
-	const char* sz = m_szval.c_str();
-	int nr = 0;
-	for (int i=0; i<n; ++i)
-	{
-		const char* sze = strchr(sz, ',');
-
-		pi[i] = atoi(sz);
-		nr++;
-
-		if (sze) sz = sze+1;
-		else break;
-	}
-	return nr;
+	return string_to_array(m_szval.c_str(), pi, n);
 }
 
 //-----------------------------------------------------------------------------
@@ -244,78 +366,30 @@ void XMLTag::value(std::string& val)
 //-----------------------------------------------------------------------------
 void XMLTag::value(vector<int>& l)
 {
-	int i, n = 0, n0, n1, nn;
-	char* szval = strdup(m_szval.c_str());
-	char* ch;
-	char* sz = szval;
-	int nread;
+	vector<int> tmp;
+	const char* sz = m_szval.c_str();
 	do
 	{
-		ch = strchr(sz, ',');
-		if (ch) *ch = 0;
-		nread = sscanf(sz, "%d:%d:%d", &n0, &n1, &nn);
-		switch (nread)
+		// each item is either a single number or a range n0:n1[:nn]
+		int n0 = 0, n1 = -1, nn = 1;
+		const char* ch = xml_read_int(sz, n0);
+		if (ch == nullptr) { n0 = 0; n1 = -1; }
+		else if (*ch != ':') n1 = n0;
+		else
 		{
-		case 1:
-			n1 = n0;
-			nn = 1;
-			break;
-		case 2:
-			nn = 1;
-			break;
-		case 3:
-			break;
-		default:
-			n0 = 0;
-			n1 = -1;
-			nn = 1;
+			ch = xml_read_int(ch + 1, n1);
+			if (ch == nullptr) n1 = n0;
+			else if ((*ch == ':') && (xml_read_int(ch + 1, nn) == nullptr)) nn = 1;
 		}
 
-		for (i=n0; i<=n1; i += nn) ++n;
-
-		if (ch) *ch = ',';
-		sz = ch+1;
-	}
-	while (ch != 0);
-
-	if (n != 0)
-	{
-		l.resize(n);
-
-		sz = szval;
-		n = 0;
-		do
-		{
-			ch = strchr(sz, ',');
-			if (ch) *ch = 0;
-			nread = sscanf(sz, "%d:%d:%d", &n0, &n1, &nn);
-			switch (nread)
-			{
-			case 1:
-				n1 = n0;
-				nn = 1;
-				break;
-			case 2:
-				nn = 1;
-				break;
-			case 3:
-				break;
-			default:
-				n0 = 0;
-				n1 = -1;
-				nn = 1;
-			}
-
-			for (i=n0; i<=n1; i += nn) l[n++] = i;
-			assert(n <= (int) l.size());
+		for (int i=n0; i<=n1; i += nn) tmp.push_back(i);
 
-			if (ch) *ch = ',';
-			sz = ch+1;
-		}
-		while (ch != 0);
+		sz = strchr(sz, ',');
+		if (sz) sz++;
 	}
+	while (sz != 0);
 
-	free(szval);
+	if (tmp.empty() == false) l = std::move(tmp);
 }
 
 //-----------------------------------------------------------------------------
@@ -331,7 +405,8 @@ void XMLTag::value(vector<double>& l)
 		// read the value
 		if (sz && *sz)
 		{
-			double v = atof(sz);
+			double v = 0.0;
+			if (xml_read_double(sz, v) == nullptr) v = 0.0;
 			l.push_back(v);
 
 			// find next space or comma
@@ -353,7 +428,8 @@ void XMLTag::value2(std::vector<int>& l)
 		// read the value
 		if (sz && *sz)
 		{
-			int v = (int)atoi(sz);
+			int v = 0;
+			xml_read_int(sz, v);
 			l.push_back(v);
 
 			// find next space or comma
@@ -978,8 +1054,7 @@ void XMLReader::ReadTag(XMLTag& tag)
 		char quot = ch;
 
 		// read the value
-		std::string& val = att.m_val;
-		while ((ch=GetChar())!=quot) val.push_back(ch);
+		ReadText(quot, &att.m_val);
 		ch=GetChar();
 
 		// mark tag as unvisited
@@ -993,17 +1068,46 @@ void XMLReader::ReadTag(XMLTag& tag)
 //-----------------------------------------------------------------------------
 void XMLReader::ReadValue(XMLTag& tag)
 {
-	char ch;
 	if (!tag.isend())
 	{
 		tag.m_szval.clear();
-		tag.m_szval.reserve(256);
-		while ((ch=GetChar())!='<') 
-		{ 
-			tag.m_szval.push_back(ch);
-		}
+		ReadText('<', &tag.m_szval);
+	}
+	else ReadText('<', nullptr);
+}
+
+//-----------------------------------------------------------------------------
+//! Read all characters up to (and including) the terminator. The characters
+//! before the terminator are appended to val (if not null). Instead of reading
+//! the text one character at a time, the buffer is scanned for the terminator
+//! and copied in blocks. Only entity references are processed by GetChar.
+void XMLReader::ReadText(char term, std::string* val)
+{
+	while (true)
+	{
+		// make sure the buffer is not empty
+		if (m_bufIndex >= m_bufSize) { readNextChar(); rewind(1); }
+
+		const char* p = m_buf + m_bufIndex;
+		size_t n = (size_t)(m_bufSize - m_bufIndex);
+
+		// find the terminator or the start of an entity reference
+		const char* pt = (const char*)memchr(p, term, n);
+		const char* pa = (const char*)memchr(p, '&', (pt ? (size_t)(pt - p) : n));
+		const char* pe = (pa ? pa : pt);
+		size_t m = (pe ? (size_t)(pe - p) : n);
+
+		if (val) val->append(p, m);
+		m_nline += (int)std::count(p, p + m, '\n');
+		m_bufIndex += m;
+		m_currentPos += m;
+
+		if (pe == nullptr) continue;
+
+		char ch = GetChar();
+		if (pe == pt) break;
+		else if (val) val->push_back(ch);
 	}
-	else while ((ch=GetChar())!='<');
 }
 
 //-----------------------------------------------------------------------------
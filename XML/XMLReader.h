@@ -304,6 +304,9 @@ protected: // helper functions
 	//! Read the value of a tag
 	void ReadValue(XMLTag& tag);
 
+	//! Read text up to the terminating character
+	void ReadText(char term, std::string* val);
+
 	//! process end tag
 	void ReadEndTag(XMLTag& tag);
 
@@ -340,6 +343,13 @@ inline void XMLTag::skip() { m_preader->SkipTag(*this); }
 
 inline const std::string& XMLTag::comment() { return m_preader->GetLastComment(); }
 
+//-----------------------------------------------------------------------------
+// Locale-independent conversion of a comma separated list of numbers. At most
+// n values are read. Returns the number of values that were converted, which stops
+// at the first field that is not a number.
+int string_to_array(const char* sz, int* pi, int n);
+int string_to_array(const char* sz, double* pf, int n);
+
 //-----------------------------------------------------------------------------
 // mechanism for using custom types with XMLReader. 
 template <class T> void string_to_type(const std::string& s, T& v) { assert(false); }